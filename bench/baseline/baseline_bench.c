@@ -0,0 +1,387 @@
+/*****************************************************************************
+    baseline_bench.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Measures each public string operation against the equivalent C
+        library operation on a C-string of the same length.  Lengths run
+        from one character to the longest possible string.  Each pair of
+        cases does the same work, so "hzstr_cat" against "libc strcat" is
+        the cost (or saving) of using a string object instead of a
+        C-string.
+
+        The C library cases allocate through mem_malloc(), so their
+        allocs/op can be compared with the string cases.
+
+        "make run" writes the CSV and JSON reports used to track results
+        between releases.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+#include "hzstr.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define NUM_SIZES ( 5 )             //number of string sizes to measure
+#define MAX_SIZE ( 65534 )          //longest possible string
+#define BUFFER_SIZE ( MAX_SIZE + 1 )//C-string buffer size
+
+//operations for a case (about the same amount of work for every length)
+#define ops( _l ) ( 16000000 / ( ( _l ) + 16 ) )
+
+//define symbols to disable the corresponding benchmark section
+//#define BNO_APPEND
+//#define BNO_CAT
+//#define BNO_CPY
+//#define BNO_CMP
+//#define BNO_STRCHR
+//#define BNO_TOLOWER
+//#define BNO_TRIM
+//#define BNO_SPRINTF
+//#define BNO_CREATE
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const hzstr_length_t sizes[ NUM_SIZES ] = {
+    1, 16, 256, 4096, MAX_SIZE
+};
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static char             target[ BUFFER_SIZE ];  //C-string output
+static char             text[ BUFFER_SIZE ];    //C-string input
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int run_bench(                      //run the benchmark
+    bench_control_type* bench       //benchmark control object
+) {                                 //result of benchmark
+
+    //local variables
+    char*               copy;       //allocated C-string
+    unsigned long       count;      //operations per case
+    unsigned long       index;      //operation index
+    hzstr_length_t      left;       //C-string characters trimmed on the left
+    hzstr_length_t      length;     //string length of the current case
+    hzstr_length_t      pos;        //character index
+    hzstr_type*         other;      //equal string to compare
+    hzstr_length_t      right;      //C-string characters kept on the right
+    int                 size;       //size index
+    hzstr_type*         source;     //string with the input text
+    hzstr_type*         string;     //string under test
+    volatile unsigned long total;   //keeps the result of each operation
+    hzstr_type*         view;       //substring under test
+
+    total = 0;
+    memset( text, 'a', MAX_SIZE );
+
+#ifndef BNO_APPEND
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        //grow the string once, so every case below fits
+        string = hzstr_create( length );
+        b_start( "hzstr_append", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_consume( string, hzstr_length( string ) );
+            for( pos = 0; pos < length; ++pos ) {
+                hzstr_append( string, 'a' );
+            }
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        b_start( "libc store", length, count );
+        for( index = 0; index < count; ++index ) {
+            for( pos = 0; pos < length; ++pos ) {
+                target[ pos ] = 'a';
+            }
+            target[ length ] = '\0';
+            total += target[ 0 ];
+        }
+        b_stop();
+    }
+#endif
+
+#ifndef BNO_CAT
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        text[ length ] = '\0';
+        source = hzstr_create_cstr( text );
+        string = hzstr_create( length );
+        b_start( "hzstr_cat", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_consume( string, hzstr_length( string ) );
+            hzstr_cat( string, source );
+        }
+        b_stop();
+        hzstr_destroy( string );
+        hzstr_destroy( source );
+
+        b_start( "libc strcat", length, count );
+        for( index = 0; index < count; ++index ) {
+            target[ 0 ] = '\0';
+            strcat( target, text );
+            total += target[ 0 ];
+        }
+        b_stop();
+        text[ length ] = 'a';
+    }
+#endif
+
+#ifndef BNO_CPY
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        text[ length ] = '\0';
+        source = hzstr_create_cstr( text );
+        string = hzstr_create( length );
+        b_start( "hzstr_cpy", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_cpy( string, source );
+        }
+        b_stop();
+        hzstr_destroy( string );
+        hzstr_destroy( source );
+
+        b_start( "libc strcpy", length, count );
+        for( index = 0; index < count; ++index ) {
+            strcpy( target, text );
+            total += target[ 0 ];
+        }
+        b_stop();
+        text[ length ] = 'a';
+    }
+#endif
+
+#ifndef BNO_CMP
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        //equal strings are compared to the end
+        text[ length ] = '\0';
+        source = hzstr_create_cstr( text );
+        other  = hzstr_create_cstr( text );
+        b_start( "hzstr_cmp", length, count );
+        for( index = 0; index < count; ++index ) {
+            total += hzstr_cmp( source, other );
+        }
+        b_stop();
+        hzstr_destroy( other );
+        hzstr_destroy( source );
+
+        strcpy( target, text );
+        b_start( "libc strcmp", length, count );
+        for( index = 0; index < count; ++index ) {
+            total += strcmp( target, text );
+        }
+        b_stop();
+        text[ length ] = 'a';
+    }
+#endif
+
+#ifndef BNO_STRCHR
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        //the searched character is never found
+        text[ length ] = '\0';
+        source = hzstr_create_cstr( text );
+        b_start( "hzstr_strchr", length, count );
+        for( index = 0; index < count; ++index ) {
+            total += hzstr_strchr( source, 'z' );
+        }
+        b_stop();
+        hzstr_destroy( source );
+
+        b_start( "libc strchr", length, count );
+        for( index = 0; index < count; ++index ) {
+            total += ( strchr( text, 'z' ) == NULL );
+        }
+        b_stop();
+        text[ length ] = 'a';
+    }
+#endif
+
+#ifndef BNO_TOLOWER
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        text[ length ] = '\0';
+        string = hzstr_create_cstr( text );
+        b_start( "hzstr_tolower", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_tolower( string );
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        strcpy( target, text );
+        b_start( "libc tolower", length, count );
+        for( index = 0; index < count; ++index ) {
+            for( pos = 0; target[ pos ] != '\0'; ++pos ) {
+                target[ pos ] = tolower( ( unsigned char ) target[ pos ] );
+            }
+            total += target[ 0 ];
+        }
+        b_stop();
+        text[ length ] = 'a';
+    }
+#endif
+
+#ifndef BNO_TRIM
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        //surround one character with whitespace (trimming a view of it only
+        //  scans the string, so each operation starts from the same state)
+        memset( target, ' ', length );
+        target[ length / 2 ] = 'x';
+        target[ length ]     = '\0';
+        string = hzstr_create_cstr( target );
+        view   = hzstr_create_substr( string, 0, length );
+        b_start( "hzstr_trim", length, count );
+        for( index = 0; index < count; ++index ) {
+            view->data   = string->data;
+            view->length = length;
+            hzstr_trim( view );
+        }
+        b_stop();
+        hzstr_destroy( view );
+        hzstr_destroy( string );
+
+        //the usual C-string trim, without moving the characters
+        b_start( "libc isspace trim", length, count );
+        for( index = 0; index < count; ++index ) {
+            for( left = 0; isspace( ( unsigned char ) target[ left ] ); ) {
+                left += 1;
+            }
+            for( right = length; right > left; --right ) {
+                if( !isspace( ( unsigned char ) target[ right - 1 ] ) ) {
+                    break;
+                }
+            }
+            total += ( right - left );
+        }
+        b_stop();
+    }
+#endif
+
+#if !defined( BNO_SPRINTF ) && defined( HZSTR_COMPAT_CSTR )
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        text[ length ] = '\0';
+        string = hzstr_create( length );
+        b_start( "hzstr_sprintf", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_sprintf( string, "%s", text );
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        b_start( "libc snprintf", length, count );
+        for( index = 0; index < count; ++index ) {
+            total += snprintf( target, BUFFER_SIZE, "%s", text );
+        }
+        b_stop();
+        text[ length ] = 'a';
+    }
+#endif
+
+#ifndef BNO_CREATE
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = ops( length );
+
+        text[ length ] = '\0';
+        b_start( "hzstr_create_cstr", length, count );
+        for( index = 0; index < count; ++index ) {
+            string = hzstr_create_cstr( text );
+            total += hzstr_length( string );
+            hzstr_destroy( string );
+        }
+        b_stop();
+
+        b_start( "libc strlen+malloc+memcpy", length, count );
+        for( index = 0; index < count; ++index ) {
+            pos  = strlen( text );
+            copy = mem_malloc( pos + 1 );
+            memcpy( copy, text, ( pos + 1 ) );
+            total += copy[ 0 ];
+            mem_free( copy );
+        }
+        b_stop();
+
+        source = hzstr_create_cstr( text );
+        b_start( "hzstr_create_substr", length, count );
+        for( index = 0; index < count; ++index ) {
+            string = hzstr_create_substr( source, 0, length );
+            total += hzstr_length( string );
+            hzstr_destroy( string );
+        }
+        b_stop();
+        hzstr_destroy( source );
+
+        b_start( "hzstr_create", length, count );
+        for( index = 0; index < count; ++index ) {
+            string = hzstr_create( length );
+            total += hzstr_length( string );
+            hzstr_destroy( string );
+        }
+        b_stop();
+
+        b_start( "libc malloc", length, count );
+        for( index = 0; index < count; ++index ) {
+            copy = mem_malloc( length + 1 );
+            copy[ 0 ] = '\0';
+            total += copy[ 0 ];
+            mem_free( copy );
+        }
+        b_stop();
+        text[ length ] = 'a';
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,364 @@
+/*****************************************************************************
+    bench.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+
+#ifdef BENCH_POOL
+#include "memory.h"
+#endif
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//counted allocations are made from the pool in pool builds (memory.h maps
+//  the mem_* names to the pool, but this file defines the mem_* functions)
+#ifdef BENCH_POOL
+#undef mem_calloc
+#undef mem_free
+#undef mem_malloc
+#undef mem_realloc
+#define heap_calloc     mem_pool_calloc
+#define heap_free       mem_pool_free
+#define heap_malloc     mem_pool_malloc
+#define heap_realloc    mem_pool_realloc
+#else
+#define heap_calloc     calloc
+#define heap_free       free
+#define heap_malloc     malloc
+#define heap_realloc    realloc
+#endif
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned long           bench_allocs;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+extern int run_bench(               //allow the linker to use run_bench()
+    bench_control_type* bench       //pointer to benchmark control object
+);                                  //result of benchmark
+
+static double now(                  //read the monotonic clock
+    void
+);                                  //current time in seconds
+
+static void write_heading(          //write the heading of a report
+    FILE*               out,        //report output file descriptor
+    int                 format      //format of the report
+);
+
+static void write_quoted(           //write text in double quotes
+    FILE*               out,        //report output file descriptor
+    const char*         text,       //text to write
+    char                escape      //character written before quotes
+);
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int main(                           //entry point of benchmark runner
+    int                 argc,       //number of command-line arguments
+    char**              argv        //list of command-line arguments
+) {                                 //benchmark result status
+
+    //local variables
+    bench_control_type  bench;      //benchmark control object
+    const char*         extension;  //file extension of a report
+    int                 report;     //report index
+    int                 result;     //result of benchmark
+
+    //clear the benchmark object
+    memset( &bench, 0, sizeof( bench_control_type ) );
+
+    //reports name the benchmark program without its directory
+    bench.program = strrchr( argv[ 0 ], '/' );
+    if( bench.program != NULL ) {
+        bench.program += 1;
+    }
+    else {
+        bench.program = argv[ 0 ];
+    }
+
+    //check for output report files
+    for( report = 1; report < argc; ++report ) {
+        if( report > BENCH_NUM_REPORTS ) {
+            printf( "Too many reports (at most %d).\n", BENCH_NUM_REPORTS );
+            return 1;
+        }
+        bench.out[ bench.reports ] = fopen( argv[ report ], "w" );
+        if( bench.out[ bench.reports ] == NULL ) {
+            printf( "Unable to open \"%s\" for writing.\n", argv[ report ] );
+            return 1;
+        }
+        extension = strrchr( argv[ report ], '.' );
+        if( ( extension != NULL ) && ( strcmp( extension, ".csv" ) == 0 ) ) {
+            bench.formats[ bench.reports ] = BENCH_FMT_CSV;
+        }
+        else if(
+            ( extension != NULL ) && ( strcmp( extension, ".json" ) == 0 )
+        ) {
+            bench.formats[ bench.reports ] = BENCH_FMT_JSON;
+        }
+        else {
+            bench.formats[ bench.reports ] = BENCH_FMT_TEXT;
+        }
+        bench.reports += 1;
+    }
+    if( bench.reports == 0 ) {
+        bench.out[ 0 ]     = stdout;
+        bench.formats[ 0 ] = BENCH_FMT_TEXT;
+        bench.reports      = 1;
+    }
+
+    //write the report headings
+    for( report = 0; report < bench.reports; ++report ) {
+        write_heading( bench.out[ report ], bench.formats[ report ] );
+    }
+
+    //run the benchmark
+    result = run_bench( &bench );
+
+    //finish and close the reports
+    for( report = 0; report < bench.reports; ++report ) {
+        if( bench.formats[ report ] == BENCH_FMT_JSON ) {
+            fprintf( bench.out[ report ], "\n]\n" );
+        }
+        if( bench.out[ report ] != stdout ) {
+            fclose( bench.out[ report ] );
+        }
+    }
+
+    //return the result of the benchmark
+    return result;
+}
+
+
+/*==========================================================================*/
+void bench_start(                   //start timing a benchmark case
+    bench_control_type* bench,      //the benchmark instance
+    const char*         name,       //name of the case
+    unsigned long       size,       //characters processed per operation
+    unsigned long       count       //number of operations to be timed
+) {
+
+    //record the case parameters
+    bench->name   = name;
+    bench->size   = size;
+    bench->count  = count;
+    bench->allocs = bench_allocs;
+
+    //record the start time last so setup is not timed
+    bench->start  = now();
+}
+
+
+/*==========================================================================*/
+void bench_stop(                    //stop timing and report a case
+    bench_control_type* bench       //the benchmark instance
+) {
+
+    //local variables
+    double              allocs;     //allocations per operation
+    double              count;      //number of operations
+    double              elapsed;    //time spent in the case (seconds)
+    double              rate;       //characters per second
+    int                 report;     //report index
+
+    //read the clock before doing anything else
+    elapsed = now() - bench->start;
+
+    //guard against empty cases
+    count = bench->count > 0 ? ( double ) bench->count : 1.0;
+
+    //calculate the results
+    allocs  = ( double ) ( bench_allocs - bench->allocs ) / count;
+    rate    = ( elapsed > 0.0 )
+            ? ( ( ( double ) bench->size * count ) / elapsed )
+            : 0.0;
+    elapsed = ( elapsed * 1e9 ) / count;
+
+    //report the case in each format
+    for( report = 0; report < bench->reports; ++report ) {
+        switch( bench->formats[ report ] ) {
+
+            case BENCH_FMT_CSV:
+                fprintf( bench->out[ report ], "%s,", bench->program );
+                write_quoted( bench->out[ report ], bench->name, '"' );
+                fprintf(
+                    bench->out[ report ],
+                    ",%lu,%lu,%.1f,%.3f,%.2f\n",
+                    bench->size,
+                    bench->count,
+                    elapsed,
+                    ( rate / 1e9 ),
+                    allocs
+                );
+                break;
+
+            case BENCH_FMT_JSON:
+                fprintf(
+                    bench->out[ report ],
+                    "%s\n  { \"bench\": \"%s\", \"case\": ",
+                    ( bench->cases > 0 ? "," : "" ),
+                    bench->program
+                );
+                write_quoted( bench->out[ report ], bench->name, '\\' );
+                fprintf(
+                    bench->out[ report ],
+                    ", \"size\": %lu, \"ops\": %lu, \"ns_per_op\": %.1f,"
+                    " \"gb_per_s\": %.3f, \"allocs_per_op\": %.2f }",
+                    bench->size,
+                    bench->count,
+                    elapsed,
+                    ( rate / 1e9 ),
+                    allocs
+                );
+                break;
+
+            default:
+                fprintf(
+                    bench->out[ report ],
+                    "%-32s %8lu %10lu %12.1f %10.1f %10.2f\n",
+                    bench->name,
+                    bench->size,
+                    bench->count,
+                    elapsed,
+                    ( rate / 1e6 ),
+                    allocs
+                );
+                break;
+        }
+    }
+    bench->cases += 1;
+}
+
+
+/*==========================================================================*/
+static double now(                  //read the monotonic clock
+    void
+) {                                 //current time in seconds
+
+    //local variables
+    struct timespec     ts;         //clock value
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( double ) ts.tv_sec + ( ( double ) ts.tv_nsec / 1e9 );
+}
+
+
+/*==========================================================================*/
+static void write_heading(          //write the heading of a report
+    FILE*               out,        //report output file descriptor
+    int                 format      //format of the report
+) {
+    switch( format ) {
+        case BENCH_FMT_CSV:
+            fprintf(
+                out,
+                "bench,case,size,ops,ns_per_op,gb_per_s,allocs_per_op\n"
+            );
+            break;
+        case BENCH_FMT_JSON:
+            fprintf( out, "[" );
+            break;
+        default:
+            fprintf(
+                out,
+                "%-32s %8s %10s %12s %10s %10s\n",
+                "case", "size", "ops", "ns/op", "MB/s", "allocs/op"
+            );
+            break;
+    }
+}
+
+
+/*==========================================================================*/
+static void write_quoted(           //write text in double quotes
+    FILE*               out,        //report output file descriptor
+    const char*         text,       //text to write
+    char                escape      //character written before quotes
+) {
+
+    //quotes (and escape characters) in the text are escaped
+    fputc( '"', out );
+    for( ; *text != '\0'; ++text ) {
+        if( ( *text == '"' ) || ( *text == escape ) ) {
+            fputc( escape, out );
+        }
+        fputc( *text, out );
+    }
+    fputc( '"', out );
+}
+
+
+/*----------------------------------------------------------------------------
+Allocation Counters
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    bench_allocs += 1;
+    return heap_calloc( num, size );
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    heap_free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    bench_allocs += 1;
+    return heap_malloc( size );
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    bench_allocs += 1;
+    return heap_realloc( ptr, size );
+}
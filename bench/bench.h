@@ -0,0 +1,99 @@
+/*****************************************************************************
+    bench.h
+    Zac Hester
+    2026-10-19
+
+    Minimal microbenchmark framework.  Each benchmark program provides a
+    run_bench() function that times a series of cases between b_start() and
+    b_stop().  The code under test is built with UNIT_TEST defined so the
+    framework can count calls into the mem_* allocation interface.
+
+    Each case is written to every report named on the command line (or to
+    the console).  A report's format is chosen by its file extension:
+    ".csv" and ".json" reports are meant for tracking results between
+    releases, and any other report is a table for reading.
+
+    Example Usage
+
+        b_start( "hzstr_insert", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_insert( string, offset, source );
+        }
+        b_stop();
+
+*****************************************************************************/
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define BENCH_NUM_REPORTS ( 3 )     //most reports written by one run
+
+//report formats
+#define BENCH_FMT_TEXT ( 0 )        //table for reading
+#define BENCH_FMT_CSV ( 1 )         //comma-separated values
+#define BENCH_FMT_JSON ( 2 )        //array of JSON objects
+
+//convenience/readability macros
+#define b_start( _n, _s, _c ) bench_start( bench, ( _n ), ( _s ), ( _c ) )
+#define b_stop() bench_stop( bench )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct {                    //benchmark control type
+    FILE*               out[ BENCH_NUM_REPORTS ];
+                                    //report output file descriptors
+    int                 formats[ BENCH_NUM_REPORTS ];
+                                    //format of each report
+    int                 reports;    //number of reports
+    const char*         program;    //name of the benchmark program
+    unsigned long       cases;      //number of cases reported
+    const char*         name;       //name of the current case
+    unsigned long       size;       //characters processed per operation
+    unsigned long       count;      //number of operations in the case
+    unsigned long       allocs;     //allocation count at start of the case
+    double              start;      //time at start of the case (seconds)
+} bench_control_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern unsigned long    bench_allocs;
+                                    //number of allocations made through mem_*
+
+void bench_start(                   //start timing a benchmark case
+    bench_control_type* bench,      //the benchmark instance
+    const char*         name,       //name of the case
+    unsigned long       size,       //characters processed per operation
+    unsigned long       count       //number of operations to be timed
+);
+
+void bench_stop(                    //stop timing and report a case
+    bench_control_type* bench       //the benchmark instance
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BENCH_H */
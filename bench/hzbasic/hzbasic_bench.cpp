@@ -0,0 +1,141 @@
+/*****************************************************************************
+    hzbasic_bench.cpp
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Measures building strings one character at a time with each growth
+        policy, allocator and character width of basic_hzstr, next to the
+        same work through hzstr_append().  The length of each case is the
+        final length of the string, so ns/op divided by length is the cost
+        of one appended character.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "bench.h"
+
+#include "hzbasic.hpp"
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define NUM_SIZES ( 3 )             //number of string sizes to measure
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+//strings that grow geometrically
+typedef hzstr::basic_hzstr< char, hzstr::double_growth > doubling;
+
+//strings that allocate from an arena
+typedef hzstr::basic_hzstr< char, hzstr::double_growth,
+    hzstr::arena_allocator > scratch;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const hzstr_length_t sizes[ NUM_SIZES ] = { 64, 1024, 16384 };
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static char             buffer[ 65536 ];
+                                    //arena memory
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+extern "C" int run_bench(           //run the benchmark
+    bench_control_type* bench       //benchmark control object
+);                                  //result of benchmark
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int run_bench(                      //run the benchmark
+    bench_control_type* bench       //benchmark control object
+) {                                 //result of benchmark
+
+    //local variables
+    unsigned long       count;      //operations per case
+    unsigned long       index;      //operation index
+    hzstr_length_t      length;     //string length of the current case
+    hzstr_length_t      pos;        //character index
+    int                 size;       //size index
+    volatile unsigned long total;   //keeps the result of each operation
+
+    total = 0;
+
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = 1000000 / length;
+
+        b_start( "hzstr_append", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_type* string = hzstr_create( 0 );
+            for( pos = 0; pos < length; ++pos ) {
+                hzstr_append( string, 'a' );
+            }
+            total += string->length;
+            hzstr_destroy( string );
+        }
+        b_stop();
+
+        b_start( "hzstr8 append", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr::hzstr8 string;
+            for( pos = 0; pos < length; ++pos ) {
+                string.append( 'a' );
+            }
+            total += string.length();
+        }
+        b_stop();
+
+        b_start( "hzstr8 append, double growth", length, count );
+        for( index = 0; index < count; ++index ) {
+            doubling string;
+            for( pos = 0; pos < length; ++pos ) {
+                string.append( 'a' );
+            }
+            total += string.length();
+        }
+        b_stop();
+
+        b_start( "hzstr8 append, arena", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr::arena arena( buffer, sizeof( buffer ) );
+            scratch string( ( hzstr::arena_allocator( arena ) ) );
+            for( pos = 0; pos < length; ++pos ) {
+                string.append( 'a' );
+            }
+            total += string.length();
+        }
+        b_stop();
+
+        b_start( "hzstr32 append", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr::hzstr32 string;
+            for( pos = 0; pos < length; ++pos ) {
+                string.append( U'a' );
+            }
+            total += string.length();
+        }
+        b_stop();
+    }
+
+    return 0;
+}
@@ -0,0 +1,453 @@
+/*****************************************************************************
+    hzstr_bench.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        The "rebuild" cases reproduce the pattern used before the editing
+        primitives were available: the edited string is assembled in a new
+        string from substrings of the original.
+
+        The "scan" cases only depend on the width of the character type.
+        "make widths" runs the benchmark with 8-bit, 16-bit and 32-bit
+        characters.
+
+        The "append" and "cat" cases build a string that has already grown
+        (so every call fits), through the header's inline fast paths and
+        through the library functions ("( hzstr_append )").  The length of
+        an append case is the number of characters appended, so ns/op
+        divided by length is the cost of one character.
+
+        "make latency" runs the benchmark with and without HZSTR_LATENCY,
+        to compare the cost of calls that do not grow their string.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "bench.h"
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define NUM_SIZES ( 4 )             //number of string sizes to measure
+#define TEXT_SIZE ( 1048576 )       //size of the untrusted input buffer
+
+//define symbols to disable the corresponding benchmark section
+//#define BNO_APPEND
+//#define BNO_EDIT
+//#define BNO_CONSUME
+//#define BNO_CSTR
+//#define BNO_TRIM
+//#define BNO_SCAN
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const hzstr_length_t sizes[ NUM_SIZES ] = { 64, 1024, 8192, 32768 };
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static char             text[ TEXT_SIZE ];  //C-string input
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static hzstr_type* make_string(     //create a string of a given length
+    hzstr_length_t      length      //length of the string
+);                                  //new string
+
+static hzstr_type* rebuild(         //splice by re-building a string
+    hzstr_type*         string,     //string to edit (destroyed)
+    hzstr_index_t       offset,     //beginning offset of range to replace
+    hzstr_length_t      length,     //number of characters to replace
+    const hzstr_type*   source      //replacement string
+);                                  //new string
+
+static hzstr_type* rebuild_all(     //replace all by re-building a string
+    hzstr_type*         string,     //string to edit (destroyed)
+    const hzstr_type*   needle,     //substring to replace (starts uniquely)
+    const hzstr_type*   source      //replacement string
+);                                  //new string
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int run_bench(                      //run the benchmark
+    bench_control_type* bench       //benchmark control object
+) {                                 //result of benchmark
+
+    //local variables
+    unsigned long       count;      //operations per case
+    unsigned long       index;      //operation index
+    hzstr_length_t      length;     //string length of the current case
+    hzstr_type*         empty;      //empty string
+    hzstr_type*         original;   //unmodified copy of a string
+    hzstr_type*         needle;     //replace-all needle
+    hzstr_type*         other;      //equal string to compare
+    hzstr_type*         source;     //inserted string
+    int                 size;       //size index
+    hzstr_type*         string;     //string under test
+    hzstr_type*         view;       //substring under test
+    hzstr_length_t      pos;        //character index
+
+#ifndef BNO_APPEND
+    source = hzstr_create_cstr( "key=value;" );
+
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ] - 1;
+        count  = 4000000 / length;
+
+        //grow the string once, so every case below fits
+        string = hzstr_create( length );
+
+        b_start( "append inline", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_consume( string, hzstr_length( string ) );
+            for( pos = 0; pos < length; ++pos ) {
+                hzstr_append( string, 'a' );
+            }
+        }
+        b_stop();
+
+        b_start( "append library", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_consume( string, hzstr_length( string ) );
+            for( pos = 0; pos < length; ++pos ) {
+                ( hzstr_append )( string, 'a' );
+            }
+        }
+        b_stop();
+
+        b_start( "cat inline", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_consume( string, hzstr_length( string ) );
+            for( pos = 10; pos <= length; pos += 10 ) {
+                hzstr_cat( string, source );
+            }
+        }
+        b_stop();
+
+        b_start( "cat library", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_consume( string, hzstr_length( string ) );
+            for( pos = 10; pos <= length; pos += 10 ) {
+                ( hzstr_cat )( string, source );
+            }
+        }
+        b_stop();
+
+        hzstr_destroy( string );
+    }
+
+    hzstr_destroy( source );
+#endif
+
+#ifndef BNO_EDIT
+    source = hzstr_create_cstr( "<inserted>" );
+    needle = hzstr_create_cstr( "q" );
+
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = 4000000 / length;
+
+        string = make_string( length );
+        b_start( "hzstr_insert+erase", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_insert( string, ( length / 2 ), source );
+            hzstr_erase( string, ( length / 2 ), source->length );
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        string = make_string( length );
+        b_start( "rebuild insert+erase", length, count );
+        for( index = 0; index < count; ++index ) {
+            string = rebuild( string, ( length / 2 ), 0, source );
+            string = rebuild( string, ( length / 2 ), source->length, NULL );
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        string = make_string( length );
+        b_start( "hzstr_splice", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_splice( string, ( length / 4 ), 1, source );
+            hzstr_splice( string, ( length / 4 ), source->length, needle );
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        string = make_string( length );
+        b_start( "hzstr_replace_all", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_replace_all( string, needle, source );
+            hzstr_replace_all( string, source, needle );
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        string = make_string( length );
+        b_start( "rebuild replace_all", length, count );
+        for( index = 0; index < count; ++index ) {
+            string = rebuild_all( string, needle, source );
+            string = rebuild_all( string, source, needle );
+        }
+        b_stop();
+        hzstr_destroy( string );
+    }
+
+    hzstr_destroy( needle );
+    hzstr_destroy( source );
+#endif
+
+#ifndef BNO_CONSUME
+    empty = hzstr_create( 0 );
+
+    //drain a receive buffer in 16-character messages
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = length / 16;
+
+        string = make_string( length );
+        b_start( "hzstr_consume 16", 16, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_consume( string, 16 );
+        }
+        b_stop();
+        hzstr_destroy( string );
+
+        string = make_string( length );
+        b_start( "copy-down 16", 16, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_splice( string, 0, 16, empty );
+        }
+        b_stop();
+        hzstr_destroy( string );
+    }
+
+    hzstr_destroy( empty );
+#endif
+
+#ifndef BNO_CSTR
+    memset( text, 'c', ( TEXT_SIZE - 1 ) );
+
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = 4000000 / length;
+
+        text[ length ] = '\0';
+        string = hzstr_create( length );
+        b_start( "hzstr_cpy_cstr", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_cpy_cstr( string, text );
+        }
+        b_stop();
+        b_start( "hzstr_cpy_cstr_n", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_cpy_cstr_n( string, text, length );
+        }
+        b_stop();
+        hzstr_destroy( string );
+        text[ length ] = 'c';
+    }
+
+    //reject a 1 MiB untrusted input against a small limit
+    string = hzstr_create( 0 );
+    b_start( "hzstr_import reject", 64, 1000 );
+    for( index = 0; index < 1000; ++index ) {
+        hzstr_import( string, text, 64 );
+    }
+    b_stop();
+    hzstr_destroy( string );
+#endif
+
+#ifndef BNO_TRIM
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = 4000000 / length;
+
+        //surround a short word with whitespace (trimming a view of it only
+        //  scans the string, so each operation starts from the same state)
+        string = hzstr_create( length );
+        while( hzstr_length( string ) < length ) {
+            hzstr_append(
+                string,
+                ( hzstr_length( string ) == ( length / 2 ) ? 'x' : ' ' )
+            );
+        }
+        view = hzstr_create_substr( string, 0, length );
+        b_start( "hzstr_trim", length, count );
+        for( index = 0; index < count; ++index ) {
+            view->data   = string->data;
+            view->length = length;
+            hzstr_trim( view );
+        }
+        b_stop();
+        hzstr_destroy( view );
+        hzstr_destroy( string );
+
+        //alternate words and whitespace runs of increasing length
+        original = hzstr_create( length );
+        while( hzstr_length( original ) < length ) {
+            hzstr_append(
+                original,
+                ( ( hzstr_length( original ) % 24 ) < 8 ? 'w' : '\t' )
+            );
+        }
+        string = hzstr_create( length );
+        b_start( "hzstr_cpy+squeeze", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_cpy( string, original );
+            hzstr_squeeze( string );
+        }
+        b_stop();
+        hzstr_destroy( string );
+        hzstr_destroy( original );
+    }
+#endif
+
+#ifndef BNO_SCAN
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = 4000000 / length;
+
+        //the searched character is never found
+        string = make_string( length );
+        b_start( "scan hzstr_strchr", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_strchr( string, 'z' );
+        }
+        b_stop();
+
+        //equal strings are compared to the end
+        other = make_string( length );
+        b_start( "scan hzstr_cmp", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_cmp( string, other );
+        }
+        b_stop();
+        hzstr_destroy( other );
+
+        b_start( "scan hzstr_toupper+tolower", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_toupper( string );
+            hzstr_tolower( string );
+        }
+        b_stop();
+        hzstr_destroy( string );
+    }
+#endif
+
+    return 0;
+}
+
+
+/*==========================================================================*/
+static hzstr_type* make_string(     //create a string of a given length
+    hzstr_length_t      length      //length of the string
+) {                                 //new string
+
+    //local variables
+    hzstr_index_t       index;      //character index
+    hzstr_type*         string;     //new string
+
+    //fill the string with letters, and place a "q" every 64 characters
+    string = hzstr_create( length );
+    for( index = 0; index < length; ++index ) {
+        hzstr_append( string, ( ( index % 64 ) == 63 ? 'q' : 'a' ) );
+    }
+
+    return string;
+}
+
+
+/*==========================================================================*/
+static hzstr_type* rebuild(         //splice by re-building a string
+    hzstr_type*         string,     //string to edit (destroyed)
+    hzstr_index_t       offset,     //beginning offset of range to replace
+    hzstr_length_t      length,     //number of characters to replace
+    const hzstr_type*   source      //replacement string
+) {                                 //new string
+
+    //local variables
+    hzstr_type*         head;       //substring before the range
+    hzstr_type*         result;     //re-built string
+    hzstr_type*         tail;       //substring after the range
+
+    head = hzstr_create_substr( string, 0, offset );
+    tail = hzstr_create_substr(
+        string,
+        ( offset + length ),
+        ( hzstr_length( string ) - offset - length )
+    );
+    result = hzstr_create( 0 );
+    hzstr_cpy( result, head );
+    if( source != NULL ) {
+        hzstr_cat( result, source );
+    }
+    hzstr_cat( result, tail );
+    hzstr_destroy( tail );
+    hzstr_destroy( head );
+    hzstr_destroy( string );
+
+    return result;
+}
+
+
+/*==========================================================================*/
+static hzstr_type* rebuild_all(     //replace all by re-building a string
+    hzstr_type*         string,     //string to edit (destroyed)
+    const hzstr_type*   needle,     //substring to replace (starts uniquely)
+    const hzstr_type*   source      //replacement string
+) {                                 //new string
+
+    //local variables
+    hzstr_index_t       found;      //length of segment before next needle
+    hzstr_index_t       from;       //start of the next segment
+    hzstr_type*         part;       //substring of the original string
+    hzstr_type*         result;     //re-built string
+
+    result = hzstr_create( 0 );
+    from   = 0;
+    while( from < hzstr_length( string ) ) {
+        part = hzstr_create_substr(
+            string, from, ( hzstr_length( string ) - from )
+        );
+        found = hzstr_strchr( part, needle->data[ 0 ] );
+        if( found == HZSTR_INDEX_NONE ) {
+            found = hzstr_length( part );
+        }
+        hzstr_destroy( part );
+        part = hzstr_create_substr( string, from, found );
+        hzstr_cat( result, part );
+        hzstr_destroy( part );
+        from += found;
+        if( from < hzstr_length( string ) ) {
+            hzstr_cat( result, source );
+            from += needle->length;
+        }
+    }
+    hzstr_destroy( string );
+
+    return result;
+}
@@ -0,0 +1,233 @@
+/*****************************************************************************
+    hzstrpp_bench.cpp
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Measures handing strings between owners through the C++ interface.
+        Moving a string takes its string object, so the move cases should
+        report no allocations at any size.  The "std::string copy" case is
+        the hand-off used before the wrapper existed (its allocations are
+        made by the standard library, and are not counted).
+
+        The concatenation cases build "<text>/<name>?id=<number>" into a
+        string that is re-used, with an expression, with a chain of C
+        calls, and with std::string.
+
+        The literal cases make a constant string object from a literal at
+        run time and at compile time, and compare unequal strings of the
+        same length with and without stored hashes.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "bench.h"
+
+#include "hzstr.hpp"
+
+using namespace hzstr::literals;
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define NUM_SIZES ( 4 )             //number of string sizes to measure
+
+//define symbols to disable the corresponding benchmark section
+//#define BNO_MOVE
+//#define BNO_CONCAT
+//#define BNO_LITERAL
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const hzstr_length_t sizes[ NUM_SIZES ] = { 64, 1024, 8192, 32768 };
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+extern "C" int run_bench(           //run the benchmark
+    bench_control_type* bench       //benchmark control object
+);                                  //result of benchmark
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int run_bench(                      //run the benchmark
+    bench_control_type* bench       //benchmark control object
+) {                                 //result of benchmark
+
+    //local variables
+    char                number[ 24 ]; //integer text for the C chain
+    unsigned long       count;      //operations per case
+    unsigned long       index;      //operation index
+    hzstr_length_t      length;     //string length of the current case
+    int                 size;       //size index
+    volatile unsigned long total;   //keeps the result of each operation
+
+    total = 0;
+
+#ifndef BNO_MOVE
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ];
+        count  = 4000000 / length;
+
+        std::string text( length, 'a' );
+        hzstr::string string( ( std::string_view( text ) ) );
+        hzstr::string other;
+
+        //hand the string back and forth between two owners
+        b_start( "hzstr::string move", length, count );
+        for( index = 0; index < count; ++index ) {
+            other  = std::move( string );
+            string = std::move( other );
+            total += string.length();
+        }
+        b_stop();
+
+        b_start( "hzstr::string move construct", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr::string moved( std::move( string ) );
+            total += moved.length();
+            string = std::move( moved );
+        }
+        b_stop();
+
+        b_start( "hzstr::string clone", length, count );
+        for( index = 0; index < count; ++index ) {
+            hzstr::string copy = string.clone();
+            total += copy.length();
+        }
+        b_stop();
+
+        b_start( "std::string copy", length, count );
+        for( index = 0; index < count; ++index ) {
+            std::string copy( string.data(), string.length() );
+            total += copy.size();
+        }
+        b_stop();
+
+        //a view of a substring needs no NULL terminator
+        hzstr::string view = string.substr( 1, ( length - 2 ) );
+        b_start( "hzstr::string view", length, count );
+        for( index = 0; index < count; ++index ) {
+            std::string_view chars = view;
+            total += chars.size();
+        }
+        b_stop();
+    }
+#endif
+
+#ifndef BNO_CONCAT
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ] - 32;
+        count  = 4000000 / sizes[ size ];
+
+        std::string text( length, 'a' );
+        hzstr::string string( ( std::string_view( text ) ) );
+        hzstr::string name( std::string_view( "name" ) );
+        hzstr::string result;
+
+        b_start( "hzstr::string concat", ( length + 16 ), count );
+        for( index = 0; index < count; ++index ) {
+            result = string + "/" + name + "?id=" + index;
+            total += result.length();
+        }
+        b_stop();
+
+        //the same result, one C call at a time
+        b_start( "hzstr_cat chain", ( length + 16 ), count );
+        for( index = 0; index < count; ++index ) {
+            hzstr_cpy( result.get(), string.get() );
+            hzstr_cat_cstr( result.get(), "/" );
+            hzstr_cat( result.get(), name.get() );
+            hzstr_cat_cstr( result.get(), "?id=" );
+            snprintf( number, sizeof( number ), "%lu", index );
+            hzstr_cat_cstr( result.get(), number );
+            total += result.length();
+        }
+        b_stop();
+
+        std::string standard;
+        b_start( "std::string concat", ( length + 16 ), count );
+        for( index = 0; index < count; ++index ) {
+            standard = text + "/" + "name" + "?id=" + std::to_string( index );
+            total += standard.size();
+        }
+        b_stop();
+    }
+#endif
+
+#ifndef BNO_LITERAL
+    count = 1000000;
+
+    b_start( "hzstr_create_ccstr", 11, count );
+    for( index = 0; index < count; ++index ) {
+        hzstr_type* constant = hzstr_create_ccstr( "Hello World" );
+        total += constant->length;
+        hzstr_destroy( constant );
+    }
+    b_stop();
+
+    b_start( "operator\"\"_hz", 11, count );
+    for( index = 0; index < count; ++index ) {
+        static constexpr hzstr_type constant = "Hello World"_hz;
+        total += constant.length;
+    }
+    b_stop();
+
+    for( size = 0; size < NUM_SIZES; ++size ) {
+        length = sizes[ size ] - 1;
+        count  = 4000000 / sizes[ size ];
+
+        //unequal strings that differ only in their last character
+        std::string text( length, 'a' );
+        std::string last( text );
+        last.back() = 'b';
+        hzstr_type left  = hzstr::literals::operator""_hz(
+            text.data(), text.size()
+        );
+        hzstr_type right = hzstr::literals::operator""_hz(
+            last.data(), last.size()
+        );
+
+        b_start( "hzstr_equal, hashed", length, count );
+        for( index = 0; index < count; ++index ) {
+            total += hzstr_equal( &left, &right );
+        }
+        b_stop();
+
+        left.flags  &= ~HZSTR_FLG_HASHED;
+        right.flags &= ~HZSTR_FLG_HASHED;
+        b_start( "hzstr_equal, not hashed", length, count );
+        for( index = 0; index < count; ++index ) {
+            total += hzstr_equal( &left, &right );
+        }
+        b_stop();
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*****************************************************************************
+    hzutf8_bench.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Each case processes a buffer of repeated text: pure ASCII, mostly
+        ASCII with accented letters, and three-byte (CJK) characters.  The
+        case-insensitive comparison compares the text to an upper-case copy
+        of itself, so the entire buffer is always compared.  The UTF-16
+        encoding of each buffer is measured before it is converted back.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+
+#include "hzutf8.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define NUM_SIZES ( 4 )             //number of buffer sizes to measure
+#define NUM_TEXTS ( 3 )             //number of kinds of text to measure
+#define NUM_OPS ( 6 )               //number of operations to measure
+#define MAX_SIZE ( 65535 )          //largest buffer to measure
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const unsigned long sizes[ NUM_SIZES ] = { 64, 1024, 8192, 65535 };
+
+static const char* const names[ NUM_OPS ][ NUM_TEXTS ] = {
+    {
+        "hzstr_utf8_check ascii",
+        "hzstr_utf8_check latin",
+        "hzstr_utf8_check cjk"
+    },
+    {
+        "hzstr_utf8_count ascii",
+        "hzstr_utf8_count latin",
+        "hzstr_utf8_count cjk"
+    },
+    {
+        "hzstr_utf8_fold ascii",
+        "hzstr_utf8_fold latin",
+        "hzstr_utf8_fold cjk"
+    },
+    {
+        "hzstr_utf8_casecmp ascii",
+        "hzstr_utf8_casecmp latin",
+        "hzstr_utf8_casecmp cjk"
+    },
+    {
+        "hzstr_utf8_to_utf16 ascii",
+        "hzstr_utf8_to_utf16 latin",
+        "hzstr_utf8_to_utf16 cjk"
+    },
+    {
+        "hzstr_utf8_from_utf16 ascii",
+        "hzstr_utf8_from_utf16 latin",
+        "hzstr_utf8_from_utf16 cjk"
+    }
+};
+
+static const char* const texts[ NUM_TEXTS ] = {
+    "The quick brown fox jumps over the lazy dog. ",
+    "Le c\xC5\x93ur d\xC3\xA9\xC3\xA7u d'un z\xC3\xA9phyr fran\xC3\xA7" "ais. ",
+    "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87\xE7\xAB\xA0"
+};
+
+//the same texts in upper case
+static const char* const uppers[ NUM_TEXTS ] = {
+    "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. ",
+    "LE C\xC5\x92UR D\xC3\x89\xC3\x87U D'UN "
+        "Z\xC3\x89PHYR FRAN\xC3\x87" "AIS. ",
+    "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87\xE7\xAB\xA0"
+};
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static char             buffer[ MAX_SIZE ]; //text to check
+static char             output[ MAX_SIZE ]; //folded text
+static char             upper[ MAX_SIZE ];  //upper-case text to compare
+static uint16_t         units[ MAX_SIZE ];  //UTF-16 text
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int run_bench(                      //run the benchmark
+    bench_control_type* bench       //benchmark control object
+) {                                 //result of benchmark
+
+    //local variables
+    unsigned long       count;      //operations per case
+    unsigned long       index;      //operation index
+    unsigned long       length;     //length of the current case
+    int                 op;         //operation index
+    unsigned long       pos;        //fill position
+    int                 size;       //size index
+    unsigned long       span;       //bytes of text copied
+    int                 text;       //text index
+    unsigned long       wide;       //number of UTF-16 units in the case
+    volatile long       valid;      //keeps the result of each operation
+
+    valid = 0;
+
+    for( op = 0; op < NUM_OPS; ++op ) {
+        for( text = 0; text < NUM_TEXTS; ++text ) {
+
+            //fill the buffers with whole copies of the text, padded with
+            //  spaces (both cases of the text are the same length)
+            span = strlen( texts[ text ] );
+            memset( buffer, ' ', MAX_SIZE );
+            memset( upper, ' ', MAX_SIZE );
+            for( pos = 0; ( pos + span ) <= MAX_SIZE; pos += span ) {
+                memcpy( ( buffer + pos ), texts[ text ], span );
+                memcpy( ( upper + pos ), uppers[ text ], span );
+            }
+
+            for( size = 0; size < NUM_SIZES; ++size ) {
+
+                //end the case on a whole copy of the text
+                length = sizes[ size ] - ( sizes[ size ] % span );
+                count  = 64000000 / sizes[ size ];
+                if( op >= 2 ) {
+                    count /= 8;
+                }
+
+                wide = hzstr_utf8_to_utf16( units, buffer, length );
+
+                b_start( names[ op ][ text ], length, count );
+                for( index = 0; index < count; ++index ) {
+                    switch( op ) {
+                        case 0:
+                            valid += hzstr_utf8_check( buffer, length );
+                            break;
+                        case 1:
+                            valid += hzstr_utf8_count( buffer, length );
+                            break;
+                        case 2:
+                            valid += hzstr_utf8_fold( output, buffer, length );
+                            break;
+                        case 3:
+                            valid += hzstr_utf8_casecmp(
+                                buffer, length, upper, length
+                            );
+                            break;
+                        case 4:
+                            valid += hzstr_utf8_to_utf16(
+                                units, buffer, length
+                            );
+                            break;
+                        default:
+                            valid += hzstr_utf8_from_utf16(
+                                output, units, wide
+                            );
+                            break;
+                    }
+                }
+                b_stop();
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************
+    memory_bench.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Each case keeps a window of live blocks, and replaces the oldest
+        block with a new block in every operation.  The pool takes its
+        slabs through the counted mem_* interface, so its allocs/op shows
+        how often it calls the system allocator.  Blocks larger than
+        MEM_POOL_MAX are passed to the system, so the pool only adds the
+        cost of its header.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "bench.h"
+
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define NUM_SIZES ( 5 )             //number of block sizes to measure
+#define WINDOW ( 64 )               //number of live blocks
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const unsigned long sizes[ NUM_SIZES ] = { 24, 32, 64, 256, 1024 };
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static void*            window[ WINDOW ];
+                                    //live blocks
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int run_bench(                      //run the benchmark
+    bench_control_type* bench       //benchmark control object
+) {                                 //result of benchmark
+
+    //local variables
+    unsigned long       count;      //operations per case
+    unsigned long       index;      //operation index
+    int                 size;       //size index
+
+    count = 4000000;
+
+    for( size = 0; size < NUM_SIZES; ++size ) {
+
+        //the system allocator (through the counted mem_* interface)
+        memset( window, 0, sizeof( window ) );
+        b_start( "mem_malloc/mem_free", sizes[ size ], count );
+        for( index = 0; index < count; ++index ) {
+            mem_free( window[ index % WINDOW ] );
+            window[ index % WINDOW ] = mem_malloc( sizes[ size ] );
+            *( ( char* ) window[ index % WINDOW ] ) = 1;
+        }
+        b_stop();
+        for( index = 0; index < WINDOW; ++index ) {
+            mem_free( window[ index ] );
+        }
+
+        //the pool (the first case of each size also fills the pool)
+        memset( window, 0, sizeof( window ) );
+        b_start( "mem_pool_malloc/mem_pool_free", sizes[ size ], count );
+        for( index = 0; index < count; ++index ) {
+            mem_pool_free( window[ index % WINDOW ] );
+            window[ index % WINDOW ] = mem_pool_malloc( sizes[ size ] );
+            *( ( char* ) window[ index % WINDOW ] ) = 1;
+        }
+        b_stop();
+        for( index = 0; index < WINDOW; ++index ) {
+            mem_pool_free( window[ index ] );
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,601 @@
+/*****************************************************************************
+    replay_bench.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Replays a call trace (see hztrace.h) against this build of the
+        library.  The trace named by the HZSTR_TRACE_FILE environment
+        variable is replayed.  Without one, a sample workload (building
+        and parsing request lines and headers) is recorded first, and its
+        trace is replayed.
+
+        Before timing, each record's string addresses are mapped to
+        string slots, so the timed replay only indexes an array.  Records
+        that can not be replayed (calls on strings that were never
+        created, or were already destroyed) are dropped.  Strings that
+        were created before the trace started are created empty.
+
+        The replay is repeated until at least MIN_OPS records are timed.
+        Each repetition includes creating the strings that existed before
+        the trace, and destroying the strings left at its end.
+
+        Replayed characters are all 'a', so searches (hzstr_strchr()) scan
+        the whole string.  hzstr_replace_all() replaces with a scratch
+        string of the recorded length, and hzstr_export_utf8() converts
+        into a buffer large enough for any replayed string.
+
+        An untimed replay adds up the memory held by the replayed strings
+        (objects and their allocations) after each record, and reports the
+        peak.  Builds with different allocators (BENCH_FLAGS=-DMEM_POOL),
+        chunk sizes (-DHZSTR_CHUNK_SIZE=64) or scans (-DHZSTR_DSBL_SIMD)
+        replay the same trace.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#include "hzstr.h"
+#include "hztrace.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define SAMPLE_PATH "build/sample.hzt"
+                                    //trace of the sample workload
+#define SAMPLE_REQUESTS ( 20000 )   //requests in the sample workload
+#define MIN_OPS ( 2000000 )         //fewest records timed
+#define TEXT_SIZE ( 65535 )         //longest replayed C-string (and NULL)
+#define OUTPUT_SIZE ( 262144 )      //size of the UTF-8 output buffer
+
+//find a C-string of a length (every C-string ends at the end of the text)
+#define cstr( _l ) ( &text[ TEXT_SIZE - 1 - ( _l ) ] )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct replay_op_s {        //a record prepared for replay
+    unsigned int        target;     //slot of the string operated on
+    unsigned int        source;     //slot of the source string (0 if none)
+    unsigned int        length;     //length argument
+    unsigned short      offset;     //offset argument
+    unsigned char       operation;  //operation called (HZSTR_TRACE_*)
+} replay_op_type;
+
+typedef struct replay_map_s {       //address map entry
+    uint64_t            address;    //string address (0 if unused)
+    unsigned int        slot;       //slot of the string at the address
+} replay_map_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static unsigned char*   alive;      //slots with a live string (preparing)
+static unsigned char*   existing;   //slots created before the trace started
+static replay_map_type* map;        //string addresses mapped to slots
+static unsigned long    map_mask;   //size of the address map, minus one
+static unsigned long    num_ops;    //number of prepared records
+static unsigned int     num_slots;  //number of string slots
+static replay_op_type*  ops;        //prepared records
+static char             output[ OUTPUT_SIZE ];
+                                    //UTF-8 conversion output
+static hzstr_type*      scratch;    //replacement of hzstr_replace_all()
+static unsigned long*   sizes;      //bytes held by each slot's string
+static hzstr_type**     strings;    //replayed strings (slot 0 is NULL)
+static char             text[ TEXT_SIZE ];
+                                    //replayed C-string characters
+static volatile unsigned long total;//keeps the result of each operation
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static unsigned int map_slot(       //find the slot of a string address
+    uint64_t            address,    //string address
+    int                 create      //non-zero to give the address a new slot
+);                                  //slot (0 for NULL)
+
+static int prepare(                 //prepare a trace for replay
+    const hzstr_trace_record_type* records,
+                                    //records of the trace
+    unsigned long       count       //number of records
+);                                  //0 on success
+
+static void record_sample(          //record the sample workload
+    void
+);
+
+static void replay(                 //replay the prepared records
+    unsigned long*      peak        //peak bytes held (NULL to not measure)
+);
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+int run_bench(                      //run the benchmark
+    bench_control_type* bench       //benchmark control object
+) {                                 //result of benchmark
+
+    //local variables
+    unsigned long       chars;      //characters named by the records
+    unsigned long       count;      //number of records in the trace
+    unsigned long       index;      //record index
+    unsigned long       pass;       //replay index
+    unsigned long       passes;     //number of timed replays
+    const char*         path;       //trace to replay
+    unsigned long       peak;       //peak bytes held by the strings
+    hzstr_trace_record_type* records;
+                                    //records of the trace
+#ifdef MEM_POOL
+    mem_pool_stats_type pool;       //pool statistics
+#endif
+
+    memset( text, 'a', ( TEXT_SIZE - 1 ) );
+
+    //replay the given trace, or record the sample workload
+    path = getenv( "HZSTR_TRACE_FILE" );
+    if( path == NULL ) {
+        record_sample();
+        path = SAMPLE_PATH;
+    }
+    records = hzstr_trace_load( path, &count );
+    if( records == NULL ) {
+        printf( "Unable to load the trace \"%s\".\n", path );
+        return 1;
+    }
+    if( prepare( records, count ) != 0 ) {
+        printf( "Unable to prepare the trace \"%s\".\n", path );
+        hzstr_trace_unload( records );
+        return 1;
+    }
+    hzstr_trace_unload( records );
+    if( num_ops == 0 ) {
+        printf( "The trace \"%s\" has nothing to replay.\n", path );
+        return 1;
+    }
+
+    //the size of a case is the mean length named by its records
+    chars = 0;
+    for( index = 0; index < num_ops; ++index ) {
+        chars += ops[ index ].length;
+    }
+
+    //measure the memory held by the strings (this also warms the heap)
+    scratch = hzstr_create( 0 );
+    peak = 0;
+    replay( &peak );
+
+    //time the replay
+    passes = ( MIN_OPS + num_ops - 1 ) / num_ops;
+    b_start( "replay", ( chars / num_ops ), ( passes * num_ops ) );
+    for( pass = 0; pass < passes; ++pass ) {
+        replay( NULL );
+    }
+    b_stop();
+
+    printf(
+        "%s: %lu records (%lu replayed), %u strings, peak %lu bytes held\n",
+        path,
+        count,
+        num_ops,
+        ( num_slots - 1 ),
+        peak
+    );
+#ifdef MEM_POOL
+    mem_pool_stats( &pool );
+    printf(
+        "pool: %lu bytes from the system, %lu bytes held for re-use\n",
+        pool.system,
+        pool.held
+    );
+#endif
+
+    hzstr_destroy( scratch );
+    free( existing );
+    free( ops );
+    free( sizes );
+    free( strings );
+    return 0;
+}
+
+
+/*==========================================================================*/
+static unsigned int map_slot(       //find the slot of a string address
+    uint64_t            address,    //string address
+    int                 create      //non-zero to give the address a new slot
+) {                                 //slot (0 for NULL)
+
+    //local variables
+    unsigned long       index;      //map entry index
+
+    if( address == 0 ) {
+        return 0;
+    }
+
+    //find the address's entry (or the empty entry it would use)
+    index = ( address >> 4 ) & map_mask;
+    while( ( map[ index ].address != 0 )
+        && ( map[ index ].address != address ) ) {
+        index = ( index + 1 ) & map_mask;
+    }
+
+    //a string created at this address replaces an earlier one
+    if( ( create != 0 ) || ( map[ index ].address == 0 ) ) {
+        map[ index ].address  = address;
+        map[ index ].slot     = num_slots;
+        alive[ num_slots ]    = 1;
+        existing[ num_slots ] = ( create == 0 );
+        num_slots += 1;
+    }
+    return map[ index ].slot;
+}
+
+
+/*==========================================================================*/
+static int prepare(                 //prepare a trace for replay
+    const hzstr_trace_record_type* records,
+                                    //records of the trace
+    unsigned long       count       //number of records
+) {                                 //0 on success
+
+    //local variables
+    unsigned long       index;      //record index
+    replay_op_type*     op;         //prepared record
+    const hzstr_trace_record_type* record;
+                                    //record to prepare
+
+    //every record names at most two new strings (the map is kept at most
+    //  half full)
+    map_mask = 1;
+    while( map_mask < ( ( count * 4 ) + 2 ) ) {
+        map_mask <<= 1;
+    }
+    map      = calloc( map_mask, sizeof( replay_map_type ) );
+    map_mask -= 1;
+    alive    = calloc( ( count * 2 ) + 1, 1 );
+    existing = calloc( ( count * 2 ) + 1, 1 );
+    ops      = malloc( ( count + 1 ) * sizeof( replay_op_type ) );
+    if( ( map == NULL ) || ( alive == NULL ) || ( existing == NULL )
+     || ( ops == NULL ) ) {
+        free( map );
+        free( alive );
+        return -1;
+    }
+
+    num_ops   = 0;
+    num_slots = 1;
+    for( index = 0; index < count; ++index ) {
+        record = &records[ index ];
+        if( record->operation >= HZSTR_NUM_TRACES ) {
+            continue;
+        }
+        op = &ops[ num_ops ];
+        op->operation = record->operation;
+        op->length    = record->length;
+        op->offset    = record->offset;
+        op->source    = map_slot( record->source, 0 );
+        switch( record->operation ) {
+
+            //each created string gets a new slot
+            case HZSTR_TRACE_CREATE:
+            case HZSTR_TRACE_CREATE_CCSTR:
+            case HZSTR_TRACE_CREATE_CSTR:
+            case HZSTR_TRACE_CREATE_CSTR_N:
+            case HZSTR_TRACE_CREATE_SUBSTR:
+                if( record->target == 0 ) {
+                    continue;
+                }
+                if( ( record->operation == HZSTR_TRACE_CREATE_SUBSTR )
+                 && ( alive[ op->source ] == 0 ) ) {
+                    continue;
+                }
+                op->target = map_slot( record->target, 1 );
+                break;
+
+            //other records operate on a live string
+            default:
+                op->target = map_slot( record->target, 0 );
+                if( alive[ op->target ] == 0 ) {
+                    continue;
+                }
+                if( ( ( record->operation == HZSTR_TRACE_CASECMP )
+                   || ( record->operation == HZSTR_TRACE_CAT )
+                   || ( record->operation == HZSTR_TRACE_CMP )
+                   || ( record->operation == HZSTR_TRACE_CPY )
+                   || ( record->operation == HZSTR_TRACE_EQUAL )
+                   || ( record->operation == HZSTR_TRACE_INSERT )
+                   || ( record->operation == HZSTR_TRACE_REPLACE_ALL )
+                   || ( record->operation == HZSTR_TRACE_SPLICE ) )
+                 && ( alive[ op->source ] == 0 ) ) {
+                    continue;
+                }
+                if( record->operation == HZSTR_TRACE_DESTROY ) {
+                    alive[ op->target ] = 0;
+                }
+                break;
+        }
+
+        //C-strings are never longer than the replayed text
+        if( op->length > ( TEXT_SIZE - 1 ) ) {
+            op->length = TEXT_SIZE - 1;
+        }
+        num_ops += 1;
+    }
+    free( map );
+    free( alive );
+
+    //strings are kept in slots while the records are replayed
+    sizes   = calloc( num_slots, sizeof( unsigned long ) );
+    strings = calloc( num_slots, sizeof( hzstr_type* ) );
+    if( ( sizes == NULL ) || ( strings == NULL ) ) {
+        return -1;
+    }
+    return 0;
+}
+
+
+/*==========================================================================*/
+static void record_sample(          //record the sample workload
+    void
+) {
+
+    //local variables
+    hzstr_type*         body;       //response headers
+    int                 header;     //header index
+    int                 headers;    //number of headers
+    hzstr_type*         key;        //normalized path
+    hzstr_type*         line;       //request line
+    hzstr_length_t      length;     //length of the path
+    hzstr_type*         path;       //path in the request line
+    unsigned long       random;     //pseudo-random state
+    int                 request;    //request index
+
+    random = 1;
+    hzstr_trace_start( SAMPLE_PATH );
+    for( request = 0; request < SAMPLE_REQUESTS; ++request ) {
+        random = ( random * 1103515245 ) + 12345;
+        length = 8 + ( ( random >> 16 ) % 120 );
+        headers = 4 + ( ( random >> 8 ) % 9 );
+
+        //parse a request line
+        line = hzstr_trace_create( 0 );
+#ifdef HZSTR_COMPAT_CSTR
+        hzstr_trace_sprintf(
+            line, "GET /%.*s HTTP/1.1", ( int ) length, text
+        );
+#else
+        hzstr_trace_cpy_cstr_n( line, text, ( length + 14 ) );
+#endif
+        path = hzstr_trace_create_substr( line, 4, ( length + 1 ) );
+        hzstr_trace_strchr( path, '?' );
+        key = hzstr_trace_create( 0 );
+        hzstr_trace_cpy( key, path );
+        hzstr_trace_tolower( key );
+        hzstr_trace_hash( key );
+        hzstr_trace_cmp( key, path );
+
+        //build the response headers
+        body = hzstr_trace_create( 0 );
+        for( header = 0; header < headers; ++header ) {
+            random = ( random * 1103515245 ) + 12345;
+            hzstr_trace_cat_cstr_n(
+                body, text, ( 10 + ( ( random >> 16 ) % 50 ) )
+            );
+            hzstr_trace_append( body, '\n' );
+        }
+        hzstr_trace_cat( body, key );
+        hzstr_trace_trim( body );
+
+        hzstr_trace_destroy( body );
+        hzstr_trace_destroy( key );
+        hzstr_trace_destroy( path );
+        hzstr_trace_destroy( line );
+    }
+    hzstr_trace_stop();
+}
+
+
+/*==========================================================================*/
+static void replay(                 //replay the prepared records
+    unsigned long*      peak        //peak bytes held (NULL to not measure)
+) {
+
+    //local variables
+    unsigned long       held;       //bytes held by the strings
+    unsigned long       index;      //record index
+    const replay_op_type* op;       //record to replay
+    unsigned int        slot;       //slot index
+    hzstr_type*         target;     //string operated on
+
+    //strings created before the trace started
+    for( slot = 1; slot < num_slots; ++slot ) {
+        if( existing[ slot ] != 0 ) {
+            strings[ slot ] = hzstr_create( 0 );
+        }
+    }
+
+    held = 0;
+    for( index = 0; index < num_ops; ++index ) {
+        op     = &ops[ index ];
+        target = strings[ op->target ];
+        switch( op->operation ) {
+            case HZSTR_TRACE_APPEND:
+                hzstr_append( target, 'a' );
+                break;
+#ifdef HZSTR_COMPAT_CSTR
+            case HZSTR_TRACE_CASECMP:
+                total += hzstr_casecmp( target, strings[ op->source ] );
+                break;
+#endif
+            case HZSTR_TRACE_CAT:
+                hzstr_cat( target, strings[ op->source ] );
+                break;
+            case HZSTR_TRACE_CAT_CSTR:
+                hzstr_cat_cstr( target, cstr( op->length ) );
+                break;
+            case HZSTR_TRACE_CAT_CSTR_N:
+                hzstr_cat_cstr_n( target, text, op->length );
+                break;
+            case HZSTR_TRACE_CMP:
+                total += hzstr_cmp( target, strings[ op->source ] );
+                break;
+            case HZSTR_TRACE_COMPACT_ALL:
+                hzstr_compact_all( &strings[ op->target ], 1 );
+                break;
+            case HZSTR_TRACE_CONSUME:
+                hzstr_consume( target, op->length );
+                break;
+            case HZSTR_TRACE_CPY:
+                hzstr_cpy( target, strings[ op->source ] );
+                break;
+            case HZSTR_TRACE_CPY_CSTR:
+                hzstr_cpy_cstr( target, cstr( op->length ) );
+                break;
+            case HZSTR_TRACE_CPY_CSTR_N:
+                hzstr_cpy_cstr_n( target, text, op->length );
+                break;
+            case HZSTR_TRACE_CREATE:
+                strings[ op->target ] = hzstr_create( op->length );
+                break;
+#ifdef HZSTR_COMPAT_CSTR
+            case HZSTR_TRACE_CREATE_CCSTR:
+                strings[ op->target ] = hzstr_create_ccstr(
+                    cstr( op->length )
+                );
+                break;
+#endif
+            case HZSTR_TRACE_CREATE_CSTR:
+                strings[ op->target ] = hzstr_create_cstr(
+                    cstr( op->length )
+                );
+                break;
+            case HZSTR_TRACE_CREATE_CSTR_N:
+                strings[ op->target ] = hzstr_create_cstr_n(
+                    text, op->length
+                );
+                break;
+            case HZSTR_TRACE_CREATE_SUBSTR:
+                strings[ op->target ] = hzstr_create_substr(
+                    strings[ op->source ], op->offset, op->length
+                );
+                break;
+            case HZSTR_TRACE_DESTROY:
+                hzstr_destroy( target );
+                strings[ op->target ] = NULL;
+                break;
+            case HZSTR_TRACE_EQUAL:
+                total += hzstr_equal( target, strings[ op->source ] );
+                break;
+            case HZSTR_TRACE_ERASE:
+                hzstr_erase( target, op->offset, op->length );
+                break;
+            case HZSTR_TRACE_EXPORT_UTF8:
+                hzstr_export_utf8( target, output, OUTPUT_SIZE );
+                break;
+#ifdef HZSTR_COMPAT_CSTR
+            case HZSTR_TRACE_FOLD:
+                hzstr_fold( target );
+                break;
+#endif
+            case HZSTR_TRACE_HASH:
+                total += hzstr_hash( target );
+                break;
+            case HZSTR_TRACE_IMPORT:
+                hzstr_import( target, cstr( op->length ), op->length );
+                break;
+            case HZSTR_TRACE_IMPORT_UTF8:
+                hzstr_import_utf8( target, cstr( op->length ), op->length );
+                break;
+            case HZSTR_TRACE_INSERT:
+                hzstr_insert( target, op->offset, strings[ op->source ] );
+                break;
+            case HZSTR_TRACE_MINIMIZE:
+                hzstr_minimize( target );
+                break;
+            case HZSTR_TRACE_REPLACE_ALL:
+                hzstr_cpy_cstr_n( scratch, text, op->length );
+                hzstr_replace_all( target, strings[ op->source ], scratch );
+                break;
+            case HZSTR_TRACE_RESERVE:
+                hzstr_reserve( target, op->length );
+                break;
+            case HZSTR_TRACE_SPLICE:
+                hzstr_splice(
+                    target, op->offset, op->length, strings[ op->source ]
+                );
+                break;
+#ifdef HZSTR_COMPAT_CSTR
+            case HZSTR_TRACE_SPRINTF:
+                hzstr_sprintf( target, "%s", cstr( op->length ) );
+                break;
+#endif
+            case HZSTR_TRACE_SQUEEZE:
+                hzstr_squeeze( target );
+                break;
+            case HZSTR_TRACE_STRCHR:
+                total += hzstr_strchr( target, 'z' );
+                break;
+            case HZSTR_TRACE_TOLOWER:
+                hzstr_tolower( target );
+                break;
+            case HZSTR_TRACE_TOUPPER:
+                hzstr_toupper( target );
+                break;
+            case HZSTR_TRACE_TRIM:
+                hzstr_trim( target );
+                break;
+            case HZSTR_TRACE_TRIM_LEFT:
+                hzstr_trim_left( target );
+                break;
+            case HZSTR_TRACE_TRIM_RIGHT:
+                hzstr_trim_right( target );
+                break;
+            case HZSTR_TRACE_VALIDATE:
+                hzstr_validate( target );
+                break;
+        }
+
+        //add up the memory held by the operated-on string
+        if( peak != NULL ) {
+            target = strings[ op->target ];
+            held  -= sizes[ op->target ];
+            sizes[ op->target ] = ( target == NULL ) ? 0
+                : ( sizeof( hzstr_type )
+                  + ( target->alloc * sizeof( hzstr_char_t ) ) );
+            held  += sizes[ op->target ];
+            if( held > *peak ) {
+                *peak = held;
+            }
+        }
+    }
+
+    //strings left at the end of the trace
+    for( slot = 1; slot < num_slots; ++slot ) {
+        if( strings[ slot ] != NULL ) {
+            hzstr_destroy( strings[ slot ] );
+            strings[ slot ] = NULL;
+        }
+        sizes[ slot ] = 0;
+    }
+}
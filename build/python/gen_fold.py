@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+##############################################################################
+#   gen_fold.py
+#   Zac Hester
+#   2026-10-19
+#
+#   Generates the simple Unicode case folding tables used by hzutf8.c.
+#
+#   The tables come from the Unicode database built into Python.  Simple
+#   case folding (CaseFolding.txt status C and S) is the single code point
+#   produced by full case folding, or the single lowercase code point where
+#   full folding produces several code points.
+#
+#   Usage:
+#       python3 build/python/gen_fold.py > src/hzutf8_fold.h
+##############################################################################
+
+import sys
+import unicodedata
+
+# code points per block of the second-level table
+SHIFT = 5
+
+
+def simple_fold( code ):
+    """Find the simple case folding of a code point."""
+    char   = chr( code )
+    folded = char.casefold()
+    if len( folded ) != 1:
+        folded = char.lower()
+        if len( folded ) != 1:
+            return code
+    return ord( folded )
+
+
+def main():
+    """Write the folding tables to standard output."""
+
+    # find the difference between each folded code point and the original
+    deltas = {}
+    for code in range( 0x110000 ):
+        if 0xD800 <= code <= 0xDFFF:
+            continue
+        folded = simple_fold( code )
+        if folded != code:
+            deltas[ code ] = folded - code
+    limit = max( deltas ) + 1
+
+    # share identical blocks of the second-level table
+    size   = 1 << SHIFT
+    blocks = {}
+    index  = []
+    for start in range( 0, limit, size ):
+        block = tuple( deltas.get( start + i, 0 ) for i in range( size ) )
+        index.append( blocks.setdefault( block, len( blocks ) ) )
+    if len( blocks ) > 256:
+        raise SystemExit( 'too many blocks for an 8-bit index' )
+
+    # the source tree uses CRLF line endings
+    out = open( sys.stdout.fileno(), 'w', newline='\r\n', closefd=False )
+    out.write( '''/*****************************************************************************
+    hzutf8_fold.h
+    Generated by build/python/gen_fold.py (Unicode %s)
+
+    Simple Unicode case folding tables.  Do not edit this file.
+
+    The folding of a code point below FOLD_LIMIT is:
+        code + fold_deltas[ ( fold_index[ code >> FOLD_SHIFT ] << FOLD_SHIFT )
+                          + ( code & FOLD_MASK ) ]
+
+*****************************************************************************/
+
+#ifndef _HZUTF8_FOLD_H
+#define _HZUTF8_FOLD_H
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+%s//code points at or above this never fold
+%s//log2 of code points per block
+%s//code point offset within a block
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+//block of the delta table used for each range of code points
+static const unsigned char fold_index[ %d ] = {
+''' % (
+        unicodedata.unidata_version,
+        ( '#define FOLD_LIMIT ( 0x%X )' % limit ).ljust( 36 ),
+        ( '#define FOLD_SHIFT ( %d )' % SHIFT ).ljust( 36 ),
+        ( '#define FOLD_MASK ( %d )' % ( size - 1 ) ).ljust( 36 ),
+        len( index )
+    ) )
+    for start in range( 0, len( index ), 16 ):
+        row = index[ start : start + 16 ]
+        out.write( '    ' + ', '.join( '%d' % value for value in row ) )
+        out.write( ',\n' if ( start + 16 ) < len( index ) else '\n' )
+    out.write( '};\n\n' )
+
+    out.write( '//difference between each folded code point and the original\n' )
+    out.write( 'static const long fold_deltas[ %d ] = {\n' % ( len( blocks ) * size ) )
+    ordered = sorted( blocks, key = blocks.get )
+    values  = [ value for block in ordered for value in block ]
+    for start in range( 0, len( values ), 8 ):
+        row = values[ start : start + 8 ]
+        out.write( '    ' + ', '.join( '%d' % value for value in row ) )
+        out.write( ',\n' if ( start + 8 ) < len( values ) else '\n' )
+    out.write( '};\n\n#endif /* _HZUTF8_FOLD_H */\n' )
+
+
+if __name__ == '__main__':
+    main()
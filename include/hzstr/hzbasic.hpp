@@ -0,0 +1,810 @@
+/*****************************************************************************
+    hzbasic.hpp
+    Zac Hester
+    2026-10-19
+
+    Header-only Hz strings with compile-time policies.
+
+    A basic_hzstr< CharT, Growth, Allocator > is a dynamic string with the
+    same layout rules and algorithms as a dynamic hzstr_type, but its
+    character type, growth curve and allocator are template parameters
+    instead of build-wide symbols (HZSTR_USER_TYPE, HZSTR_CHUNK_SIZE and
+    the mem_* interface).  One program may use 8-bit, 16-bit and 32-bit
+    strings side by side, each with its own growth curve and allocator.
+    Every call is compiled for its own instantiation, so nothing is
+    dispatched at run time, and the policies inline into each operation.
+
+    Interface Notes:
+        - Strings are move-only, like hzstr::string.  clone() makes an
+            independent copy using a copy of the allocator.
+        - A default-constructed (or moved-from) string allocates nothing,
+            and views as zero characters.  Any operation that stores
+            characters allocates the string's memory.
+        - Constructors throw std::bad_alloc if the string can not be
+            allocated, and std::length_error if the characters can not be
+            stored in one string.  Other functions return the library's
+            result codes (a length, or a negative HZSTR_RSLT_* value), and
+            leave the string unchanged when they fail.
+        - Removing characters from the front of a string (consume(),
+            trim()) only advances the data pointer, and the consumed space
+            is reclaimed when the string next needs to grow, as with
+            hzstr_consume().
+        - A text argument may view the string's own characters.
+        - A Growth policy provides a static grow( alloc, length ) that
+            returns the number of characters to allocate for length
+            characters and a NULL.  The result must be more than length,
+            and at most hzstr::max_alloc.  chunk_growth< N > pads to the
+            next multiple of N characters (the C library's curve, with
+            N = HZSTR_CHUNK_SIZE), and double_growth at least doubles the
+            current allocation.
+        - An Allocator provides allocate( size ), reallocate( ptr, old,
+            size ) and deallocate( ptr, size ), with sizes in bytes, and
+            returns nullptr on failure (leaving a re-allocated block as it
+            was).  heap_allocator uses the mem_* interface (memory.h).
+            pool_allocator always uses the size-class pool (mem_pool_*), so
+            one kind of string can be pooled without defining MEM_POOL for
+            the whole program (memory.c must be linked).  An
+            arena_allocator takes memory from an arena (a caller-provided
+            buffer).  An arena re-sizes or gives back only its most recent
+            allocation, and everything else is released all at once with
+            arena::reset().
+        - Encoding flags are not tracked.
+        - Requires C++17.
+
+    Example Usage
+
+        hzstr::hzstr32 wide( std::u32string_view( U"caf\u00E9" ) );
+        wide.append( U'!' );
+
+        char buffer[ 1024 ];
+        hzstr::arena arena( buffer, sizeof( buffer ) );
+        hzstr::basic_hzstr< char, hzstr::double_growth,
+            hzstr::arena_allocator > text( hzstr::arena_allocator( arena ) );
+        text.cat( "Hello" );
+
+*****************************************************************************/
+
+#ifndef _HZBASIC_HPP
+#define _HZBASIC_HPP
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "hzstr.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+namespace hzstr {
+
+//largest allocation (in characters) of any string
+constexpr unsigned long max_alloc = 65535;
+
+template< hzstr_length_t N = HZSTR_CHUNK_SIZE >
+struct chunk_growth {               //grow in fixed-size chunks
+
+    static_assert( N > 0, "chunk size must not be zero" );
+
+    /*======================================================================*/
+    static hzstr_length_t grow(     //compute a new allocation
+        hzstr_length_t,             //current allocation (characters)
+        unsigned long   length      //characters needed (without the NULL)
+    ) noexcept {                    //characters to allocate
+
+        //pad to the next chunk (without exceeding the length type)
+        if( length < ( max_alloc - N ) ) {
+            return static_cast< hzstr_length_t >( ( ( length / N ) + 1 ) * N );
+        }
+        return static_cast< hzstr_length_t >( max_alloc );
+    }
+};
+
+struct double_growth {              //grow geometrically
+
+    /*======================================================================*/
+    static hzstr_length_t grow(     //compute a new allocation
+        hzstr_length_t  alloc,      //current allocation (characters)
+        unsigned long   length      //characters needed (without the NULL)
+    ) noexcept {                    //characters to allocate
+
+        //local variables
+        unsigned long   next;       //doubled allocation
+
+        //never grow by less than a chunk, or by less than the current size
+        next = chunk_growth<>::grow( alloc, length );
+        if( next < ( 2UL * alloc ) ) {
+            next = 2UL * alloc;
+        }
+        if( next > max_alloc ) {
+            next = max_alloc;
+        }
+        return static_cast< hzstr_length_t >( next );
+    }
+};
+
+struct heap_allocator {             //allocate through the mem_* interface
+
+    /*======================================================================*/
+    void* allocate(                 //allocate a block
+        std::size_t     size        //bytes to allocate
+    ) noexcept {                    //new block (nullptr on failure)
+        return mem_malloc( size );
+    }
+
+    /*======================================================================*/
+    void deallocate(                //release a block
+        void*           ptr,        //block to release
+        std::size_t                 //size of the block
+    ) noexcept {
+        mem_free( ptr );
+    }
+
+    /*======================================================================*/
+    void* reallocate(               //re-size a block
+        void*           ptr,        //block to re-size
+        std::size_t,                //current size of the block
+        std::size_t     size        //new size of the block
+    ) noexcept {                    //re-sized block (nullptr on failure)
+        return mem_realloc( ptr, size );
+    }
+};
+
+struct pool_allocator {             //allocate from the size-class pool
+
+    /*======================================================================*/
+    void* allocate(                 //allocate a block
+        std::size_t     size        //bytes to allocate
+    ) noexcept {                    //new block (nullptr on failure)
+        return mem_pool_malloc( size );
+    }
+
+    /*======================================================================*/
+    void deallocate(                //release a block
+        void*           ptr,        //block to release
+        std::size_t                 //size of the block
+    ) noexcept {
+        mem_pool_free( ptr );
+    }
+
+    /*======================================================================*/
+    void* reallocate(               //re-size a block
+        void*           ptr,        //block to re-size
+        std::size_t,                //current size of the block
+        std::size_t     size        //new size of the block
+    ) noexcept {                    //re-sized block (nullptr on failure)
+        return mem_pool_realloc( ptr, size );
+    }
+};
+
+class arena {                       //bump allocation from a caller's buffer
+
+public:
+
+    /*======================================================================*/
+    arena(                          //use a buffer for allocations
+        void*           buffer,     //memory to allocate from
+        std::size_t     size        //size of the buffer
+    ) noexcept : base_( static_cast< unsigned char* >( buffer ) ),
+        last_( nullptr ), size_( size ), used_( 0 ) {
+    }
+
+    arena( const arena& ) = delete;
+    arena& operator=( const arena& ) = delete;
+
+    /*======================================================================*/
+    void* allocate(                 //allocate a block
+        std::size_t     size        //bytes to allocate
+    ) noexcept {                    //new block (nullptr on failure)
+
+        //local variables
+        std::size_t     start;      //aligned offset of the block
+
+        //align every block for any type
+        start = ( used_ + ( alignof( std::max_align_t ) - 1 ) )
+              & ~( alignof( std::max_align_t ) - 1 );
+        if( ( start > size_ ) || ( size > ( size_ - start ) ) ) {
+            return nullptr;
+        }
+        last_ = base_ + start;
+        used_ = start + size;
+        return last_;
+    }
+
+    /*======================================================================*/
+    void deallocate(                //release a block
+        void*           ptr,        //block to release
+        std::size_t                 //size of the block
+    ) noexcept {
+
+        //only the most recent block can be given back
+        if( ( ptr != nullptr ) && ( ptr == last_ ) ) {
+            used_ = last_ - base_;
+            last_ = nullptr;
+        }
+    }
+
+    /*======================================================================*/
+    void* reallocate(               //re-size a block
+        void*           ptr,        //block to re-size
+        std::size_t     old,        //current size of the block
+        std::size_t     size        //new size of the block
+    ) noexcept {                    //re-sized block (nullptr on failure)
+
+        //local variables
+        void*           moved;      //new block
+
+        //the most recent block re-sizes in place
+        if( ( ptr != nullptr ) && ( ptr == last_ ) ) {
+            if( size > ( size_ - ( last_ - base_ ) ) ) {
+                return nullptr;
+            }
+            used_ = ( last_ - base_ ) + size;
+            return ptr;
+        }
+
+        //any other block is copied to a new block
+        moved = allocate( size );
+        if( ( moved != nullptr ) && ( ptr != nullptr ) ) {
+            std::memcpy( moved, ptr, ( old < size ? old : size ) );
+        }
+        return moved;
+    }
+
+    /*======================================================================*/
+    void reset(                     //release every block
+    ) noexcept {
+        last_ = nullptr;
+        used_ = 0;
+    }
+
+    /*======================================================================*/
+    std::size_t used(               //count the bytes in use
+    ) const noexcept {
+        return used_;
+    }
+
+private:
+
+    unsigned char*      base_;      //beginning of the buffer
+    unsigned char*      last_;      //most recent block
+    std::size_t         size_;      //size of the buffer
+    std::size_t         used_;      //bytes allocated so far
+};
+
+class arena_allocator {             //allocate from an arena
+
+public:
+
+    /*======================================================================*/
+    explicit arena_allocator(       //allocate from an arena
+        arena&          source      //arena (must outlive the allocator)
+    ) noexcept : arena_( &source ) {
+    }
+
+    /*======================================================================*/
+    void* allocate(                 //allocate a block
+        std::size_t     size        //bytes to allocate
+    ) noexcept {                    //new block (nullptr on failure)
+        return arena_->allocate( size );
+    }
+
+    /*======================================================================*/
+    void deallocate(                //release a block
+        void*           ptr,        //block to release
+        std::size_t     size        //size of the block
+    ) noexcept {
+        arena_->deallocate( ptr, size );
+    }
+
+    /*======================================================================*/
+    void* reallocate(               //re-size a block
+        void*           ptr,        //block to re-size
+        std::size_t     old,        //current size of the block
+        std::size_t     size        //new size of the block
+    ) noexcept {                    //re-sized block (nullptr on failure)
+        return arena_->reallocate( ptr, old, size );
+    }
+
+private:
+
+    arena*              arena_;     //arena to allocate from
+};
+
+template<
+    typename CharT,
+    typename Growth    = chunk_growth<>,
+    typename Allocator = heap_allocator
+>
+class basic_hzstr : private Allocator {
+                                    //dynamic string with policies
+
+public:
+
+    typedef CharT value_type;       //character type
+
+    typedef std::basic_string_view< CharT > view_type;
+                                    //view of a string's characters
+
+    /*======================================================================*/
+    basic_hzstr(                    //create an empty string
+    ) noexcept : basic_hzstr( Allocator() ) {
+    }
+
+    /*======================================================================*/
+    explicit basic_hzstr(           //create an empty string
+        const Allocator& allocator  //allocator for the string's memory
+    ) noexcept : Allocator( allocator ), data_( nullptr ), alloc_( 0 ),
+        length_( 0 ), offset_( 0 ) {
+    }
+
+    /*======================================================================*/
+    explicit basic_hzstr(           //create a string from known-length text
+        view_type       text,       //characters to copy
+        const Allocator& allocator = Allocator()
+                                    //allocator for the string's memory
+    ) : basic_hzstr( allocator ) {
+
+        //the length must be representable
+        if( text.size() >= max_alloc ) {
+            throw std::length_error( "hzstr::basic_hzstr" );
+        }
+        if( assign( text ) < 0 ) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /*======================================================================*/
+    basic_hzstr(                    //move a string
+        basic_hzstr&&   other       //string to take the memory from
+    ) noexcept : Allocator( std::move( other.allocator() ) ),
+        data_( other.data_ ), alloc_( other.alloc_ ),
+        length_( other.length_ ), offset_( other.offset_ ) {
+        other.forget();
+    }
+
+    basic_hzstr( const basic_hzstr& ) = delete;
+
+    /*======================================================================*/
+    ~basic_hzstr(                   //release the string's memory
+    ) {
+        release();
+    }
+
+    /*======================================================================*/
+    basic_hzstr& operator=(         //move a string
+        basic_hzstr&&   other       //string to take the memory from
+    ) noexcept {
+        if( this != &other ) {
+            release();
+            allocator() = std::move( other.allocator() );
+            data_   = other.data_;
+            alloc_  = other.alloc_;
+            length_ = other.length_;
+            offset_ = other.offset_;
+            other.forget();
+        }
+        return *this;
+    }
+
+    basic_hzstr& operator=( const basic_hzstr& ) = delete;
+
+    /*======================================================================*/
+    operator view_type(             //view the string's characters
+    ) const noexcept {
+        return view();
+    }
+
+    /*======================================================================*/
+    hzstr_result_t append(          //append a character
+        CharT           c           //character to append
+    ) noexcept {                    //new length (or error result)
+
+        //local variables
+        hzstr_result_t  result;     //allocation result
+
+        //only the grow path leaves this function
+        if( room() <= ( length_ + 1UL ) ) {
+            result = check_alloc( length_ + 1UL );
+            if( result < HZSTR_RSLT_OK ) {
+                return result;
+            }
+        }
+
+        //append the character
+        data_[ length_ ] = c;
+        length_ += 1;
+        data_[ length_ ] = 0;
+        return length_;
+    }
+
+    /*======================================================================*/
+    hzstr_result_t assign(          //replace the string's characters
+        view_type       text        //characters to copy
+    ) noexcept {                    //new length (or error result)
+
+        //local variables
+        std::size_t     from;       //offset of own characters in the text
+        hzstr_result_t  result;     //allocation result
+
+        //remember where the text is, in case it is this string
+        from = own_offset( text );
+
+        //check the allocation for the new length
+        result = check_alloc( text.size() );
+        if( result < HZSTR_RSLT_OK ) {
+            return result;
+        }
+
+        //copy the characters (text in this string is moved toward the
+        //  front, so the copy may overlap)
+        if( text.size() > 0 ) {
+            std::memmove(
+                data_,
+                ( from != npos ? ( data_ + from ) : text.data() ),
+                ( text.size() * sizeof( CharT ) )
+            );
+        }
+        length_ = static_cast< hzstr_length_t >( text.size() );
+        data_[ length_ ] = 0;
+        return length_;
+    }
+
+    /*======================================================================*/
+    hzstr_length_t capacity(        //count the characters that fit now
+    ) const noexcept {              //number of characters (without a NULL)
+        return ( alloc_ > offset_ ? ( alloc_ - offset_ - 1 ) : 0 );
+    }
+
+    /*======================================================================*/
+    hzstr_result_t cat(             //append characters
+        view_type       text        //characters to copy
+    ) noexcept {                    //new length (or error result)
+
+        //local variables
+        std::size_t     from;       //offset of own characters in the text
+        hzstr_result_t  result;     //allocation result
+
+        //remember where the text is, in case it is this string
+        from = own_offset( text );
+
+        //check the allocation for the new length
+        if( room() <= ( length_ + text.size() ) ) {
+            result = check_alloc( length_ + text.size() );
+            if( result < HZSTR_RSLT_OK ) {
+                return result;
+            }
+        }
+
+        //copy the characters after the current characters
+        if( text.size() > 0 ) {
+            std::memcpy(
+                ( data_ + length_ ),
+                ( from != npos ? ( data_ + from ) : text.data() ),
+                ( text.size() * sizeof( CharT ) )
+            );
+        }
+        length_ += static_cast< hzstr_length_t >( text.size() );
+        data_[ length_ ] = 0;
+        return length_;
+    }
+
+    /*======================================================================*/
+    void clear(                     //remove every character (keeping memory)
+    ) noexcept {
+        if( data_ != nullptr ) {
+            data_  -= offset_;
+            offset_ = 0;
+            length_ = 0;
+            data_[ 0 ] = 0;
+        }
+    }
+
+    /*======================================================================*/
+    basic_hzstr clone(              //copy into a new string
+    ) const {
+
+        //local variables
+        basic_hzstr     copy( allocator() );
+                                    //new string (with a copy of allocator)
+
+        //an empty string has nothing to copy
+        if( ( data_ != nullptr ) && ( copy.assign( view() ) < 0 ) ) {
+            throw std::bad_alloc();
+        }
+        return copy;
+    }
+
+    /*======================================================================*/
+    long compare(                   //compare with other characters
+        view_type       text        //characters to compare with
+    ) const noexcept {              //comparison value (0 means equal)
+
+        //local variables
+        std::size_t     length;     //number of characters in both
+        std::size_t     pos;        //position index
+
+        //only compare the characters that are in both
+        length = ( text.size() < length_ ? text.size() : length_ );
+        for( pos = 0; pos < length; ++pos ) {
+            if( data_[ pos ] != text[ pos ] ) {
+                return static_cast< long >( data_[ pos ] )
+                     - static_cast< long >( text[ pos ] );
+            }
+        }
+
+        //the shorter string is ordered first
+        return static_cast< long >( length_ )
+             - static_cast< long >( text.size() );
+    }
+
+    /*======================================================================*/
+    hzstr_result_t consume(         //remove characters from the front
+        hzstr_length_t  length      //number of characters to remove
+    ) noexcept {                    //new length (or error result)
+
+        //make sure the characters exist
+        if( length > length_ ) {
+            return HZSTR_RSLT_USAGE;
+        }
+        skip( length );
+        return length_;
+    }
+
+    /*======================================================================*/
+    const CharT* data(              //access the string's characters
+    ) const noexcept {              //NULL-terminated characters
+        return ( data_ != nullptr ? data_ : &none_ );
+    }
+
+    /*======================================================================*/
+    bool empty(                     //check for zero characters
+    ) const noexcept {
+        return length_ == 0;
+    }
+
+    /*======================================================================*/
+    hzstr_index_t find(             //find first instance of a character
+        CharT           c           //character to search for
+    ) const noexcept {              //index of character (-1=none)
+
+        //local variables
+        hzstr_length_t  pos;        //position index
+
+        for( pos = 0; pos < length_; ++pos ) {
+            if( data_[ pos ] == c ) {
+                return pos;
+            }
+        }
+        return HZSTR_INDEX_NONE;
+    }
+
+    /*======================================================================*/
+    Allocator get_allocator(        //copy the string's allocator
+    ) const noexcept {
+        return allocator();
+    }
+
+    /*======================================================================*/
+    hzstr_length_t length(          //count the string's characters
+    ) const noexcept {
+        return length_;
+    }
+
+    /*======================================================================*/
+    hzstr_result_t reserve(         //make room for a number of characters
+        hzstr_length_t  length      //number of characters it will hold
+    ) noexcept {                    //size of allocation (or error result)
+        return check_alloc( length );
+    }
+
+    /*======================================================================*/
+    hzstr_result_t trim(            //trim whitespace from both ends
+    ) noexcept {                    //new length
+
+        //local variables
+        hzstr_length_t  leading;    //amount of leading whitespace
+        hzstr_length_t  length;     //length after trimming the end
+
+        //find the end of the last non-whitespace character
+        length = length_;
+        while( ( length > 0 ) && space( data_[ length - 1 ] ) ) {
+            length -= 1;
+        }
+
+        //find the first non-whitespace character
+        leading = 0;
+        while( ( leading < length ) && space( data_[ leading ] ) ) {
+            leading += 1;
+        }
+
+        //drop the trailing whitespace, and skip the leading whitespace
+        if( length < length_ ) {
+            length_ = length;
+            data_[ length_ ] = 0;
+        }
+        skip( leading );
+        return length_;
+    }
+
+    /*======================================================================*/
+    view_type view(                 //view the string's characters
+    ) const noexcept {
+        return view_type( data(), length_ );
+    }
+
+private:
+
+    //no position (characters are not in this string)
+    static constexpr std::size_t npos = static_cast< std::size_t >( -1 );
+
+    //characters viewed by an empty string
+    static constexpr CharT none_ = 0;
+
+    /*======================================================================*/
+    Allocator& allocator(           //access the allocator
+    ) noexcept {
+        return *this;
+    }
+
+    /*======================================================================*/
+    const Allocator& allocator(     //access the allocator
+    ) const noexcept {
+        return *this;
+    }
+
+    /*======================================================================*/
+    hzstr_result_t check_alloc(     //check the string's allocation
+        unsigned long   length      //the desired length of the string
+    ) noexcept {                    //size of allocation (or error result)
+
+        //local variables
+        hzstr_length_t  alloc;      //new allocation (characters)
+        void*           base;       //new allocation
+
+        //the string and its NULL must fit in the largest allocation
+        if( length >= max_alloc ) {
+            return HZSTR_RSLT_SAFETY;
+        }
+
+        //see if the string needs to grow
+        if( room() < ( length + 1 ) ) {
+
+            //reclaim the consumed characters once they outnumber the
+            //  string's characters, or if keeping them would not fit
+            if( ( offset_ > length_ )
+             || ( ( offset_ + length ) >= max_alloc ) ) {
+                compact();
+            }
+
+            //see if the string still needs more memory
+            if( room() < ( length + 1 ) ) {
+                alloc = Growth::grow( alloc_, ( offset_ + length ) );
+                if( data_ == nullptr ) {
+                    base = allocator().allocate( alloc * sizeof( CharT ) );
+                }
+                else {
+                    base = allocator().reallocate(
+                        ( data_ - offset_ ),
+                        ( alloc_ * sizeof( CharT ) ),
+                        ( alloc  * sizeof( CharT ) )
+                    );
+                }
+                if( base == nullptr ) {
+                    return HZSTR_RSLT_ALLOC;
+                }
+
+                //a new allocation holds an empty string
+                if( data_ == nullptr ) {
+                    static_cast< CharT* >( base )[ 0 ] = 0;
+                }
+                data_  = static_cast< CharT* >( base ) + offset_;
+                alloc_ = alloc;
+            }
+        }
+        return alloc_;
+    }
+
+    /*======================================================================*/
+    void compact(                   //reclaim the consumed characters
+    ) noexcept {
+
+        //move the string (including the NULL) to the start of its memory
+        if( offset_ > 0 ) {
+            std::memmove(
+                ( data_ - offset_ ),
+                data_,
+                ( ( length_ + 1 ) * sizeof( CharT ) )
+            );
+            data_  -= offset_;
+            offset_ = 0;
+        }
+    }
+
+    /*======================================================================*/
+    void forget(                    //drop the memory (owned elsewhere now)
+    ) noexcept {
+        data_   = nullptr;
+        alloc_  = 0;
+        length_ = 0;
+        offset_ = 0;
+    }
+
+    /*======================================================================*/
+    std::size_t own_offset(         //find text within this string
+        view_type       text        //text that may view this string
+    ) const noexcept {              //offset from data_ (or npos)
+
+        //compare addresses as integers (the text may be anywhere)
+        if( ( data_ != nullptr )
+         && ( reinterpret_cast< std::uintptr_t >( text.data() )
+           >= reinterpret_cast< std::uintptr_t >( data_ ) )
+         && ( reinterpret_cast< std::uintptr_t >( text.data() )
+           <= reinterpret_cast< std::uintptr_t >( data_ + length_ ) ) ) {
+            return text.data() - data_;
+        }
+        return npos;
+    }
+
+    /*======================================================================*/
+    void release(                   //release the string's memory
+    ) noexcept {
+        if( data_ != nullptr ) {
+            allocator().deallocate(
+                ( data_ - offset_ ), ( alloc_ * sizeof( CharT ) )
+            );
+            forget();
+        }
+    }
+
+    /*======================================================================*/
+    unsigned long room(             //count the characters allocated after
+    ) const noexcept {              //  the front of the string
+        return static_cast< unsigned long >( alloc_ - offset_ );
+    }
+
+    /*======================================================================*/
+    void skip(                      //advance the front of the string
+        hzstr_length_t  length      //number of characters to skip
+    ) noexcept {
+        data_   += length;
+        offset_ += length;
+        length_ -= length;
+
+        //an empty string can start over at the beginning of its memory
+        if( length_ == 0 ) {
+            clear();
+        }
+    }
+
+    /*======================================================================*/
+    static bool space(              //check for a whitespace character
+        CharT           c           //character to check
+    ) noexcept {
+        return static_cast< unsigned long >( c ) <= ' ';
+    }
+
+    CharT*              data_;      //characters (nullptr until allocated)
+    hzstr_length_t      alloc_;     //number of characters allocated
+    hzstr_length_t      length_;    //length of string
+    hzstr_length_t      offset_;    //characters consumed before data
+};
+
+//strings of each character width, with the C library's policies
+typedef basic_hzstr< char >     hzstr8;
+typedef basic_hzstr< char16_t > hzstr16;
+typedef basic_hzstr< char32_t > hzstr32;
+
+} //namespace hzstr
+
+#endif /* _HZBASIC_HPP */
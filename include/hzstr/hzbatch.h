@@ -0,0 +1,99 @@
+/*****************************************************************************
+    hzbatch.h
+    Zac Hester
+    2026-10-19
+
+    Parallel batch operations on arrays of Hz strings.
+
+    A batch is split into work units of about HZSTR_BATCH_UNIT bytes of
+    characters.  Short strings next to each other in the array share a
+    unit, and a long string is a unit by itself.  Each thread starts with a
+    contiguous run of units holding an equal share of the batch's bytes,
+    and a thread that finishes its own units takes units from the end of
+    another thread's run.  Batches with a few very long strings are
+    therefore balanced by bytes, not by the number of strings.
+
+    Interface Notes:
+        - hzstr_batch_apply() calls an operation on each string.  Any
+            function that takes only a string and returns a result can be
+            used, including hzstr_tolower(), hzstr_toupper(),
+            hzstr_trim(), and hzstr_validate().  The number of strings
+            that the operation failed on (returned an error result) is
+            returned.
+        - hzstr_batch_hash() stores hzstr_hash() of each string.
+        - The strings are divided between the threads, so an operation may
+            modify its string.  The same string must not appear twice in a
+            batch.
+        - A thread count of 0 uses one thread per online processor (up to
+            HZSTR_BATCH_THREADS).  The calling thread is one of the threads.
+            Batches of less than 2 units are done by the calling thread.
+        - If a thread can't be started, the threads that did start do its
+            units.
+
+    Example Usage
+
+        failed = hzstr_batch_apply( strings, count, hzstr_validate, 0 );
+
+*****************************************************************************/
+
+#ifndef _HZBATCH_H
+#define _HZBATCH_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//most threads used by a batch
+#ifndef HZSTR_BATCH_THREADS
+#define HZSTR_BATCH_THREADS ( 64 )
+#endif
+
+//bytes of characters in a work unit
+#ifndef HZSTR_BATCH_UNIT
+#define HZSTR_BATCH_UNIT ( 16384 )
+#endif
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef hzstr_result_t ( *hzstr_batch_op_t )( hzstr_type* string );
+                                    //operation applied to each string
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+hzstr_result_t hzstr_batch_apply(   //apply an operation to every string
+    hzstr_type**        strings,    //strings to change
+    int                 count,      //number of strings
+    hzstr_batch_op_t    op,         //operation to apply
+    int                 threads     //number of threads (0 for each processor)
+);                                  //strings failed (or error result)
+
+hzstr_result_t hzstr_batch_hash(    //hash every string
+    hzstr_type* const*  strings,    //strings to hash
+    int                 count,      //number of strings
+    hzstr_hash_t*       hashes,     //hash of each string (count entries)
+    int                 threads     //number of threads (0 for each processor)
+);                                  //result of operation
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HZBATCH_H */
@@ -0,0 +1,136 @@
+/*****************************************************************************
+    hzgap.h
+    Zac Hester
+    2026-10-19
+
+    Gap buffer representation of a Hz string for editing workloads.
+
+    The characters are stored in a single allocation with an unused "gap"
+    at the cursor.  Inserting or erasing at the cursor only adjusts the
+    edges of the gap, and moving the cursor moves only the characters
+    between the old and new positions.  Edits that stay near the cursor are
+    therefore O(1) amortized, where the same edit in a hzstr_type moves the
+    entire tail of the string.
+
+    Interface Notes:
+        - Gap buffers are converted to and from normal, dynamic strings.
+            Storage grows in HZSTR_CHUNK_SIZE multiples, so a buffer released
+            by hzstr_gap_to_str() is a normal, dynamic string.
+        - hzstr_gap_views() describes the contents as two substring objects
+            (before and after the cursor) without moving any characters.
+            The views are invalidated by the next edit.
+
+    Example Usage
+
+        hzstr_gap_type* gap;
+        hzstr_type      before;
+        hzstr_type      after;
+
+        gap = hzstr_gap_create_str( string );
+        hzstr_gap_move( gap, 5 );
+        hzstr_gap_append( gap, ',' );
+        hzstr_gap_views( gap, &before, &after );
+
+*****************************************************************************/
+
+#ifndef _HZGAP_H
+#define _HZGAP_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//find the length of the string in a gap buffer
+#define hzstr_gap_length( _g ) \
+    ( ( _g )->alloc - ( ( _g )->end - ( _g )->start ) )
+
+//find the cursor position in a gap buffer
+#define hzstr_gap_cursor( _g ) ( ( _g )->start )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct hzstr_gap_s {        //gap buffer data type
+    hzstr_length_t      alloc;      //number of characters allocated
+    hzstr_length_t      start;      //start of the gap (cursor position)
+    hzstr_length_t      end;        //end of the gap (start of text after it)
+    hzstr_char_t*       data;       //pointer to array of characters
+} hzstr_gap_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+hzstr_result_t hzstr_gap_append(    //insert a character at the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_char_t        c           //character to insert
+);                                  //result of operation
+
+hzstr_result_t hzstr_gap_backspace( //remove characters before the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_length_t      length      //number of characters to remove
+);                                  //result of operation
+
+hzstr_gap_type* hzstr_gap_create(   //create a new, empty gap buffer
+    hzstr_length_t      length      //initial capacity (0 for default)
+);                                  //pointer to new gap buffer
+
+hzstr_gap_type* hzstr_gap_create_str(
+                                    //create a gap buffer from a string
+    const hzstr_type*   source      //string to copy (cursor is at the end)
+);                                  //pointer to new gap buffer
+
+void hzstr_gap_destroy(             //destroy a gap buffer
+    hzstr_gap_type*     gap         //the gap buffer to destroy
+);
+
+hzstr_result_t hzstr_gap_erase(     //remove characters after the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_length_t      length      //number of characters to remove
+);                                  //result of operation
+
+hzstr_result_t hzstr_gap_export(    //copy the contents into a string
+    const hzstr_gap_type* gap,      //source gap buffer
+    hzstr_type*         target      //dynamic string to receive the contents
+);                                  //result of operation
+
+hzstr_result_t hzstr_gap_insert(    //insert a string at the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    const hzstr_type*   source      //string to insert
+);                                  //result of operation
+
+hzstr_result_t hzstr_gap_move(      //move the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_index_t       cursor      //new cursor position
+);                                  //result of operation
+
+hzstr_type* hzstr_gap_to_str(       //convert a gap buffer into a string
+    hzstr_gap_type*     gap         //gap buffer (destroyed if successful)
+);                                  //pointer to new dynamic string
+
+void hzstr_gap_views(               //describe the contents without copying
+    const hzstr_gap_type* gap,      //source gap buffer
+    hzstr_type*         before,     //receives the text before the cursor
+    hzstr_type*         after       //receives the text after the cursor
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HZGAP_H */
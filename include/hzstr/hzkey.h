@@ -0,0 +1,117 @@
+/*****************************************************************************
+    hzkey.h
+    Zac Hester
+    2026-10-19
+
+    Compact 16-byte string keys for comparison-heavy workloads.
+
+    A key holds a string's length and its first 4 bytes of characters (the
+    prefix) in the key itself.  The rest of a short string (up to 12 bytes
+    of characters) is also stored in the key, and a longer string's key
+    holds a pointer to its characters instead.  Keys are small enough to
+    sort and hash in place, and most comparisons of unequal keys are
+    decided by the length and prefix without reading the characters.
+
+    Interface Notes:
+        - A key of a long string refers to the characters of the string it
+            was set from.  The key is invalidated when that string is
+            modified or destroyed.  A key of a short string does not refer
+            to any other memory.
+        - The unused characters of a short key are always zero, so equal
+            short keys have equal bytes.
+        - hzstr_key_cmp() orders keys the same way hzstr_cmp() orders the
+            strings they were set from.
+        - hzstr_key_view() describes a key's string as a substring object.
+            The view of a short key refers to the key itself, so the key
+            must not be moved while the view is in use.
+
+    Example Usage
+
+        hzstr_key_type  keys[ 2 ];
+
+        hzstr_key_set( &keys[ 0 ], string0 );
+        hzstr_key_set( &keys[ 1 ], string1 );
+        if( hzstr_key_equal( &keys[ 0 ], &keys[ 1 ] ) ) {
+            ...
+        }
+
+*****************************************************************************/
+
+#ifndef _HZKEY_H
+#define _HZKEY_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//key capacities (in characters)
+#define HZSTR_KEY_PREFIX ( 4 / sizeof( hzstr_char_t ) )
+                                    //characters in every key's prefix
+#define HZSTR_KEY_INLINE ( 12 / sizeof( hzstr_char_t ) )
+                                    //longest string stored in a key
+
+//find the length of a key's string
+#define hzstr_key_length( _k ) ( ( _k )->length )
+
+//check if a key stores all of its string's characters
+#define hzstr_key_is_inline( _k ) ( ( _k )->length <= HZSTR_KEY_INLINE )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct hzstr_key_s {        //compact string key data type
+    uint32_t            length;     //length of string
+    hzstr_char_t        chars[ HZSTR_KEY_INLINE ];
+                                    //prefix, then characters or pointer
+} hzstr_key_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+long hzstr_key_cmp(                 //compare two keys
+    const hzstr_key_type* key0,     //first key
+    const hzstr_key_type* key1      //second key
+);                                  //comparison value (0 means equal)
+
+int hzstr_key_equal(                //check two keys for equal characters
+    const hzstr_key_type* key0,     //first key
+    const hzstr_key_type* key1      //second key
+);                                  //1 if equal, 0 if not
+
+hzstr_result_t hzstr_key_set(       //set a key from a string
+    hzstr_key_type*     key,        //key to set
+    const hzstr_type*   source      //string described by the key
+);                                  //length of the string (or error result)
+
+hzstr_type* hzstr_key_to_str(       //create a new string from a key
+    const hzstr_key_type* key       //source key
+);                                  //pointer to new string
+
+hzstr_result_t hzstr_key_view(      //describe a key's string without copying
+    const hzstr_key_type* key,      //source key
+    hzstr_type*         view        //receives a substring of the string
+);                                  //length of the string (or error result)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HZKEY_H */
@@ -0,0 +1,90 @@
+/*****************************************************************************
+    hzsort.h
+    Zac Hester
+    2026-10-19
+
+    Sorting of large arrays of Hz strings.
+
+    hzstr_sort() is a most-significant-digit radix sort.  Each string's
+    next 8 bytes of characters are cached in a work array next to the
+    string's pointer, so each level of the sort reads the cache instead of
+    following the pointer.  A string's characters are only read again every
+    8 levels.  Small buckets are finished with a multikey quicksort (or an
+    insertion sort for stable sorts), which uses the same cache.
+
+    Interface Notes:
+        - Strings are ordered the same way hzstr_cmp() orders them.
+        - HZSTR_SORT_STABLE keeps equal strings in their original order.
+        - HZSTR_SORT_NOCASE orders strings as if ASCII letters were
+            lowercase (the same change as hzstr_tolower()).  Other
+            characters, including multi-byte UTF-8, are ordered by value.
+        - HZSTR_SORT_PARALLEL sorts large arrays with several threads.  The
+            first level is sorted by the calling thread, and the resulting
+            buckets are sorted by up to HZSTR_SORT_THREADS threads (the
+            calling thread included).  Arrays smaller than
+            HZSTR_SORT_PARALLEL_MINIMUM are sorted by the calling thread.
+        - The work arrays take about 2 pointers and 16 bytes per string.
+            If they can't be allocated, the strings are not changed.
+
+    Example Usage
+
+        hzstr_sort( strings, count, HZSTR_SORT_PARALLEL );
+
+*****************************************************************************/
+
+#ifndef _HZSORT_H
+#define _HZSORT_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//most threads used by a parallel sort
+#ifndef HZSTR_SORT_THREADS
+#define HZSTR_SORT_THREADS ( 8 )
+#endif
+
+//fewest strings sorted by more than one thread
+#ifndef HZSTR_SORT_PARALLEL_MINIMUM
+#define HZSTR_SORT_PARALLEL_MINIMUM ( 65536 )
+#endif
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+enum {                              //sort behavior flags
+    HZSTR_SORT_STABLE   = ( 1 << 0 ),//equal strings keep their order
+    HZSTR_SORT_NOCASE   = ( 1 << 1 ),//ASCII letters are ordered as lowercase
+    HZSTR_SORT_PARALLEL = ( 1 << 2 ) //large arrays are sorted by threads
+};
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+hzstr_result_t hzstr_sort(          //sort an array of strings
+    hzstr_type**        strings,    //strings to sort
+    int                 count,      //number of strings
+    int                 flags       //sort behavior flags (HZSTR_SORT_*)
+);                                  //result of operation
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HZSORT_H */
@@ -23,7 +23,119 @@
             necessary.
         - In the above case, the user may specify any primitive character type
             by defining the HZSTR_USER_TYPE symbol.  This type will then be
-            used for all string storage and manipulation.
+            used for all string storage and manipulation.  C-strings are
+            decoded from UTF-8 into 16-bit (UTF-16) and 32-bit (UTF-32)
+            character types, and hzstr_export_utf8() converts a string back
+            into a UTF-8 C-string.
+        - Dynamic strings may begin part-way into their allocation.  Removing
+            characters from the front of a string (hzstr_consume(),
+            hzstr_trim()) only advances the data pointer, and the consumed
+            space is reclaimed when the string next needs to grow.  The
+            offset member counts the characters before the data pointer.
+        - Scans over string data use SSE2 vector instructions when the target
+            supports them, for 8-bit, 16-bit and 32-bit character types.
+            Defining the HZSTR_DSBL_SIMD symbol when building the library
+            forces the portable, one-character-at-a-time scans.
+        - hzstr_cmp() orders a string before any longer string that it is
+            a prefix of.
+        - hzstr_reserve() allocates room for a final length once, without
+            changing the string's characters.  Later operations that fit
+            in that room never re-allocate.
+        - Strings keep their allocations when they get shorter, unless a
+            shrink policy is set (by hzstr_shrink_policy(), or by defining
+            HZSTR_SHRINK_FACTOR when building the library).  With a policy,
+            hzstr_cpy(), the C-string copies, the trims and hzstr_erase()
+            re-allocate a string whose allocation is more than the factor
+            times its length (and more than the policy's minimum).  The new
+            allocation leaves room to double the length, so a string is
+            only shrunk again after losing half of its length.
+            hzstr_compact_all() moves a batch of strings into new, exact
+            allocations (after a load spike, for example), so the memory
+            of their old allocations can be reused by the allocator.
+        - Whitespace is any character with a value from 0 through ' ' (space).
+        - The C-string functions with an _n suffix take the length of the
+            C-string from the caller, and never scan it for a NULL byte or
+            check its encoding (so the string's encoding flags are cleared).
+            The caller's characters are copied as-is, and the string is
+            always NULL-terminated.  C-strings too long to be stored are
+            rejected after scanning at most the longest possible string.
+        - The HZSTR_FLG_ASCII and HZSTR_FLG_UTF8 flags record what is known
+            about a string's encoding.  A clear flag means "not known," not
+            "known to be invalid."  hzstr_import() and hzstr_validate() check
+            the whole string.  Functions that copy characters in from
+            C-strings (other than the _n functions) check only the new
+            characters, and the other mutators update the flags from what
+            is known about their inputs without scanning.  Appending a
+            single non-ASCII byte clears both flags.  Without C-string
+            compatibility, only ASCII strings are recognized as valid.
+        - hzstr_fold(), hzstr_casecmp(), and the code point functions
+            (hzstr_cp_*) treat the characters as UTF-8 (see hzutf8.h), and
+            are only available with C-string compatibility.  Folding may
+            change the length of a string, and hzstr_casecmp() compares the
+            folded code points without allocating.
+        - HZSTR_LITERAL() initializes a string object around a C-string
+            literal when the program is built, so a constant string needs
+            no allocation or length scan at run time.  These objects are
+            marked HZSTR_FLG_STATIC, and hzstr_destroy() leaves them alone.
+            C++ programs may use the _hz literal (see hzstr.hpp), which also
+            computes the hash and encoding of the literal at compile time.
+        - hzstr_hash() is the 32-bit FNV-1a hash of a string's characters.
+            The hash is only stored in objects marked HZSTR_FLG_HASHED (the
+            immutable constants made by the _hz literal), and is computed
+            for all other strings.  hzstr_equal() uses stored hashes to
+            reject unequal strings without comparing their characters.
+        - hzstr_append() and hzstr_cat() are expanded in place (as static
+            inline functions) when the target is a dynamic string with room
+            for the new characters.  Every other case, including growing
+            the string, is handled by the library's function.  Defining the
+            HZSTR_DSBL_INLINE symbol makes every call go to the library,
+            and ( hzstr_append )( ... ) always does.  hzstr_available()
+            counts the characters a dynamic string can take before it must
+            grow.
+        - Defining the HZSTR_STATS symbol (for the library and its users)
+            counts the calls of each function, the bytes each function
+            copies or moves, the allocations grown by the library, the
+            bytes requested and allocated, and the bytes released by
+            hzstr_minimize().  Each thread counts into its own counters
+            without locking or atomic read-modify-writes.
+            hzstr_stats_snapshot() adds up every thread's counters (since
+            the last hzstr_stats_reset()).  Calls made by one library
+            function to another are counted too, and bytes are counted for
+            the function most recently called by the thread.  Statistics
+            builds do not use the inline fast paths, so every call is
+            counted.  Without HZSTR_STATS, nothing is counted, and the
+            statistics functions do not exist.
+        - Defining the HZSTR_LATENCY symbol (for the library and its users)
+            records the time taken to grow strings, where the tail of the
+            library's latency comes from.  The growths of hzstr_append(),
+            hzstr_cat(), hzstr_cat_cstr() (and hzstr_cat_cstr_n()),
+            hzstr_cpy(), hzstr_cpy_cstr() (and the other C-string copies)
+            and hzstr_sprintf() are each recorded, as are the library's
+            allocations of string data.  A growth is timed from its check
+            through the re-allocation and the copy it makes.  One growth of
+            each operation in every HZSTR_LATENCY_RATE (64 unless defined
+            otherwise, or as set by hzstr_latency_rate()) is timed, and each
+            thread counts the times in its own log-linear histograms (8
+            buckets for each power of two, so a bucket's range is within
+            12.5% of its values).  Times are in time-stamp counter ticks on
+            x86, and in nanoseconds elsewhere.  hzstr_latency_summary()
+            reports the percentiles of one operation, and
+            hzstr_latency_dump() writes every non-empty histogram.  Calls
+            that fit in their string's allocation are not counted or timed,
+            and latency builds keep the inline fast paths, so those calls
+            cost the same as in other builds ("make latency" in
+            bench/hzstr compares them).
+        - Defining the HZSTR_PROFILE symbol (for the library and its users)
+            keeps a table of every live string object.  Strings created
+            through the hzstr_create* macros of a profiling build are tagged
+            with the file and line of the call (strings created any other
+            way are reported with an unknown site).  hzstr_profile_sites()
+            reports each site's live strings, the bytes they hold (object
+            and allocation), the slack bytes allocated but not used by
+            characters, and the distributions of their sizes and ages.
+            Sites are reported most slack first, so the few sites holding
+            most of the unused memory come first.  hzstr_profile_dump()
+            writes the same report with each site's share of all slack.
 
     Example Usage
 
@@ -36,6 +148,19 @@
 Includes
 ----------------------------------------------------------------------------*/
 
+//statistics builds count every call, so the inline fast paths are not used
+#if defined( HZSTR_STATS ) && !defined( HZSTR_DSBL_INLINE )
+#define HZSTR_DSBL_INLINE
+#endif
+
+#if defined( HZSTR_LATENCY ) || defined( HZSTR_PROFILE )
+#include <stdio.h>
+#endif
+
+#ifndef HZSTR_DSBL_INLINE
+#include <string.h>
+#endif
+
 /*----------------------------------------------------------------------------
 Macros
 ----------------------------------------------------------------------------*/
@@ -54,8 +179,52 @@ Macros
 //find the length of a string
 #define hzstr_length( _s ) ( ( _s )->length )
 
-//performance tuning
+//access the characters of a string
+#define hzstr_data( _s ) ( ( _s )->data )
+
+//count the characters a string can take without growing (0 if it can not)
+#define hzstr_available( _s ) ( ( _s )->alloc > 0 \
+    ? ( ( _s )->alloc - ( _s )->offset - ( _s )->length - 1 ) : 0 )
+
+//performance tuning (the chunk size may be defined for the whole build)
+#ifndef HZSTR_CHUNK_SIZE
 #define HZSTR_CHUNK_SIZE ( 32 )     //allocation chunk size (characters)
+#endif
+
+//32-bit FNV-1a hash parameters
+#define HZSTR_HASH_BASIS ( 2166136261u )
+#define HZSTR_HASH_PRIME ( 16777619u )
+
+//default shrink policy (a factor of 0 never shrinks strings; allocations
+//  of up to the minimum number of characters are never shrunk)
+#ifndef HZSTR_SHRINK_FACTOR
+#define HZSTR_SHRINK_FACTOR ( 0 )
+#endif
+#ifndef HZSTR_SHRINK_MINIMUM
+#define HZSTR_SHRINK_MINIMUM ( 1024 )
+#endif
+
+//one call in this many is timed by latency builds (by default)
+#ifndef HZSTR_LATENCY_RATE
+#define HZSTR_LATENCY_RATE ( 64 )
+#endif
+
+//profile distribution buckets (bucket 0 holds values under one unit, and
+//  bucket N holds values of at least unit << ( N - 1 ), up to the last)
+#define HZSTR_PROFILE_BUCKETS ( 16 )
+#define HZSTR_PROFILE_SIZE_UNIT ( 32 )  //bytes in the first size bucket
+#define HZSTR_PROFILE_AGE_UNIT ( 1 )    //milliseconds in the first age bucket
+
+#ifdef HZSTR_COMPAT_CSTR
+
+//initialize a constant string object from a C-string literal
+//  e.g. static const hzstr_type name = HZSTR_LITERAL( "name" );
+#define HZSTR_LITERAL( _literal ) { \
+    HZSTR_TYPE_CONST, HZSTR_FLG_STATIC, 0, ( sizeof( _literal ) - 1 ), 0, 0, \
+    ( hzstr_char_t* ) ( "" _literal ) \
+}
+
+#endif  //HZSTR_COMPAT_CSTR
 
 /*----------------------------------------------------------------------------
 Types and Structures
@@ -78,6 +247,7 @@ enum {                              //operation results (+ indicates length)
     HZSTR_RSLT_USAGE    = -99,      //used incorrectly (invalid parameters)
     HZSTR_RSLT_TYPE     = -98,      //string type incorrectly accessed
     HZSTR_RSLT_SAFETY   = -97,      //operation failed safety check
+    HZSTR_RSLT_ENCODING = -96,      //characters are not valid UTF-8
     HZSTR_RSLT_ALLOC    = -89       //failed to allocate memory
 };
 
@@ -95,9 +265,15 @@ typedef unsigned short hzstr_flags_t;
                                     //object behavior flag type
 
 enum {                              //string behavior flags
-    HZSTR_FLG_WRITABLE = ( 1 << 0 ) //the string can accept mutating access
+    HZSTR_FLG_WRITABLE = ( 1 << 0 ),//the string can accept mutating access
+    HZSTR_FLG_ASCII    = ( 1 << 1 ),//characters are known to be ASCII
+    HZSTR_FLG_UTF8     = ( 1 << 2 ),//characters are known to be valid UTF-8
+    HZSTR_FLG_STATIC   = ( 1 << 3 ),//the object itself is not allocated
+    HZSTR_FLG_HASHED   = ( 1 << 4 ) //the hash member holds the string's hash
 };
 
+typedef unsigned int hzstr_hash_t;  //hash of a string's characters
+
 #ifdef HZSTR_USER_TYPE
 typedef HZSTR_USER_TYPE hzstr_char_t;
                                     //internal type alias to character type
@@ -110,9 +286,115 @@ typedef struct hzstr_s {            //string data type
     hzstr_flags_t       flags;      //object behavior flags
     hzstr_length_t      alloc;      //number of bytes allocated
     hzstr_length_t      length;     //length of string
+    hzstr_length_t      offset;     //characters consumed before data
+    hzstr_hash_t        hash;       //hash of characters (HZSTR_FLG_HASHED)
     hzstr_char_t*       data;       //pointer to array of characters in string
 } hzstr_type;
 
+#ifdef HZSTR_STATS
+
+enum {                              //functions counted by the statistics
+    HZSTR_STAT_APPEND,
+    HZSTR_STAT_CASECMP,
+    HZSTR_STAT_CAT,
+    HZSTR_STAT_CAT_CSTR,
+    HZSTR_STAT_CAT_CSTR_N,
+    HZSTR_STAT_CMP,
+    HZSTR_STAT_COMPACT_ALL,
+    HZSTR_STAT_CONSUME,
+    HZSTR_STAT_CP_COUNT,
+    HZSTR_STAT_CP_OFFSET,
+    HZSTR_STAT_CPY,
+    HZSTR_STAT_CPY_CSTR,
+    HZSTR_STAT_CPY_CSTR_N,
+    HZSTR_STAT_CREATE,
+    HZSTR_STAT_CREATE_CCSTR,
+    HZSTR_STAT_CREATE_CSTR,
+    HZSTR_STAT_CREATE_CSTR_N,
+    HZSTR_STAT_CREATE_SUBSTR,
+    HZSTR_STAT_DESTROY,
+    HZSTR_STAT_EQUAL,
+    HZSTR_STAT_ERASE,
+    HZSTR_STAT_EXPORT_UTF8,
+    HZSTR_STAT_FOLD,
+    HZSTR_STAT_HASH,
+    HZSTR_STAT_IMPORT,
+    HZSTR_STAT_IMPORT_UTF8,
+    HZSTR_STAT_INSERT,
+    HZSTR_STAT_MINIMIZE,
+    HZSTR_STAT_REPLACE_ALL,
+    HZSTR_STAT_RESERVE,
+    HZSTR_STAT_SPLICE,
+    HZSTR_STAT_SPRINTF,
+    HZSTR_STAT_SQUEEZE,
+    HZSTR_STAT_STRCHR,
+    HZSTR_STAT_TOLOWER,
+    HZSTR_STAT_TOUPPER,
+    HZSTR_STAT_TRIM,
+    HZSTR_STAT_TRIM_LEFT,
+    HZSTR_STAT_TRIM_RIGHT,
+    HZSTR_STAT_VALIDATE,
+
+    HZSTR_NUM_STATS                 //number of counted functions
+};
+
+typedef struct hzstr_stats_s {      //operation statistics
+    unsigned long       calls[ HZSTR_NUM_STATS ];
+                                    //calls of each function
+    unsigned long       moved[ HZSTR_NUM_STATS ];
+                                    //bytes copied or moved by each function
+    unsigned long       grows;      //allocations grown to fit more characters
+    unsigned long       requested;  //bytes requested for string data
+    unsigned long       allocated;  //bytes allocated for string data
+    unsigned long       minimized;  //bytes released by hzstr_minimize(),
+                                    //  shrinking and hzstr_compact_all()
+} hzstr_stats_type;
+
+#endif  //HZSTR_STATS
+
+#ifdef HZSTR_LATENCY
+
+enum {                              //operations timed by latency builds
+    HZSTR_LAT_ALLOC,                //allocation of string data
+    HZSTR_LAT_APPEND,
+    HZSTR_LAT_CAT,
+    HZSTR_LAT_CAT_CSTR,
+    HZSTR_LAT_CPY,
+    HZSTR_LAT_CPY_CSTR,
+    HZSTR_LAT_SPRINTF,
+
+    HZSTR_NUM_LATS                  //number of timed operations
+};
+
+typedef struct hzstr_latency_s {    //summary of an operation's times
+    unsigned long       samples;    //number of calls timed
+    unsigned long       total;      //sum of the times
+    unsigned long       maximum;    //longest time
+    unsigned long       p50;        //median time (highest in its bucket)
+    unsigned long       p90;        //90th percentile time
+    unsigned long       p99;        //99th percentile time
+    unsigned long       p999;       //99.9th percentile time
+} hzstr_latency_type;
+
+#endif  //HZSTR_LATENCY
+
+#ifdef HZSTR_PROFILE
+
+typedef struct hzstr_profile_site_s {
+                                    //live strings created at a call site
+    const char*         file;       //source file (NULL if unknown)
+    int                 line;       //source line (0 if unknown)
+    unsigned long       strings;    //number of live strings
+    unsigned long       bytes;      //bytes held (objects and allocations)
+    unsigned long       slack;      //allocated bytes not used by characters
+    unsigned long       sizes[ HZSTR_PROFILE_BUCKETS ];
+                                    //strings by bytes held
+    unsigned long       ages[ HZSTR_PROFILE_BUCKETS ];
+                                    //strings by milliseconds alive
+} hzstr_profile_site_type;
+
+#endif  //HZSTR_PROFILE
+
 /*----------------------------------------------------------------------------
 Memory Constants
 ----------------------------------------------------------------------------*/
@@ -121,9 +403,13 @@ Memory Constants
 Interface Prototypes
 ----------------------------------------------------------------------------*/
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 hzstr_result_t hzstr_append(        //append character onto end of string
     hzstr_type*         string,     //target string
-    char                c           //character to append
+    hzstr_char_t        c           //character to append
 );                                  //result of appending
 
 hzstr_type* hzstr_create(           //create a new string
@@ -140,6 +426,11 @@ hzstr_type* hzstr_create_cstr(      //create new string from a C-string
     const char*         cstring     //C string
 );                                  //pointer to new string
 
+hzstr_type* hzstr_create_cstr_n(    //create string from a sized C-string
+    const char*         cstring,    //C string
+    hzstr_length_t      length      //number of characters in the C string
+);                                  //pointer to new string
+
 hzstr_type* hzstr_create_substr(    //create a substring of another string
     const hzstr_type*   source,     //source string
     hzstr_index_t       offset,     //beginning offset in string
@@ -156,6 +447,12 @@ hzstr_result_t hzstr_cat_cstr(      //concatenate a C-string onto a string
     const char*         source      //concatenation source
 );                                  //result of operation
 
+hzstr_result_t hzstr_cat_cstr_n(    //concatenate a known-length C-string
+    hzstr_type*         target,     //concatenation target
+    const char*         source,     //concatenation source
+    hzstr_length_t      length      //number of characters in the source
+);                                  //result of operation
+
 hzstr_result_t hzstr_cpy(           //copy one string into another
     hzstr_type*         target,     //copy target
     const hzstr_type*   source      //copy source
@@ -166,25 +463,159 @@ hzstr_result_t hzstr_cpy_cstr(      //copy a C-string into a string
     const char*         source      //copy source
 );                                  //result of operation
 
+hzstr_result_t hzstr_cpy_cstr_n(    //copy a known-length C-string
+    hzstr_type*         target,     //copy target
+    const char*         source,     //copy source
+    hzstr_length_t      length      //number of characters in the source
+);                                  //result of operation
+
+hzstr_result_t hzstr_consume(       //remove characters from the front
+    hzstr_type*         string,     //string to modify
+    hzstr_length_t      length      //number of characters to remove
+);                                  //result of operation
+
+#ifdef HZSTR_COMPAT_CSTR
+long hzstr_casecmp(                 //compare two strings ignoring case
+    const hzstr_type*   string0,    //first string
+    const hzstr_type*   string1     //second string
+);                                  //comparison value (0 means equal)
+#endif
+
 long hzstr_cmp(                     //compare two strings for equality
     const hzstr_type*   string0,    //first string
     const hzstr_type*   string1     //second string
 );                                  //comparison value (0 means equal)
 
+hzstr_result_t hzstr_compact_all(   //move strings into exact allocations
+    hzstr_type**        strings,    //strings to move (NULL entries skipped)
+    int                 count       //number of strings
+);                                  //bytes released (or error result)
+
+#ifdef HZSTR_COMPAT_CSTR
+hzstr_result_t hzstr_cp_count(      //count the code points in a string
+    const hzstr_type*   string      //string to count
+);                                  //number of code points
+
+hzstr_index_t hzstr_cp_offset(      //find the offset of a code point
+    const hzstr_type*   string,     //string to search
+    hzstr_index_t       index       //index of the code point
+);                                  //offset of code point, or INDEX_NONE
+#endif
+
 void hzstr_destroy(                 //destroy a string
     hzstr_type*         string      //the string to destroy
 );
 
+int hzstr_equal(                    //check two strings for equal characters
+    const hzstr_type*   string0,    //first string
+    const hzstr_type*   string1     //second string
+);                                  //1 if equal, 0 if not
+
+hzstr_result_t hzstr_erase(         //remove a range of characters
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //beginning offset of range to remove
+    hzstr_length_t      length      //number of characters to remove
+);                                  //result of operation
+
+hzstr_result_t hzstr_export_utf8(   //convert a string to a UTF-8 C-string
+    const hzstr_type*   string,     //string to convert
+    char*               output,     //C-string output (NULL to measure)
+    unsigned long       size        //size of the output buffer
+);                                  //result of operation
+
+#ifdef HZSTR_COMPAT_CSTR
+hzstr_result_t hzstr_fold(          //fold the case of a string's code points
+    hzstr_type*         string      //string to fold
+);                                  //result of operation
+#endif
+
+hzstr_hash_t hzstr_hash(            //hash a string's characters
+    const hzstr_type*   string      //string to hash
+);                                  //32-bit FNV-1a hash
+
 hzstr_result_t hzstr_import(        //safely import an untrusted string
     hzstr_type*         string,     //existing string to use for storage
     const char*         source,     //C string to import
     hzstr_length_t      length      //maximum length to import
 );                                  //result of operation
 
+hzstr_result_t hzstr_import_utf8(   //import an untrusted UTF-8 string
+    hzstr_type*         string,     //existing string to use for storage
+    const char*         source,     //C string to import
+    hzstr_length_t      length      //maximum length to import
+);                                  //result of operation
+
+hzstr_result_t hzstr_insert(        //insert a string at an offset
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //offset at which to insert
+    const hzstr_type*   source      //string to insert
+);                                  //result of operation
+
+#ifdef HZSTR_LATENCY
+void hzstr_latency_dump(            //write every thread's latency histograms
+    FILE*               out         //output file
+);
+
+void hzstr_latency_rate(            //set how often calls are timed
+    unsigned int        rate        //one call in this many is timed (>0)
+);
+
+void hzstr_latency_reset(           //clear every thread's latency histograms
+    void
+);
+
+hzstr_result_t hzstr_latency_summary(
+                                    //summarize the times of an operation
+    int                 operation,  //operation to summarize (HZSTR_LAT_*)
+    hzstr_latency_type* summary     //summary output
+);                                  //result of operation
+#endif
+
 hzstr_result_t hzstr_minimize(      //minimize the memory used for this string
     hzstr_type*         string      //string to minimize
 );                                  //result of operation
 
+#ifdef HZSTR_PROFILE
+hzstr_result_t hzstr_profile_dump(  //write the live strings of every site
+    FILE*               out         //output file
+);                                  //number of sites (or error result)
+
+hzstr_result_t hzstr_profile_sites(
+                                    //report the live strings of every site
+    hzstr_profile_site_type* sites, //list of sites (most slack first)
+    int                 size        //number of sites the list can hold
+);                                  //number of sites (or error result)
+
+hzstr_type* hzstr_profile_tag(      //tag a live string with its call site
+    hzstr_type*         string,     //string to tag (may be NULL)
+    const char*         file,       //source file of the call
+    int                 line        //source line of the call
+);                                  //the string
+#endif
+
+hzstr_result_t hzstr_replace_all(   //replace all instances of a substring
+    hzstr_type*         target,     //string to modify
+    const hzstr_type*   needle,     //substring to search for
+    const hzstr_type*   replacement //string to put in place of each instance
+);                                  //result of operation
+
+hzstr_result_t hzstr_reserve(       //make room for a number of characters
+    hzstr_type*         string,     //string to prepare
+    hzstr_length_t      length      //number of characters it will hold
+);                                  //size of allocation (or error result)
+
+hzstr_result_t hzstr_shrink_policy( //set when shorter strings are shrunk
+    unsigned int        factor,     //allocation to length ratio (0, or >= 4)
+    hzstr_length_t      minimum     //largest allocation never shrunk
+);                                  //result of operation
+
+hzstr_result_t hzstr_splice(        //replace a range with another string
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //beginning offset of range to replace
+    hzstr_length_t      length,     //number of characters to replace
+    const hzstr_type*   source      //replacement string
+);                                  //result of operation
+
 #ifdef HZSTR_COMPAT_CSTR
 hzstr_result_t hzstr_sprintf(       //formatted printing into a string
     hzstr_type*         string,     //target string
@@ -193,9 +624,23 @@ hzstr_result_t hzstr_sprintf(       //formatted printing into a string
 );                                  //result of operation
 #endif
 
+hzstr_result_t hzstr_squeeze(       //collapse runs of whitespace
+    hzstr_type*         string      //string to modify
+);                                  //result of operation
+
+#ifdef HZSTR_STATS
+void hzstr_stats_reset(             //start counting the statistics again
+    void
+);
+
+void hzstr_stats_snapshot(          //add up the statistics of every thread
+    hzstr_stats_type*   stats       //statistics output
+);
+#endif
+
 hzstr_index_t hzstr_strchr(         //find first instance of a character
     const hzstr_type*   string,     //string to search
-    char                c           //character to search for
+    hzstr_char_t        c           //character to search for
 );                                  //index of character in string (-1=none)
 
 hzstr_result_t hzstr_tolower(       //transform the string to lowercase
@@ -210,4 +655,105 @@ hzstr_result_t hzstr_trim(          //trim a string in-place
     hzstr_type*         string      //string to trim
 );                                  //result of operation
 
+hzstr_result_t hzstr_trim_left(     //trim leading whitespace in-place
+    hzstr_type*         string      //string to trim
+);                                  //result of operation
+
+hzstr_result_t hzstr_trim_right(    //trim trailing whitespace in-place
+    hzstr_type*         string      //string to trim
+);                                  //result of operation
+
+hzstr_result_t hzstr_validate(      //check and record a string's encoding
+    hzstr_type*         string      //string to check
+);                                  //result of check
+
+#ifdef __cplusplus
+}
+#endif
+
+/*----------------------------------------------------------------------------
+Inline Functions
+----------------------------------------------------------------------------*/
+
+#ifndef HZSTR_DSBL_INLINE
+
+/*==========================================================================*/
+static inline hzstr_result_t hzstr_append_inline(
+                                    //append character onto end of string
+    hzstr_type*         string,     //target string
+    hzstr_char_t        c           //character to append
+) {                                 //result of appending
+
+    //append in place if there is room for the character and a NULL
+    if( ( string != NULL )
+     && ( string->type == HZSTR_TYPE_DYNAMIC )
+     && ( ( string->alloc - string->offset ) > ( string->length + 1 ) ) ) {
+        if( ( unsigned long ) c > 0x7F ) {
+            string->flags &= ~( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 );
+        }
+        string->data[ string->length ] = c;
+        string->length += 1;
+        string->data[ string->length ] = 0;
+        return string->length;
+    }
+
+    //the library grows the string (or reports the error)
+    return ( hzstr_append )( string, c );
+}
+
+
+/*==========================================================================*/
+static inline hzstr_result_t hzstr_cat_inline(
+                                    //concatenate two strings
+    hzstr_type*         target,     //concatenation target
+    const hzstr_type*   source      //concatenation source
+) {                                 //result of operation
+
+    //copy in place if there is room for the source and a NULL
+    if( ( target->type == HZSTR_TYPE_DYNAMIC )
+     && ( ( target->alloc - target->offset )
+        > ( target->length + source->length ) ) ) {
+        memcpy(
+            &( target->data[ target->length ] ),
+            source->data,
+            ( source->length * sizeof( hzstr_char_t ) )
+        );
+        target->length += source->length;
+        target->data[ target->length ] = 0;
+        target->flags &= source->flags | ~( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 );
+        return target->length;
+    }
+
+    //the library grows the string (or reports the error)
+    return ( hzstr_cat )( target, source );
+}
+
+//calls to these functions use the fast paths
+#define hzstr_append( _s, _c ) hzstr_append_inline( ( _s ), ( _c ) )
+#define hzstr_cat( _t, _s ) hzstr_cat_inline( ( _t ), ( _s ) )
+
+#endif  //HZSTR_DSBL_INLINE
+
+/*----------------------------------------------------------------------------
+Call Sites
+----------------------------------------------------------------------------*/
+
+#ifdef HZSTR_PROFILE
+
+//calls to the create functions tag their strings with the call site
+#define hzstr_create( _l ) \
+    hzstr_profile_tag( ( hzstr_create )( _l ), __FILE__, __LINE__ )
+#define hzstr_create_cstr( _c ) \
+    hzstr_profile_tag( ( hzstr_create_cstr )( _c ), __FILE__, __LINE__ )
+#define hzstr_create_cstr_n( _c, _l ) hzstr_profile_tag( \
+    ( hzstr_create_cstr_n )( ( _c ), ( _l ) ), __FILE__, __LINE__ )
+#define hzstr_create_substr( _s, _o, _l ) hzstr_profile_tag( \
+    ( hzstr_create_substr )( ( _s ), ( _o ), ( _l ) ), __FILE__, __LINE__ )
+#ifdef HZSTR_COMPAT_CSTR
+#define hzstr_create_ccstr( _c ) \
+    hzstr_profile_tag( ( hzstr_create_ccstr )( _c ), __FILE__, __LINE__ )
+#endif
+
+#endif  //HZSTR_PROFILE
+
 #endif /* _HZSTR_H */
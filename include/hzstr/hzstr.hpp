@@ -0,0 +1,852 @@
+/*****************************************************************************
+    hzstr.hpp
+    Zac Hester
+    2026-10-19
+
+    C++ interface to Hz strings.
+
+    An hzstr::string owns one string object, and destroys it when the
+    hzstr::string goes out of scope.  The string object is always available
+    to the C interface through get().
+
+    Interface Notes:
+        - Strings are move-only.  A move takes the other string's object
+            (nothing is allocated or copied) and leaves the other string
+            empty.  clone() makes an independent copy.
+        - An empty (default-constructed or moved-from) string has no string
+            object.  It views as zero characters, and get() returns nullptr.
+        - Strings convert implicitly to a string view of their characters.
+            The view is sized by the string's length, so substrings (which
+            are not NULL-terminated) view correctly.
+        - Construction from a std::string_view copies exactly the viewed
+            characters, and never scans them for a NULL byte.  Without
+            C-string compatibility, the characters are decoded from UTF-8.
+        - Functions that create a string object throw std::bad_alloc if it
+            can not be allocated, std::length_error if the characters can
+            not be stored in one string, and std::out_of_range if a
+            substring is not within its source.  Other functions return
+            the library's result codes.
+        - With C-string compatibility, strings concatenate with the +
+            operator.  The operands of a chain (strings, string views,
+            string literals, characters and integers) are collected into
+            an expression, and nothing is copied until it is stored.  The
+            total length is found first, the target's allocation is checked
+            once, and each operand is copied (or formatted) directly into
+            place.  Storing an expression that reads the target's own
+            characters assembles it in a new string object instead.
+            Character arrays (string literals, or buffers) are copied up
+            to their first NULL, and never past their last element.  Their
+            encoding is checked once, when the expression is made.
+        - With C-string compatibility, the _hz literal (in the namespace
+            hzstr::literals) makes a constant string object when the program
+            is built.  Its length, hash and encoding are computed by the
+            compiler, so a constexpr object is placed in read-only data and
+            costs nothing at startup.  hzstr::hash() computes the same hash
+            at compile time for other uses (e.g. case labels).
+        - Requires C++17.
+
+    Example Usage
+
+        hzstr::string path( std::string_view( "/usr/local/bin" ) );
+        hzstr::string name = path.substr( 11, 3 );
+        std::string_view view = name;
+        hzstr::string url = path + "/" + name + "?id=" + 42;
+
+        using namespace hzstr::literals;
+        static constexpr hzstr_type bin = "bin"_hz;
+        bool same = hzstr_equal( &bin, name.get() );
+
+*****************************************************************************/
+
+#ifndef _HZSTR_HPP
+#define _HZSTR_HPP
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+namespace hzstr {
+
+class string;
+
+#ifdef HZSTR_COMPAT_CSTR
+
+namespace detail {
+
+//encoding flags that describe a string's characters
+const hzstr_flags_t text_flags = HZSTR_FLG_ASCII | HZSTR_FLG_UTF8;
+
+constexpr hzstr_flags_t encoding(   //check the encoding of characters
+    std::string_view    text        //characters to check
+) noexcept;                         //encoding flags
+
+struct character {                  //operand: a single character
+    char                c;          //the character
+
+    /*======================================================================*/
+    hzstr_flags_t flags(            //what is known about the encoding
+    ) const noexcept {
+        return ( ( c & 0x80 ) == 0 ? text_flags : 0 );
+    }
+
+    /*======================================================================*/
+    bool overlaps(                  //check for characters in a range
+        const char*,                //beginning of range
+        const char*                 //end of range
+    ) const noexcept {
+        return false;
+    }
+
+    /*======================================================================*/
+    unsigned long size(             //number of characters
+    ) const noexcept {
+        return 1;
+    }
+
+    /*======================================================================*/
+    char* write(                    //copy the characters into place
+        char*           output      //where to copy the characters
+    ) const noexcept {
+        *output = c;
+        return output + 1;
+    }
+};
+
+class integer {                     //operand: an integer formatted in base 10
+
+public:
+
+    /*======================================================================*/
+    template< typename T >
+    explicit integer(               //measure an integer's formatted length
+        T               value       //integer to format
+    ) noexcept : magnitude_( value < 0
+        ? ( 0ULL - static_cast< unsigned long long >( value ) )
+        : static_cast< unsigned long long >( value ) ),
+        length_( value < 0 ? 2 : 1 ),
+        negative_( value < 0 ) {
+
+        //local variables
+        unsigned long long rest;    //digits not yet counted
+
+        for( rest = magnitude_ / 10; rest != 0; rest /= 10 ) {
+            length_ += 1;
+        }
+    }
+
+    /*======================================================================*/
+    hzstr_flags_t flags(            //what is known about the encoding
+    ) const noexcept {
+        return text_flags;
+    }
+
+    /*======================================================================*/
+    bool overlaps(                  //check for characters in a range
+        const char*,                //beginning of range
+        const char*                 //end of range
+    ) const noexcept {
+        return false;
+    }
+
+    /*======================================================================*/
+    unsigned long size(             //number of characters
+    ) const noexcept {
+        return length_;
+    }
+
+    /*======================================================================*/
+    char* write(                    //format the integer into place
+        char*           output      //where to write the characters
+    ) const noexcept {
+
+        //local variables
+        char*           digit;      //position of the next digit
+        unsigned long long rest;    //digits not yet written
+
+        //the digits are written from the last one back
+        if( negative_ ) {
+            *output = '-';
+        }
+        digit = output + length_;
+        rest  = magnitude_;
+        do {
+            digit -= 1;
+            *digit = static_cast< char >( '0' + ( rest % 10 ) );
+            rest  /= 10;
+        } while( rest != 0 );
+        return output + length_;
+    }
+
+private:
+
+    unsigned long long  magnitude_; //absolute value of the integer
+    unsigned char       length_;    //number of characters (with any sign)
+    bool                negative_;  //the integer is less than zero
+};
+
+template< std::size_t N >
+class literal {                     //operand: a character array
+
+public:
+
+    /*======================================================================*/
+    explicit literal(               //measure and check a character array
+        const char      ( &data )[ N ]
+                                    //string literal (or buffer)
+    ) noexcept : data_( data ), length_( strnlen( data, ( N - 1 ) ) ),
+        flags_( encoding( std::string_view( data_, length_ ) ) ) {
+    }
+
+    /*======================================================================*/
+    hzstr_flags_t flags(            //what is known about the encoding
+    ) const noexcept {
+        return flags_;
+    }
+
+    /*======================================================================*/
+    bool overlaps(                  //check for characters in a range
+        const char*,                //beginning of range
+        const char*                 //end of range
+    ) const noexcept {
+        return false;
+    }
+
+    /*======================================================================*/
+    unsigned long size(             //number of characters (without NULL)
+    ) const noexcept {
+        return length_;
+    }
+
+    /*======================================================================*/
+    char* write(                    //copy the characters into place
+        char*           output      //where to copy the characters
+    ) const noexcept {
+        std::memcpy( output, data_, length_ );
+        return output + length_;
+    }
+
+private:
+
+    const char*         data_;      //characters of the array
+    std::size_t         length_;    //characters before the first NULL
+    hzstr_flags_t       flags_;     //what is known about the encoding
+};
+
+struct text {                       //operand: characters of known length
+    const char*         data;       //first character
+    unsigned long       length;     //number of characters
+    hzstr_flags_t       known;      //what is known about the encoding
+
+    /*======================================================================*/
+    hzstr_flags_t flags(            //what is known about the encoding
+    ) const noexcept {
+        return known;
+    }
+
+    /*======================================================================*/
+    bool overlaps(                  //check for characters in a range
+        const char*     begin,      //beginning of range
+        const char*     end         //end of range
+    ) const noexcept {
+        return ( length > 0 )
+            && ( data < end ) && ( begin < ( data + length ) );
+    }
+
+    /*======================================================================*/
+    unsigned long size(             //number of characters
+    ) const noexcept {
+        return length;
+    }
+
+    /*======================================================================*/
+    char* write(                    //copy the characters into place
+        char*           output      //where to copy the characters
+    ) const noexcept {
+        if( length > 0 ) {
+            std::memcpy( output, data, length );
+        }
+        return output + length;
+    }
+};
+
+} //namespace detail
+
+template< typename L, typename R >
+class concat {                      //concatenation of two operands
+
+public:
+
+    /*======================================================================*/
+    concat(                         //join two operands
+        const L&        left,       //first operand
+        const R&        right       //second operand
+    ) noexcept : left_( left ), right_( right ) {
+    }
+
+    /*======================================================================*/
+    hzstr_flags_t flags(            //what is known about the encoding
+    ) const noexcept {
+        return left_.flags() & right_.flags();
+    }
+
+    /*======================================================================*/
+    bool overlaps(                  //check for characters in a range
+        const char*     begin,      //beginning of range
+        const char*     end         //end of range
+    ) const noexcept {
+        return left_.overlaps( begin, end ) || right_.overlaps( begin, end );
+    }
+
+    /*======================================================================*/
+    unsigned long size(             //number of characters
+    ) const noexcept {
+        return left_.size() + right_.size();
+    }
+
+    /*======================================================================*/
+    char* write(                    //copy the characters into place
+        char*           output      //where to copy the characters
+    ) const noexcept {
+        return right_.write( left_.write( output ) );
+    }
+
+private:
+
+    L                   left_;      //first operand
+    R                   right_;     //second operand
+};
+
+namespace detail {
+
+/*==========================================================================*/
+template< typename L, typename R >
+inline const concat< L, R >& make_operand(
+                                    //use a concatenation as an operand
+    const concat< L, R >& expr      //concatenation
+) noexcept {
+    return expr;
+}
+
+/*==========================================================================*/
+template< std::size_t N >
+inline literal< N > make_operand(   //use a character array as an operand
+    const char          ( &data )[ N ]
+                                    //string literal (or buffer)
+) noexcept {
+    return literal< N >( data );
+}
+
+/*==========================================================================*/
+inline character make_operand(      //use a character as an operand
+    char                c           //character
+) noexcept {
+    return character{ c };
+}
+
+/*==========================================================================*/
+template<
+    typename T,
+    typename = std::enable_if_t<
+        std::is_integral_v< T >
+     && !std::is_same_v< T, bool >
+     && !std::is_same_v< T, char >
+    >
+>
+inline integer make_operand(        //use an integer as an operand
+    T                   value       //integer
+) noexcept {
+    return integer( value );
+}
+
+/*==========================================================================*/
+inline text make_operand(           //use a string view as an operand
+    std::string_view    view        //view of characters
+) noexcept {
+    return text{ view.data(), view.size(), 0 };
+}
+
+inline text make_operand(           //use a string as an operand
+    const string&       operand     //string
+) noexcept;
+
+//the operand type used for a value
+template< typename T >
+using operand_t = std::decay_t<
+    decltype( make_operand( std::declval< const T& >() ) )
+>;
+
+//strings and concatenations start an expression
+template< typename T >
+struct is_expression : std::false_type {};
+
+template<>
+struct is_expression< string > : std::true_type {};
+
+template< typename L, typename R >
+struct is_expression< concat< L, R > > : std::true_type {};
+
+} //namespace detail
+
+#endif
+
+class string {                      //owner of one string object
+
+public:
+
+    typedef hzstr_char_t value_type;//character type
+
+    typedef std::basic_string_view< hzstr_char_t > view_type;
+                                    //view of a string's characters
+
+    /*======================================================================*/
+    string(                         //create an empty string
+    ) noexcept : string_( nullptr ) {
+    }
+
+    /*======================================================================*/
+    explicit string(                //take ownership of a string object
+        hzstr_type*     object      //string object (destroyed by this)
+    ) noexcept : string_( object ) {
+    }
+
+    /*======================================================================*/
+    explicit string(                //create a string from known-length text
+        std::string_view text       //characters to copy
+    ) : string_( nullptr ) {
+
+        //the length must be representable
+        if( text.size() > std::numeric_limits< hzstr_length_t >::max() ) {
+            throw std::length_error( "hzstr::string" );
+        }
+
+        //copy exactly the viewed characters (a view may have no data)
+        string_ = hzstr_create_cstr_n(
+            ( text.data() != nullptr ? text.data() : "" ),
+            static_cast< hzstr_length_t >( text.size() )
+        );
+        if( string_ == nullptr ) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /*======================================================================*/
+    string(                         //move a string
+        string&&        other       //string to take the object from
+    ) noexcept : string_( other.string_ ) {
+        other.string_ = nullptr;
+    }
+
+    string( const string& ) = delete;
+
+    /*======================================================================*/
+    ~string(                        //destroy the string object
+    ) {
+        hzstr_destroy( string_ );
+    }
+
+    /*======================================================================*/
+    string& operator=(              //move a string
+        string&&        other       //string to take the object from
+    ) noexcept {
+        if( this != &other ) {
+            hzstr_destroy( string_ );
+            string_       = other.string_;
+            other.string_ = nullptr;
+        }
+        return *this;
+    }
+
+    string& operator=( const string& ) = delete;
+
+#ifdef HZSTR_COMPAT_CSTR
+
+    /*======================================================================*/
+    template< typename L, typename R >
+    string(                         //store a concatenation in a new string
+        const concat< L, R >& expr  //concatenation to store
+    ) : string_( nullptr ) {
+        assemble( expr, 0 );
+    }
+
+    /*======================================================================*/
+    template< typename L, typename R >
+    string& operator=(              //replace the string with a concatenation
+        const concat< L, R >& expr  //concatenation to store
+    ) {
+        assemble( expr, 0 );
+        return *this;
+    }
+
+    /*======================================================================*/
+    template< typename T >
+    string& operator+=(             //append an operand or concatenation
+        const T&        operand     //operand to append
+    ) {
+        assemble( detail::make_operand( operand ), length() );
+        return *this;
+    }
+
+#endif
+
+    /*======================================================================*/
+    operator view_type(             //view the string's characters
+    ) const noexcept {
+        return view();
+    }
+
+    /*======================================================================*/
+    string clone(                   //copy into a new dynamic string
+    ) const {
+
+        //local variables
+        hzstr_type*     copy;       //new string object
+
+        //an empty string has nothing to copy
+        if( string_ == nullptr ) {
+            return string();
+        }
+
+        //allocate the exact length, and copy the characters
+        copy = hzstr_create( string_->length );
+        if( ( copy == nullptr ) || ( hzstr_cpy( copy, string_ ) < 0 ) ) {
+            hzstr_destroy( copy );
+            throw std::bad_alloc();
+        }
+        return string( copy );
+    }
+
+    /*======================================================================*/
+    const hzstr_char_t* data(       //access the string's characters
+    ) const noexcept {
+        return ( string_ != nullptr ? string_->data : nullptr );
+    }
+
+    /*======================================================================*/
+    bool empty(                     //check for zero characters
+    ) const noexcept {
+        return length() == 0;
+    }
+
+    /*======================================================================*/
+    hzstr_type* get(                //access the string object
+    ) const noexcept {
+        return string_;
+    }
+
+    /*======================================================================*/
+    hzstr_hash_t hash(              //hash the string's characters
+    ) const noexcept {
+        return ( string_ != nullptr ? hzstr_hash( string_ )
+                                    : HZSTR_HASH_BASIS );
+    }
+
+    /*======================================================================*/
+    hzstr_length_t length(          //count the string's characters
+    ) const noexcept {
+        return ( string_ != nullptr ? string_->length : 0 );
+    }
+
+    /*======================================================================*/
+    hzstr_type* release(            //give up ownership of the string object
+    ) noexcept {
+
+        //local variables
+        hzstr_type*     object;     //released string object
+
+        object  = string_;
+        string_ = nullptr;
+        return object;
+    }
+
+    /*======================================================================*/
+    void reset(                     //replace the owned string object
+        hzstr_type*     object = nullptr
+                                    //new string object (destroyed by this)
+    ) noexcept {
+        if( object != string_ ) {
+            hzstr_destroy( string_ );
+            string_ = object;
+        }
+    }
+
+    /*======================================================================*/
+    string substr(                  //create a substring of this string
+        hzstr_index_t   offset,     //beginning offset in string
+        hzstr_length_t  count       //length of substring
+    ) const {
+
+        //local variables
+        hzstr_type*     object;     //new substring object
+
+        //the substring must be within this string
+        if( ( offset < 0 ) || ( offset > length() )
+         || ( count > ( length() - offset ) ) ) {
+            throw std::out_of_range( "hzstr::string::substr" );
+        }
+
+        //an empty substring does not need a string object
+        if( count == 0 ) {
+            return string();
+        }
+
+        //the substring refers to this string's characters
+        object = hzstr_create_substr( string_, offset, count );
+        if( object == nullptr ) {
+            throw std::bad_alloc();
+        }
+        return string( object );
+    }
+
+    /*======================================================================*/
+    view_type view(                 //view the string's characters
+    ) const noexcept {
+        return view_type( data(), length() );
+    }
+
+private:
+
+#ifdef HZSTR_COMPAT_CSTR
+
+    /*======================================================================*/
+    template< typename E >
+    void assemble(                  //store an expression after some characters
+        const E&        expr,       //expression to store
+        hzstr_length_t  keep        //number of current characters to keep
+    ) {
+
+        //local variables
+        const char*     base;       //beginning of this string's allocation
+        hzstr_flags_t   known;      //what is known about the kept characters
+        hzstr_type*     target;     //string object to assemble into
+        unsigned long   total;      //length of the assembled string
+
+        //the assembled string (and its NULL) must fit in one string
+        total = keep + expr.size();
+        if( total >= std::numeric_limits< hzstr_length_t >::max() ) {
+            throw std::length_error( "hzstr::string" );
+        }
+        known = ( keep > 0 ? ( string_->flags & detail::text_flags )
+                           : detail::text_flags );
+
+        //assemble in place, unless this string can not grow, or the
+        //  expression reads characters that growing could move
+        target = string_;
+        if( ( target != nullptr ) && ( target->type == HZSTR_TYPE_DYNAMIC ) ) {
+            base = target->data - target->offset;
+            if( expr.overlaps( base, ( base + target->alloc ) ) ) {
+                target = nullptr;
+            }
+        }
+        else {
+            target = nullptr;
+        }
+
+        //a new string object is allocated once for the total length
+        if( target == nullptr ) {
+            target = hzstr_create( static_cast< hzstr_length_t >( total ) );
+            if( target == nullptr ) {
+                throw std::bad_alloc();
+            }
+            if( keep > 0 ) {
+                std::memcpy( target->data, data(), keep );
+            }
+        }
+
+        //otherwise, the existing allocation is checked once (and the
+        //  string is unchanged if it can not grow)
+        else {
+            if( hzstr_reserve(
+                target, static_cast< hzstr_length_t >( total )
+            ) < 0 ) {
+                throw std::bad_alloc();
+            }
+            if( keep == 0 ) {
+                hzstr_consume( target, target->length );
+            }
+        }
+
+        //copy (or format) each operand into place
+        expr.write( target->data + keep );
+        target->length = static_cast< hzstr_length_t >( total );
+        target->data[ total ] = '\0';
+        target->flags = ( target->flags & ~detail::text_flags )
+                      | ( known & expr.flags() );
+
+        //replace this string's object if a new one was assembled
+        if( target != string_ ) {
+            reset( target );
+        }
+    }
+
+#endif
+
+    hzstr_type*         string_;    //owned string object (may be nullptr)
+};
+
+#ifdef HZSTR_COMPAT_CSTR
+
+/*==========================================================================*/
+inline detail::text detail::make_operand(
+                                    //use a string as an operand
+    const string&       operand     //string
+) noexcept {
+    return text{
+        operand.data(),
+        operand.length(),
+        static_cast< hzstr_flags_t >( operand.get() != nullptr
+            ? ( operand.get()->flags & text_flags )
+            : text_flags )
+    };
+}
+
+/*==========================================================================*/
+template<
+    typename L,
+    typename R,
+    typename = std::enable_if_t<
+        detail::is_expression< L >::value
+     || detail::is_expression< R >::value
+    >
+>
+inline concat< detail::operand_t< L >, detail::operand_t< R > > operator+(
+                                    //concatenate two operands
+    const L&            left,       //first operand
+    const R&            right       //second operand
+) noexcept {
+    return concat< detail::operand_t< L >, detail::operand_t< R > >(
+        detail::make_operand( left ),
+        detail::make_operand( right )
+    );
+}
+
+namespace detail {
+
+/*==========================================================================*/
+constexpr hzstr_flags_t encoding(   //check the encoding of characters
+    std::string_view    text        //characters to check
+) noexcept {                        //encoding flags
+
+    //local variables (initialized, as constexpr requires)
+    unsigned long       code   = 0; //code point of a sequence
+    unsigned long       least  = 0; //smallest code point for its length
+    hzstr_flags_t       flags  = text_flags;
+                                    //what is known so far
+    std::size_t         follow = 0; //continuation bytes in a sequence
+    std::size_t         index  = 0; //continuation byte index
+    std::size_t         pos    = 0; //position index
+
+    for( pos = 0; pos < text.size(); pos += follow + 1 ) {
+
+        //ASCII characters keep what is known
+        code   = static_cast< unsigned char >( text[ pos ] );
+        follow = 0;
+        if( code < 0x80 ) {
+            continue;
+        }
+        flags = HZSTR_FLG_UTF8;
+
+        //the lead byte gives the sequence length
+        if( ( code & 0xE0 ) == 0xC0 ) {
+            follow = 1;
+            code  &= 0x1F;
+            least  = 0x80;
+        }
+        else if( ( code & 0xF0 ) == 0xE0 ) {
+            follow = 2;
+            code  &= 0x0F;
+            least  = 0x800;
+        }
+        else if( ( code & 0xF8 ) == 0xF0 ) {
+            follow = 3;
+            code  &= 0x07;
+            least  = 0x10000;
+        }
+        else {
+            return 0;
+        }
+        if( follow >= ( text.size() - pos ) ) {
+            return 0;
+        }
+
+        //each continuation byte adds six bits
+        for( index = 1; index <= follow; ++index ) {
+            if( ( text[ pos + index ] & 0xC0 ) != 0x80 ) {
+                return 0;
+            }
+            code = ( code << 6 ) | ( text[ pos + index ] & 0x3F );
+        }
+
+        //reject overlong encodings, surrogates, and values out of range
+        if( ( code < least ) || ( code > 0x10FFFF )
+         || ( ( code >= 0xD800 ) && ( code <= 0xDFFF ) ) ) {
+            return 0;
+        }
+    }
+    return flags;
+}
+
+} //namespace detail
+
+/*==========================================================================*/
+constexpr hzstr_hash_t hash(        //hash characters (same as hzstr_hash())
+    std::string_view    text        //characters to hash
+) noexcept {                        //32-bit FNV-1a hash
+
+    //local variables (initialized, as constexpr requires)
+    hzstr_hash_t        value = HZSTR_HASH_BASIS;
+                                    //hash of the characters so far
+
+    for( char c : text ) {
+        value ^= static_cast< unsigned char >( c );
+        value *= HZSTR_HASH_PRIME;
+    }
+    return value;
+}
+
+namespace literals {
+
+/*==========================================================================*/
+constexpr hzstr_type operator""_hz( //make a constant string object
+    const char*         literal,    //string literal
+    std::size_t         size        //number of characters in the literal
+) {                                 //string object referring to the literal
+
+    //the length must be representable (a compile error when constexpr)
+    if( size >= std::numeric_limits< hzstr_length_t >::max() ) {
+        throw std::length_error( "hzstr literal" );
+    }
+
+    return hzstr_type{
+        static_cast< hzstr_type_t >( HZSTR_TYPE_CONST ),
+        static_cast< hzstr_flags_t >(
+            HZSTR_FLG_STATIC | HZSTR_FLG_HASHED
+          | detail::encoding( std::string_view( literal, size ) )
+        ),
+        0,
+        static_cast< hzstr_length_t >( size ),
+        0,
+        hash( std::string_view( literal, size ) ),
+        const_cast< hzstr_char_t* >( literal )
+    };
+}
+
+} //namespace literals
+
+#endif
+
+} //namespace hzstr
+
+#endif /* _HZSTR_HPP */
@@ -0,0 +1,419 @@
+/*****************************************************************************
+    hztrace.h
+    Zac Hester
+    2026-10-19
+
+    Call-trace recorder for Hz strings.  A trace records the string
+    operations an application makes (the operation, the strings involved,
+    and its lengths and offsets) as fixed-size binary records.  Replaying
+    a trace against other builds of the library (bench/replay) measures
+    them against the application's own mix of operations and lengths.
+
+    Interface Notes:
+        - The recorder interposes on the library the same way memory.h
+            provides the mem_* interface.  In translation units that
+            include this header (after hzstr.h) and are built with the
+            HZSTR_TRACE symbol defined, calls to the traced functions are
+            routed to the hzstr_trace_* functions, which record each call
+            and then call the library.  The library itself is not changed.
+        - Calls are only recorded between hzstr_trace_start() and
+            hzstr_trace_stop().  Records from every thread are written to
+            the same trace (in the order they are recorded).
+        - Strings are identified by their addresses.  A replay maps each
+            address to the string created at that address most recently.
+        - Characters are not recorded, only lengths.  Offsets are recorded
+            in 16 bits (enough for any valid offset).
+        - Every function that creates, changes, compares or searches a
+            string is recorded.  The accessor macros (hzstr_length() and
+            the like), the code point functions (hzstr_cp_*),
+            hzstr_shrink_policy() and the statistics, latency and profile
+            functions are not.
+        - hzstr_sprintf() is recorded with the length it printed, so a
+            replay prints a string of that length.
+        - hzstr_import() and hzstr_import_utf8() are recorded with the
+            length of their source (up to their length limit), not the
+            limit itself.
+        - hzstr_replace_all() is recorded with the needle as its source
+            string and the length of the replacement.
+        - hzstr_compact_all() is recorded as one record for each string it
+            is given.
+
+    Example Usage
+
+        #include "hzstr.h"
+        #include "hztrace.h"
+
+        hzstr_trace_start( "requests.hzt" );
+        handle_requests();
+        hzstr_trace_stop();
+
+*****************************************************************************/
+
+#ifndef _HZTRACE_H
+#define _HZTRACE_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//trace file identification
+#define HZSTR_TRACE_MAGIC "HZTRACE"  //first bytes of a trace (with the NULL)
+#define HZSTR_TRACE_VERSION ( 2 )   //version of the record format
+
+//route calls to the recorder (the recorder itself calls the library)
+#if defined( HZSTR_TRACE ) && !defined( HZSTR_TRACE_RECORDER )
+
+#undef hzstr_append
+#undef hzstr_cat
+#undef hzstr_create
+#undef hzstr_create_ccstr
+#undef hzstr_create_cstr
+#undef hzstr_create_cstr_n
+#undef hzstr_create_substr
+
+#define hzstr_append            hzstr_trace_append
+#define hzstr_casecmp           hzstr_trace_casecmp
+#define hzstr_cat               hzstr_trace_cat
+#define hzstr_cat_cstr          hzstr_trace_cat_cstr
+#define hzstr_cat_cstr_n        hzstr_trace_cat_cstr_n
+#define hzstr_cmp               hzstr_trace_cmp
+#define hzstr_compact_all       hzstr_trace_compact_all
+#define hzstr_consume           hzstr_trace_consume
+#define hzstr_cpy               hzstr_trace_cpy
+#define hzstr_cpy_cstr          hzstr_trace_cpy_cstr
+#define hzstr_cpy_cstr_n        hzstr_trace_cpy_cstr_n
+#define hzstr_create            hzstr_trace_create
+#define hzstr_create_ccstr      hzstr_trace_create_ccstr
+#define hzstr_create_cstr       hzstr_trace_create_cstr
+#define hzstr_create_cstr_n     hzstr_trace_create_cstr_n
+#define hzstr_create_substr     hzstr_trace_create_substr
+#define hzstr_destroy           hzstr_trace_destroy
+#define hzstr_equal             hzstr_trace_equal
+#define hzstr_erase             hzstr_trace_erase
+#define hzstr_export_utf8       hzstr_trace_export_utf8
+#define hzstr_fold              hzstr_trace_fold
+#define hzstr_hash              hzstr_trace_hash
+#define hzstr_import            hzstr_trace_import
+#define hzstr_import_utf8       hzstr_trace_import_utf8
+#define hzstr_insert            hzstr_trace_insert
+#define hzstr_minimize          hzstr_trace_minimize
+#define hzstr_replace_all       hzstr_trace_replace_all
+#define hzstr_reserve           hzstr_trace_reserve
+#define hzstr_splice            hzstr_trace_splice
+#define hzstr_sprintf           hzstr_trace_sprintf
+#define hzstr_squeeze           hzstr_trace_squeeze
+#define hzstr_strchr            hzstr_trace_strchr
+#define hzstr_tolower           hzstr_trace_tolower
+#define hzstr_toupper           hzstr_trace_toupper
+#define hzstr_trim              hzstr_trace_trim
+#define hzstr_trim_left         hzstr_trace_trim_left
+#define hzstr_trim_right        hzstr_trace_trim_right
+#define hzstr_validate          hzstr_trace_validate
+
+#endif
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+enum {                              //traced operations
+    HZSTR_TRACE_APPEND,
+    HZSTR_TRACE_CASECMP,
+    HZSTR_TRACE_CAT,
+    HZSTR_TRACE_CAT_CSTR,
+    HZSTR_TRACE_CAT_CSTR_N,
+    HZSTR_TRACE_CMP,
+    HZSTR_TRACE_COMPACT_ALL,
+    HZSTR_TRACE_CONSUME,
+    HZSTR_TRACE_CPY,
+    HZSTR_TRACE_CPY_CSTR,
+    HZSTR_TRACE_CPY_CSTR_N,
+    HZSTR_TRACE_CREATE,
+    HZSTR_TRACE_CREATE_CCSTR,
+    HZSTR_TRACE_CREATE_CSTR,
+    HZSTR_TRACE_CREATE_CSTR_N,
+    HZSTR_TRACE_CREATE_SUBSTR,
+    HZSTR_TRACE_DESTROY,
+    HZSTR_TRACE_EQUAL,
+    HZSTR_TRACE_ERASE,
+    HZSTR_TRACE_EXPORT_UTF8,
+    HZSTR_TRACE_FOLD,
+    HZSTR_TRACE_HASH,
+    HZSTR_TRACE_IMPORT,
+    HZSTR_TRACE_IMPORT_UTF8,
+    HZSTR_TRACE_INSERT,
+    HZSTR_TRACE_MINIMIZE,
+    HZSTR_TRACE_REPLACE_ALL,
+    HZSTR_TRACE_RESERVE,
+    HZSTR_TRACE_SPLICE,
+    HZSTR_TRACE_SPRINTF,
+    HZSTR_TRACE_SQUEEZE,
+    HZSTR_TRACE_STRCHR,
+    HZSTR_TRACE_TOLOWER,
+    HZSTR_TRACE_TOUPPER,
+    HZSTR_TRACE_TRIM,
+    HZSTR_TRACE_TRIM_LEFT,
+    HZSTR_TRACE_TRIM_RIGHT,
+    HZSTR_TRACE_VALIDATE,
+
+    HZSTR_NUM_TRACES                //number of traced operations
+};
+
+typedef struct hzstr_trace_header_s {
+                                    //first bytes of a trace file
+    char                magic[ 8 ]; //HZSTR_TRACE_MAGIC
+    uint32_t            version;    //HZSTR_TRACE_VERSION
+    uint32_t            char_size;  //size of the recorded build's characters
+} hzstr_trace_header_type;
+
+typedef struct hzstr_trace_record_s {
+                                    //one recorded call
+    uint64_t            target;     //string operated on (or created)
+    uint64_t            source;     //source string (0 if none)
+    uint32_t            length;     //length argument (C-string or printed)
+    uint16_t            offset;     //offset argument
+    uint8_t             operation;  //operation called (HZSTR_TRACE_*)
+    uint8_t             reserved;   //always 0
+} hzstr_trace_record_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+hzstr_trace_record_type* hzstr_trace_load(
+                                    //read every record of a trace file
+    const char*         path,       //trace file to read
+    unsigned long*      count       //number of records read
+);                                  //records (NULL if the trace is invalid)
+
+hzstr_result_t hzstr_trace_start(   //start recording calls into a trace
+    const char*         path        //trace file to write
+);                                  //result of operation
+
+hzstr_result_t hzstr_trace_stop(    //stop recording, and close the trace
+    void
+);                                  //number of records written (or error)
+
+void hzstr_trace_unload(            //release the records of a loaded trace
+    hzstr_trace_record_type* records//records from hzstr_trace_load()
+);
+
+//recorded equivalents of the library functions (see hzstr.h)
+
+hzstr_result_t hzstr_trace_append(
+    hzstr_type*         string,
+    hzstr_char_t        c
+);
+
+#ifdef HZSTR_COMPAT_CSTR
+long hzstr_trace_casecmp(
+    const hzstr_type*   string0,
+    const hzstr_type*   string1
+);
+#endif
+
+hzstr_result_t hzstr_trace_cat(
+    hzstr_type*         target,
+    const hzstr_type*   source
+);
+
+hzstr_result_t hzstr_trace_cat_cstr(
+    hzstr_type*         target,
+    const char*         source
+);
+
+hzstr_result_t hzstr_trace_cat_cstr_n(
+    hzstr_type*         target,
+    const char*         source,
+    hzstr_length_t      length
+);
+
+long hzstr_trace_cmp(
+    const hzstr_type*   string0,
+    const hzstr_type*   string1
+);
+
+hzstr_result_t hzstr_trace_compact_all(
+    hzstr_type**        strings,
+    int                 count
+);
+
+hzstr_result_t hzstr_trace_consume(
+    hzstr_type*         string,
+    hzstr_length_t      length
+);
+
+hzstr_result_t hzstr_trace_cpy(
+    hzstr_type*         target,
+    const hzstr_type*   source
+);
+
+hzstr_result_t hzstr_trace_cpy_cstr(
+    hzstr_type*         target,
+    const char*         source
+);
+
+hzstr_result_t hzstr_trace_cpy_cstr_n(
+    hzstr_type*         target,
+    const char*         source,
+    hzstr_length_t      length
+);
+
+hzstr_type* hzstr_trace_create(
+    hzstr_length_t      length
+);
+
+#ifdef HZSTR_COMPAT_CSTR
+hzstr_type* hzstr_trace_create_ccstr(
+    const char*         cstring
+);
+#endif
+
+hzstr_type* hzstr_trace_create_cstr(
+    const char*         cstring
+);
+
+hzstr_type* hzstr_trace_create_cstr_n(
+    const char*         cstring,
+    hzstr_length_t      length
+);
+
+hzstr_type* hzstr_trace_create_substr(
+    const hzstr_type*   source,
+    hzstr_index_t       offset,
+    hzstr_length_t      length
+);
+
+void hzstr_trace_destroy(
+    hzstr_type*         string
+);
+
+int hzstr_trace_equal(
+    const hzstr_type*   string0,
+    const hzstr_type*   string1
+);
+
+hzstr_result_t hzstr_trace_erase(
+    hzstr_type*         target,
+    hzstr_index_t       offset,
+    hzstr_length_t      length
+);
+
+hzstr_result_t hzstr_trace_export_utf8(
+    const hzstr_type*   string,
+    char*               output,
+    unsigned long       size
+);
+
+#ifdef HZSTR_COMPAT_CSTR
+hzstr_result_t hzstr_trace_fold(
+    hzstr_type*         string
+);
+#endif
+
+hzstr_hash_t hzstr_trace_hash(
+    const hzstr_type*   string
+);
+
+hzstr_result_t hzstr_trace_import(
+    hzstr_type*         string,
+    const char*         source,
+    hzstr_length_t      length
+);
+
+hzstr_result_t hzstr_trace_import_utf8(
+    hzstr_type*         string,
+    const char*         source,
+    hzstr_length_t      length
+);
+
+hzstr_result_t hzstr_trace_insert(
+    hzstr_type*         target,
+    hzstr_index_t       offset,
+    const hzstr_type*   source
+);
+
+hzstr_result_t hzstr_trace_minimize(
+    hzstr_type*         string
+);
+
+hzstr_result_t hzstr_trace_replace_all(
+    hzstr_type*         target,
+    const hzstr_type*   needle,
+    const hzstr_type*   replacement
+);
+
+hzstr_result_t hzstr_trace_reserve(
+    hzstr_type*         string,
+    hzstr_length_t      length
+);
+
+hzstr_result_t hzstr_trace_splice(
+    hzstr_type*         target,
+    hzstr_index_t       offset,
+    hzstr_length_t      length,
+    const hzstr_type*   source
+);
+
+#ifdef HZSTR_COMPAT_CSTR
+hzstr_result_t hzstr_trace_sprintf(
+    hzstr_type*         string,
+    const char*         format,
+    ...
+);
+#endif
+
+hzstr_result_t hzstr_trace_squeeze(
+    hzstr_type*         string
+);
+
+hzstr_index_t hzstr_trace_strchr(
+    const hzstr_type*   string,
+    hzstr_char_t        c
+);
+
+hzstr_result_t hzstr_trace_tolower(
+    hzstr_type*         string
+);
+
+hzstr_result_t hzstr_trace_toupper(
+    hzstr_type*         string
+);
+
+hzstr_result_t hzstr_trace_trim(
+    hzstr_type*         string
+);
+
+hzstr_result_t hzstr_trace_trim_left(
+    hzstr_type*         string
+);
+
+hzstr_result_t hzstr_trace_trim_right(
+    hzstr_type*         string
+);
+
+hzstr_result_t hzstr_trace_validate(
+    hzstr_type*         string
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HZTRACE_H */
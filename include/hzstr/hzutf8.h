@@ -0,0 +1,166 @@
+/*****************************************************************************
+    hzutf8.h
+    Zac Hester
+    2026-10-19
+
+    UTF-8 encoding support for Hz strings.
+
+    These functions work on raw character data, and are used by the string
+    module to record what is known about a string's encoding.
+
+    Interface Notes:
+        - hzstr_utf8_check() reports its findings as the string flags
+            HZSTR_FLG_ASCII and HZSTR_FLG_UTF8.  Valid UTF-8 excludes
+            overlong forms, surrogate code points (U+D800 - U+DFFF), and
+            code points above U+10FFFF.
+        - On x86 targets built with gcc or clang, the check uses a vector
+            lookup-table validator when the processor supports SSSE3.
+            Otherwise, blocks of ASCII are skipped with SSE2, and other
+            characters are checked one sequence at a time.  Defining the
+            HZSTR_DSBL_SIMD symbol forces the portable check.
+        - Case folding uses the simple case folding of the Unicode standard,
+            so every code point folds to exactly one code point.  The folded
+            text may be a different number of bytes than the original.  The
+            tables are generated by build/python/gen_fold.py.
+        - Bytes that are not part of a valid sequence are never folded, and
+            compare greater than any code point.  Code point counts and
+            offsets count every byte that is not a continuation byte.
+        - The transcoders convert between UTF-8 and UTF-16 or UTF-32 in
+            the host's byte order.  Each *_size() function returns the exact
+            number of output units, so the output can be allocated once.
+            Anything that is not a valid sequence (including an unpaired
+            surrogate) is converted to U+FFFD, one for each invalid byte or
+            unit.  Runs of ASCII are widened and narrowed with SSE2.
+
+    Example Usage
+
+        flags = hzstr_utf8_check( buffer, length );
+        if( ( flags & HZSTR_FLG_UTF8 ) == 0 ) {
+            //reject the buffer
+        }
+
+*****************************************************************************/
+
+#ifndef _HZUTF8_H
+#define _HZUTF8_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+long hzstr_utf8_casecmp(            //compare text ignoring case
+    const char*         data0,      //first text
+    unsigned long       length0,    //number of bytes in first text
+    const char*         data1,      //second text
+    unsigned long       length1     //number of bytes in second text
+);                                  //comparison value (0 means equal)
+
+hzstr_flags_t hzstr_utf8_check(     //check the encoding of character data
+    const char*         data,       //character data to check
+    unsigned long       length      //number of bytes to check
+);                                  //encoding flags (0 if invalid UTF-8)
+
+unsigned long hzstr_utf8_count(     //count the code points in text
+    const char*         data,       //text to count
+    unsigned long       length      //number of bytes in text
+);                                  //number of code points
+
+unsigned long hzstr_utf8_fold(      //fold the case of text
+    char*               output,     //folded text (may be data if in-place)
+    const char*         data,       //text to fold
+    unsigned long       length      //number of bytes in text
+);                                  //number of bytes written to output
+
+unsigned long hzstr_utf8_fold_cp(   //fold the case of a code point
+    unsigned long       code        //code point to fold
+);                                  //folded code point
+
+unsigned long hzstr_utf8_fold_size( //measure the case-folded text
+    const char*         data,       //text to fold
+    unsigned long       length,     //number of bytes in text
+    int*                in_place    //set non-zero if folding can be in-place
+);                                  //number of bytes of folded text
+
+unsigned long hzstr_utf8_from_utf16(//convert UTF-16 to UTF-8
+    char*               output,     //UTF-8 output
+    const uint16_t*     data,       //UTF-16 text to convert
+    unsigned long       length      //number of units in text
+);                                  //number of bytes written to output
+
+unsigned long hzstr_utf8_from_utf16_size(
+                                    //measure UTF-16 converted to UTF-8
+    const uint16_t*     data,       //UTF-16 text to convert
+    unsigned long       length      //number of units in text
+);                                  //number of bytes of UTF-8
+
+unsigned long hzstr_utf8_from_utf32(//convert UTF-32 to UTF-8
+    char*               output,     //UTF-8 output
+    const uint32_t*     data,       //UTF-32 text to convert
+    unsigned long       length      //number of units in text
+);                                  //number of bytes written to output
+
+unsigned long hzstr_utf8_from_utf32_size(
+                                    //measure UTF-32 converted to UTF-8
+    const uint32_t*     data,       //UTF-32 text to convert
+    unsigned long       length      //number of units in text
+);                                  //number of bytes of UTF-8
+
+unsigned long hzstr_utf8_offset(    //find the offset of a code point
+    const char*         data,       //text to search
+    unsigned long       length,     //number of bytes in text
+    unsigned long       index       //index of the code point
+);                                  //byte offset (length if past the end)
+
+unsigned long hzstr_utf8_to_utf16(  //convert UTF-8 to UTF-16
+    uint16_t*           output,     //UTF-16 output
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+);                                  //number of units written to output
+
+unsigned long hzstr_utf8_to_utf16_size(
+                                    //measure UTF-8 converted to UTF-16
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+);                                  //number of units of UTF-16
+
+unsigned long hzstr_utf8_to_utf32(  //convert UTF-8 to UTF-32
+    uint32_t*           output,     //UTF-32 output
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+);                                  //number of units written to output
+
+unsigned long hzstr_utf8_to_utf32_size(
+                                    //measure UTF-8 converted to UTF-32
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+);                                  //number of units of UTF-32
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HZUTF8_H */
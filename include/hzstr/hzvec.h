@@ -0,0 +1,165 @@
+/*****************************************************************************
+    hzvec.h
+    Zac Hester
+    2026-10-19
+
+    Contiguous vector of Hz strings for large collections of short strings.
+
+    The characters of every string are stored end to end in one growable
+    allocation, and a parallel table of 32-bit offsets marks where each
+    string starts (the next string's offset is where it ends).  A vector of
+    a million strings is therefore two allocations instead of two million,
+    each string costs 4 bytes beyond its characters (instead of a string
+    object and an allocation), and scanning the strings in order reads
+    memory in order.
+
+    Interface Notes:
+        - Strings are only added to the end of a vector.  hzstr_vec_clear()
+            empties the vector without releasing its memory.
+        - hzstr_vec_view() describes one string as a substring object over
+            the vector's characters, without copying.  Views are
+            invalidated by the next append (which may move the
+            characters).  A view of a vector may be appended to the same
+            vector.
+        - The strings are not NULL-terminated.
+        - hzstr_vec_tolower() and hzstr_vec_hash() work on the shared
+            allocation directly (hzstr_vec_tolower() treats it as one
+            string), so the bulk operations do not visit each string's
+            object or allocation.  The hashes are the same as hzstr_hash()
+            of each string.
+        - hzstr_vec_save() writes the offset table and the characters as
+            they are in memory (after a small header), and hzstr_vec_load()
+            reads them back into a new vector with two reads.  A saved
+            vector is only loaded by builds with the same character size
+            and byte order.
+        - A vector holds up to 4 GiB - 1 characters, and each string may
+            be as long as any other string.
+
+    Example Usage
+
+        hzstr_vec_type* names;
+        hzstr_type      name;
+
+        names = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append( names, string );
+        hzstr_vec_view( names, 0, &name );
+
+*****************************************************************************/
+
+#ifndef _HZVEC_H
+#define _HZVEC_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//vector file identification
+#define HZSTR_VEC_MAGIC "HZVEC"     //first bytes of a saved vector
+#define HZSTR_VEC_VERSION ( 1 )     //version of the file format
+
+//find the number of strings in a vector
+#define hzstr_vec_count( _v ) ( ( _v )->count )
+
+//find the number of characters of every string in a vector
+#define hzstr_vec_chars( _v ) ( ( _v )->offsets[ ( _v )->count ] )
+
+//find the length of one string in a vector
+#define hzstr_vec_length( _v, _i ) ( ( hzstr_length_t ) \
+    ( ( _v )->offsets[ ( _i ) + 1 ] - ( _v )->offsets[ _i ] ) )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct hzstr_vec_s {        //contiguous string vector data type
+    unsigned long       count;      //number of strings
+    unsigned long       slots;      //number of strings the table can hold
+    unsigned long       alloc;      //number of characters allocated
+    uint32_t*           offsets;    //start of each string (and of the next)
+    hzstr_char_t*       data;       //characters of every string
+} hzstr_vec_type;
+
+typedef struct hzstr_vec_header_s { //first bytes of a saved vector
+    char                magic[ 8 ]; //HZSTR_VEC_MAGIC
+    uint32_t            version;    //HZSTR_VEC_VERSION
+    uint32_t            char_size;  //size of the saved build's characters
+    uint64_t            count;      //number of strings
+    uint64_t            chars;      //number of characters
+} hzstr_vec_header_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+hzstr_result_t hzstr_vec_append(    //add a string to the end of a vector
+    hzstr_vec_type*     vec,        //target vector
+    const hzstr_type*   source      //string to add
+);                                  //index of the string (or error result)
+
+#ifdef HZSTR_COMPAT_CSTR
+hzstr_result_t hzstr_vec_append_cstr_n(
+                                    //add a known-length C-string to a vector
+    hzstr_vec_type*     vec,        //target vector
+    const char*         source,     //C-string to add
+    hzstr_length_t      length      //number of characters in the C-string
+);                                  //index of the string (or error result)
+#endif
+
+void hzstr_vec_clear(               //remove every string from a vector
+    hzstr_vec_type*     vec         //vector to empty
+);
+
+hzstr_vec_type* hzstr_vec_create(   //create a new, empty vector
+    unsigned long       count,      //initial number of strings (0 for default)
+    unsigned long       chars       //initial characters (0 for default)
+);                                  //pointer to new vector
+
+void hzstr_vec_destroy(             //destroy a vector
+    hzstr_vec_type*     vec         //the vector to destroy
+);
+
+hzstr_result_t hzstr_vec_hash(      //hash every string in a vector
+    const hzstr_vec_type* vec,      //source vector
+    hzstr_hash_t*       hashes      //hash of each string (count entries)
+);                                  //number of strings (or error result)
+
+hzstr_vec_type* hzstr_vec_load(     //read a vector saved by hzstr_vec_save()
+    const char*         path        //file to read
+);                                  //new vector (NULL if the file is invalid)
+
+hzstr_result_t hzstr_vec_save(      //write a vector's memory to a file
+    const hzstr_vec_type* vec,      //vector to save
+    const char*         path        //file to write
+);                                  //number of strings (or error result)
+
+hzstr_result_t hzstr_vec_tolower(   //make every string in a vector lowercase
+    hzstr_vec_type*     vec         //vector to change
+);                                  //result of operation
+
+hzstr_result_t hzstr_vec_view(      //describe one string without copying
+    const hzstr_vec_type* vec,      //source vector
+    unsigned long       index,      //index of the string
+    hzstr_type*         view        //receives a substring of the string
+);                                  //length of the string (or error result)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HZVEC_H */
@@ -6,6 +6,28 @@
     Memory management interface to provide testable interaction with memory
     allocation on the host platform.
 
+    Defining the MEM_POOL symbol (for every module, along with linking
+    memory.c) routes the mem_* allocation calls to a size-class pool.  The
+    pool keeps freed blocks of up to MEM_POOL_MAX bytes on free lists (one
+    list per MEM_POOL_GRAIN bytes of size), so string objects and small
+    string buffers are re-used without calling the system allocator.
+    Larger blocks go directly to the system.
+
+    Pool Notes:
+        - Each thread keeps a cache of free blocks for each size class.  A
+            thread takes blocks from (and gives blocks back to) the shared
+            lists in batches, so most calls do not take a lock.
+        - Memory taken for pooled blocks is kept for re-use, and is not
+            returned to the system.
+        - mem_pool_flush() returns the calling thread's cached blocks to
+            the shared lists.  A thread should flush its cache before it
+            exits, or its cached blocks are not re-used.
+        - mem_pool_stats() reports the statistics published so far.  Each
+            thread publishes its counts when it refills or flushes a cache.
+            Blocks cached by other threads are not counted as held.
+        - Every block has a small header, so a pooled block takes
+            MEM_POOL_HEAD more bytes than its size class.
+
     Example Usage
 
 *****************************************************************************/
@@ -27,6 +49,10 @@ Macros
 #ifdef UNIT_TEST
 
 //provide equivalent prototypes to link against test stubs
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 void* mem_calloc(
     size_t              num,
     size_t              size
@@ -45,6 +71,18 @@ void* mem_realloc(
     size_t              size
 );
 
+#ifdef __cplusplus
+}
+#endif
+
+#elif defined( MEM_POOL )
+
+//use the size-class pool
+#define mem_calloc      mem_pool_calloc
+#define mem_free        mem_pool_free
+#define mem_malloc      mem_pool_malloc
+#define mem_realloc     mem_pool_realloc
+
 #else
 
 //use standard heap operations
@@ -58,10 +96,25 @@ void* mem_realloc(
 //most implementations use memcpy to copy bytes because compilers like it
 #define mem_copy        memcpy
 
+//overlapping moves within one buffer must use memmove
+#define mem_move        memmove
+
+//pool configuration
+#define MEM_POOL_GRAIN  ( 16 )      //size difference between classes (bytes)
+#define MEM_POOL_HEAD   ( 16 )      //bytes of each block's header
+#define MEM_POOL_MAX    ( 512 )     //largest pooled block (bytes)
+
 /*----------------------------------------------------------------------------
 Types and Structures
 ----------------------------------------------------------------------------*/
 
+typedef struct mem_pool_stats_s {   //pool statistics
+    unsigned long       hits;       //allocations from free blocks
+    unsigned long       misses;     //allocations from the system
+    unsigned long       held;       //bytes in free blocks (held for re-use)
+    unsigned long       system;     //bytes taken from the system for pooling
+} mem_pool_stats_type;
+
 /*----------------------------------------------------------------------------
 Memory Constants
 ----------------------------------------------------------------------------*/
@@ -70,5 +123,38 @@ Memory Constants
 Interface Prototypes
 ----------------------------------------------------------------------------*/
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* mem_pool_calloc(              //allocate zeroed memory from the pool
+    size_t              num,        //number of elements
+    size_t              size        //size of each element
+);                                  //new block (NULL on failure)
+
+void mem_pool_flush(                //return this thread's cached blocks
+    void
+);
+
+void mem_pool_free(                 //release memory to the pool
+    void*               ptr         //block to release (may be NULL)
+);
+
+void* mem_pool_malloc(              //allocate memory from the pool
+    size_t              size        //bytes to allocate
+);                                  //new block (NULL on failure)
+
+void* mem_pool_realloc(             //re-size memory from the pool
+    void*               ptr,        //block to re-size (may be NULL)
+    size_t              size        //new size of the block
+);                                  //re-sized block (NULL on failure)
+
+void mem_pool_stats(                //report the pool's statistics
+    mem_pool_stats_type* stats      //statistics output
+);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* _MEMORY_H */
@@ -0,0 +1,407 @@
+/*****************************************************************************
+    hzbatch.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Each thread's run of units is a queue described by one atomic word
+        (the index of the first unit in the high 32 bits, and the index
+        after the last unit in the low 32 bits).  The owner takes units
+        from the front, and other threads take units from the back, both
+        with a compare-and-swap.  No units are added after the threads
+        start, so the front only moves up and the back only moves down.
+
+        A string's cost is its bytes of characters plus BATCH_COST, so a
+        run of empty strings still fills units.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "hzbatch.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//useful values
+#define BATCH_COST ( 64 )           //bytes of cost added for each string
+#define BATCH_LINE ( 64 )           //bytes in a cache line
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct batch_unit_s {       //contiguous strings done together
+    int                 first;      //index of the first string
+    int                 last;       //index after the last string
+    unsigned long       cost;       //cost of the strings
+} batch_unit_type;
+
+typedef struct batch_queue_s {      //one thread's run of units
+    atomic_ullong       range;      //first unit (high), after last (low)
+    char                pad[ BATCH_LINE - sizeof( atomic_ullong ) ];
+                                    //keeps each queue in its own line
+} batch_queue_type;
+
+typedef struct batch_job_s {        //state shared by the threads of a batch
+    hzstr_type**        strings;    //strings of the batch
+    hzstr_batch_op_t    op;         //operation to apply (or NULL)
+    hzstr_hash_t*       hashes;     //hash of each string (or NULL)
+    batch_unit_type*    units;      //work units
+    int                 threads;    //number of threads (and queues)
+    atomic_int          failed;     //number of strings the operation failed
+    batch_queue_type    queues[ HZSTR_BATCH_THREADS ];
+                                    //each thread's units
+} batch_job_type;
+
+typedef struct batch_worker_s {     //one thread of a batch
+    batch_job_type*     job;        //state shared by the threads
+    int                 id;         //index of the thread's queue
+} batch_worker_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static int batch_range(             //apply a batch to a range of strings
+    hzstr_type**        strings,    //strings of the batch
+    int                 first,      //index of the first string
+    int                 last,       //index after the last string
+    hzstr_batch_op_t    op,         //operation to apply (or NULL)
+    hzstr_hash_t*       hashes      //hash of each string (or NULL)
+);                                  //number of strings failed
+
+static hzstr_result_t batch_run(    //apply a batch with threads
+    hzstr_type**        strings,    //strings of the batch
+    int                 count,      //number of strings
+    hzstr_batch_op_t    op,         //operation to apply (or NULL)
+    hzstr_hash_t*       hashes,     //hash of each string (or NULL)
+    int                 threads     //number of threads (0 for each processor)
+);                                  //strings failed (or error result)
+
+static int batch_take(              //take a unit from a queue
+    batch_queue_type*   queue,      //queue to take from
+    int                 back,       //take from the back (another's queue)
+    int*                unit        //receives the index of the unit
+);                                  //1 if a unit was taken, 0 if empty
+
+static void* batch_worker(          //do units until none are left
+    void*               worker      //the thread of the batch
+);                                  //always NULL
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_batch_apply(   //apply an operation to every string
+    hzstr_type**        strings,    //strings to change
+    int                 count,      //number of strings
+    hzstr_batch_op_t    op,         //operation to apply
+    int                 threads     //number of threads (0 for each processor)
+) {                                 //strings failed (or error result)
+
+    //check arguments
+    if( ( count < 0 ) || ( ( strings == NULL ) && ( count > 0 ) )
+     || ( op == NULL ) || ( threads < 0 ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //apply the operation
+    return batch_run( strings, count, op, NULL, threads );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_batch_hash(    //hash every string
+    hzstr_type* const*  strings,    //strings to hash
+    int                 count,      //number of strings
+    hzstr_hash_t*       hashes,     //hash of each string (count entries)
+    int                 threads     //number of threads (0 for each processor)
+) {                                 //result of operation
+
+    //check arguments
+    if( ( count < 0 )
+     || ( ( ( strings == NULL ) || ( hashes == NULL ) ) && ( count > 0 ) )
+     || ( threads < 0 ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //hash the strings (hashing doesn't change them, and never fails)
+    return batch_run( ( hzstr_type** ) strings, count, NULL, hashes, threads );
+}
+
+
+/*==========================================================================*/
+static int batch_range(             //apply a batch to a range of strings
+    hzstr_type**        strings,    //strings of the batch
+    int                 first,      //index of the first string
+    int                 last,       //index after the last string
+    hzstr_batch_op_t    op,         //operation to apply (or NULL)
+    hzstr_hash_t*       hashes      //hash of each string (or NULL)
+) {                                 //number of strings failed
+
+    //local variables
+    int                 failed;     //number of strings failed
+    int                 index;      //string index
+
+    //hash the strings
+    failed = 0;
+    if( op == NULL ) {
+        for( index = first; index < last; ++index ) {
+            hashes[ index ] = hzstr_hash( strings[ index ] );
+        }
+    }
+
+    //apply the operation, counting error results
+    else {
+        for( index = first; index < last; ++index ) {
+            if( op( strings[ index ] ) < 0 ) {
+                failed += 1;
+            }
+        }
+    }
+
+    return failed;
+}
+
+
+/*==========================================================================*/
+static hzstr_result_t batch_run(    //apply a batch with threads
+    hzstr_type**        strings,    //strings of the batch
+    int                 count,      //number of strings
+    hzstr_batch_op_t    op,         //operation to apply (or NULL)
+    hzstr_hash_t*       hashes,     //hash of each string (or NULL)
+    int                 threads     //number of threads (0 for each processor)
+) {                                 //strings failed (or error result)
+
+    //local variables
+    unsigned long       cost;       //cost of the units so far
+    int                 failed;     //number of strings failed
+    int                 index;      //string or unit index
+    batch_job_type*     job;        //state shared by the threads
+    long                processors; //number of online processors
+    int                 start;      //first unit of a thread's queue
+    int                 started;    //number of threads started
+    unsigned long       total;      //cost of every string
+    int                 units;      //number of units
+    batch_worker_type   workers[ HZSTR_BATCH_THREADS ];
+    pthread_t           handles[ HZSTR_BATCH_THREADS ];
+
+    //measure the batch, and count the units it needs
+    cost  = 0;
+    total = 0;
+    units = 0;
+    for( index = 0; index < count; ++index ) {
+        if( strings[ index ] == NULL ) {
+            return HZSTR_RSLT_USAGE;
+        }
+        cost += ( strings[ index ]->length * sizeof( hzstr_char_t ) )
+            + BATCH_COST;
+        if( cost >= HZSTR_BATCH_UNIT ) {
+            total += cost;
+            cost   = 0;
+            units += 1;
+        }
+    }
+    if( cost > 0 ) {
+        total += cost;
+        units += 1;
+    }
+
+    //use a thread for each processor (and no more threads than units)
+    if( threads == 0 ) {
+        processors = sysconf( _SC_NPROCESSORS_ONLN );
+        threads    = ( processors > 0 ) ? ( int ) processors : 1;
+    }
+    if( threads > HZSTR_BATCH_THREADS ) {
+        threads = HZSTR_BATCH_THREADS;
+    }
+    if( threads > units ) {
+        threads = units;
+    }
+
+    //small batches are done by the calling thread
+    if( threads < 2 ) {
+        return batch_range( strings, 0, count, op, hashes );
+    }
+
+    //the job is shared, so it is not on any thread's stack
+    job = mem_calloc( 1, sizeof( batch_job_type ) );
+    if( job == NULL ) {
+        return HZSTR_RSLT_ALLOC;
+    }
+    job->units = mem_malloc( units * sizeof( batch_unit_type ) );
+    if( job->units == NULL ) {
+        mem_free( job );
+        return HZSTR_RSLT_ALLOC;
+    }
+    job->strings = strings;
+    job->op      = op;
+    job->hashes  = hashes;
+    job->threads = threads;
+    atomic_init( &job->failed, 0 );
+
+    //cut the strings into units the same way they were counted
+    cost  = 0;
+    units = 0;
+    job->units[ 0 ].first = 0;
+    for( index = 0; index < count; ++index ) {
+        cost += ( strings[ index ]->length * sizeof( hzstr_char_t ) )
+            + BATCH_COST;
+        if( ( cost >= HZSTR_BATCH_UNIT ) || ( index == ( count - 1 ) ) ) {
+            job->units[ units ].last = index + 1;
+            job->units[ units ].cost = cost;
+            cost   = 0;
+            units += 1;
+            if( index < ( count - 1 ) ) {
+                job->units[ units ].first = index + 1;
+            }
+        }
+    }
+
+    //give each thread a run of units holding an equal share of the cost
+    cost    = 0;
+    start   = 0;
+    started = 0;
+    for( index = 0; index < units; ++index ) {
+        while( ( started < ( threads - 1 ) )
+            && ( cost >= ( ( total / threads ) * ( started + 1 ) ) ) ) {
+            atomic_init(
+                &job->queues[ started ].range,
+                ( ( unsigned long long ) start << 32 ) | index
+            );
+            start    = index;
+            started += 1;
+        }
+        cost += job->units[ index ].cost;
+    }
+    while( started < threads ) {
+        atomic_init(
+            &job->queues[ started ].range,
+            ( ( unsigned long long ) start << 32 ) | units
+        );
+        start    = units;
+        started += 1;
+    }
+
+    //start the other threads (if a thread can't be started, the threads
+    //  that did start take its units)
+    for( started = 1; started < threads; ++started ) {
+        workers[ started ].job = job;
+        workers[ started ].id  = started;
+        if( pthread_create(
+            &handles[ started ], NULL, batch_worker, &workers[ started ]
+        ) != 0 ) {
+            break;
+        }
+    }
+
+    //the calling thread does units too
+    workers[ 0 ].job = job;
+    workers[ 0 ].id  = 0;
+    batch_worker( &workers[ 0 ] );
+    while( started > 1 ) {
+        started -= 1;
+        pthread_join( handles[ started ], NULL );
+    }
+
+    //return the number of strings the operation failed
+    failed = atomic_load( &job->failed );
+    mem_free( job->units );
+    mem_free( job );
+    return failed;
+}
+
+
+/*==========================================================================*/
+static int batch_take(              //take a unit from a queue
+    batch_queue_type*   queue,      //queue to take from
+    int                 back,       //take from the back (another's queue)
+    int*                unit        //receives the index of the unit
+) {                                 //1 if a unit was taken, 0 if empty
+
+    //local variables
+    unsigned long long  first;      //first unit in the queue
+    unsigned long long  last;       //unit after the last unit in the queue
+    unsigned long long  next;       //queue after taking the unit
+    unsigned long long  range;      //queue before taking the unit
+
+    //retry until no other thread changes the queue while taking the unit
+    range = atomic_load_explicit( &queue->range, memory_order_relaxed );
+    do {
+        first = range >> 32;
+        last  = range & 0xFFFFFFFFull;
+        if( first >= last ) {
+            return 0;
+        }
+        if( back != 0 ) {
+            next  = ( first << 32 ) | ( last - 1 );
+            *unit = ( int ) ( last - 1 );
+        }
+        else {
+            next  = ( ( first + 1 ) << 32 ) | last;
+            *unit = ( int ) first;
+        }
+    } while( !atomic_compare_exchange_weak_explicit(
+        &queue->range, &range, next,
+        memory_order_relaxed, memory_order_relaxed
+    ) );
+
+    return 1;
+}
+
+
+/*==========================================================================*/
+static void* batch_worker(          //do units until none are left
+    void*               worker      //the thread of the batch
+) {                                 //always NULL
+
+    //local variables
+    int                 failed;     //number of strings failed
+    int                 id;         //index of the thread's queue
+    batch_job_type*     job;        //state shared by the threads
+    batch_unit_type*    unit;       //unit being done
+    int                 taken;      //index of the unit taken
+    int                 victim;     //offset of the queue to take from
+
+    job    = ( ( batch_worker_type* ) worker )->job;
+    id     = ( ( batch_worker_type* ) worker )->id;
+    failed = 0;
+
+    //do the thread's own units from the front, then take units from the
+    //  back of every other queue (queues never refill, so one visit each
+    //  is enough)
+    for( victim = 0; victim < job->threads; ++victim ) {
+        while( batch_take(
+            &job->queues[ ( id + victim ) % job->threads ],
+            ( victim != 0 ), &taken
+        ) ) {
+            unit    = &job->units[ taken ];
+            failed += batch_range(
+                job->strings, unit->first, unit->last, job->op, job->hashes
+            );
+        }
+    }
+
+    atomic_fetch_add_explicit( &job->failed, failed, memory_order_relaxed );
+    return NULL;
+}
@@ -0,0 +1,438 @@
+/*****************************************************************************
+    hzgap.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        The gap always holds at least one character.  This guarantees a
+        place for the NULL byte when the buffer is converted into a string.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "hzgap.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//useful values
+#define MAX_LENGTH ( 65535 )        //largest possible single string
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static hzstr_result_t gap_reserve(  //make sure the gap can hold characters
+    hzstr_gap_type*     gap,        //the gap buffer to check
+    hzstr_length_t      length      //number of characters to be inserted
+);                                  //result of the check
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_gap_append(    //insert a character at the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_char_t        c           //character to insert
+) {                                 //result of operation
+
+    //local variables
+    hzstr_result_t      result;     //allocation result
+
+    //check pointer
+    if( gap == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //check the size of the gap
+    result = gap_reserve( gap, 1 );
+    if( result < HZSTR_RSLT_OK ) {
+        return result;
+    }
+
+    //place the character at the start of the gap
+    gap->data[ gap->start ] = c;
+    gap->start += 1;
+
+    //return the new length of the string
+    return hzstr_gap_length( gap );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_gap_backspace( //remove characters before the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_length_t      length      //number of characters to remove
+) {                                 //result of operation
+
+    //check pointer, and make sure the characters exist
+    if( ( gap == NULL ) || ( length > gap->start ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //extend the gap over the characters
+    gap->start -= length;
+
+    //return the new length of the string
+    return hzstr_gap_length( gap );
+}
+
+
+/*==========================================================================*/
+hzstr_gap_type* hzstr_gap_create(   //create a new, empty gap buffer
+    hzstr_length_t      length      //initial capacity (0 for default)
+) {                                 //pointer to new gap buffer
+
+    //local variables
+    hzstr_gap_type*     gap;        //pointer to new gap buffer
+
+    //allocate a gap buffer object
+    gap = mem_calloc( 1, sizeof( hzstr_gap_type ) );
+
+    //check allocation
+    if( gap != NULL ) {
+
+        //pad the allocation the same way strings are padded
+        if( length == 0 ) {
+            length = HZSTR_CHUNK_SIZE;
+        }
+        else if( length < ( MAX_LENGTH - HZSTR_CHUNK_SIZE ) ) {
+            length = ( ( length / HZSTR_CHUNK_SIZE ) + 1 ) * HZSTR_CHUNK_SIZE;
+        }
+        else {
+            length = MAX_LENGTH;
+        }
+
+        //allocate memory for the characters
+        gap->data = mem_malloc( length * sizeof( hzstr_char_t ) );
+
+        //check allocation
+        if( gap->data == NULL ) {
+            mem_free( gap );
+            return NULL;
+        }
+
+        //the entire allocation is the gap
+        gap->alloc = length;
+        gap->start = 0;
+        gap->end   = length;
+    }
+
+    //return the gap buffer pointer
+    return gap;
+}
+
+
+/*==========================================================================*/
+hzstr_gap_type* hzstr_gap_create_str(
+                                    //create a gap buffer from a string
+    const hzstr_type*   source      //string to copy (cursor is at the end)
+) {                                 //pointer to new gap buffer
+
+    //local variables
+    hzstr_gap_type*     gap;        //pointer to new gap buffer
+
+    //allocate a gap buffer large enough for the string
+    gap = hzstr_gap_create( source->length );
+
+    //check allocation
+    if( gap != NULL ) {
+
+        //copy the string in front of the gap
+        mem_copy(
+            gap->data,
+            source->data,
+            ( source->length * sizeof( hzstr_char_t ) )
+        );
+        gap->start = source->length;
+    }
+
+    //return the gap buffer pointer
+    return gap;
+}
+
+
+/*==========================================================================*/
+void hzstr_gap_destroy(             //destroy a gap buffer
+    hzstr_gap_type*     gap         //the gap buffer to destroy
+) {
+
+    //check the pointer
+    if( gap != NULL ) {
+
+        //free the character memory
+        if( gap->data != NULL ) {
+            mem_free( gap->data );
+        }
+
+        //free the gap buffer object
+        mem_free( gap );
+    }
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_gap_erase(     //remove characters after the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_length_t      length      //number of characters to remove
+) {                                 //result of operation
+
+    //check pointer, and make sure the characters exist
+    if( ( gap == NULL ) || ( length > ( gap->alloc - gap->end ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //extend the gap over the characters
+    gap->end += length;
+
+    //return the new length of the string
+    return hzstr_gap_length( gap );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_gap_export(    //copy the contents into a string
+    const hzstr_gap_type* gap,      //source gap buffer
+    hzstr_type*         target      //dynamic string to receive the contents
+) {                                 //result of operation
+
+    //local variables
+    hzstr_type          after;      //view of the text after the cursor
+    hzstr_type          before;     //view of the text before the cursor
+    hzstr_result_t      result;     //result of copying
+
+    //check pointers
+    if( ( gap == NULL ) || ( target == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //describe both sides of the gap
+    hzstr_gap_views( gap, &before, &after );
+
+    //copy the text before the gap, then append the text after the gap
+    result = hzstr_cpy( target, &before );
+    if( result < HZSTR_RSLT_OK ) {
+        return result;
+    }
+    return hzstr_cat( target, &after );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_gap_insert(    //insert a string at the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    const hzstr_type*   source      //string to insert
+) {                                 //result of operation
+
+    //local variables
+    hzstr_result_t      result;     //allocation result
+
+    //check pointers
+    if( ( gap == NULL ) || ( source == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //the source must not move while the gap is re-allocated
+    if( ( source->data >= gap->data )
+     && ( source->data < ( gap->data + gap->alloc ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //check the size of the gap
+    result = gap_reserve( gap, source->length );
+    if( result < HZSTR_RSLT_OK ) {
+        return result;
+    }
+
+    //copy the string into the start of the gap
+    mem_copy(
+        ( gap->data + gap->start ),
+        source->data,
+        ( source->length * sizeof( hzstr_char_t ) )
+    );
+    gap->start += source->length;
+
+    //return the new length of the string
+    return hzstr_gap_length( gap );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_gap_move(      //move the cursor
+    hzstr_gap_type*     gap,        //target gap buffer
+    hzstr_index_t       cursor      //new cursor position
+) {                                 //result of operation
+
+    //local variables
+    hzstr_length_t      distance;   //number of characters to move
+
+    //check pointer, and the new cursor position
+    if( ( gap == NULL )
+     || ( cursor < 0 )
+     || ( cursor > hzstr_gap_length( gap ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //move the characters between the cursor and the gap to the gap's end
+    if( cursor < gap->start ) {
+        distance = gap->start - cursor;
+        mem_move(
+            ( gap->data + gap->end - distance ),
+            ( gap->data + cursor ),
+            ( distance * sizeof( hzstr_char_t ) )
+        );
+        gap->start -= distance;
+        gap->end   -= distance;
+    }
+
+    //move the characters after the gap to the gap's start
+    else if( cursor > gap->start ) {
+        distance = cursor - gap->start;
+        mem_move(
+            ( gap->data + gap->start ),
+            ( gap->data + gap->end ),
+            ( distance * sizeof( hzstr_char_t ) )
+        );
+        gap->start += distance;
+        gap->end   += distance;
+    }
+
+    //return the new cursor position
+    return gap->start;
+}
+
+
+/*==========================================================================*/
+hzstr_type* hzstr_gap_to_str(       //convert a gap buffer into a string
+    hzstr_gap_type*     gap         //gap buffer (destroyed if successful)
+) {                                 //pointer to new dynamic string
+
+    //local variables
+    hzstr_type*         string;     //pointer to new string
+
+    //check pointer
+    if( gap == NULL ) {
+        return NULL;
+    }
+
+    //allocate a string object
+    string = mem_calloc( 1, sizeof( hzstr_type ) );
+
+    //check allocation
+    if( string != NULL ) {
+
+        //close the gap at the end of the text, and terminate the text
+        hzstr_gap_move( gap, hzstr_gap_length( gap ) );
+        gap->data[ gap->start ] = 0;
+
+        //the string takes ownership of the gap buffer's allocation
+        string->type   = HZSTR_TYPE_DYNAMIC;
+        string->flags  = HZSTR_FLG_WRITABLE;
+        string->alloc  = gap->alloc;
+        string->length = gap->start;
+        string->data   = gap->data;
+
+        //release the gap buffer object
+        mem_free( gap );
+    }
+
+    //return the string pointer
+    return string;
+}
+
+
+/*==========================================================================*/
+void hzstr_gap_views(               //describe the contents without copying
+    const hzstr_gap_type* gap,      //source gap buffer
+    hzstr_type*         before,     //receives the text before the cursor
+    hzstr_type*         after       //receives the text after the cursor
+) {
+
+    //clear both view objects
+    memset( before, 0, sizeof( hzstr_type ) );
+    memset( after,  0, sizeof( hzstr_type ) );
+
+    //the text before the cursor starts the allocation
+    before->type   = HZSTR_TYPE_SUBSTR;
+    before->length = gap->start;
+    before->data   = gap->data;
+
+    //the text after the cursor ends the allocation
+    after->type    = HZSTR_TYPE_SUBSTR;
+    after->length  = gap->alloc - gap->end;
+    after->data    = gap->data + gap->end;
+}
+
+
+/*==========================================================================*/
+static hzstr_result_t gap_reserve(  //make sure the gap can hold characters
+    hzstr_gap_type*     gap,        //the gap buffer to check
+    hzstr_length_t      length      //number of characters to be inserted
+) {                                 //result of the check
+
+    //local variables
+    unsigned long       alloc;      //new allocation of the characters
+    hzstr_char_t*       data;       //pointer to re-allocated characters
+    hzstr_length_t      tail;       //number of characters after the gap
+
+    //see if the gap can hold the characters (and one to spare)
+    if( ( gap->end - gap->start ) > length ) {
+        return HZSTR_RSLT_OK;
+    }
+
+    //compute the smallest allocation that can hold the new text
+    alloc = ( unsigned long ) hzstr_gap_length( gap ) + length + 1;
+    if( alloc > MAX_LENGTH ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //grow in proportion to the text so repeated inserts are amortized, then
+    //  pad the allocation the same way strings are padded
+    alloc += alloc / 2;
+    alloc  = ( ( alloc / HZSTR_CHUNK_SIZE ) + 1 ) * HZSTR_CHUNK_SIZE;
+    if( alloc > MAX_LENGTH ) {
+        alloc = MAX_LENGTH;
+    }
+
+    //re-allocate the characters
+    data = mem_realloc( gap->data, ( alloc * sizeof( hzstr_char_t ) ) );
+    if( data == NULL ) {
+        return HZSTR_RSLT_ALLOC;
+    }
+
+    //move the text after the gap to the end of the new allocation
+    tail = gap->alloc - gap->end;
+    mem_move(
+        ( data + alloc - tail ),
+        ( data + gap->end ),
+        ( tail * sizeof( hzstr_char_t ) )
+    );
+
+    //update the gap buffer
+    gap->alloc = alloc;
+    gap->end   = alloc - tail;
+    gap->data  = data;
+
+    //the gap is now large enough
+    return HZSTR_RSLT_OK;
+}
@@ -0,0 +1,256 @@
+/*****************************************************************************
+    hzkey.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        A key is a 4-byte length followed by 12 bytes of characters.  The
+        first 4 bytes of characters are always the prefix.  When the string
+        is longer than the key can hold, the next 8 bytes hold a pointer to
+        the string's characters (copied in and out with mem_copy(), so the
+        key needs no alignment beyond its length).
+
+        Because the length and prefix are the first 8 bytes, and a short
+        key's unused characters are zero, the equality check compares keys
+        as two 8-byte blocks before it ever reads a string's characters.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "hzkey.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//useful values
+#define KEY_HEAD ( 8 )              //bytes in a key's length and prefix
+#define KEY_PREFIX ( 4 )            //bytes in a key's prefix
+#define KEY_TAIL ( 8 )              //bytes in a key's characters or pointer
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static const hzstr_char_t* key_data(//find the characters of a key's string
+    const hzstr_key_type* key       //source key
+);                                  //pointer to the string's characters
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+long hzstr_key_cmp(                 //compare two keys
+    const hzstr_key_type* key0,     //first key
+    const hzstr_key_type* key1      //second key
+) {                                 //comparison value (0 means equal)
+
+    //local variables
+    const hzstr_char_t* data0;      //characters of the first string
+    const hzstr_char_t* data1;      //characters of the second string
+    uint32_t            first;      //number of prefix characters compared
+    uint32_t            length;     //number of characters in both strings
+    uint32_t            pos;        //position index
+
+    //only compare the characters that are in both strings
+    length = key0->length;
+    if( key1->length < length ) {
+        length = key1->length;
+    }
+    first = length;
+    if( first > HZSTR_KEY_PREFIX ) {
+        first = HZSTR_KEY_PREFIX;
+    }
+
+    //unequal prefixes are usually decided here, without reading the
+    //  strings' characters
+    if( memcmp( key0->chars, key1->chars, KEY_PREFIX ) != 0 ) {
+        for( pos = 0; pos < first; ++pos ) {
+            if( key0->chars[ pos ] != key1->chars[ pos ] ) {
+                return ( long ) key0->chars[ pos ]
+                    - ( long ) key1->chars[ pos ];
+            }
+        }
+    }
+
+    //compare the characters after the prefix
+    if( length > HZSTR_KEY_PREFIX ) {
+        data0 = key_data( key0 );
+        data1 = key_data( key1 );
+        if( data0 != data1 ) {
+            for( pos = HZSTR_KEY_PREFIX; pos < length; ++pos ) {
+                if( data0[ pos ] != data1[ pos ] ) {
+                    return ( long ) data0[ pos ] - ( long ) data1[ pos ];
+                }
+            }
+        }
+    }
+
+    //the shorter string is ordered first
+    return ( long ) key0->length - ( long ) key1->length;
+}
+
+
+/*==========================================================================*/
+int hzstr_key_equal(                //check two keys for equal characters
+    const hzstr_key_type* key0,     //first key
+    const hzstr_key_type* key1      //second key
+) {                                 //1 if equal, 0 if not
+
+    //local variables
+    const hzstr_char_t* data0;      //characters of the first string
+    const hzstr_char_t* data1;      //characters of the second string
+
+    //the lengths and prefixes must be equal
+    if( memcmp( key0, key1, KEY_HEAD ) != 0 ) {
+        return 0;
+    }
+
+    //short keys are equal if the rest of their bytes are equal
+    if( hzstr_key_is_inline( key0 ) ) {
+        return memcmp(
+            ( ( const char* ) key0 + KEY_HEAD ),
+            ( ( const char* ) key1 + KEY_HEAD ),
+            KEY_TAIL
+        ) == 0;
+    }
+
+    //long keys of the same characters are equal
+    data0 = key_data( key0 );
+    data1 = key_data( key1 );
+    if( data0 == data1 ) {
+        return 1;
+    }
+
+    //compare the characters after the prefix
+    return memcmp(
+        ( data0 + HZSTR_KEY_PREFIX ),
+        ( data1 + HZSTR_KEY_PREFIX ),
+        ( ( key0->length - HZSTR_KEY_PREFIX ) * sizeof( hzstr_char_t ) )
+    ) == 0;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_key_set(       //set a key from a string
+    hzstr_key_type*     key,        //key to set
+    const hzstr_type*   source      //string described by the key
+) {                                 //length of the string (or error result)
+
+    //check pointers
+    if( ( key == NULL ) || ( source == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //unused characters are zero
+    memset( key, 0, sizeof( hzstr_key_type ) );
+    key->length = source->length;
+
+    //short strings are stored in the key
+    if( source->length <= HZSTR_KEY_INLINE ) {
+        mem_copy(
+            key->chars, source->data,
+            ( source->length * sizeof( hzstr_char_t ) )
+        );
+    }
+
+    //long strings store the prefix and a pointer to the characters
+    else {
+        mem_copy( key->chars, source->data, KEY_PREFIX );
+        mem_copy(
+            &key->chars[ HZSTR_KEY_PREFIX ],
+            &source->data,
+            sizeof( source->data )
+        );
+    }
+
+    //return the length of the string
+    return source->length;
+}
+
+
+/*==========================================================================*/
+hzstr_type* hzstr_key_to_str(       //create a new string from a key
+    const hzstr_key_type* key       //source key
+) {                                 //pointer to new string
+
+    //local variables
+    hzstr_type*         string;     //pointer to new string
+    hzstr_type          view;       //the key's string
+
+    //check pointer
+    if( key == NULL ) {
+        return NULL;
+    }
+
+    //copy the key's string to a new string
+    hzstr_key_view( key, &view );
+    string = hzstr_create( view.length );
+    if( ( string != NULL ) && ( hzstr_cpy( string, &view ) < 0 ) ) {
+        hzstr_destroy( string );
+        string = NULL;
+    }
+
+    //return the string pointer
+    return string;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_key_view(      //describe a key's string without copying
+    const hzstr_key_type* key,      //source key
+    hzstr_type*         view        //receives a substring of the string
+) {                                 //length of the string (or error result)
+
+    //check pointers
+    if( ( key == NULL ) || ( view == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //the view refers to the key's characters or the string's characters
+    memset( view, 0, sizeof( hzstr_type ) );
+    view->type   = HZSTR_TYPE_SUBSTR;
+    view->length = key->length;
+    view->data   = ( hzstr_char_t* ) key_data( key );
+
+    //return the length of the string
+    return key->length;
+}
+
+
+/*==========================================================================*/
+static const hzstr_char_t* key_data(//find the characters of a key's string
+    const hzstr_key_type* key       //source key
+) {                                 //pointer to the string's characters
+
+    //local variables
+    const hzstr_char_t* data;       //pointer to the string's characters
+
+    //short strings are stored in the key
+    if( hzstr_key_is_inline( key ) ) {
+        return key->chars;
+    }
+
+    //long strings are stored elsewhere
+    mem_copy( &data, &key->chars[ HZSTR_KEY_PREFIX ], sizeof( data ) );
+    return data;
+}
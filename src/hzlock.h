@@ -0,0 +1,49 @@
+/*****************************************************************************
+    hzlock.h
+    Zac Hester
+    2026-10-19
+
+    Spin lock shared by the library's modules.  Not installed.
+
+    A lock is an atomic_int that is non-zero while it is held.  The locks
+    guard short critical sections (moving a few pointers or records), so a
+    waiting thread spins on plain loads, and only tries to take the lock
+    again once the holder has released it.
+
+*****************************************************************************/
+
+#ifndef _HZLOCK_H
+#define _HZLOCK_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdatomic.h>
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+static inline void spin_lock(       //take a spin lock
+    atomic_int*         lock        //lock to take
+) {
+
+    //wait for the holder to release the lock
+    while( atomic_exchange_explicit( lock, 1, memory_order_acquire ) != 0 ) {
+        while( atomic_load_explicit( lock, memory_order_relaxed ) != 0 ) {
+        }
+    }
+}
+
+
+/*==========================================================================*/
+static inline void spin_unlock(     //release a spin lock
+    atomic_int*         lock        //lock to release
+) {
+    atomic_store_explicit( lock, 0, memory_order_release );
+}
+
+#endif /* _HZLOCK_H */
@@ -0,0 +1,659 @@
+/*****************************************************************************
+    hzsort.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        The sort treats each string as a sequence of digits, one for each
+        byte of its characters (most significant byte first), plus a digit
+        for the end of the string that is lower than every byte.  Signed
+        characters have their sign bit flipped, so the digits are ordered
+        the same way hzstr_cmp() orders the characters.
+
+        The work array holds each string's pointer, its length in bytes,
+        and 8 bytes of its digits.  The 8 bytes start at the last multiple
+        of 8 at or before the current depth, and are refilled whenever a
+        range of strings reaches the next multiple of 8.
+
+        Each radix pass recurses into every bucket except the largest, and
+        then continues with the largest bucket.  The recursion is therefore
+        no deeper than the log of the number of strings.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "hzsort.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//sort tuning
+#define SORT_BINS ( 257 )           //digits (0 is the end of a string)
+#define SORT_CACHE ( 8 )            //bytes of digits cached for each string
+#define SORT_INSERT ( 8 )           //largest range sorted by insertion
+#define SORT_SMALL ( 64 )           //largest range sorted without a pass
+
+//character digits
+#define CHAR_BYTES ( sizeof( hzstr_char_t ) )
+                                    //digits in each character
+#define CHAR_SIGN ( ( ( hzstr_char_t ) -1 < 0 ) \
+    ? ( 1ul << ( ( 8 * CHAR_BYTES ) - 1 ) ) : 0 )
+                                    //bit flipped to order signed characters
+
+//find the first byte of the cached digits for a depth
+#define sort_base( _d ) ( ( _d ) - ( ( _d ) % SORT_CACHE ) )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct sort_entry_s {       //one string in the work array
+    uint64_t            cache;      //cached digits (first digit is highest)
+    uint32_t            bytes;      //number of digits in the string
+    hzstr_type*         string;     //the string
+} sort_entry_type;
+
+typedef struct sort_job_s {         //buckets shared by a parallel sort
+    sort_entry_type*    entries;    //work array
+    sort_entry_type*    aux;        //scatter array
+    int                 flags;      //sort behavior flags
+    int                 buckets;    //number of buckets to sort
+    int                 order[ SORT_BINS ];
+                                    //buckets from largest to smallest
+    unsigned long       counts[ SORT_BINS ];
+                                    //strings in each bucket
+    unsigned long       starts[ SORT_BINS ];
+                                    //first string of each bucket
+    atomic_int          next;       //next bucket (in order) to sort
+} sort_job_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static unsigned int sort_byte(      //find one byte of a string's digits
+    const hzstr_type*   string,     //the string
+    uint32_t            pos,        //byte position
+    int                 flags       //sort behavior flags
+);                                  //value of the byte
+
+static int sort_compare(            //compare two strings from a depth
+    const sort_entry_type* entry0,  //first string
+    const sort_entry_type* entry1,  //second string
+    uint32_t            depth,      //first digit to compare
+    int                 flags       //sort behavior flags
+);                                  //comparison value (0 means equal)
+
+static unsigned int sort_digit(     //find one digit of a string
+    const sort_entry_type* entry,   //the string
+    uint32_t            pos,        //digit position
+    uint32_t            base,       //position of the first cached digit
+    int                 flags       //sort behavior flags
+);                                  //digit (0 at the end of the string)
+
+static void sort_fill(              //cache the digits at a depth
+    sort_entry_type*    entries,    //strings to update
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit to cache
+    int                 flags       //sort behavior flags
+);
+
+static void sort_insertion(         //sort a small range by insertion
+    sort_entry_type*    entries,    //strings to sort
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit that may differ
+    int                 flags       //sort behavior flags
+);
+
+static void sort_mkqs(              //sort a small range by multikey quicksort
+    sort_entry_type*    entries,    //strings to sort
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit that may differ
+    int                 flags       //sort behavior flags
+);
+
+static void sort_parallel(          //sort the buckets of a range with threads
+    sort_entry_type*    entries,    //strings to sort
+    sort_entry_type*    aux,        //scatter array
+    unsigned long       count,      //number of strings
+    int                 flags       //sort behavior flags
+);
+
+static void sort_pass(              //distribute a range by one digit
+    sort_entry_type*    entries,    //strings to distribute
+    sort_entry_type*    aux,        //scatter array
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //digit to distribute by
+    int                 flags,      //sort behavior flags
+    unsigned long*      counts      //receives the strings in each bucket
+);
+
+static void sort_range(             //sort a range of strings
+    sort_entry_type*    entries,    //strings to sort
+    sort_entry_type*    aux,        //scatter array
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit that may differ
+    int                 flags       //sort behavior flags
+);
+
+static void* sort_worker(           //sort buckets of a parallel sort
+    void*               job         //buckets shared by the sort
+);                                  //always NULL
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_sort(          //sort an array of strings
+    hzstr_type**        strings,    //strings to sort
+    int                 count,      //number of strings
+    int                 flags       //sort behavior flags (HZSTR_SORT_*)
+) {                                 //result of operation
+
+    //local variables
+    sort_entry_type*    entries;    //work array (followed by scatter array)
+    int                 index;      //string index
+
+    //check arguments
+    if( ( count < 0 ) || ( ( strings == NULL ) && ( count > 0 ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //arrays of one string are already sorted
+    if( count < 2 ) {
+        return HZSTR_RSLT_OK;
+    }
+
+    //allocate the work and scatter arrays together
+    entries = mem_malloc( 2 * ( size_t ) count * sizeof( sort_entry_type ) );
+    if( entries == NULL ) {
+        return HZSTR_RSLT_ALLOC;
+    }
+
+    //describe each string (the digits are cached by the sort)
+    for( index = 0; index < count; ++index ) {
+        if( strings[ index ] == NULL ) {
+            mem_free( entries );
+            return HZSTR_RSLT_USAGE;
+        }
+        entries[ index ].string = strings[ index ];
+        entries[ index ].bytes  = strings[ index ]->length * CHAR_BYTES;
+    }
+
+    //sort the strings
+    if( ( ( flags & HZSTR_SORT_PARALLEL ) != 0 )
+     && ( count >= HZSTR_SORT_PARALLEL_MINIMUM ) ) {
+        sort_parallel( entries, ( entries + count ), count, flags );
+    }
+    else {
+        sort_range( entries, ( entries + count ), count, 0, flags );
+    }
+
+    //store the sorted order
+    for( index = 0; index < count; ++index ) {
+        strings[ index ] = entries[ index ].string;
+    }
+    mem_free( entries );
+
+    //return result of sort
+    return HZSTR_RSLT_OK;
+}
+
+
+/*==========================================================================*/
+static unsigned int sort_byte(      //find one byte of a string's digits
+    const hzstr_type*   string,     //the string
+    uint32_t            pos,        //byte position
+    int                 flags       //sort behavior flags
+) {                                 //value of the byte
+
+    //local variables
+    hzstr_char_t        character;  //character holding the byte
+    unsigned long       value;      //character as an ordered value
+
+    //find the character, as it is ordered
+    character = string->data[ pos / CHAR_BYTES ];
+    if( ( ( flags & HZSTR_SORT_NOCASE ) != 0 )
+     && ( character >= 'A' ) && ( character <= 'Z' ) ) {
+        character += 'a' - 'A';
+    }
+    value = ( unsigned long ) character ^ CHAR_SIGN;
+
+    //return the byte (most significant first)
+    return ( value >> ( 8 * ( CHAR_BYTES - 1 - ( pos % CHAR_BYTES ) ) ) )
+        & 0xFF;
+}
+
+
+/*==========================================================================*/
+static int sort_compare(            //compare two strings from a depth
+    const sort_entry_type* entry0,  //first string
+    const sort_entry_type* entry1,  //second string
+    uint32_t            depth,      //first digit to compare
+    int                 flags       //sort behavior flags
+) {                                 //comparison value (0 means equal)
+
+    //local variables
+    uint32_t            base;       //position of the first cached digit
+    unsigned int        digit0;     //digit of the first string
+    unsigned int        digit1;     //digit of the second string
+
+    //compare digits until they differ or both strings end
+    base = sort_base( depth );
+    do {
+        digit0 = sort_digit( entry0, depth, base, flags );
+        digit1 = sort_digit( entry1, depth, base, flags );
+        depth += 1;
+    } while( ( digit0 == digit1 ) && ( digit0 != 0 ) );
+
+    //return the difference in the last digits
+    return ( int ) digit0 - ( int ) digit1;
+}
+
+
+/*==========================================================================*/
+static unsigned int sort_digit(     //find one digit of a string
+    const sort_entry_type* entry,   //the string
+    uint32_t            pos,        //digit position
+    uint32_t            base,       //position of the first cached digit
+    int                 flags       //sort behavior flags
+) {                                 //digit (0 at the end of the string)
+
+    //the end of the string is the lowest digit
+    if( pos >= entry->bytes ) {
+        return 0;
+    }
+
+    //use the cached digits when possible
+    if( ( pos - base ) < SORT_CACHE ) {
+        return ( unsigned int ) ( ( entry->cache
+            >> ( 8 * ( SORT_CACHE - 1 - ( pos - base ) ) ) ) & 0xFF ) + 1;
+    }
+
+    //digits past the cache are read from the string
+    return sort_byte( entry->string, pos, flags ) + 1;
+}
+
+
+/*==========================================================================*/
+static void sort_fill(              //cache the digits at a depth
+    sort_entry_type*    entries,    //strings to update
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit to cache
+    int                 flags       //sort behavior flags
+) {
+
+    //local variables
+    uint64_t            cache;      //digits being cached
+    unsigned long       index;      //string index
+    uint32_t            pos;        //digit position
+
+    //each string's digits are read in order, and padded with zeros
+    for( index = 0; index < count; ++index ) {
+        cache = 0;
+        for( pos = depth; pos < ( depth + SORT_CACHE ); ++pos ) {
+            cache <<= 8;
+            if( pos < entries[ index ].bytes ) {
+                cache |= sort_byte( entries[ index ].string, pos, flags );
+            }
+        }
+        entries[ index ].cache = cache;
+    }
+}
+
+
+/*==========================================================================*/
+static void sort_insertion(         //sort a small range by insertion
+    sort_entry_type*    entries,    //strings to sort
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit that may differ
+    int                 flags       //sort behavior flags
+) {
+
+    //local variables
+    unsigned long       index;      //string index
+    unsigned long       target;     //position of the string being inserted
+    sort_entry_type     entry;      //string being inserted
+
+    //insert each string after every string that is not greater (so equal
+    //  strings keep their order)
+    for( index = 1; index < count; ++index ) {
+        entry  = entries[ index ];
+        target = index;
+        while( ( target > 0 )
+            && ( sort_compare( &entries[ target - 1 ], &entry, depth, flags )
+                > 0 ) ) {
+            entries[ target ] = entries[ target - 1 ];
+            target -= 1;
+        }
+        entries[ target ] = entry;
+    }
+}
+
+
+/*==========================================================================*/
+static void sort_mkqs(              //sort a small range by multikey quicksort
+    sort_entry_type*    entries,    //strings to sort
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit that may differ
+    int                 flags       //sort behavior flags
+) {
+
+    //local variables
+    uint32_t            base;       //position of the first cached digit
+    unsigned int        digit;      //digit of the current string
+    unsigned int        digits[ 3 ];//digits of the pivot candidates
+    unsigned long       greater;    //start of the strings above the pivot
+    unsigned long       index;      //string index
+    unsigned long       less;       //end of the strings below the pivot
+    unsigned int        pivot;      //digit to partition by
+    sort_entry_type     swap;       //string being swapped
+
+    while( count > SORT_INSERT ) {
+
+        //use the median digit of the first, middle, and last strings
+        base = sort_base( depth );
+        digits[ 0 ] = sort_digit( &entries[ 0 ], depth, base, flags );
+        digits[ 1 ] = sort_digit( &entries[ count / 2 ], depth, base, flags );
+        digits[ 2 ] = sort_digit( &entries[ count - 1 ], depth, base, flags );
+        pivot = digits[ 1 ];
+        if( ( digits[ 0 ] > digits[ 1 ] ) == ( digits[ 0 ] < digits[ 2 ] ) ) {
+            pivot = digits[ 0 ];
+        }
+        else if( ( digits[ 2 ] > digits[ 0 ] )
+              == ( digits[ 2 ] < digits[ 1 ] ) ) {
+            pivot = digits[ 2 ];
+        }
+
+        //partition the strings below, equal to, and above the pivot
+        less    = 0;
+        index   = 0;
+        greater = count;
+        while( index < greater ) {
+            digit = sort_digit( &entries[ index ], depth, base, flags );
+            if( digit < pivot ) {
+                swap = entries[ less ];
+                entries[ less ] = entries[ index ];
+                entries[ index ] = swap;
+                less  += 1;
+                index += 1;
+            }
+            else if( digit > pivot ) {
+                greater -= 1;
+                swap = entries[ greater ];
+                entries[ greater ] = entries[ index ];
+                entries[ index ] = swap;
+            }
+            else {
+                index += 1;
+            }
+        }
+
+        //sort the strings below and above the pivot at this depth
+        sort_mkqs( entries, less, depth, flags );
+        sort_mkqs( ( entries + greater ), ( count - greater ), depth, flags );
+
+        //strings that ended at this depth are equal
+        if( pivot == 0 ) {
+            return;
+        }
+
+        //continue with the next digit of the strings equal to the pivot
+        entries += less;
+        count    = greater - less;
+        depth   += 1;
+        if( ( depth % SORT_CACHE ) == 0 ) {
+            sort_fill( entries, count, depth, flags );
+        }
+    }
+
+    //finish small ranges by insertion
+    sort_insertion( entries, count, depth, flags );
+}
+
+
+/*==========================================================================*/
+static void sort_parallel(          //sort the buckets of a range with threads
+    sort_entry_type*    entries,    //strings to sort
+    sort_entry_type*    aux,        //scatter array
+    unsigned long       count,      //number of strings
+    int                 flags       //sort behavior flags
+) {
+
+    //local variables
+    int                 bin;        //bucket index
+    int                 index;      //bucket order index
+    sort_job_type*      job;        //buckets shared by the threads
+    int                 order;      //bucket being placed in order
+    long                processors; //number of online processors
+    unsigned long       start;      //first string of a bucket
+    int                 started;    //number of threads started
+    int                 threads;    //number of threads to use
+    pthread_t           workers[ HZSTR_SORT_THREADS ];
+
+    //the job is shared, so it is not on any thread's stack
+    job = mem_calloc( 1, sizeof( sort_job_type ) );
+    if( job == NULL ) {
+        sort_range( entries, aux, count, 0, flags );
+        return;
+    }
+
+    //distribute the strings by their first digit
+    sort_fill( entries, count, 0, flags );
+    sort_pass( entries, aux, count, 0, flags, job->counts );
+
+    //list the buckets that need sorting from largest to smallest, so the
+    //  largest buckets don't start last
+    start = job->counts[ 0 ];
+    for( bin = 1; bin < SORT_BINS; ++bin ) {
+        job->starts[ bin ] = start;
+        start += job->counts[ bin ];
+        if( job->counts[ bin ] < 2 ) {
+            continue;
+        }
+        for( index = job->buckets; index > 0; --index ) {
+            order = job->order[ index - 1 ];
+            if( job->counts[ order ] >= job->counts[ bin ] ) {
+                break;
+            }
+            job->order[ index ] = order;
+        }
+        job->order[ index ] = bin;
+        job->buckets += 1;
+    }
+    job->entries = entries;
+    job->aux     = aux;
+    job->flags   = flags;
+    atomic_init( &job->next, 0 );
+
+    //use a thread for each processor (and no more threads than buckets)
+    processors = sysconf( _SC_NPROCESSORS_ONLN );
+    threads    = HZSTR_SORT_THREADS;
+    if( ( processors > 0 ) && ( processors < threads ) ) {
+        threads = ( int ) processors;
+    }
+    if( job->buckets < threads ) {
+        threads = job->buckets;
+    }
+
+    //start the other threads (if a thread can't be started, the threads
+    //  that did start take its buckets)
+    for( started = 0; started < ( threads - 1 ); ++started ) {
+        if( pthread_create( &workers[ started ], NULL, sort_worker, job )
+            != 0 ) {
+            break;
+        }
+    }
+
+    //the calling thread sorts buckets too
+    sort_worker( job );
+    while( started > 0 ) {
+        started -= 1;
+        pthread_join( workers[ started ], NULL );
+    }
+    mem_free( job );
+}
+
+
+/*==========================================================================*/
+static void sort_pass(              //distribute a range by one digit
+    sort_entry_type*    entries,    //strings to distribute
+    sort_entry_type*    aux,        //scatter array
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //digit to distribute by
+    int                 flags,      //sort behavior flags
+    unsigned long*      counts      //receives the strings in each bucket
+) {
+
+    //local variables
+    uint32_t            base;       //position of the first cached digit
+    int                 bin;        //bucket index
+    unsigned long       index;      //string index
+    unsigned long       next[ SORT_BINS ];
+                                    //next position in each bucket
+
+    //count the strings in each bucket
+    base = sort_base( depth );
+    memset( counts, 0, ( SORT_BINS * sizeof( unsigned long ) ) );
+    for( index = 0; index < count; ++index ) {
+        counts[ sort_digit( &entries[ index ], depth, base, flags ) ] += 1;
+    }
+
+    //find where each bucket starts
+    next[ 0 ] = 0;
+    for( bin = 1; bin < SORT_BINS; ++bin ) {
+        next[ bin ] = next[ bin - 1 ] + counts[ bin - 1 ];
+    }
+
+    //scatter the strings in order (so equal strings keep their order)
+    for( index = 0; index < count; ++index ) {
+        bin = sort_digit( &entries[ index ], depth, base, flags );
+        aux[ next[ bin ] ] = entries[ index ];
+        next[ bin ] += 1;
+    }
+    mem_copy( entries, aux, ( count * sizeof( sort_entry_type ) ) );
+}
+
+
+/*==========================================================================*/
+static void sort_range(             //sort a range of strings
+    sort_entry_type*    entries,    //strings to sort
+    sort_entry_type*    aux,        //scatter array
+    unsigned long       count,      //number of strings
+    uint32_t            depth,      //first digit that may differ
+    int                 flags       //sort behavior flags
+) {
+
+    //local variables
+    int                 bin;        //bucket index
+    unsigned long       counts[ SORT_BINS ];
+                                    //strings in each bucket
+    int                 largest;    //largest bucket of unfinished strings
+    unsigned long       skip;       //first string of the largest bucket
+    unsigned long       start;      //first string of a bucket
+
+    while( count > 1 ) {
+
+        //cache the next digits when the cached digits are used up
+        if( ( depth % SORT_CACHE ) == 0 ) {
+            sort_fill( entries, count, depth, flags );
+        }
+
+        //small ranges are finished without more passes
+        if( count <= SORT_SMALL ) {
+            if( ( flags & HZSTR_SORT_STABLE ) != 0 ) {
+                sort_insertion( entries, count, depth, flags );
+            }
+            else {
+                sort_mkqs( entries, count, depth, flags );
+            }
+            return;
+        }
+
+        //distribute the strings by the digit at this depth
+        sort_pass( entries, aux, count, depth, flags, counts );
+
+        //find the largest bucket of strings that have not ended
+        largest = 1;
+        for( bin = 2; bin < SORT_BINS; ++bin ) {
+            if( counts[ bin ] > counts[ largest ] ) {
+                largest = bin;
+            }
+        }
+
+        //sort the other buckets by the next digit
+        skip  = 0;
+        start = counts[ 0 ];
+        for( bin = 1; bin < SORT_BINS; ++bin ) {
+            if( bin == largest ) {
+                skip = start;
+            }
+            else if( counts[ bin ] > 1 ) {
+                sort_range(
+                    ( entries + start ), ( aux + start ), counts[ bin ],
+                    ( depth + 1 ), flags
+                );
+            }
+            start += counts[ bin ];
+        }
+
+        //continue with the largest bucket (without recursing)
+        entries += skip;
+        aux     += skip;
+        count    = counts[ largest ];
+        depth   += 1;
+    }
+}
+
+
+/*==========================================================================*/
+static void* sort_worker(           //sort buckets of a parallel sort
+    void*               job         //buckets shared by the sort
+) {                                 //always NULL
+
+    //local variables
+    int                 bin;        //bucket index
+    int                 index;      //bucket order index
+    sort_job_type*      shared;     //buckets shared by the sort
+    unsigned long       start;      //first string of the bucket
+
+    //sort the next bucket until there are none left
+    shared = job;
+    for( ;; ) {
+        index = atomic_fetch_add_explicit(
+            &shared->next, 1, memory_order_relaxed
+        );
+        if( index >= shared->buckets ) {
+            break;
+        }
+        bin   = shared->order[ index ];
+        start = shared->starts[ bin ];
+        sort_range(
+            ( shared->entries + start ), ( shared->aux + start ),
+            shared->counts[ bin ], 1, shared->flags
+        );
+    }
+
+    return NULL;
+}
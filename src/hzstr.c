@@ -15,8 +15,45 @@ Includes
 #include <stdio.h>
 
 #include "hzstr.h"
+#include "hzutf8.h"
 #include "memory.h"
 
+//this defines the library functions behind the header's inline fast paths
+//  and call-site macros
+#undef hzstr_append
+#undef hzstr_cat
+#undef hzstr_create
+#undef hzstr_create_ccstr
+#undef hzstr_create_cstr
+#undef hzstr_create_cstr_n
+#undef hzstr_create_substr
+
+#if defined( __SSE2__ ) && !defined( HZSTR_DSBL_SIMD )
+#include <emmintrin.h>
+#include <stdint.h>
+#endif
+
+#if defined( HZSTR_STATS ) || defined( HZSTR_LATENCY ) \
+ || defined( HZSTR_PROFILE )
+#include <stdatomic.h>
+#include <stdlib.h>
+#endif
+
+#ifdef HZSTR_PROFILE
+#include <stdint.h>
+#include <time.h>
+
+#include "hzlock.h"
+#endif
+
+#ifdef HZSTR_LATENCY
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+#endif
+
 /*----------------------------------------------------------------------------
 Macros
 ----------------------------------------------------------------------------*/
@@ -27,30 +64,419 @@ Macros
 //useful values
 #define MAX_LENGTH ( 65535 )        //largest possible single string
 
+//find the beginning of a dynamic string's allocation
+#define str_base( _s ) ( ( _s )->data - ( _s )->offset )
+
+//count statistics (each thread counts into its own block of counters)
+#ifdef HZSTR_STATS
+#define stat_call( _f ) stats_call( _f )
+#define stat_count( _c, _n ) stats_count( ( _c ), ( _n ) )
+#define stat_moved( _n ) stats_moved( _n )
+#else
+#define stat_call( _f )
+#define stat_count( _c, _n )
+#define stat_moved( _n ) ( ( void ) 0 )
+#endif
+
+//copy or move bytes (the statistics count them as moved)
+#define str_copy( _d, _s, _n ) \
+    ( stat_moved( _n ), mem_copy( ( _d ), ( _s ), ( _n ) ) )
+#define str_move( _d, _s, _n ) \
+    ( stat_moved( _n ), mem_move( ( _d ), ( _s ), ( _n ) ) )
+
+//statistics counters (per-function counters follow the totals)
+#ifdef HZSTR_STATS
+#define STAT_GROWS ( 0 )            //allocations grown by check_alloc()
+#define STAT_REQUESTED ( 1 )        //bytes requested from str_alloc()
+#define STAT_ALLOCATED ( 2 )        //bytes allocated by str_alloc()
+#define STAT_MINIMIZED ( 3 )        //bytes released by hzstr_minimize()
+#define STAT_CALLS ( 4 )            //calls of each function
+#define STAT_MOVED ( STAT_CALLS + HZSTR_NUM_STATS )
+                                    //bytes moved by each function
+#define STAT_COUNTERS ( STAT_MOVED + HZSTR_NUM_STATS )
+                                    //number of counters
+#endif
+
+//time a call (the probe's clean-up function records the time when the
+//  call returns, from any of its return statements)
+#ifdef HZSTR_LATENCY
+#define lat_scope( _o ) lat_probe_type lat_probe \
+    __attribute__(( cleanup( lat_stop ) )) = lat_start( _o )
+#else
+#define lat_scope( _o )
+#endif
+
+//check the allocation of a string a timed operation writes (only calls that
+//  grow the string are counted, and one in every HZSTR_LATENCY_RATE is timed)
+#ifdef HZSTR_LATENCY
+#define lat_check_alloc( _o, _s, _l ) lat_grow( ( _o ), ( _s ), ( _l ) )
+#else
+#define lat_check_alloc( _o, _s, _l ) check_alloc( ( _s ), ( _l ) )
+#endif
+
+//latency clock and histograms (each power of two is split into LAT_SUB
+//  buckets, so a bucket's width is under 1/8 of the times in it)
+#ifdef HZSTR_LATENCY
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define lat_clock() ( ( unsigned long ) __rdtsc() )
+#define LAT_UNIT "ticks"            //unit of the recorded times
+#else
+#define lat_clock() lat_nanoseconds()
+#define LAT_UNIT "ns"               //unit of the recorded times
+#endif
+#define LAT_SUB_BITS ( 3 )          //bits of a time used below its top bit
+#define LAT_SUB ( 1 << LAT_SUB_BITS )
+                                    //buckets for each power of two
+#define LAT_BITS ( ( int ) sizeof( unsigned long ) * 8 )
+                                    //bits in a time
+#define LAT_BUCKETS ( ( LAT_BITS - LAT_SUB_BITS + 1 ) * LAT_SUB )
+                                    //buckets in a histogram
+#endif
+
+//diagnostic memory (statistics counters, latency histograms and profiles)
+//  is not allocated through mem_*, so measuring does not change the
+//  allocations being measured (or tested)
+#if defined( HZSTR_STATS ) || defined( HZSTR_LATENCY ) \
+ || defined( HZSTR_PROFILE )
+#define diag_calloc calloc
+#define diag_free free
+#endif
+
+//track live strings in profiling builds
+#ifdef HZSTR_PROFILE
+#define prof_add( _s ) profile_add( _s )
+#define prof_remove( _s ) profile_remove( _s )
+#else
+#define prof_add( _s )
+#define prof_remove( _s )
+#endif
+
+//live string table parameters
+#ifdef HZSTR_PROFILE
+#define PROF_TABLE ( 4096 )         //lists of live strings (a power of 2)
+#define PROF_SITES ( 1024 )         //call sites (site 0 is the unknown site)
+#define prof_list( _s ) \
+    ( ( ( uintptr_t ) ( _s ) / sizeof( hzstr_type ) ) & ( PROF_TABLE - 1 ) )
+#endif
+
+//smallest shrink factor (a shrunk string has room to double its length)
+#define SHRINK_LEAST ( 4 )
+
+//flags describing a string's encoding
+#define TEXT_FLAGS ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 )
+
+//value of a character for hashing (bytes are hashed as unsigned values, so
+//  the hash of a C-string does not depend on the signedness of char)
+#define hash_char( _c ) ( ( hzstr_hash_t ) ( sizeof( _c ) == 1 \
+    ? ( unsigned char ) ( _c ) : ( _c ) ) )
+
+//check for a whitespace character (any type, any signedness)
+#define str_space( _c ) ( ( unsigned long ) ( _c ) <= ' ' )
+
+//use vector scans when the target supports them
+#if defined( __SSE2__ ) && !defined( HZSTR_DSBL_SIMD )
+#define USE_SSE2
+#define VEC_SIZE ( 16 )             //bytes in a vector register
+#endif
+
+//vector scans work on 8-bit, 16-bit and 32-bit characters (the width is
+//  known at compile time, so each build keeps only its own lane width)
+#ifdef USE_SSE2
+#define VEC_CHARS ( VEC_SIZE / sizeof( hzstr_char_t ) )
+#define VEC_WIDTH_OK ( sizeof( hzstr_char_t ) <= 4 )
+#define vec_lane( _m ) ( __builtin_ctz( _m ) / sizeof( hzstr_char_t ) )
+#define vec_rlane( _m ) \
+    ( ( 31 - __builtin_clz( _m ) ) / sizeof( hzstr_char_t ) )
+#endif
+
+//aligned vector loads may read past the end of a C-string (never past the
+//  end of its page), which the address sanitizer would report
+#if defined( USE_SSE2 ) && defined( __SANITIZE_ADDRESS__ )
+#define NO_SANITIZE __attribute__(( no_sanitize_address ))
+#else
+#define NO_SANITIZE
+#endif
+
 /*----------------------------------------------------------------------------
 Types and Structures
 ----------------------------------------------------------------------------*/
 
+#if defined( HZSTR_STATS ) || defined( HZSTR_LATENCY )
+typedef struct thread_block_s {     //start of one thread's block of data
+    struct thread_block_s* next;    //next thread's block
+} thread_block_type;
+#endif
+
+#ifdef HZSTR_STATS
+typedef struct stats_block_s {      //one thread's statistics counters
+    thread_block_type   link;       //link to the next thread's counters
+    int                 current;    //function most recently called
+    atomic_ulong        counters[ STAT_COUNTERS ];
+                                    //counters (only written by the thread)
+} stats_block_type;
+#endif
+
+#ifdef HZSTR_LATENCY
+typedef struct lat_block_s {        //one thread's latency histograms
+    thread_block_type   link;       //link to the next thread's histograms
+    atomic_ulong        counts[ HZSTR_NUM_LATS ][ LAT_BUCKETS ];
+                                    //times in each bucket
+    atomic_ulong        maximums[ HZSTR_NUM_LATS ];
+                                    //longest time of each operation
+    atomic_ulong        totals[ HZSTR_NUM_LATS ];
+                                    //sum of the times of each operation
+} lat_block_type;
+
+typedef struct lat_probe_s {        //one call that may be timed
+    unsigned long       start;      //clock at the start (0 if not timed)
+    int                 operation;  //operation called (HZSTR_LAT_*)
+} lat_probe_type;
+#endif
+
+#ifdef HZSTR_PROFILE
+typedef struct prof_entry_s {       //one live string
+    struct prof_entry_s* next;      //next string in the same list
+    const hzstr_type*   string;     //the string
+    unsigned long       created;    //time it was created (milliseconds)
+    int                 site;       //call site that created it (0 if unknown)
+} prof_entry_type;
+
+typedef struct prof_site_s {        //one call site
+    const char*         file;       //source file (NULL if not used)
+    int                 line;       //source line
+} prof_site_type;
+#endif
+
 /*----------------------------------------------------------------------------
 Memory Constants
 ----------------------------------------------------------------------------*/
 
+#ifdef HZSTR_LATENCY
+static const char* const lat_names[ HZSTR_NUM_LATS ] = {
+    "allocation",
+    "hzstr_append",
+    "hzstr_cat",
+    "hzstr_cat_cstr",
+    "hzstr_cpy",
+    "hzstr_cpy_cstr",
+    "hzstr_sprintf"
+};
+#endif
+
 /*----------------------------------------------------------------------------
 Module Variables
 ----------------------------------------------------------------------------*/
 
+static unsigned int     shrink_factor = HZSTR_SHRINK_FACTOR;
+                                    //allocation to length ratio to shrink at
+static hzstr_length_t   shrink_minimum = HZSTR_SHRINK_MINIMUM;
+                                    //largest allocation never shrunk
+
+#ifdef HZSTR_STATS
+static _Atomic( thread_block_type* ) stats_blocks;
+                                    //every thread's counters
+static atomic_ulong     stats_base[ STAT_COUNTERS ];
+                                    //totals at the last reset
+static _Thread_local stats_block_type* stats_local;
+                                    //this thread's counters
+#endif
+
+#ifdef HZSTR_LATENCY
+static _Atomic( thread_block_type* ) lat_blocks;
+                                    //every thread's histograms
+static atomic_uint      lat_rate = HZSTR_LATENCY_RATE;
+                                    //one call in this many is timed
+static _Thread_local unsigned int lat_countdowns[ HZSTR_NUM_LATS ];
+                                    //calls until this thread times each
+static _Thread_local lat_block_type* lat_local;
+                                    //this thread's histograms
+#endif
+
+#ifdef HZSTR_PROFILE
+static atomic_int       prof_lock;  //lock of the tables below
+static prof_entry_type* prof_lists[ PROF_TABLE ];
+                                    //live strings (listed by address)
+static prof_site_type   prof_sites[ PROF_SITES ];
+                                    //call sites (found by line)
+#endif
+
 /*----------------------------------------------------------------------------
 Module Prototypes
 ----------------------------------------------------------------------------*/
 
 static hzstr_result_t check_alloc(  //check a string's allocation
     hzstr_type*         string,     //the string to check
-    hzstr_length_t      length      //the desired length of the string
+    unsigned long       length      //the desired length of the string
+);                                  //result of the check
+
+#ifdef HZSTR_LATENCY
+static lat_block_type* lat_block(   //find this thread's latency histograms
+    void
+);                                  //histograms (NULL if there is no memory)
+
+static int lat_bucket(              //find the histogram bucket of a time
+    unsigned long       time        //recorded time
+);                                  //bucket index
+
+static unsigned long lat_floor(     //find the shortest time in a bucket
+    int                 bucket      //bucket index
+);                                  //shortest time in the bucket
+
+static inline hzstr_result_t lat_grow(
+                                    //check an allocation, timing growths
+    int                 operation,  //operation growing it (HZSTR_LAT_*)
+    hzstr_type*         string,     //the string to check
+    unsigned long       length      //the desired length of the string
 );                                  //result of the check
 
-static hzstr_length_t cstr_len(     //compute length of C-string
-    const char*         cstring     //pointer to C-string
-);                                  //length of C-string
+#if !defined( __x86_64__ ) && !defined( __i386__ )
+static unsigned long lat_nanoseconds(
+                                    //read the monotonic clock
+    void
+);                                  //current time in nanoseconds
+#endif
+
+static unsigned long lat_percentile(//find a percentile of a histogram
+    const unsigned long* counts,    //times in each bucket (LAT_BUCKETS)
+    unsigned long       samples,    //number of times
+    unsigned long       maximum,    //longest time
+    unsigned long       permille    //percentile (in tenths of a percent)
+);                                  //highest time in the percentile's bucket
+
+static void lat_record(             //record the time of a call
+    int                 operation,  //operation called (HZSTR_LAT_*)
+    unsigned long       time        //time taken
+);
+
+static inline lat_probe_type lat_start(
+                                    //start a call that may be timed
+    int                 operation   //operation called (HZSTR_LAT_*)
+);                                  //probe for the call
+
+static inline void lat_stop(        //finish a call that may be timed
+    lat_probe_type*     probe       //probe for the call
+);
+
+static hzstr_result_t lat_timed_grow(
+                                    //time one string growth
+    int                 operation,  //operation growing it (HZSTR_LAT_*)
+    hzstr_type*         string,     //the string to grow
+    unsigned long       length      //the desired length of the string
+) __attribute__(( cold, noinline )); //result of the check
+
+static void lat_total(              //add up every thread's histograms
+    int                 operation,  //operation to add up (HZSTR_LAT_*)
+    unsigned long*      counts,     //times in each bucket (LAT_BUCKETS)
+    hzstr_latency_type* summary     //samples, total and maximum output
+);
+#endif
+
+#ifdef HZSTR_PROFILE
+static void profile_add(            //add a new string to the live strings
+    const hzstr_type*   string      //new string
+);
+
+static int profile_bucket(          //find the distribution bucket of a value
+    unsigned long       value       //value (in the distribution's units)
+);                                  //bucket index
+
+static unsigned long profile_clock( //read the monotonic clock
+    void
+);                                  //current time in milliseconds
+
+static int profile_collect(         //add up the live strings of every site
+    hzstr_profile_site_type* totals //totals of each site (PROF_SITES)
+);                                  //number of sites with live strings
+
+static int profile_compare(         //order sites by slack (for qsort)
+    const void*         site0,      //first site
+    const void*         site1       //second site
+);                                  //<0 if site0 holds more slack
+
+static prof_entry_type** profile_find(
+                                    //find the entry of a live string
+    const hzstr_type*   string      //string to find
+);                                  //link to its entry (to NULL if not found)
+
+static void profile_remove(         //remove a string from the live strings
+    const hzstr_type*   string      //string being destroyed
+);
+
+static int profile_site(            //find (or add) a call site
+    const char*         file,       //source file
+    int                 line        //source line
+);                                  //site index (0 if the table is full)
+#endif
+
+static hzstr_length_t rspan_space(  //find the end of the last non-whitespace
+    const hzstr_char_t* data,       //character data to scan
+    hzstr_length_t      length      //number of characters to scan
+);                                  //length without trailing whitespace
+
+static hzstr_length_t span_space(   //count leading whitespace
+    const hzstr_char_t* data,       //character data to scan
+    hzstr_length_t      length      //number of characters to scan
+);                                  //number of whitespace characters
+
+static hzstr_length_t span_text(    //count leading non-whitespace
+    const hzstr_char_t* data,       //character data to scan
+    hzstr_length_t      length      //number of characters to scan
+);                                  //number of non-whitespace characters
+
+static unsigned long cstr_len(      //compute length of C-string
+    const char*         cstring,    //pointer to C-string
+    unsigned long       limit       //stop scanning after this many characters
+);                                  //length of C-string (limit if longer)
+
+static unsigned long cstr_chars(    //count characters stored for C-string
+    const char*         cstring,    //pointer to C-string data
+    unsigned long       length      //number of bytes of C-string data
+);                                  //number of string characters
+
+static hzstr_flags_t cstr_encoding( //check the encoding of C-string data
+    const char*         cstring,    //pointer to C-string data
+    unsigned long       length      //number of characters to check
+);                                  //encoding flags
+
+static unsigned long cstr_widen(    //store C-string data as characters
+    hzstr_char_t*       data,       //string characters (sized by cstr_chars)
+    const char*         cstring,    //pointer to C-string data
+    unsigned long       length      //number of bytes of C-string data
+);                                  //number of characters stored
+
+static hzstr_flags_t str_encoding(  //check the encoding of string data
+    const hzstr_char_t* data,       //character data to check
+    hzstr_length_t      length      //number of characters to check
+);                                  //encoding flags
+
+static int str_boundary(            //check for a UTF-8 sequence boundary
+    const hzstr_type*   string,     //string to check
+    hzstr_index_t       offset      //offset of character to check
+);                                  //non-zero if a sequence starts here
+
+#ifdef HZSTR_STATS
+static stats_block_type* stats_block(
+                                    //find this thread's statistics counters
+    void
+);                                  //counters (NULL if there is no memory)
+
+static void stats_call(             //count a call of a library function
+    int                 function    //function called (HZSTR_STAT_*)
+);
+
+static void stats_count(            //add to a statistics counter
+    int                 counter,    //counter to add to (STAT_*)
+    unsigned long       amount      //amount to add
+);
+
+static void stats_moved(            //count bytes moved by the last function
+    unsigned long       bytes       //number of bytes moved
+);
+
+static void stats_total(            //add up every thread's counters
+    unsigned long*      totals      //counter totals (STAT_COUNTERS)
+);
+#endif
 
 static hzstr_length_t str_alloc(    //allocate/re-allocate string memory
     hzstr_char_t**      target,     //target string pointer
@@ -58,6 +484,98 @@ static hzstr_length_t str_alloc(    //allocate/re-allocate string memory
     hzstr_length_t      length      //length to allocate
 );                                  //number of bytes actually allocated
 
+static void str_compact(            //reclaim a string's consumed characters
+    hzstr_type*         string      //the string to compact
+);
+
+static void str_consume(            //advance the front of a string
+    hzstr_type*         string,     //the string to advance
+    hzstr_length_t      length      //number of characters to skip
+);
+
+static hzstr_result_t str_copy_cstr(//copy C-string data into a string
+    hzstr_type*         target,     //copy target (dynamic)
+    const char*         source,     //copy source
+    hzstr_length_t      length,     //number of characters in the source
+    hzstr_flags_t       encoding    //encoding flags of the source
+);                                  //result of operation
+
+static hzstr_index_t str_find(      //find a substring in character data
+    const hzstr_char_t* data,       //character data to search
+    hzstr_length_t      length,     //number of characters to search
+    const hzstr_type*   needle      //substring to search for
+);                                  //index of substring in data (-1=none)
+
+static hzstr_result_t str_trim(     //trim either end of a string in-place
+    hzstr_type*         string,     //string to trim
+    int                 left,       //non-zero to trim leading whitespace
+    int                 right       //non-zero to trim trailing whitespace
+);                                  //result of operation
+
+static hzstr_result_t str_import(   //import an untrusted string
+    hzstr_type*         string,     //existing string to use for storage
+    const char*         source,     //C string to import
+    hzstr_length_t      length,     //maximum length to import
+    hzstr_flags_t       required    //encoding flags the source must have
+);                                  //result of operation
+
+static int str_overlaps(            //check if two strings share storage
+    const hzstr_type*   string,     //string that owns its storage
+    const hzstr_type*   other       //string that may refer to that storage
+);                                  //non-zero if the storage overlaps
+
+static void str_shrink(             //apply the shrink policy to a string
+    hzstr_type*         string      //the string that may be shrunk
+);
+
+static hzstr_result_t str_splice(   //replace a range of a string's data
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //beginning offset of range to replace
+    hzstr_length_t      length,     //number of characters to replace
+    const hzstr_char_t* source,     //replacement characters
+    hzstr_length_t      insert,     //number of replacement characters
+    hzstr_flags_t       encoding    //encoding flags of replacement
+);                                  //result of operation
+
+#if defined( HZSTR_STATS ) || defined( HZSTR_LATENCY )
+static void thread_add(             //add to one of this thread's counters
+    atomic_ulong*       counter,    //counter in this thread's block
+    unsigned long       amount      //amount to add
+);
+
+static void* thread_block(          //add a block of data for this thread
+    _Atomic( thread_block_type* )* blocks,
+                                    //every thread's blocks
+    size_t              size        //size of the block
+);                                  //new block (NULL if there is no memory)
+#endif
+
+#ifdef USE_SSE2
+static __m128i vec_add(             //add characters in each lane
+    __m128i             a,          //first vector
+    __m128i             b           //second vector
+);                                  //lane-wise sum
+
+static __m128i vec_at_most(         //compare lanes as unsigned characters
+    __m128i             a,          //characters to check
+    __m128i             b           //limit for each lane
+);                                  //all bits set in lanes where a <= b
+
+static __m128i vec_equal(           //compare lanes for equality
+    __m128i             a,          //first vector
+    __m128i             b           //second vector
+);                                  //all bits set in lanes where a == b
+
+static __m128i vec_fill(            //place a character in every lane
+    hzstr_char_t        c           //character to place
+);                                  //vector of the character
+
+static __m128i vec_sub(             //subtract characters in each lane
+    __m128i             a,          //first vector
+    __m128i             b           //second vector
+);                                  //lane-wise difference
+#endif
+
 /*----------------------------------------------------------------------------
 Functions
 ----------------------------------------------------------------------------*/
@@ -66,12 +584,14 @@ Functions
 /*==========================================================================*/
 hzstr_result_t hzstr_append(        //append character onto end of string
     hzstr_type*         string,     //target string
-    char                c           //character to append
+    hzstr_char_t        c           //character to append
 ) {                                 //result of appending
 
     //local variables
     hzstr_result_t      result;     //allocation result
 
+    stat_call( HZSTR_STAT_APPEND );
+
     //check pointer
     if( string == NULL ) {
         return HZSTR_RSLT_USAGE;
@@ -83,13 +603,20 @@ hzstr_result_t hzstr_append(        //append character onto end of string
     }
 
     //check allocation of target string
-    result = check_alloc( string, ( string->length + 1 ) );
+    result = lat_check_alloc(
+        HZSTR_LAT_APPEND, string, ( string->length + 1 )
+    );
     if( result < HZSTR_RSLT_OK ) {
         return result;
     }
 
+    //a single non-ASCII character may or may not finish a UTF-8 sequence
+    if( ( unsigned long ) c > 0x7F ) {
+        string->flags &= ~TEXT_FLAGS;
+    }
+
     //append the character
-    string->data[ string->length ] = ( hzstr_char_t ) c;
+    string->data[ string->length ] = c;
     string->length += 1;
     string->data[ string->length ] = 0;
 
@@ -106,6 +633,8 @@ hzstr_type* hzstr_create(           //create a new string
     //local variables
     hzstr_type*         string;     //pointer to new string
 
+    stat_call( HZSTR_STAT_CREATE );
+
     //allocate a string object
     string = mem_calloc( 1, sizeof( hzstr_type ) );
 
@@ -124,10 +653,11 @@ hzstr_type* hzstr_create(           //create a new string
         //null terminate string
         string->data[ 0 ] = 0;
 
-        //initialize string object
+        //initialize string object (an empty string is ASCII)
         string->type  = HZSTR_TYPE_DYNAMIC;
-        string->flags = HZSTR_FLG_WRITABLE;
+        string->flags = HZSTR_FLG_WRITABLE | TEXT_FLAGS;
         string->alloc = length;
+        prof_add( string );
     }
 
     //return the string pointer
@@ -143,8 +673,17 @@ hzstr_type* hzstr_create_ccstr(     //create new string using a const C-string
 ) {                                 //pointer to new string
 
     //local variables
+    unsigned long       length;     //length of C-string
     hzstr_type*         string;     //pointer to new string
 
+    stat_call( HZSTR_STAT_CREATE_CCSTR );
+
+    //find the length of the C-string, and make sure it can be represented
+    length = cstr_len( cstring, MAX_LENGTH );
+    if( length >= MAX_LENGTH ) {
+        return NULL;
+    }
+
     //allocate a string object
     string = mem_calloc( 1, sizeof( hzstr_type ) );
 
@@ -156,7 +695,8 @@ hzstr_type* hzstr_create_ccstr(     //create new string using a const C-string
 
         //initialize the string object
         string->type   = HZSTR_TYPE_CONST;
-        string->length = cstr_len( string->data );
+        string->length = length;
+        prof_add( string );
     }
 
     //return the new string object
@@ -171,17 +711,50 @@ hzstr_type* hzstr_create_cstr(      //create new string from a C-string
     const char*         cstring     //C string
 ) {                                 //pointer to new string
 
+    //local variables
+    unsigned long       length;     //length of C-string
+    hzstr_type*         string;     //pointer to new string
+
+    stat_call( HZSTR_STAT_CREATE_CSTR );
+
+    //find the length of the C-string, and make sure it can be represented
+    length = cstr_len( cstring, MAX_LENGTH );
+    if( length >= MAX_LENGTH ) {
+        return NULL;
+    }
+
+    //create the string without scanning the C-string again
+    string = hzstr_create_cstr_n( cstring, length );
+
+    //record the encoding of the string's characters
+    if( string != NULL ) {
+        string->flags |= cstr_encoding( cstring, length );
+    }
+
+    //return the new string
+    return string;
+}
+
+
+/*==========================================================================*/
+hzstr_type* hzstr_create_cstr_n(    //create string from a sized C-string
+    const char*         cstring,    //C string
+    hzstr_length_t      length      //number of characters in the C string
+) {                                 //pointer to new string
+
     //local variables
     hzstr_type*         string;     //pointer to new string
 
+    stat_call( HZSTR_STAT_CREATE_CSTR_N );
+
     //allocate the string
-    string = hzstr_create( cstr_len( cstring ) );
+    string = hzstr_create( length );
 
     //check allocation
     if( string != NULL ) {
 
-        //copy the C string into the string
-        hzstr_cpy_cstr( string, cstring );
+        //copy the C string into the string (its encoding is not checked)
+        hzstr_cpy_cstr_n( string, cstring, length );
     }
 
     //return the new string
@@ -199,6 +772,8 @@ hzstr_type* hzstr_create_substr(    //create a substring of another string
     //local variables
     hzstr_type*         string;     //pointer to new string
 
+    stat_call( HZSTR_STAT_CREATE_SUBSTR );
+
     //validate the requested substring
     if( ( offset >= source->length             )
      || ( length > ( source->length - offset ) ) ) {
@@ -218,6 +793,15 @@ hzstr_type* hzstr_create_substr(    //create a substring of another string
         string->type   = HZSTR_TYPE_SUBSTR;
         string->alloc  = 0;
         string->length = length;
+
+        //the substring keeps the source's encoding unless it splits a
+        //  UTF-8 sequence
+        string->flags = source->flags & TEXT_FLAGS;
+        if( ( str_boundary( source, offset ) == 0 )
+         || ( str_boundary( source, ( offset + length ) ) == 0 ) ) {
+            string->flags &= ~HZSTR_FLG_UTF8;
+        }
+        prof_add( string );
     }
 
     //return the new string
@@ -234,22 +818,26 @@ hzstr_result_t hzstr_cat(           //concatenate two strings
     //local variables
     hzstr_result_t      result;     //allocation result
 
+    stat_call( HZSTR_STAT_CAT );
+
     //check the type of target string
     if( target->type != HZSTR_TYPE_DYNAMIC ) {
         return HZSTR_RSLT_TYPE;
     }
 
     //check allocation of target string
-    result = check_alloc( target, ( target->length + source->length ) );
+    result = lat_check_alloc(
+        HZSTR_LAT_CAT, target, ( target->length + source->length )
+    );
     if( result < HZSTR_RSLT_OK ) {
         return result;
     }
 
     //copy the source data onto the end of the target data
-    mem_copy(
+    str_copy(
         &( target->data[ target->length ] ),
         source->data,
-        source->length
+        ( source->length * sizeof( hzstr_char_t ) )
     );
 
     //update the length of the target
@@ -258,6 +846,9 @@ hzstr_result_t hzstr_cat(           //concatenate two strings
     //null-terminate the target string
     target->data[ target->length ] = 0;
 
+    //the result is only known to be what both strings are known to be
+    target->flags &= source->flags | ~TEXT_FLAGS;
+
     //return the new length
     return target->length;
 }
@@ -268,44 +859,74 @@ hzstr_result_t hzstr_cat_cstr(      //concatenate a C-string onto a string
     hzstr_type*         target,     //concatenation target
     const char*         source      //concatenation source
 ) {                                 //result of operation
+
     //local variables
-#ifndef HZSTR_COMPAT_CSTR
-    hzstr_index_t       index;      //index
-#endif
-    hzstr_length_t      length;     //length of source string
-    hzstr_result_t      result;     //allocation result
+    hzstr_flags_t       known;      //what is known about the target
+    unsigned long       length;     //length of source string
+    hzstr_result_t      result;     //result of concatenation
+
+    stat_call( HZSTR_STAT_CAT_CSTR );
 
     //check the type of target string
     if( target->type != HZSTR_TYPE_DYNAMIC ) {
         return HZSTR_RSLT_TYPE;
     }
 
-    //find the length of the source string
-    length = cstr_len( source );
+    //find the length of the source string (no longer than can be stored)
+    length = cstr_len( source, ( MAX_LENGTH - target->length ) );
+    if( ( target->length + length ) >= MAX_LENGTH ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //concatenate the source without scanning it again
+    known  = target->flags & TEXT_FLAGS;
+    result = hzstr_cat_cstr_n( target, source, length );
 
-    //check allocation of target string
-    result = check_alloc( target, ( target->length + length ) );
-    if( result < HZSTR_RSLT_OK ) {
-        return result;
+    //check the new characters (if anything is known about the target)
+    if( ( result >= HZSTR_RSLT_OK ) && ( known != 0 ) ) {
+        target->flags |= known & cstr_encoding( source, length );
     }
 
-#ifdef HZSTR_COMPAT_CSTR
+    //return new length of target
+    return result;
+}
 
-    //copy the source onto the end of the target
-    mem_copy( ( target->data + target->length ), source, length );
 
-#else
+/*==========================================================================*/
+hzstr_result_t hzstr_cat_cstr_n(    //concatenate a known-length C-string
+    hzstr_type*         target,     //concatenation target
+    const char*         source,     //concatenation source
+    hzstr_length_t      length      //number of characters in the source
+) {                                 //result of operation
 
-    //copy the source onto the end of the target
-    for( index = 0; index < length; ++index ) {
-        target->data[ target->length + index ]
-            = ( hzstr_char_t ) source[ index ];
+    //local variables
+    unsigned long       chars;      //number of characters to store
+    hzstr_result_t      result;     //allocation result
+
+    stat_call( HZSTR_STAT_CAT_CSTR_N );
+
+    //check the type of target string
+    if( target->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
     }
 
-#endif
+    //check allocation of target string (once, for the exact length)
+    chars  = cstr_chars( source, length );
+    result = lat_check_alloc(
+        HZSTR_LAT_CAT_CSTR, target, ( target->length + chars )
+    );
+    if( result < HZSTR_RSLT_OK ) {
+        return result;
+    }
+
+    //store the source on the end of the target
+    cstr_widen( ( target->data + target->length ), source, length );
+
+    //nothing is known about the new characters
+    target->flags &= ~TEXT_FLAGS;
 
     //update the length of the target string
-    target->length += length;
+    target->length += chars;
 
     //null-terminate target string
     target->data[ target->length ] = 0;
@@ -322,32 +943,51 @@ hzstr_result_t hzstr_cpy(           //copy one string into another
 ) {                                 //result of operation
 
     //local variables
+    const hzstr_char_t* chars;      //source characters
+    hzstr_length_t      length;     //number of source characters
     hzstr_result_t      result;     //allocation result
 
+    stat_call( HZSTR_STAT_CPY );
+
     //check the type of target string
     if( target->type != HZSTR_TYPE_DYNAMIC ) {
         return HZSTR_RSLT_TYPE;
     }
 
-    //check allocation of target string
-    result = check_alloc( target, source->length );
-    if( result < HZSTR_RSLT_OK ) {
-        return result;
+    //find the source before the target changes (the source may be the
+    //  target, or a view of it)
+    chars  = source->data;
+    length = source->length;
+
+    //check allocation of target string (a source in the target's memory
+    //  always fits, so it is never moved by a re-allocation)
+    if( target->alloc < ( length + 1 ) ) {
+        result = lat_check_alloc( HZSTR_LAT_CPY, target, length );
+        if( result < HZSTR_RSLT_OK ) {
+            return result;
+        }
     }
 
-    //copy the source data into the target
-    mem_copy(
-        target->data,
-        source->data,
-        ( source->length * sizeof( hzstr_char_t ) )
-    );
+    //the entire string is replaced, so consumed characters can be re-used
+    target->data  -= target->offset;
+    target->offset = 0;
+
+    //move the source data into the target (the two may overlap)
+    str_move( target->data, chars, ( length * sizeof( hzstr_char_t ) ) );
 
     //update the length of the target string
-    target->length = source->length;
+    target->length = length;
 
     //null-terminate target string
     target->data[ target->length ] = 0;
 
+    //the target is now known to be whatever the source is known to be
+    target->flags = ( target->flags & ~TEXT_FLAGS )
+                  | ( source->flags &  TEXT_FLAGS );
+
+    //a much shorter string may be shrunk
+    str_shrink( target );
+
     //return new length of target
     return target->length;
 }
@@ -360,46 +1000,105 @@ hzstr_result_t hzstr_cpy_cstr(      //copy a C-string into a string
 ) {                                 //result of operation
 
     //local variables
-#ifndef HZSTR_COMPAT_CSTR
-    hzstr_index_t       index;      //index
-#endif
-    hzstr_length_t      length;     //length of string copied
-    hzstr_result_t      result;     //allocation result
+    unsigned long       length;     //length of string copied
+    hzstr_result_t      result;     //result of copy
+
+    stat_call( HZSTR_STAT_CPY_CSTR );
 
     //check the type of string
     if( target->type != HZSTR_TYPE_DYNAMIC ) {
         return HZSTR_RSLT_TYPE;
     }
 
-    //get the length of the C-string
-    length = cstr_len( source );
+    //get the length of the C-string (no longer than can be stored)
+    length = cstr_len( source, MAX_LENGTH );
+    if( length >= MAX_LENGTH ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //copy the C-string without scanning it again
+    result = hzstr_cpy_cstr_n( target, source, length );
 
-    //check allocation for this string
-    result = check_alloc( target, length );
-    if( result < HZSTR_RSLT_OK ) {
-        return result;
+    //record the encoding of the new characters
+    if( result >= HZSTR_RSLT_OK ) {
+        target->flags |= cstr_encoding( source, length );
     }
 
-#ifdef HZSTR_COMPAT_CSTR
+    //return new length of target
+    return result;
+}
 
-    //copy the C-string (including NULL byte) into the string
-    mem_copy( target->data, source, ( length + 1 ) );
 
-#else
+/*==========================================================================*/
+hzstr_result_t hzstr_cpy_cstr_n(    //copy a known-length C-string
+    hzstr_type*         target,     //copy target
+    const char*         source,     //copy source
+    hzstr_length_t      length      //number of characters in the source
+) {                                 //result of operation
 
-    //do not assume a single-byte type
-    for( index = 0; index < ( length + 1 ); ++index ) {
-        target->data[ index ] = ( hzstr_char_t ) source[ index ];
+    stat_call( HZSTR_STAT_CPY_CSTR_N );
+
+    //check the type of string
+    if( target->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
     }
 
-#endif
+    //copy the C-string (its encoding is not checked)
+    return str_copy_cstr( target, source, length, 0 );
+}
 
-    //update the string's length
-    target->length = length;
 
-    //return length of string
-    return target->length;
+/*==========================================================================*/
+hzstr_result_t hzstr_consume(       //remove characters from the front
+    hzstr_type*         string,     //string to modify
+    hzstr_length_t      length      //number of characters to remove
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_CONSUME );
+
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //check the type of string
+    if( string->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
+
+    //make sure the characters exist
+    if( length > string->length ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //the rest of the string is UTF-8 if a sequence starts after the range
+    if( str_boundary( string, length ) == 0 ) {
+        string->flags &= ~HZSTR_FLG_UTF8;
+    }
+
+    //skip over the characters
+    str_consume( string, length );
+
+    //return new length of string
+    return string->length;
+}
+
+
+#ifdef HZSTR_COMPAT_CSTR
+/*==========================================================================*/
+long hzstr_casecmp(                 //compare two strings ignoring case
+    const hzstr_type*   string0,    //first string
+    const hzstr_type*   string1     //second string
+) {                                 //comparison value (0 means equal)
+
+    stat_call( HZSTR_STAT_CASECMP );
+
+    //compare the folded code points of both strings (without copying them)
+    return hzstr_utf8_casecmp(
+        string0->data, string0->length, string1->data, string1->length
+    );
 }
+#endif
 
 
 /*==========================================================================*/
@@ -409,308 +1108,2822 @@ long hzstr_cmp(                     //compare two strings for equality
 ) {                                 //comparison value (0 means equal)
 
     //local variables
+    hzstr_length_t      length;     //number of characters in both strings
     hzstr_length_t      pos;        //position index
+#ifdef USE_SSE2
+    unsigned int        same;       //mask of equal lanes
+#endif
+
+    stat_call( HZSTR_STAT_CMP );
+
+    //only compare the characters that are in both strings
+    length = string0->length;
+    if( string1->length < length ) {
+        length = string1->length;
+    }
 
     //initialize position index
     pos = 0;
 
+#ifdef USE_SSE2
+
+    //skip whole vectors of equal characters
+    if( VEC_WIDTH_OK ) {
+        while( ( pos + VEC_CHARS ) <= length ) {
+            same = _mm_movemask_epi8(
+                vec_equal(
+                    _mm_loadu_si128(
+                        ( const __m128i* ) ( string0->data + pos )
+                    ),
+                    _mm_loadu_si128(
+                        ( const __m128i* ) ( string1->data + pos )
+                    )
+                )
+            );
+            if( same != 0xFFFF ) {
+                pos += vec_lane( ~same );
+                break;
+            }
+            pos += VEC_CHARS;
+        }
+    }
+
+#endif
+
     //scan both strings
-    while( pos < string0->length ) {
+    while( pos < length ) {
 
         //check the current character
         if( string0->data[ pos ] != string1->data[ pos ] ) {
 
-            //return the difference in these characters
-            return string0->data[ pos ] - string1->data[ pos ];
+            //return the difference in these characters (without wrapping
+            //  unsigned types)
+            return ( long ) string0->data[ pos ]
+                - ( long ) string1->data[ pos ];
         }
 
         //advance the position index
         pos += 1;
     }
 
-    //strings appear the be the same
-    return 0;
+    //the shorter string is ordered first
+    return ( long ) string0->length - ( long ) string1->length;
 }
 
 
 /*==========================================================================*/
-void hzstr_destroy(                 //destroy a string
-    hzstr_type*         string      //the string to destroy
-) {
+hzstr_result_t hzstr_compact_all(   //move strings into exact allocations
+    hzstr_type**        strings,    //strings to move (NULL entries skipped)
+    int                 count       //number of strings
+) {                                 //bytes released (or error result)
 
-    //check the pointer
-    if( string != NULL ) {
+    //local variables
+    hzstr_char_t*       data;       //new allocation of a string
+    int                 index;      //string index
+    unsigned long       released;   //bytes released
+    hzstr_type*         string;     //string to move
 
-        //check for a valid, allocated string
-        if( ( string->alloc > 0 ) && ( string->data != NULL ) ) {
+    stat_call( HZSTR_STAT_COMPACT_ALL );
 
-            //free the string memory
-            mem_free( string->data );
+    //check the arguments
+    if( ( count < 0 ) || ( ( strings == NULL ) && ( count > 0 ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    released = 0;
+    for( index = 0; index < count; ++index ) {
+        string = strings[ index ];
+
+        //only dynamic strings with unused memory are moved
+        if( ( string == NULL )
+         || ( string->type != HZSTR_TYPE_DYNAMIC )
+         || ( ( string->flags & HZSTR_FLG_STATIC ) != 0 )
+         || ( string->alloc <= ( string->length + 1 ) ) ) {
+            continue;
         }
 
-        //free the string object
-        mem_free( string );
+        //a new allocation (rather than a re-allocation, which may shrink
+        //  in place) lets the allocator pack the strings together, and
+        //  release the old memory as a whole (strings moved before a
+        //  failure keep their new allocations)
+        data = mem_malloc( ( string->length + 1 ) * sizeof( hzstr_char_t ) );
+        if( data == NULL ) {
+            return HZSTR_RSLT_ALLOC;
+        }
+        str_copy(
+            data,
+            string->data,
+            ( ( string->length + 1 ) * sizeof( hzstr_char_t ) )
+        );
+        mem_free( str_base( string ) );
+
+        //update the string object
+        released += ( string->alloc - string->length - 1 )
+            * sizeof( hzstr_char_t );
+        stat_count(
+            STAT_MINIMIZED,
+            ( ( string->alloc - string->length - 1 ) * sizeof( hzstr_char_t ) )
+        );
+        string->alloc  = string->length + 1;
+        string->data   = data;
+        string->offset = 0;
     }
+
+    //return the bytes released
+    return released;
 }
 
 
+#ifdef HZSTR_COMPAT_CSTR
 /*==========================================================================*/
-hzstr_result_t hzstr_import(        //safely import an untrusted string
-    hzstr_type*         string,     //existing string to use for storage
-    const char*         source,     //C string to import
-    hzstr_length_t      length      //maximum length to import
-) {                                 //result of operation
+hzstr_result_t hzstr_cp_count(      //count the code points in a string
+    const hzstr_type*   string      //string to count
+) {                                 //number of code points
+
+    stat_call( HZSTR_STAT_CP_COUNT );
+
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //every character of an ASCII string is a code point
+    if( ( string->flags & HZSTR_FLG_ASCII ) != 0 ) {
+        return string->length;
+    }
+
+    //count the characters that start a sequence
+    return hzstr_utf8_count( string->data, string->length );
+}
+
+
+/*==========================================================================*/
+hzstr_index_t hzstr_cp_offset(      //find the offset of a code point
+    const hzstr_type*   string,     //string to search
+    hzstr_index_t       index       //index of the code point
+) {                                 //offset of code point, or INDEX_NONE
 
     //local variables
-    hzstr_length_t      srclen;     //source string length
+    hzstr_index_t       offset;     //offset of the code point
 
-    //this can only be done to dynamic strings
+    stat_call( HZSTR_STAT_CP_OFFSET );
+
+    //check pointer and index
+    if( ( string == NULL ) || ( index < 0 ) ) {
+        return HZSTR_INDEX_NONE;
+    }
+
+    //every character of an ASCII string is a code point
+    if( ( string->flags & HZSTR_FLG_ASCII ) != 0 ) {
+        return index <= string->length ? index : HZSTR_INDEX_NONE;
+    }
+
+    //find the start of the code point (the end of the string is allowed,
+    //  but only if every code point before it was counted)
+    offset = hzstr_utf8_offset( string->data, string->length, index );
+    if( ( offset == string->length )
+     && ( hzstr_utf8_count( string->data, string->length ) != index ) ) {
+        return HZSTR_INDEX_NONE;
+    }
+    return offset;
+}
+#endif
+
+
+/*==========================================================================*/
+void hzstr_destroy(                 //destroy a string
+    hzstr_type*         string      //the string to destroy
+) {
+
+    stat_call( HZSTR_STAT_DESTROY );
+
+    //check the pointer (objects initialized at build time are not freed)
+    if( ( string != NULL ) && ( ( string->flags & HZSTR_FLG_STATIC ) == 0 ) ) {
+
+        prof_remove( string );
+
+        //check for a valid, allocated string
+        if( ( string->alloc > 0 ) && ( string->data != NULL ) ) {
+
+            //free the string memory
+            mem_free( str_base( string ) );
+        }
+
+        //free the string object
+        mem_free( string );
+    }
+}
+
+
+/*==========================================================================*/
+int hzstr_equal(                    //check two strings for equal characters
+    const hzstr_type*   string0,    //first string
+    const hzstr_type*   string1     //second string
+) {                                 //1 if equal, 0 if not
+
+    stat_call( HZSTR_STAT_EQUAL );
+
+    //strings of different lengths are never equal
+    if( string0->length != string1->length ) {
+        return 0;
+    }
+
+    //strings with different stored hashes are never equal
+    if( ( ( string0->flags & HZSTR_FLG_HASHED ) != 0 )
+     && ( ( string1->flags & HZSTR_FLG_HASHED ) != 0 )
+     && ( string0->hash != string1->hash ) ) {
+        return 0;
+    }
+
+    //the same characters are always equal
+    if( string0->data == string1->data ) {
+        return 1;
+    }
+
+    //compare the characters
+    return hzstr_cmp( string0, string1 ) == 0;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_erase(         //remove a range of characters
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //beginning offset of range to remove
+    hzstr_length_t      length      //number of characters to remove
+) {                                 //result of operation
+
+    //local variables
+    hzstr_result_t      result;     //result of the removal
+
+    stat_call( HZSTR_STAT_ERASE );
+
+    //check pointer
+    if( target == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //removing from the front only advances the data pointer
+    if( offset == 0 ) {
+        result = hzstr_consume( target, length );
+    }
+
+    //close the range (nothing is inserted)
+    else {
+        result = str_splice( target, offset, length, NULL, 0, TEXT_FLAGS );
+    }
+
+    //a much shorter string may be shrunk
+    if( result >= HZSTR_RSLT_OK ) {
+        str_shrink( target );
+    }
+    return result;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_export_utf8(   //convert a string to a UTF-8 C-string
+    const hzstr_type*   string,     //string to convert
+    char*               output,     //C-string output (NULL to measure)
+    unsigned long       size        //size of the output buffer
+) {                                 //result of operation
+
+    //local variables
+    unsigned long       length;     //length of the UTF-8 text
+#ifndef HZSTR_COMPAT_CSTR
+    hzstr_length_t      index;      //character index
+#endif
+
+    stat_call( HZSTR_STAT_EXPORT_UTF8 );
+
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //measure the converted string
+#ifdef HZSTR_COMPAT_CSTR
+    length = string->length;
+#else
+    if( sizeof( hzstr_char_t ) == sizeof( uint16_t ) ) {
+        length = hzstr_utf8_from_utf16_size(
+            ( const uint16_t* ) string->data, string->length
+        );
+    }
+    else if( sizeof( hzstr_char_t ) == sizeof( uint32_t ) ) {
+        length = hzstr_utf8_from_utf32_size(
+            ( const uint32_t* ) string->data, string->length
+        );
+    }
+    else {
+        length = string->length;
+    }
+#endif
+
+    //the caller may only need to know how much to allocate
+    if( output == NULL ) {
+        return length;
+    }
+
+    //the output must have room for the NULL byte
+    if( length >= size ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //convert the string
+#ifdef HZSTR_COMPAT_CSTR
+    str_copy( output, string->data, length );
+#else
+    if( sizeof( hzstr_char_t ) == sizeof( uint16_t ) ) {
+        hzstr_utf8_from_utf16(
+            output, ( const uint16_t* ) string->data, string->length
+        );
+    }
+    else if( sizeof( hzstr_char_t ) == sizeof( uint32_t ) ) {
+        hzstr_utf8_from_utf32(
+            output, ( const uint32_t* ) string->data, string->length
+        );
+    }
+    else {
+        for( index = 0; index < string->length; ++index ) {
+            output[ index ] = ( char ) string->data[ index ];
+        }
+    }
+#endif
+    output[ length ] = '\0';
+
+    //return the length of the C-string
+    return length;
+}
+
+
+#ifdef HZSTR_COMPAT_CSTR
+/*==========================================================================*/
+hzstr_result_t hzstr_fold(          //fold the case of a string's code points
+    hzstr_type*         string      //string to fold
+) {                                 //result of operation
+
+    //local variables
+    hzstr_length_t      alloc;      //size of a new allocation
+    hzstr_char_t*       data;       //new string data
+    int                 in_place;   //folding will not grow the string
+    unsigned long       length;     //length of the folded string
+
+    stat_call( HZSTR_STAT_FOLD );
+
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //check the type of string
     if( string->type != HZSTR_TYPE_DYNAMIC ) {
         return HZSTR_RSLT_TYPE;
     }
 
-    //find the length of the source string
-    srclen = cstr_len( source );
+    //ASCII is folded in place without measuring it
+    if( ( string->flags & HZSTR_FLG_ASCII ) != 0 ) {
+        hzstr_utf8_fold( string->data, string->data, string->length );
+        return string->length;
+    }
 
-    //check what was found against the user's limit
-    if( srclen > length ) {
+    //find out if any code point becomes longer when it is folded
+    length = hzstr_utf8_fold_size( string->data, string->length, &in_place );
+    if( length >= MAX_LENGTH ) {
         return HZSTR_RSLT_SAFETY;
     }
 
-    //copy the user's C-string into the string
-    return hzstr_cpy_cstr( string, source );
+    //fold in place (the write position never passes the read position)
+    if( in_place != 0 ) {
+        string->length = hzstr_utf8_fold(
+            string->data, string->data, string->length
+        );
+    }
+
+    //fold into a new buffer
+    else {
+        alloc = str_alloc( &data, NULL, ( length + 1 ) );
+        if( data == NULL ) {
+            return HZSTR_RSLT_ALLOC;
+        }
+        string->length = hzstr_utf8_fold( data, string->data, string->length );
+        mem_free( str_base( string ) );
+        string->alloc  = alloc;
+        string->offset = 0;
+        string->data   = data;
+    }
+
+    //the encoding is unchanged, so the flags still hold
+    string->data[ string->length ] = '\0';
+
+    //return the new length of the string
+    return string->length;
+}
+#endif
+
+
+/*==========================================================================*/
+hzstr_hash_t hzstr_hash(            //hash a string's characters
+    const hzstr_type*   string      //string to hash
+) {                                 //32-bit FNV-1a hash
+
+    //local variables
+    hzstr_hash_t        hash;       //hash of the characters so far
+    hzstr_length_t      pos;        //position index
+
+    stat_call( HZSTR_STAT_HASH );
+
+    //use the hash stored with the string
+    if( ( string->flags & HZSTR_FLG_HASHED ) != 0 ) {
+        return string->hash;
+    }
+
+    //fold each character into the hash
+    hash = HZSTR_HASH_BASIS;
+    for( pos = 0; pos < string->length; ++pos ) {
+        hash ^= hash_char( string->data[ pos ] );
+        hash *= HZSTR_HASH_PRIME;
+    }
+
+    //return the hash
+    return hash;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_import(        //safely import an untrusted string
+    hzstr_type*         string,     //existing string to use for storage
+    const char*         source,     //C string to import
+    hzstr_length_t      length      //maximum length to import
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_IMPORT );
+
+    //import the string, recording its encoding
+    return str_import( string, source, length, 0 );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_import_utf8(   //import an untrusted UTF-8 string
+    hzstr_type*         string,     //existing string to use for storage
+    const char*         source,     //C string to import
+    hzstr_length_t      length      //maximum length to import
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_IMPORT_UTF8 );
+
+    //import the string, rejecting it if it is not valid UTF-8
+    return str_import( string, source, length, HZSTR_FLG_UTF8 );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_insert(        //insert a string at an offset
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //offset at which to insert
+    const hzstr_type*   source      //string to insert
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_INSERT );
+
+    //check pointers
+    if( ( target == NULL ) || ( source == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //the source must not move while the target is re-allocated
+    if( str_overlaps( target, source ) != 0 ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //open an empty range at the offset, and fill it with the source
+    return str_splice(
+        target, offset, 0, source->data, source->length, source->flags
+    );
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_LATENCY
+
+void hzstr_latency_dump(            //write every thread's latency histograms
+    FILE*               out         //output file
+) {
+
+    //local variables
+    int                 bucket;     //bucket index
+    unsigned long       counts[ LAT_BUCKETS ];
+                                    //times in each bucket
+    int                 operation;  //operation index
+    hzstr_latency_type  summary;    //summary of the operation
+
+    for( operation = 0; operation < HZSTR_NUM_LATS; ++operation ) {
+
+        //only operations that were timed are written
+        hzstr_latency_summary( operation, &summary );
+        if( summary.samples == 0 ) {
+            continue;
+        }
+        lat_total( operation, counts, &summary );
+
+        //summary line, then the range and count of each non-empty bucket
+        fprintf(
+            out,
+            "%s: %lu samples (%s), mean %lu, p50 %lu, p90 %lu, p99 %lu,"
+            " p99.9 %lu, max %lu\n",
+            lat_names[ operation ],
+            summary.samples,
+            LAT_UNIT,
+            ( summary.total / summary.samples ),
+            summary.p50,
+            summary.p90,
+            summary.p99,
+            summary.p999,
+            summary.maximum
+        );
+        for( bucket = 0; bucket < LAT_BUCKETS; ++bucket ) {
+            if( counts[ bucket ] != 0 ) {
+                fprintf(
+                    out,
+                    "  %12lu %12lu %12lu\n",
+                    lat_floor( bucket ),
+                    ( lat_floor( bucket + 1 ) - 1 ),
+                    counts[ bucket ]
+                );
+            }
+        }
+    }
+}
+
+
+/*==========================================================================*/
+void hzstr_latency_rate(            //set how often calls are timed
+    unsigned int        rate        //one call in this many is timed (>0)
+) {
+
+    //every call is timed rather than none
+    if( rate == 0 ) {
+        rate = 1;
+    }
+    atomic_store_explicit( &lat_rate, rate, memory_order_relaxed );
+
+    //the calling thread times its next growth of each operation (other
+    //  threads use the new rate after their next timed growths)
+    memset( lat_countdowns, 0, sizeof( lat_countdowns ) );
+}
+
+
+/*==========================================================================*/
+void hzstr_latency_reset(           //clear every thread's latency histograms
+    void
+) {
+
+    //local variables
+    lat_block_type*     block;      //one thread's histograms
+    int                 bucket;     //bucket index
+    thread_block_type*  link;       //link to one thread's histograms
+    int                 operation;  //operation index
+
+    //times recorded by other threads during a reset may be partly kept
+    link = atomic_load_explicit( &lat_blocks, memory_order_acquire );
+    for( ; link != NULL; link = link->next ) {
+        block = ( lat_block_type* ) link;
+        for( operation = 0; operation < HZSTR_NUM_LATS; ++operation ) {
+            for( bucket = 0; bucket < LAT_BUCKETS; ++bucket ) {
+                atomic_store_explicit(
+                    &block->counts[ operation ][ bucket ],
+                    0,
+                    memory_order_relaxed
+                );
+            }
+            atomic_store_explicit(
+                &block->maximums[ operation ], 0, memory_order_relaxed
+            );
+            atomic_store_explicit(
+                &block->totals[ operation ], 0, memory_order_relaxed
+            );
+        }
+    }
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_latency_summary(
+                                    //summarize the times of an operation
+    int                 operation,  //operation to summarize (HZSTR_LAT_*)
+    hzstr_latency_type* summary     //summary output
+) {                                 //result of operation
+
+    //local variables
+    unsigned long       counts[ LAT_BUCKETS ];
+                                    //times in each bucket
+
+    //check the arguments
+    if( ( operation < 0 ) || ( operation >= HZSTR_NUM_LATS )
+     || ( summary == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //add up the histograms, and find the percentiles
+    lat_total( operation, counts, summary );
+    summary->p50  = lat_percentile(
+        counts, summary->samples, summary->maximum, 500
+    );
+    summary->p90  = lat_percentile(
+        counts, summary->samples, summary->maximum, 900
+    );
+    summary->p99  = lat_percentile(
+        counts, summary->samples, summary->maximum, 990
+    );
+    summary->p999 = lat_percentile(
+        counts, summary->samples, summary->maximum, 999
+    );
+    return HZSTR_RSLT_OK;
+}
+
+#endif
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_minimize(      //minimize the memory used for this string
+    hzstr_type*         string      //string to minimize
+) {                                 //result of operation
+
+    //local variables
+    hzstr_char_t*       ptr;        //pointer to newly-allocated string data
+
+    stat_call( HZSTR_STAT_MINIMIZE );
+
+    //this can only be done to dynamic strings
+    if( string->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
+
+    //move the characters to the beginning of the allocation
+    str_compact( string );
+
+    //re-allocate the string down to its current length (+1 for NULL)
+    ptr = mem_realloc(
+        string->data,
+        ( ( string->length + 1 ) * sizeof( hzstr_char_t ) )
+    );
+
+    //check memory allocation
+    if( ptr == NULL ) {
+        return HZSTR_RSLT_ALLOC;
+    }
+
+    //update string object
+    stat_count(
+        STAT_MINIMIZED,
+        ( ( string->alloc - string->length - 1 ) * sizeof( hzstr_char_t ) )
+    );
+    string->alloc = string->length + 1;
+    string->data  = ptr;
+
+    //return the new size of the string's allocation
+    return string->alloc;
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_PROFILE
+
+hzstr_result_t hzstr_profile_dump(  //write the live strings of every site
+    FILE*               out         //output file
+) {                                 //number of sites (or error result)
+
+    //local variables
+    int                 bucket;     //bucket index
+    int                 count;      //number of sites with live strings
+    double              cumulative; //slack of the sites written so far
+    int                 index;      //site index
+    hzstr_profile_site_type* site;  //site being written
+    hzstr_profile_site_type* totals;//totals of each site
+    hzstr_profile_site_type total;  //totals of every site
+
+    //check the arguments
+    if( out == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //collect the totals of each site
+    totals = diag_calloc( PROF_SITES, sizeof( hzstr_profile_site_type ) );
+    if( totals == NULL ) {
+        return HZSTR_RSLT_ALLOC;
+    }
+    count = profile_collect( totals );
+
+    //totals line
+    memset( &total, 0, sizeof( total ) );
+    for( index = 0; index < count; ++index ) {
+        total.strings += totals[ index ].strings;
+        total.bytes   += totals[ index ].bytes;
+        total.slack   += totals[ index ].slack;
+    }
+    fprintf(
+        out,
+        "live strings: %lu, bytes: %lu, slack: %lu\n",
+        total.strings,
+        total.bytes,
+        total.slack
+    );
+
+    //each site's line (with its share of all slack, and the share of the
+    //  sites before it), then its sizes and ages
+    cumulative = 0.0;
+    for( index = 0; index < count; ++index ) {
+        site = &totals[ index ];
+        cumulative += site->slack;
+        fprintf(
+            out,
+            "%s:%d: %lu strings, %lu bytes, %lu slack"
+            " (%.1f%%, cumulative %.1f%%)\n",
+            ( site->file != NULL ? site->file : "(unknown)" ),
+            site->line,
+            site->strings,
+            site->bytes,
+            site->slack,
+            ( total.slack > 0 ? ( 100.0 * site->slack / total.slack ) : 0.0 ),
+            ( total.slack > 0 ? ( 100.0 * cumulative / total.slack ) : 0.0 )
+        );
+        fprintf( out, "  sizes (bytes):" );
+        for( bucket = 0; bucket < HZSTR_PROFILE_BUCKETS; ++bucket ) {
+            if( site->sizes[ bucket ] != 0 ) {
+                fprintf(
+                    out,
+                    " %lu+:%lu",
+                    ( bucket > 0
+                        ? ( ( unsigned long ) HZSTR_PROFILE_SIZE_UNIT
+                            << ( bucket - 1 ) )
+                        : 0ul ),
+                    site->sizes[ bucket ]
+                );
+            }
+        }
+        fprintf( out, "\n  ages (ms):" );
+        for( bucket = 0; bucket < HZSTR_PROFILE_BUCKETS; ++bucket ) {
+            if( site->ages[ bucket ] != 0 ) {
+                fprintf(
+                    out,
+                    " %lu+:%lu",
+                    ( bucket > 0
+                        ? ( ( unsigned long ) HZSTR_PROFILE_AGE_UNIT
+                            << ( bucket - 1 ) )
+                        : 0ul ),
+                    site->ages[ bucket ]
+                );
+            }
+        }
+        fprintf( out, "\n" );
+    }
+
+    diag_free( totals );
+    return count;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_profile_sites(
+                                    //report the live strings of every site
+    hzstr_profile_site_type* sites, //list of sites (most slack first)
+    int                 size        //number of sites the list can hold
+) {                                 //number of sites (or error result)
+
+    //local variables
+    int                 count;      //number of sites with live strings
+    hzstr_profile_site_type* totals;//totals of each site
+
+    //check the arguments (a list of no sites only counts them)
+    if( ( size < 0 ) || ( ( sites == NULL ) && ( size > 0 ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //add up the sites, and copy as many as the list holds
+    totals = diag_calloc( PROF_SITES, sizeof( hzstr_profile_site_type ) );
+    if( totals == NULL ) {
+        return HZSTR_RSLT_ALLOC;
+    }
+    count = profile_collect( totals );
+    if( size > count ) {
+        size = count;
+    }
+    if( size > 0 ) {
+        memcpy( sites, totals, ( size * sizeof( hzstr_profile_site_type ) ) );
+    }
+    diag_free( totals );
+    return count;
+}
+
+
+/*==========================================================================*/
+hzstr_type* hzstr_profile_tag(      //tag a live string with its call site
+    hzstr_type*         string,     //string to tag (may be NULL)
+    const char*         file,       //source file of the call
+    int                 line        //source line of the call
+) {                                 //the string
+
+    //local variables
+    prof_entry_type**   link;       //link to the string's entry
+
+    //a string that was not created is not tagged
+    if( string == NULL ) {
+        return NULL;
+    }
+
+    //the last tag wins (the outermost create call is the call site)
+    spin_lock( &prof_lock );
+    link = profile_find( string );
+    if( *link != NULL ) {
+        ( *link )->site = profile_site( file, line );
+    }
+    spin_unlock( &prof_lock );
+    return string;
+}
+
+#endif
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_replace_all(   //replace all instances of a substring
+    hzstr_type*         target,     //string to modify
+    const hzstr_type*   needle,     //substring to search for
+    const hzstr_type*   replacement //string to put in place of each instance
+) {                                 //result of operation
+
+    //local variables
+    hzstr_length_t      alloc;      //allocation of re-built string data
+    hzstr_length_t      count;      //number of instances found
+    hzstr_char_t*       data;       //string data being written
+    hzstr_index_t       found;      //index of the next instance
+    hzstr_length_t      read;       //read position in original data
+    unsigned long       total;      //length of string after replacement
+    hzstr_length_t      write;      //write position in new data
+
+    stat_call( HZSTR_STAT_REPLACE_ALL );
+
+    //check pointers
+    if( ( target == NULL ) || ( needle == NULL ) || ( replacement == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //check the type of target string
+    if( target->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
+
+    //an empty needle matches everywhere, and the replacement must not be
+    //  modified while it is being copied into the target
+    if( ( needle->length == 0 )
+     || ( str_overlaps( target, needle      ) != 0 )
+     || ( str_overlaps( target, replacement ) != 0 ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //count the instances of the needle so the result can be sized exactly
+    count = 0;
+    read  = 0;
+    while( ( found = str_find(
+        ( target->data + read ), ( target->length - read ), needle
+    ) ) != HZSTR_INDEX_NONE ) {
+        count += 1;
+        read  += found + needle->length;
+    }
+
+    //nothing to replace
+    if( count == 0 ) {
+        return target->length;
+    }
+
+    //compute the final length of the string
+    total = target->length
+          + ( ( long ) replacement->length - ( long ) needle->length ) * count;
+    if( total >= MAX_LENGTH ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //a growing string is written into a new buffer, a shrinking string is
+    //  written in place (the write position never passes the read position)
+    if( total > target->length ) {
+        alloc = str_alloc( &data, NULL, total );
+        if( data == NULL ) {
+            return HZSTR_RSLT_ALLOC;
+        }
+    }
+    else {
+        alloc = target->alloc;
+        data  = target->data;
+    }
+
+    //copy each segment followed by its replacement in a single pass
+    read  = 0;
+    write = 0;
+    while( count > 0 ) {
+        found = str_find(
+            ( target->data + read ), ( target->length - read ), needle
+        );
+        str_move(
+            ( data + write ),
+            ( target->data + read ),
+            ( found * sizeof( hzstr_char_t ) )
+        );
+        write += found;
+        str_copy(
+            ( data + write ),
+            replacement->data,
+            ( replacement->length * sizeof( hzstr_char_t ) )
+        );
+        write += replacement->length;
+        read  += found + needle->length;
+        count -= 1;
+    }
+
+    //copy the remainder of the string (including the NULL byte)
+    str_move(
+        ( data + write ),
+        ( target->data + read ),
+        ( ( target->length - read + 1 ) * sizeof( hzstr_char_t ) )
+    );
+
+    //release the original data if the string was re-built
+    if( data != target->data ) {
+        mem_free( str_base( target ) );
+        target->alloc  = alloc;
+        target->offset = 0;
+        target->data   = data;
+    }
+
+    //update the length of the string
+    target->length = total;
+
+    //a UTF-8 needle (or any needle in ASCII) only matches whole sequences,
+    //  so the result is what the target and replacement are both known to be
+    if( ( ( needle->flags & HZSTR_FLG_UTF8  ) == 0 )
+     && ( ( target->flags & HZSTR_FLG_ASCII ) == 0 ) ) {
+        target->flags &= ~HZSTR_FLG_UTF8;
+    }
+    target->flags &= replacement->flags | ~TEXT_FLAGS;
+
+    //return the new length of the string
+    return target->length;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_reserve(       //make room for a number of characters
+    hzstr_type*         string,     //string to prepare
+    hzstr_length_t      length      //number of characters it will hold
+) {                                 //size of allocation (or error result)
+
+    stat_call( HZSTR_STAT_RESERVE );
+
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //only dynamic strings have an allocation to grow
+    if( string->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
+
+    //grow the allocation (the characters are not changed)
+    return check_alloc( string, length );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_shrink_policy( //set when shorter strings are shrunk
+    unsigned int        factor,     //allocation to length ratio (0, or >= 4)
+    hzstr_length_t      minimum     //largest allocation never shrunk
+) {                                 //result of operation
+
+    //a shrunk string has room to double, so smaller factors would shrink
+    //  it again on its next change
+    if( ( factor > 0 ) && ( factor < SHRINK_LEAST ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //strings use the new policy on their next change
+    shrink_factor  = factor;
+    shrink_minimum = minimum;
+    return HZSTR_RSLT_OK;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_splice(        //replace a range with another string
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //beginning offset of range to replace
+    hzstr_length_t      length,     //number of characters to replace
+    const hzstr_type*   source      //replacement string
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_SPLICE );
+
+    //check pointers
+    if( ( target == NULL ) || ( source == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //the source must not move while the target is re-allocated
+    if( str_overlaps( target, source ) != 0 ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //replace the range with the source
+    return str_splice(
+        target, offset, length, source->data, source->length, source->flags
+    );
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_COMPAT_CSTR
+
+hzstr_result_t hzstr_sprintf(       //formatted printing into a string
+    hzstr_type*         string,     //target string
+    const char*         format,     //string format
+    ...                             //format arguments
+) {                                 //result of operation
+
+    //local variables
+    char                dummy[ 1 ]; //dummy C-string buffer
+    hzstr_length_t      length;     //length of printed string
+    hzstr_result_t      result;     //allocation result
+    va_list             sizeargs;   //varargs object for the dummy print
+    va_list             varargs;    //varargs object
+
+    stat_call( HZSTR_STAT_SPRINTF );
+
+    //this can only be done to dynamic strings
+    if( string->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
+
+    va_start( varargs, format );
+
+    //perform a dummy print to compute the size of the print
+    //  note: a va_list can not be used again after it is consumed
+    va_copy( sizeargs, varargs );
+    length = vsnprintf( dummy, 1, format, sizeargs );
+    va_end( sizeargs );
+
+    //check the size we would have printed, and allocate, as needed
+    if( string->alloc < ( length + 1 ) ) {
+        result = lat_check_alloc( HZSTR_LAT_SPRINTF, string, length );
+        if( result < HZSTR_RSLT_OK ) {
+            va_end( varargs );
+            return result;
+        }
+    }
+
+    //the entire string is replaced, so consumed characters can be re-used
+    string->data  -= string->offset;
+    string->offset = 0;
+
+    //print to the string
+    length = vsnprintf( string->data, string->alloc, format, varargs );
+
+    va_end( varargs );
+
+    //update the string's length, and record the encoding of what was printed
+    string->length = length;
+    string->flags  = ( string->flags & ~TEXT_FLAGS )
+                   | cstr_encoding( string->data, length );
+
+    //return the printed length
+    return length;
+}
+
+#endif
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_squeeze(       //collapse runs of whitespace
+    hzstr_type*         string      //string to modify
+) {                                 //result of operation
+
+    //local variables
+    hzstr_length_t      read;       //read position in string
+    hzstr_length_t      span;       //length of the current run
+    hzstr_length_t      write;      //write position in string
+
+    stat_call( HZSTR_STAT_SQUEEZE );
+
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //this can only be done to dynamic strings
+    if( string->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
+
+    //initialize positions
+    read  = 0;
+    write = 0;
+
+    //alternate between runs of text and runs of whitespace
+    while( read < string->length ) {
+
+        //keep the text (it only moves once a run has been collapsed)
+        span = span_text( ( string->data + read ), ( string->length - read ) );
+        if( write != read ) {
+            str_move(
+                ( string->data + write ),
+                ( string->data + read ),
+                ( span * sizeof( hzstr_char_t ) )
+            );
+        }
+        read  += span;
+        write += span;
+
+        //replace the whitespace with a single space
+        if( read < string->length ) {
+            read += span_space(
+                ( string->data + read ), ( string->length - read )
+            );
+            string->data[ write ] = ' ';
+            write += 1;
+        }
+    }
+
+    //update the length of the string
+    string->length = write;
+    string->data[ string->length ] = '\0';
+
+    //return the new length of the string
+    return string->length;
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_STATS
+
+void hzstr_stats_reset(             //start counting the statistics again
+    void
+) {
+
+    //local variables
+    int                 counter;    //counter index
+    unsigned long       totals[ STAT_COUNTERS ];
+                                    //current totals
+
+    //later snapshots only count what happens after the current totals
+    stats_total( totals );
+    for( counter = 0; counter < STAT_COUNTERS; ++counter ) {
+        atomic_store_explicit(
+            &stats_base[ counter ], totals[ counter ], memory_order_relaxed
+        );
+    }
+}
+
+
+/*==========================================================================*/
+void hzstr_stats_snapshot(          //add up the statistics of every thread
+    hzstr_stats_type*   stats       //statistics output
+) {
+
+    //local variables
+    int                 counter;    //counter index
+    int                 function;   //function index
+    unsigned long       totals[ STAT_COUNTERS ];
+                                    //current totals
+
+    //subtract the totals at the last reset from the current totals
+    stats_total( totals );
+    for( counter = 0; counter < STAT_COUNTERS; ++counter ) {
+        totals[ counter ] -= atomic_load_explicit(
+            &stats_base[ counter ], memory_order_relaxed
+        );
+    }
+
+    //report the totals
+    for( function = 0; function < HZSTR_NUM_STATS; ++function ) {
+        stats->calls[ function ] = totals[ STAT_CALLS + function ];
+        stats->moved[ function ] = totals[ STAT_MOVED + function ];
+    }
+    stats->grows     = totals[ STAT_GROWS ];
+    stats->requested = totals[ STAT_REQUESTED ];
+    stats->allocated = totals[ STAT_ALLOCATED ];
+    stats->minimized = totals[ STAT_MINIMIZED ];
+}
+
+#endif
+
+
+/*==========================================================================*/
+hzstr_index_t hzstr_strchr(         //find first instance of a character
+    const hzstr_type*   string,     //string to search
+    hzstr_char_t        c           //character to search for
+) {                                 //index of character in string (-1=none)
+
+    //local variables
+    hzstr_index_t       pos;        //position in string
+#ifdef USE_SSE2
+    __m128i             needle;     //character in every lane
+    unsigned int        found;      //mask of matching lanes
+#endif
+
+    stat_call( HZSTR_STAT_STRCHR );
+
+    //initialize the position
+    pos = 0;
+
+#ifdef USE_SSE2
+
+    //check whole vectors of characters
+    if( VEC_WIDTH_OK ) {
+        needle = vec_fill( c );
+        while( ( pos + VEC_CHARS ) <= string->length ) {
+            found = _mm_movemask_epi8(
+                vec_equal(
+                    _mm_loadu_si128(
+                        ( const __m128i* ) ( string->data + pos )
+                    ),
+                    needle
+                )
+            );
+            if( found != 0 ) {
+                return pos + vec_lane( found );
+            }
+            pos += VEC_CHARS;
+        }
+    }
+
+#endif
+
+    //loop through the hzstring (may be a substring)
+    while( pos < string->length ) {
+
+        //check for the character
+        if( string->data[ pos ] == c ) {
+            return pos;
+        }
+
+        //increment the position index
+        pos += 1;
+    }
+
+    //unable to find character in string
+    return HZSTR_INDEX_NONE;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_tolower(       //transform the string to lowercase
+    hzstr_type*         string      //the string to make lowercase
+) {                                 //result of operation
+
+    //local variables
+    hzstr_index_t       pos;        //position index
+#ifdef USE_SSE2
+    __m128i             chunk;      //characters being changed
+    __m128i             delta;      //difference between cases
+    __m128i             letters;    //lanes holding letters to change
+    __m128i             lowest;     //first letter to change
+    __m128i             span;       //distance to the last letter to change
+#endif
+
+    stat_call( HZSTR_STAT_TOLOWER );
+
+    //initialize position index
+    pos = 0;
+
+#ifdef USE_SSE2
+
+    //change whole vectors of characters
+    if( VEC_WIDTH_OK ) {
+        lowest = vec_fill( 'A' );
+        span   = vec_fill( 'Z' - 'A' );
+        delta  = vec_fill( 'a' - 'A' );
+        while( ( pos + VEC_CHARS ) <= string->length ) {
+            chunk = _mm_loadu_si128(
+                ( const __m128i* ) ( string->data + pos )
+            );
+
+            //a lane is a letter if its distance from the first letter is in
+            //  range (characters below the first letter wrap around)
+            letters = vec_at_most( vec_sub( chunk, lowest ), span );
+
+            //only chunks with letters are stored (constant strings are
+            //  not written unless they have letters to change)
+            if( _mm_movemask_epi8( letters ) != 0 ) {
+                chunk = vec_add( chunk, _mm_and_si128( letters, delta ) );
+                _mm_storeu_si128(
+                    ( __m128i* ) ( string->data + pos ), chunk
+                );
+            }
+            pos += VEC_CHARS;
+        }
+    }
+
+#endif
+
+    //loop through the entire string
+    while( pos < string->length ) {
+
+        //check for an uppercase letter
+        if( ( string->data[ pos ] >= 'A' )
+         && ( string->data[ pos ] <= 'Z' ) ) {
+
+            //make it lowercase
+            string->data[ pos ] += 'a' - 'A';
+        }
+
+        //advance to the next character
+        pos += 1;
+    }
+
+    //return success
+    return HZSTR_RSLT_OK;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_toupper(       //transform the string to uppercase
+    hzstr_type*         string      //the string to make uppercase
+) {                                 //result of operation
+
+    //local variables
+    hzstr_index_t       pos;        //position index
+#ifdef USE_SSE2
+    __m128i             chunk;      //characters being changed
+    __m128i             delta;      //difference between cases
+    __m128i             letters;    //lanes holding letters to change
+    __m128i             lowest;     //first letter to change
+    __m128i             span;       //distance to the last letter to change
+#endif
+
+    stat_call( HZSTR_STAT_TOUPPER );
+
+    //initialize position index
+    pos = 0;
+
+#ifdef USE_SSE2
+
+    //change whole vectors of characters
+    if( VEC_WIDTH_OK ) {
+        lowest = vec_fill( 'a' );
+        span   = vec_fill( 'z' - 'a' );
+        delta  = vec_fill( 'a' - 'A' );
+        while( ( pos + VEC_CHARS ) <= string->length ) {
+            chunk = _mm_loadu_si128(
+                ( const __m128i* ) ( string->data + pos )
+            );
+
+            //a lane is a letter if its distance from the first letter is in
+            //  range (characters below the first letter wrap around)
+            letters = vec_at_most( vec_sub( chunk, lowest ), span );
+
+            //only chunks with letters are stored (constant strings are
+            //  not written unless they have letters to change)
+            if( _mm_movemask_epi8( letters ) != 0 ) {
+                chunk = vec_sub( chunk, _mm_and_si128( letters, delta ) );
+                _mm_storeu_si128(
+                    ( __m128i* ) ( string->data + pos ), chunk
+                );
+            }
+            pos += VEC_CHARS;
+        }
+    }
+
+#endif
+
+    //loop through the entire string
+    while( pos < string->length ) {
+
+        //check for a lowercase letter
+        if( ( string->data[ pos ] >= 'a' )
+         && ( string->data[ pos ] <= 'z' ) ) {
+
+            //make it uppercase
+            string->data[ pos ] -= 'a' - 'A';
+        }
+
+        //advance to the next character
+        pos += 1;
+    }
+
+    //return success
+    return HZSTR_RSLT_OK;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trim(          //trim a string in-place
+    hzstr_type*         string      //string to trim
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_TRIM );
+
+    //trim both ends of the string
+    return str_trim( string, 1, 1 );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trim_left(     //trim leading whitespace in-place
+    hzstr_type*         string      //string to trim
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_TRIM_LEFT );
+
+    //trim the start of the string
+    return str_trim( string, 1, 0 );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trim_right(    //trim trailing whitespace in-place
+    hzstr_type*         string      //string to trim
+) {                                 //result of operation
+
+    stat_call( HZSTR_STAT_TRIM_RIGHT );
+
+    //trim the end of the string
+    return str_trim( string, 0, 1 );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_validate(      //check and record a string's encoding
+    hzstr_type*         string      //string to check
+) {                                 //result of check
+
+    //local variables
+    hzstr_flags_t       encoding;   //encoding of the string's characters
+
+    stat_call( HZSTR_STAT_VALIDATE );
+
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //scan the entire string
+    encoding = str_encoding( string->data, string->length );
+
+    //record what was found (objects initialized at build time may be in
+    //  read-only memory)
+    if( ( string->flags & HZSTR_FLG_STATIC ) == 0 ) {
+        string->flags = ( string->flags & ~TEXT_FLAGS ) | encoding;
+    }
+
+    //report whether or not the string is valid UTF-8
+    if( ( encoding & HZSTR_FLG_UTF8 ) == 0 ) {
+        return HZSTR_RSLT_ENCODING;
+    }
+    return HZSTR_RSLT_OK;
+}
+
+
+/*==========================================================================*/
+static hzstr_result_t check_alloc(  //check a string's allocation
+    hzstr_type*         string,     //the string to check
+    unsigned long       length      //the desired length of the string
+) {                                 //result of the check
+
+    //local variables
+    hzstr_length_t      alloc;      //new allocation of the string data
+    hzstr_char_t*       data;       //pointer to allocated string data
+
+    //the string and its NULL byte must fit in the largest allocation
+    if( length >= MAX_LENGTH ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //see if the string needs to be embiggened
+    if( ( string->alloc - string->offset ) < ( length + 1 ) ) {
+
+        //reclaim the consumed characters once they outnumber the string's
+        //  characters, or if keeping them would exceed the largest string
+        if( ( string->offset > string->length )
+         || ( ( string->offset + length ) >= MAX_LENGTH ) ) {
+            str_compact( string );
+        }
+
+        //see if the string still needs more memory
+        if( ( string->alloc - string->offset ) < ( length + 1 ) ) {
+
+            //adjust the allocated memory for the string
+            alloc = str_alloc(
+                &data, str_base( string ), ( string->offset + length )
+            );
+
+            //check allocation
+            if( data == NULL ) {
+
+                //report failure
+                return HZSTR_RSLT_ALLOC;
+            }
+
+            //update the string's allocated length and string pointer
+            string->alloc = alloc;
+            string->data  = data + string->offset;
+            stat_count( STAT_GROWS, 1 );
+        }
+    }
+
+    //report the allocated length of the string
+    return string->alloc;
+}
+
+
+/*==========================================================================*/
+static unsigned long cstr_chars(    //count characters stored for C-string
+    const char*         cstring,    //pointer to C-string data
+    unsigned long       length      //number of bytes of C-string data
+) {                                 //number of string characters
+
+#ifndef HZSTR_COMPAT_CSTR
+
+    //UTF-8 is decoded into 16-bit and 32-bit characters
+    if( sizeof( hzstr_char_t ) == sizeof( uint16_t ) ) {
+        return hzstr_utf8_to_utf16_size( cstring, length );
+    }
+    if( sizeof( hzstr_char_t ) == sizeof( uint32_t ) ) {
+        return hzstr_utf8_to_utf32_size( cstring, length );
+    }
+
+#endif
+
+    //each byte is stored as one character
+    return length;
+}
+
+
+/*==========================================================================*/
+static hzstr_flags_t cstr_encoding( //check the encoding of C-string data
+    const char*         cstring,    //pointer to C-string data
+    unsigned long       length      //number of characters to check
+) {                                 //encoding flags
+
+    //local variables
+    hzstr_flags_t       flags;      //encoding flags
+
+    //check the characters
+    flags = hzstr_utf8_check( cstring, length );
+
+#ifndef HZSTR_COMPAT_CSTR
+
+    //each byte is stored as one character, so only ASCII survives the copy
+    if( ( flags & HZSTR_FLG_ASCII ) == 0 ) {
+        flags = 0;
+    }
+
+#endif
+
+    //return the encoding flags
+    return flags;
+}
+
+
+/*==========================================================================*/
+static NO_SANITIZE unsigned long cstr_len(
+                                    //compute length of C-string
+    const char*         cstring,    //pointer to C-string
+    unsigned long       limit       //stop scanning after this many characters
+) {                                 //length of C-string (limit if longer)
+
+    //local variables
+    unsigned long       length;     //number of characters scanned
+#ifdef USE_SSE2
+    const char*         block;      //aligned block containing the C-string
+    unsigned int        mask;       //NULL bytes found in a block
+    __m128i             zero;       //vector of NULL bytes
+
+    //aligned loads never cross a page boundary, so the whole block holding
+    //  the first character can be read even if the C-string ends early
+    block = ( const char* )
+        ( ( uintptr_t ) cstring & ~( ( uintptr_t ) VEC_SIZE - 1 ) );
+    zero  = _mm_setzero_si128();
+    mask  = _mm_movemask_epi8(
+        _mm_cmpeq_epi8( _mm_load_si128( ( const __m128i* ) block ), zero )
+    );
+
+    //ignore any NULL bytes before the start of the C-string
+    mask >>= ( cstring - block );
+    if( mask != 0 ) {
+        length = __builtin_ctz( mask );
+        return length < limit ? length : limit;
+    }
+
+    //scan the remaining aligned blocks until a NULL byte or the limit
+    length = VEC_SIZE - ( cstring - block );
+    while( length < limit ) {
+        mask = _mm_movemask_epi8(
+            _mm_cmpeq_epi8(
+                _mm_load_si128( ( const __m128i* ) ( cstring + length ) ),
+                zero
+            )
+        );
+        if( mask != 0 ) {
+            length += __builtin_ctz( mask );
+            break;
+        }
+        length += VEC_SIZE;
+    }
+
+    //the last block may have extended past the limit
+    return length < limit ? length : limit;
+
+#else
+
+    //scan string for the NULL terminator, or until the limit
+    for( length = 0; length < limit; ++length ) {
+        if( cstring[ length ] == '\0' ) {
+            break;
+        }
+    }
+
+    //return the number of characters before the terminator
+    return length;
+
+#endif
+}
+
+
+/*==========================================================================*/
+static unsigned long cstr_widen(    //store C-string data as characters
+    hzstr_char_t*       data,       //string characters (sized by cstr_chars)
+    const char*         cstring,    //pointer to C-string data
+    unsigned long       length      //number of bytes of C-string data
+) {                                 //number of characters stored
+
+#ifdef HZSTR_COMPAT_CSTR
+
+    //string data is C-string data (which may be in the string's own memory)
+    str_move( data, cstring, length );
+    return length;
+
+#else
+
+    //local variables
+    unsigned long       index;      //index
+
+    //UTF-8 is decoded into 16-bit and 32-bit characters
+    if( sizeof( hzstr_char_t ) == sizeof( uint16_t ) ) {
+        return hzstr_utf8_to_utf16( ( uint16_t* ) data, cstring, length );
+    }
+    if( sizeof( hzstr_char_t ) == sizeof( uint32_t ) ) {
+        return hzstr_utf8_to_utf32( ( uint32_t* ) data, cstring, length );
+    }
+
+    //do not assume a single-byte type
+    for( index = 0; index < length; ++index ) {
+        data[ index ] = ( hzstr_char_t ) cstring[ index ];
+    }
+    return length;
+
+#endif
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_LATENCY
+
+static lat_block_type* lat_block(   //find this thread's latency histograms
+    void
+) {                                 //histograms (NULL if there is no memory)
+
+    //the first call on each thread adds its histograms
+    if( lat_local == NULL ) {
+        lat_local = ( lat_block_type* ) thread_block(
+            &lat_blocks, sizeof( lat_block_type )
+        );
+    }
+    return lat_local;
+}
+
+
+/*==========================================================================*/
+static int lat_bucket(              //find the histogram bucket of a time
+    unsigned long       time        //recorded time
+) {                                 //bucket index
+
+    //local variables
+    int                 top;        //index of the time's highest set bit
+
+    //short times have a bucket each
+    if( time < LAT_SUB ) {
+        return time;
+    }
+
+    //longer times use their top bit and the LAT_SUB_BITS bits below it
+    top = ( LAT_BITS - 1 ) - __builtin_clzl( time );
+    return ( ( top - LAT_SUB_BITS + 1 ) * LAT_SUB )
+        + ( ( time >> ( top - LAT_SUB_BITS ) ) & ( LAT_SUB - 1 ) );
+}
+
+
+/*==========================================================================*/
+static unsigned long lat_floor(     //find the shortest time in a bucket
+    int                 bucket      //bucket index
+) {                                 //shortest time in the bucket
+
+    //short times have a bucket each
+    if( bucket < LAT_SUB ) {
+        return bucket;
+    }
+
+    //reverse lat_bucket() (the bucket past the last wraps to zero)
+    return ( unsigned long ) ( LAT_SUB + ( bucket % LAT_SUB ) )
+        << ( ( bucket / LAT_SUB ) - 1 );
+}
+
+
+/*==========================================================================*/
+static inline hzstr_result_t lat_grow(
+                                    //check an allocation, timing growths
+    int                 operation,  //operation growing it (HZSTR_LAT_*)
+    hzstr_type*         string,     //the string to check
+    unsigned long       length      //the desired length of the string
+) {                                 //result of the check
+
+    //a string that already fits is neither counted nor timed, so calls
+    //  that do not allocate cost the same as in other builds (the timing
+    //  is kept out of line so it does not add to the caller's frame)
+    if( __builtin_expect(
+        ( length < MAX_LENGTH )
+     && ( ( string->alloc - string->offset ) >= ( length + 1 ) ),
+        1
+    ) ) {
+        return string->alloc;
+    }
+    return lat_timed_grow( operation, string, length );
+}
+
+
+/*==========================================================================*/
+#if !defined( __x86_64__ ) && !defined( __i386__ )
+
+static unsigned long lat_nanoseconds(
+                                    //read the monotonic clock
+    void
+) {                                 //current time in nanoseconds
+
+    //local variables
+    struct timespec     now;        //current time
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( ( unsigned long ) now.tv_sec * 1000000000ul ) + now.tv_nsec;
+}
+
+#endif
+
+
+/*==========================================================================*/
+static unsigned long lat_percentile(//find a percentile of a histogram
+    const unsigned long* counts,    //times in each bucket (LAT_BUCKETS)
+    unsigned long       samples,    //number of times
+    unsigned long       maximum,    //longest time
+    unsigned long       permille    //percentile (in tenths of a percent)
+) {                                 //highest time in the percentile's bucket
+
+    //local variables
+    int                 bucket;     //bucket index
+    unsigned long       rank;       //number of times at or below the result
+    unsigned long       seen;       //number of times in earlier buckets
+
+    //nothing was timed
+    if( samples == 0 ) {
+        return 0;
+    }
+
+    //find the bucket holding the time at the percentile's rank
+    rank = ( ( samples * permille ) + 999 ) / 1000;
+    seen = 0;
+    for( bucket = 0; bucket < ( LAT_BUCKETS - 1 ); ++bucket ) {
+        seen += counts[ bucket ];
+        if( seen >= rank ) {
+            break;
+        }
+    }
+
+    //report the top of the bucket (but never more than the longest time)
+    if( ( lat_floor( bucket + 1 ) - 1 ) < maximum ) {
+        return lat_floor( bucket + 1 ) - 1;
+    }
+    return maximum;
+}
+
+
+/*==========================================================================*/
+static void lat_record(             //record the time of a call
+    int                 operation,  //operation called (HZSTR_LAT_*)
+    unsigned long       time        //time taken
+) {
+
+    //local variables
+    lat_block_type*     block;      //this thread's histograms
+
+    block = lat_block();
+    if( block == NULL ) {
+        return;
+    }
+
+    //add the time to the operation's histogram
+    thread_add( &block->counts[ operation ][ lat_bucket( time ) ], 1 );
+    thread_add( &block->totals[ operation ], time );
+    if( time > atomic_load_explicit(
+        &block->maximums[ operation ], memory_order_relaxed
+    ) ) {
+        atomic_store_explicit(
+            &block->maximums[ operation ], time, memory_order_relaxed
+        );
+    }
+}
+
+
+/*==========================================================================*/
+static inline lat_probe_type lat_start(
+                                    //start a call that may be timed
+    int                 operation   //operation called (HZSTR_LAT_*)
+) {                                 //probe for the call
+
+    //local variables
+    lat_probe_type      probe;      //probe for the call
+
+    probe.operation = operation;
+
+    //untimed calls only count down to the operation's next timed call
+    if( __builtin_expect( lat_countdowns[ operation ] > 1, 1 ) ) {
+        lat_countdowns[ operation ] -= 1;
+        probe.start = 0;
+        return probe;
+    }
+    lat_countdowns[ operation ] = atomic_load_explicit(
+        &lat_rate, memory_order_relaxed
+    );
+    probe.start = lat_clock();
+    return probe;
+}
+
+
+/*==========================================================================*/
+static inline void lat_stop(        //finish a call that may be timed
+    lat_probe_type*     probe       //probe for the call
+) {
+
+    if( __builtin_expect( probe->start != 0, 0 ) ) {
+        lat_record( probe->operation, ( lat_clock() - probe->start ) );
+    }
+}
+
+
+/*==========================================================================*/
+static hzstr_result_t lat_timed_grow(
+                                    //time one string growth
+    int                 operation,  //operation growing it (HZSTR_LAT_*)
+    hzstr_type*         string,     //the string to grow
+    unsigned long       length      //the desired length of the string
+) {                                 //result of the check
+
+    //local variables
+    lat_probe_type      probe;      //probe for the growth
+    hzstr_result_t      result;     //result of the check
+
+    //time the growth (the re-allocation, and the copy it makes)
+    probe  = lat_start( operation );
+    result = check_alloc( string, length );
+    lat_stop( &probe );
+    return result;
+}
+
+
+/*==========================================================================*/
+static void lat_total(              //add up every thread's histograms
+    int                 operation,  //operation to add up (HZSTR_LAT_*)
+    unsigned long*      counts,     //times in each bucket (LAT_BUCKETS)
+    hzstr_latency_type* summary     //samples, total and maximum output
+) {
+
+    //local variables
+    lat_block_type*     block;      //one thread's histograms
+    int                 bucket;     //bucket index
+    unsigned long       count;      //times in one thread's bucket
+    thread_block_type*  link;       //link to one thread's histograms
+    unsigned long       maximum;    //one thread's longest time
+
+    memset( counts, 0, ( LAT_BUCKETS * sizeof( unsigned long ) ) );
+    summary->samples = 0;
+    summary->total   = 0;
+    summary->maximum = 0;
+    link = atomic_load_explicit( &lat_blocks, memory_order_acquire );
+    for( ; link != NULL; link = link->next ) {
+        block = ( lat_block_type* ) link;
+        for( bucket = 0; bucket < LAT_BUCKETS; ++bucket ) {
+            count = atomic_load_explicit(
+                &block->counts[ operation ][ bucket ], memory_order_relaxed
+            );
+            counts[ bucket ] += count;
+            summary->samples += count;
+        }
+        summary->total += atomic_load_explicit(
+            &block->totals[ operation ], memory_order_relaxed
+        );
+        maximum = atomic_load_explicit(
+            &block->maximums[ operation ], memory_order_relaxed
+        );
+        if( maximum > summary->maximum ) {
+            summary->maximum = maximum;
+        }
+    }
+}
+
+#endif
+
+
+/*==========================================================================*/
+#ifdef HZSTR_PROFILE
+
+static void profile_add(            //add a new string to the live strings
+    const hzstr_type*   string      //new string
+) {
+
+    //local variables
+    prof_entry_type*    entry;      //new entry
+    unsigned long       list;       //list of the string
+
+    //a string without an entry is only missing from the reports
+    entry = diag_calloc( 1, sizeof( prof_entry_type ) );
+    if( entry == NULL ) {
+        return;
+    }
+    entry->string  = string;
+    entry->created = profile_clock();
+
+    //add the entry to the front of its list
+    list = prof_list( string );
+    spin_lock( &prof_lock );
+    entry->next        = prof_lists[ list ];
+    prof_lists[ list ] = entry;
+    spin_unlock( &prof_lock );
+}
+
+
+/*==========================================================================*/
+static int profile_bucket(          //find the distribution bucket of a value
+    unsigned long       value       //value (in the distribution's units)
+) {                                 //bucket index
+
+    //local variables
+    int                 bucket;     //bucket index
+
+    //bucket N holds values of at least 1 << ( N - 1 ), up to the last
+    for( bucket = 0; ( value != 0 ) && ( bucket < HZSTR_PROFILE_BUCKETS - 1 );
+        ++bucket ) {
+        value >>= 1;
+    }
+    return bucket;
+}
+
+
+/*==========================================================================*/
+static unsigned long profile_clock( //read the monotonic clock
+    void
+) {                                 //current time in milliseconds
+
+    //local variables
+    struct timespec     now;        //current time
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( ( unsigned long ) now.tv_sec * 1000ul )
+        + ( now.tv_nsec / 1000000l );
+}
+
+
+/*==========================================================================*/
+static int profile_collect(         //add up the live strings of every site
+    hzstr_profile_site_type* totals //totals of each site (PROF_SITES)
+) {                                 //number of sites with live strings
+
+    //local variables
+    unsigned long       bytes;      //bytes held by a string
+    int                 count;      //number of sites with live strings
+    prof_entry_type*    entry;      //one live string
+    int                 index;      //site index
+    unsigned long       list;       //list index
+    unsigned long       now;        //current time
+    hzstr_profile_site_type* site;  //totals of the string's site
+    unsigned long       slack;      //unused bytes of a string
+    const hzstr_type*   string;     //one live string
+
+    //strings changed by other threads during a report may be counted at
+    //  either size
+    now = profile_clock();
+    spin_lock( &prof_lock );
+    for( list = 0; list < PROF_TABLE; ++list ) {
+        for( entry = prof_lists[ list ]; entry != NULL; entry = entry->next ) {
+            string = entry->string;
+
+            //the object, and the allocation of a dynamic string (whose
+            //  slack includes any consumed characters)
+            bytes = sizeof( hzstr_type );
+            slack = 0;
+            if( string->alloc > 0 ) {
+                bytes += string->alloc * sizeof( hzstr_char_t );
+                slack  = ( string->alloc - string->length - 1 )
+                    * sizeof( hzstr_char_t );
+            }
+
+            site = &totals[ entry->site ];
+            site->strings += 1;
+            site->bytes   += bytes;
+            site->slack   += slack;
+            site->sizes[ profile_bucket( bytes / HZSTR_PROFILE_SIZE_UNIT ) ]
+                += 1;
+            site->ages[
+                profile_bucket( ( now - entry->created )
+                    / HZSTR_PROFILE_AGE_UNIT )
+            ] += 1;
+        }
+    }
+
+    //move the sites with live strings to the front of the list
+    count = 0;
+    for( index = 0; index < PROF_SITES; ++index ) {
+        if( totals[ index ].strings == 0 ) {
+            continue;
+        }
+        totals[ index ].file = prof_sites[ index ].file;
+        totals[ index ].line = prof_sites[ index ].line;
+        if( index != count ) {
+            totals[ count ] = totals[ index ];
+        }
+        count += 1;
+    }
+    spin_unlock( &prof_lock );
+
+    //most slack first
+    qsort( totals, count, sizeof( hzstr_profile_site_type ), profile_compare );
+    return count;
+}
+
+
+/*==========================================================================*/
+static int profile_compare(         //order sites by slack (for qsort)
+    const void*         site0,      //first site
+    const void*         site1       //second site
+) {                                 //<0 if site0 holds more slack
+
+    //local variables
+    const hzstr_profile_site_type* first;
+                                    //first site
+    const hzstr_profile_site_type* second;
+                                    //second site
+
+    //sites with the same slack are ordered by the bytes they hold
+    first  = site0;
+    second = site1;
+    if( first->slack != second->slack ) {
+        return ( first->slack > second->slack ) ? -1 : 1;
+    }
+    if( first->bytes != second->bytes ) {
+        return ( first->bytes > second->bytes ) ? -1 : 1;
+    }
+    return 0;
+}
+
+
+/*==========================================================================*/
+static prof_entry_type** profile_find(
+                                    //find the entry of a live string
+    const hzstr_type*   string      //string to find
+) {                                 //link to its entry (to NULL if not found)
+
+    //local variables
+    prof_entry_type**   link;       //link to the current entry
+
+    link = &prof_lists[ prof_list( string ) ];
+    while( ( *link != NULL ) && ( ( *link )->string != string ) ) {
+        link = &( *link )->next;
+    }
+    return link;
+}
+
+
+/*==========================================================================*/
+static void profile_remove(         //remove a string from the live strings
+    const hzstr_type*   string      //string being destroyed
+) {
+
+    //local variables
+    prof_entry_type*    entry;      //the string's entry
+    prof_entry_type**   link;       //link to the string's entry
+
+    spin_lock( &prof_lock );
+    link  = profile_find( string );
+    entry = *link;
+    if( entry != NULL ) {
+        *link = entry->next;
+    }
+    spin_unlock( &prof_lock );
+    diag_free( entry );
+}
+
+
+/*==========================================================================*/
+static int profile_site(            //find (or add) a call site
+    const char*         file,       //source file
+    int                 line        //source line
+) {                                 //site index (0 if the table is full)
+
+    //local variables
+    int                 index;      //site index
+    int                 probe;      //number of sites probed
+
+    //a call without a file is not a site
+    if( file == NULL ) {
+        return 0;
+    }
+
+    //sites are found by line (then file), skipping the unknown site
+    index = ( ( unsigned int ) line % ( PROF_SITES - 1 ) ) + 1;
+    for( probe = 1; probe < PROF_SITES; ++probe ) {
+
+        //a site not used yet becomes the new site
+        if( prof_sites[ index ].file == NULL ) {
+            prof_sites[ index ].file = file;
+            prof_sites[ index ].line = line;
+            return index;
+        }
+
+        //the same file may be named by more than one pointer
+        if( ( prof_sites[ index ].line == line )
+         && ( ( prof_sites[ index ].file == file )
+           || ( strcmp( prof_sites[ index ].file, file ) == 0 ) ) ) {
+            return index;
+        }
+        index = ( index < ( PROF_SITES - 1 ) ) ? ( index + 1 ) : 1;
+    }
+    return 0;
+}
+
+#endif
+
+
+/*==========================================================================*/
+static hzstr_length_t rspan_space(  //find the end of the last non-whitespace
+    const hzstr_char_t* data,       //character data to scan
+    hzstr_length_t      length      //number of characters to scan
+) {                                 //length without trailing whitespace
+
+#ifdef USE_SSE2
+
+    //local variables
+    __m128i             limit;      //whitespace limit in every lane
+    __m128i             chunk;      //characters being checked
+    unsigned int        text;       //mask of non-whitespace lanes
+
+    //check whole vectors from the end of the string
+    if( VEC_WIDTH_OK ) {
+        limit = vec_fill( ' ' );
+        while( length >= VEC_CHARS ) {
+            chunk = _mm_loadu_si128(
+                ( const __m128i* ) ( data + length - VEC_CHARS )
+            );
+
+            //a lane is whitespace if it is not above the limit (unsigned)
+            text = ~_mm_movemask_epi8( vec_at_most( chunk, limit ) ) & 0xFFFF;
+
+            //the highest non-whitespace lane ends the text
+            if( text != 0 ) {
+                return length - VEC_CHARS + vec_rlane( text ) + 1;
+            }
+            length -= VEC_CHARS;
+        }
+    }
+
+#endif
+
+    //check the remaining characters
+    while( ( length > 0 ) && str_space( data[ length - 1 ] ) ) {
+        length -= 1;
+    }
+
+    //return the length of the string without trailing whitespace
+    return length;
+}
+
+
+/*==========================================================================*/
+static hzstr_length_t span_space(   //count leading whitespace
+    const hzstr_char_t* data,       //character data to scan
+    hzstr_length_t      length      //number of characters to scan
+) {                                 //number of whitespace characters
+
+    //local variables
+    hzstr_length_t      pos;        //position in data
+#ifdef USE_SSE2
+    __m128i             limit;      //whitespace limit in every lane
+    __m128i             chunk;      //characters being checked
+    unsigned int        text;       //mask of non-whitespace lanes
+#endif
+
+    //initialize the position
+    pos = 0;
+
+#ifdef USE_SSE2
+
+    //check whole vectors from the start of the string
+    if( VEC_WIDTH_OK ) {
+        limit = vec_fill( ' ' );
+        while( ( pos + VEC_CHARS ) <= length ) {
+            chunk = _mm_loadu_si128( ( const __m128i* ) ( data + pos ) );
+
+            //a lane is whitespace if it is not above the limit (unsigned)
+            text = ~_mm_movemask_epi8( vec_at_most( chunk, limit ) ) & 0xFFFF;
+
+            //the lowest non-whitespace lane ends the whitespace
+            if( text != 0 ) {
+                return pos + vec_lane( text );
+            }
+            pos += VEC_CHARS;
+        }
+    }
+
+#endif
+
+    //check the remaining characters
+    while( ( pos < length ) && str_space( data[ pos ] ) ) {
+        pos += 1;
+    }
+
+    //return the number of whitespace characters
+    return pos;
+}
+
+
+/*==========================================================================*/
+static hzstr_length_t span_text(    //count leading non-whitespace
+    const hzstr_char_t* data,       //character data to scan
+    hzstr_length_t      length      //number of characters to scan
+) {                                 //number of non-whitespace characters
+
+    //local variables
+    hzstr_length_t      pos;        //position in data
+#ifdef USE_SSE2
+    __m128i             limit;      //whitespace limit in every lane
+    __m128i             chunk;      //characters being checked
+    unsigned int        space;      //mask of whitespace lanes
+#endif
+
+    //initialize the position
+    pos = 0;
+
+#ifdef USE_SSE2
+
+    //check whole vectors from the start of the string
+    if( VEC_WIDTH_OK ) {
+        limit = vec_fill( ' ' );
+        while( ( pos + VEC_CHARS ) <= length ) {
+            chunk = _mm_loadu_si128( ( const __m128i* ) ( data + pos ) );
+
+            //a lane is whitespace if it is not above the limit (unsigned)
+            space = _mm_movemask_epi8( vec_at_most( chunk, limit ) );
+
+            //the lowest whitespace lane ends the text
+            if( space != 0 ) {
+                return pos + vec_lane( space );
+            }
+            pos += VEC_CHARS;
+        }
+    }
+
+#endif
+
+    //check the remaining characters
+    while( ( pos < length ) && !str_space( data[ pos ] ) ) {
+        pos += 1;
+    }
+
+    //return the number of non-whitespace characters
+    return pos;
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_STATS
+
+static stats_block_type* stats_block(
+                                    //find this thread's statistics counters
+    void
+) {                                 //counters (NULL if there is no memory)
+
+    //the first call on each thread adds its counters
+    if( stats_local == NULL ) {
+        stats_local = ( stats_block_type* ) thread_block(
+            &stats_blocks, sizeof( stats_block_type )
+        );
+    }
+    return stats_local;
+}
+
+
+/*==========================================================================*/
+static void stats_call(             //count a call of a library function
+    int                 function    //function called (HZSTR_STAT_*)
+) {
+
+    //local variables
+    stats_block_type*   block;      //this thread's counters
+
+    block = stats_block();
+    if( block != NULL ) {
+        block->current = function;
+        stats_count( ( STAT_CALLS + function ), 1 );
+    }
+}
+
+
+/*==========================================================================*/
+static void stats_count(            //add to a statistics counter
+    int                 counter,    //counter to add to (STAT_*)
+    unsigned long       amount      //amount to add
+) {
+
+    //local variables
+    stats_block_type*   block;      //this thread's counters
+
+    block = stats_block();
+    if( block != NULL ) {
+        thread_add( &block->counters[ counter ], amount );
+    }
+}
+
+
+/*==========================================================================*/
+static void stats_moved(            //count bytes moved by the last function
+    unsigned long       bytes       //number of bytes moved
+) {
+
+    //local variables
+    stats_block_type*   block;      //this thread's counters
+
+    block = stats_block();
+    if( block != NULL ) {
+        stats_count( ( STAT_MOVED + block->current ), bytes );
+    }
+}
+
+
+/*==========================================================================*/
+static void stats_total(            //add up every thread's counters
+    unsigned long*      totals      //counter totals (STAT_COUNTERS)
+) {
+
+    //local variables
+    stats_block_type*   block;      //one thread's counters
+    int                 counter;    //counter index
+    thread_block_type*  link;       //link to one thread's counters
+
+    memset( totals, 0, ( STAT_COUNTERS * sizeof( unsigned long ) ) );
+    link = atomic_load_explicit( &stats_blocks, memory_order_acquire );
+    for( ; link != NULL; link = link->next ) {
+        block = ( stats_block_type* ) link;
+        for( counter = 0; counter < STAT_COUNTERS; ++counter ) {
+            totals[ counter ] += atomic_load_explicit(
+                &block->counters[ counter ], memory_order_relaxed
+            );
+        }
+    }
+}
+
+#endif
+
+
+/*==========================================================================*/
+static hzstr_length_t str_alloc(    //allocate/re-allocate string memory
+    hzstr_char_t**      target,     //target string data pointer
+    hzstr_char_t*       source,     //optional source string data pointer
+    hzstr_length_t      length      //length to allocate
+) {                                 //number of bytes actually allocated
+
+#ifdef HZSTR_STATS
+    //local variables
+    hzstr_length_t      requested;  //length requested
+
+    requested = length;
+#endif
+
+    lat_scope( HZSTR_LAT_ALLOC );
+
+    //use a default allocation
+    if( length == 0 ) {
+        length = HZSTR_CHUNK_SIZE;
+    }
+
+    //compute a padded allocation (without exceeding the length type)
+    else if( length < ( MAX_LENGTH - HZSTR_CHUNK_SIZE ) ) {
+        length = ( ( length / HZSTR_CHUNK_SIZE ) + 1 ) * HZSTR_CHUNK_SIZE;
+    }
+    else {
+        length = MAX_LENGTH;
+    }
+
+    //check for new allocation
+    if( source == NULL ) {
+
+        //allocate the requested memory
+        *target = mem_malloc( length * sizeof( hzstr_char_t ) );
+    }
+
+    //this is re-allocating an existing string
+    else {
+
+        //re-allocate the string
+        *target = mem_realloc( source, ( length * sizeof( hzstr_char_t ) ) );
+    }
+
+    //count the characters requested (and a NULL) against those allocated
+    if( *target != NULL ) {
+        stat_count(
+            STAT_REQUESTED, ( ( requested + 1 ) * sizeof( hzstr_char_t ) )
+        );
+        stat_count( STAT_ALLOCATED, ( length * sizeof( hzstr_char_t ) ) );
+    }
+
+    //return length requested for allocation
+    return length;
 }
 
 
 /*==========================================================================*/
-hzstr_result_t hzstr_minimize(      //minimize the memory used for this string
-    hzstr_type*         string      //string to minimize
-) {                                 //result of operation
+static int str_boundary(            //check for a UTF-8 sequence boundary
+    const hzstr_type*   string,     //string to check
+    hzstr_index_t       offset      //offset of character to check
+) {                                 //non-zero if a sequence starts here
+
+    //the end of the string is a boundary, otherwise any character that is
+    //  not a continuation byte (10xxxxxx) starts a sequence
+    return ( offset >= string->length )
+        || ( ( string->data[ offset ] & 0xC0 ) != 0x80 );
+}
 
-    //local variables
-    hzstr_char_t*       ptr;        //pointer to newly-allocated string data
 
-    //this can only be done to dynamic strings
-    if( string->type != HZSTR_TYPE_DYNAMIC ) {
-        return HZSTR_RSLT_TYPE;
+/*==========================================================================*/
+static void str_compact(            //reclaim a string's consumed characters
+    hzstr_type*         string      //the string to compact
+) {
+
+    //move the string (including the NULL byte) to the start of its memory
+    if( string->offset > 0 ) {
+        str_move(
+            str_base( string ),
+            string->data,
+            ( ( string->length + 1 ) * sizeof( hzstr_char_t ) )
+        );
+        string->data  -= string->offset;
+        string->offset = 0;
     }
+}
 
-    //re-allocate the string down to its current length (+1 for NULL)
-    ptr = mem_realloc( string->data, ( string->length + 1 ) );
 
-    //check memory allocation
-    if( ptr == NULL ) {
-        return HZSTR_RSLT_ALLOC;
-    }
+/*==========================================================================*/
+static void str_consume(            //advance the front of a string
+    hzstr_type*         string,     //the string to advance
+    hzstr_length_t      length      //number of characters to skip
+) {
 
-    //update string object
-    string->alloc = string->length + 1;
-    string->data  = ptr;
+    //skip the characters
+    string->data   += length;
+    string->offset += length;
+    string->length -= length;
 
-    //return the new size of the string's allocation
-    return string->alloc;
+    //an empty string can start over at the beginning of its memory
+    if( string->length == 0 ) {
+        string->data  -= string->offset;
+        string->offset = 0;
+        string->data[ 0 ] = 0;
+    }
 }
 
 
 /*==========================================================================*/
-#ifdef HZSTR_COMPAT_CSTR
-
-hzstr_result_t hzstr_sprintf(       //formatted printing into a string
-    hzstr_type*         string,     //target string
-    const char*         format,     //string format
-    ...                             //format arguments
+static hzstr_result_t str_copy_cstr(//copy C-string data into a string
+    hzstr_type*         target,     //copy target (dynamic)
+    const char*         source,     //copy source
+    hzstr_length_t      length,     //number of characters in the source
+    hzstr_flags_t       encoding    //encoding flags of the source
 ) {                                 //result of operation
 
     //local variables
-    char                dummy[ 1 ]; //dummy C-string buffer
-    hzstr_length_t      length;     //length of printed string
+    unsigned long       chars;      //number of characters to store
     hzstr_result_t      result;     //allocation result
-    va_list             varargs;    //varargs object
 
-    //this can only be done to dynamic strings
-    if( string->type != HZSTR_TYPE_DYNAMIC ) {
-        return HZSTR_RSLT_TYPE;
+    //check allocation for this string (once, for the exact length, and
+    //  never for a C-string in the string's own memory)
+    chars = cstr_chars( source, length );
+    if( target->alloc < ( chars + 1 ) ) {
+        result = lat_check_alloc( HZSTR_LAT_CPY_CSTR, target, chars );
+        if( result < HZSTR_RSLT_OK ) {
+            return result;
+        }
     }
 
-    va_start( varargs, format );
-
-    //perform a dummy print to compute the size of the print
-    length = vsnprintf( dummy, 1, format, varargs );
+    //the entire string is replaced, so consumed characters can be re-used
+    target->data  -= target->offset;
+    target->offset = 0;
 
-    //check the size we would have printed, and allocate, as needed
-    result = check_alloc( string, length );
-    if( result < HZSTR_RSLT_OK ) {
-        return result;
-    }
+    //store the C-string in the string
+    cstr_widen( target->data, source, length );
 
-    //print to the string
-    length = vsnprintf( string->data, string->alloc, format, varargs );
+    //update the string's length, and null-terminate it
+    target->length = chars;
+    target->data[ chars ] = 0;
 
-    va_end( varargs );
+    //record the encoding of the new characters
+    target->flags = ( target->flags & ~TEXT_FLAGS ) | encoding;
 
-    //update the string's length
-    string->length = length;
+    //a much shorter string may be shrunk
+    str_shrink( target );
 
-    //return the printed length
-    return length;
+    //return length of string
+    return target->length;
 }
 
-#endif
-
 
 /*==========================================================================*/
-hzstr_index_t hzstr_strchr(         //find first instance of a character
-    const hzstr_type*   string,     //string to search
-    hzstr_char_t        c           //character to search for
-) {                                 //index of character in string (-1=none)
+static hzstr_flags_t str_encoding(  //check the encoding of string data
+    const hzstr_char_t* data,       //character data to check
+    hzstr_length_t      length      //number of characters to check
+) {                                 //encoding flags
+
+#ifdef HZSTR_COMPAT_CSTR
+
+    //string data is C-string data
+    return hzstr_utf8_check( data, length );
+
+#else
 
     //local variables
-    hzstr_index_t       pos;        //position in string
+    hzstr_length_t      index;      //character index
 
-    //initialize the position
-    pos = 0;
+    //only ASCII can be recognized in strings of other character types
+    for( index = 0; index < length; ++index ) {
+        if( ( unsigned long ) data[ index ] >= 0x80 ) {
+            return 0;
+        }
+    }
+    return TEXT_FLAGS;
 
-    //loop through the hzstring (may be a substring)
-    while( pos < string->length ) {
+#endif
+}
 
-        //check for the character
-        if( string->data[ pos ] == c ) {
+
+/*==========================================================================*/
+static hzstr_index_t str_find(      //find a substring in character data
+    const hzstr_char_t* data,       //character data to search
+    hzstr_length_t      length,     //number of characters to search
+    const hzstr_type*   needle      //substring to search for
+) {                                 //index of substring in data (-1=none)
+
+    //local variables
+    hzstr_index_t       last;       //last position a match can start
+    hzstr_index_t       pos;        //position in data
+
+    //the last possible match must fit in the data
+    last = ( hzstr_index_t ) length - needle->length;
+
+    //scan for the first character, then check the rest of the needle
+    for( pos = 0; pos <= last; ++pos ) {
+        if( ( data[ pos ] == needle->data[ 0 ] )
+         && ( memcmp(
+                ( data + pos ),
+                needle->data,
+                ( needle->length * sizeof( hzstr_char_t ) )
+            ) == 0 ) ) {
             return pos;
         }
-
-        //increment the position index
-        pos += 1;
     }
 
-    //unable to find character in string
+    //unable to find the needle in the data
     return HZSTR_INDEX_NONE;
 }
 
 
 /*==========================================================================*/
-hzstr_result_t hzstr_tolower(       //transform the string to lowercase
-    hzstr_type*         string      //the string to make lowercase
+static hzstr_result_t str_import(   //import an untrusted string
+    hzstr_type*         string,     //existing string to use for storage
+    const char*         source,     //C string to import
+    hzstr_length_t      length,     //maximum length to import
+    hzstr_flags_t       required    //encoding flags the source must have
 ) {                                 //result of operation
 
     //local variables
-    hzstr_index_t       pos;        //position index
-
-    //initialize position index
-    pos = 0;
+    hzstr_flags_t       encoding;   //encoding of the source string
+    unsigned long       srclen;     //source string length
 
-    //loop through the entire string
-    while( pos < string->length ) {
+    //this can only be done to dynamic strings
+    if( string->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
 
-        //check for an uppercase letter
-        if( ( string->data[ pos ] >= 'A' )
-         && ( string->data[ pos ] <= 'Z' ) ) {
+    //find the length of the source string, but never scan further than
+    //  one character past the user's limit
+    srclen = cstr_len( source, ( ( unsigned long ) length + 1 ) );
 
-            //make it lowercase
-            string->data[ pos ] += 'a' - 'A';
-        }
+    //check what was found against the user's limit
+    if( srclen > length ) {
+        return HZSTR_RSLT_SAFETY;
+    }
 
-        //advance to the next character
-        pos += 1;
+    //check the encoding before anything is copied
+    encoding = cstr_encoding( source, srclen );
+    if( ( encoding & required ) != required ) {
+        return HZSTR_RSLT_ENCODING;
     }
 
-    //return success
-    return HZSTR_RSLT_OK;
+    //copy the user's C-string into the string
+    return str_copy_cstr( string, source, srclen, encoding );
 }
 
 
 /*==========================================================================*/
-hzstr_result_t hzstr_toupper(       //transform the string to uppercase
-    hzstr_type*         string      //the string to make uppercase
-) {                                 //result of operation
-
-    //local variables
-    hzstr_index_t       pos;        //position index
+static int str_overlaps(            //check if two strings share storage
+    const hzstr_type*   string,     //string that owns its storage
+    const hzstr_type*   other       //string that may refer to that storage
+) {                                 //non-zero if the storage overlaps
+
+    //check if the other string's data lies within the string's allocation
+    return ( other->data >= str_base( string ) )
+        && ( other->data < ( str_base( string ) + string->alloc ) );
+}
 
-    //initialize position index
-    pos = 0;
 
-    //loop through the entire string
-    while( pos < string->length ) {
+/*==========================================================================*/
+static void str_shrink(             //apply the shrink policy to a string
+    hzstr_type*         string      //the string that may be shrunk
+) {
 
-        //check for a lowercase letter
-        if( ( string->data[ pos ] >= 'a' )
-         && ( string->data[ pos ] <= 'z' ) ) {
+    //local variables
+    hzstr_length_t      alloc;      //new allocation of the string data
+    hzstr_char_t*       data;       //pointer to re-allocated string data
+
+    //shrink only dynamic strings whose allocations are well beyond their
+    //  lengths (and beyond the policy's minimum)
+    if( ( shrink_factor == 0 )
+     || ( string->type != HZSTR_TYPE_DYNAMIC )
+     || ( string->alloc <= shrink_minimum )
+     || ( ( ( unsigned long ) string->length + 1 ) * shrink_factor
+        > string->alloc ) ) {
+        return;
+    }
 
-            //make it uppercase
-            string->data[ pos ] -= 'a' - 'A';
-        }
+    //leave room to double the length (so the string must lose half of its
+    //  length before it is shrunk again)
+    alloc = ( ( ( string->length * 2 ) / HZSTR_CHUNK_SIZE ) + 1 )
+        * HZSTR_CHUNK_SIZE;
+    if( alloc >= string->alloc ) {
+        return;
+    }
 
-        //advance to the next character
-        pos += 1;
+    //move the characters to the beginning of the allocation, and shrink it
+    //  (a string that can not be re-allocated keeps its memory)
+    str_compact( string );
+    data = mem_realloc( string->data, ( alloc * sizeof( hzstr_char_t ) ) );
+    if( data == NULL ) {
+        return;
     }
 
-    //return success
-    return HZSTR_RSLT_OK;
+    //update the string object
+    stat_count(
+        STAT_MINIMIZED, ( ( string->alloc - alloc ) * sizeof( hzstr_char_t ) )
+    );
+    string->alloc = alloc;
+    string->data  = data;
 }
 
 
 /*==========================================================================*/
-hzstr_result_t hzstr_trim(          //trim a string in-place
-    hzstr_type*         string      //string to trim
+static hzstr_result_t str_splice(   //replace a range of a string's data
+    hzstr_type*         target,     //string to modify
+    hzstr_index_t       offset,     //beginning offset of range to replace
+    hzstr_length_t      length,     //number of characters to replace
+    const hzstr_char_t* source,     //replacement characters
+    hzstr_length_t      insert,     //number of replacement characters
+    hzstr_flags_t       encoding    //encoding flags of replacement
 ) {                                 //result of operation
 
     //local variables
-    hzstr_length_t      leading;    //amount of leading whitespace
-    hzstr_length_t      length;     //length of string after trimming
-    hzstr_char_t*       pos;        //position pointer in string data
+    hzstr_flags_t       flags;      //encoding flags of the result
+    hzstr_result_t      result;     //allocation result
+    unsigned long       total;      //length of string after the splice
 
-    //initialize length
-    length = string->length;
+    //check the type of target string
+    if( target->type != HZSTR_TYPE_DYNAMIC ) {
+        return HZSTR_RSLT_TYPE;
+    }
+
+    //validate the requested range
+    if( ( offset < 0                             )
+     || ( offset > target->length                )
+     || ( length > ( target->length - offset )   ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
 
-    //set the position to the last character in the string
-    pos = string->data + string->length - 1;
+    //compute the length of the string after the splice
+    total = ( unsigned long ) target->length - length + insert;
+    if( total >= MAX_LENGTH ) {
+        return HZSTR_RSLT_SAFETY;
+    }
 
-    //loop until the last non-whitespace character is found
-    //  note: do not scan past the start of the string
-    while( ( *pos <= ' ' ) && ( pos >= string->data ) ) {
+    //the result is what the target and replacement are both known to be,
+    //  as long as the range does not split a UTF-8 sequence
+    flags = target->flags & ( encoding | ~TEXT_FLAGS );
+    if( ( str_boundary( target, offset ) == 0 )
+     || ( str_boundary( target, ( offset + length ) ) == 0 ) ) {
+        flags &= ~HZSTR_FLG_UTF8;
+    }
 
-        //set all whitespace characters to the NULL byte
-        *pos = '\0';
+    //check allocation of target string
+    result = check_alloc( target, total );
+    if( result < HZSTR_RSLT_OK ) {
+        return result;
+    }
 
-        //decrement length
-        length -= 1;
+    //move the tail of the string (including the NULL byte) into place
+    if( insert != length ) {
+        str_move(
+            &( target->data[ offset + insert ] ),
+            &( target->data[ offset + length ] ),
+            ( ( target->length - offset - length + 1 )
+                * sizeof( hzstr_char_t ) )
+        );
+    }
 
-        //move position back one character
-        pos -= 1;
+    //copy the replacement into the range
+    if( insert > 0 ) {
+        str_copy(
+            &( target->data[ offset ] ),
+            source,
+            ( insert * sizeof( hzstr_char_t ) )
+        );
     }
 
-    //set the position to the first character in the string
-    pos = string->data;
+    //update the length and encoding of the target
+    target->length = total;
+    target->flags  = flags;
+
+    //return the new length
+    return target->length;
+}
 
-    //set the leading space to zero
-    leading = 0;
 
-    //loop until the first non-whitespace character is found
-    //  note: do not scan past the end of the string
-    while( ( *pos <= ' ' ) && ( *pos != '\0' ) ) {
+/*==========================================================================*/
+static hzstr_result_t str_trim(     //trim either end of a string in-place
+    hzstr_type*         string,     //string to trim
+    int                 left,       //non-zero to trim leading whitespace
+    int                 right       //non-zero to trim trailing whitespace
+) {                                 //result of operation
 
-        //increment the leading space counter
-        leading += 1;
+    //local variables
+    hzstr_length_t      leading;    //amount of leading whitespace
+    hzstr_length_t      length;     //length of string after trimming
 
-        //move the position to the next character
-        pos += 1;
+    //check pointer
+    if( string == NULL ) {
+        return HZSTR_RSLT_USAGE;
     }
 
-    //move all the characters up to the beginning of the string
-    while( *pos != '\0' ) {
+    //constant strings can not be modified
+    if( string->type == HZSTR_TYPE_CONST ) {
+        return HZSTR_RSLT_TYPE;
+    }
 
-        //place the current character earlier in the string
-        *( pos - leading ) = *pos;
+    //find the end of the last non-whitespace character
+    length = string->length;
+    if( right != 0 ) {
+        length = rspan_space( string->data, length );
+    }
 
-        //move the position to the next character
-        pos += 1;
+    //find the first non-whitespace character
+    //  note: do not scan past the trailing whitespace
+    leading = 0;
+    if( left != 0 ) {
+        leading = span_space( string->data, length );
+    }
+
+    //substrings are trimmed by narrowing the view of their source
+    if( string->type == HZSTR_TYPE_SUBSTR ) {
+        string->data  += leading;
+        string->length = length - leading;
+        return string->length;
     }
 
-    //set the null pointer in the last position
-    *( pos - leading ) = '\0';
+    //drop the trailing whitespace
+    string->length = length;
+    string->data[ string->length ] = '\0';
+
+    //skip the leading whitespace without moving the string
+    str_consume( string, leading );
 
-    //update the string's length
-    string->length = length - leading;
+    //a much shorter string may be shrunk
+    str_shrink( string );
 
     //return the trimmed length
     return string->length;
@@ -718,92 +3931,138 @@ hzstr_result_t hzstr_trim(          //trim a string in-place
 
 
 /*==========================================================================*/
-static hzstr_result_t check_alloc(  //check a string's allocation
-    hzstr_type*         string,     //the string to check
-    hzstr_length_t      length      //the desired length of the string
-) {                                 //result of the check
+#if defined( HZSTR_STATS ) || defined( HZSTR_LATENCY )
 
-    //local variables
-    hzstr_length_t      alloc;      //new allocation of the string data
-    hzstr_char_t*       data;       //pointer to allocated string data
+static void thread_add(             //add to one of this thread's counters
+    atomic_ulong*       counter,    //counter in this thread's block
+    unsigned long       amount      //amount to add
+) {
 
-    //see if the string needs to be embiggened
-    if( string->alloc < ( length + 1 ) ) {
+    //only this thread writes its block, so no read-modify-write is needed
+    //  (other threads only read it)
+    atomic_store_explicit(
+        counter,
+        ( atomic_load_explicit( counter, memory_order_relaxed ) + amount ),
+        memory_order_relaxed
+    );
+}
 
-        //adjust the allocated memory for the string
-        alloc = str_alloc( &data, string->data, length );
 
-        //check allocation
-        if( data == NULL ) {
+/*==========================================================================*/
+static void* thread_block(          //add a block of data for this thread
+    _Atomic( thread_block_type* )* blocks,
+                                    //every thread's blocks
+    size_t              size        //size of the block
+) {                                 //new block (NULL if there is no memory)
 
-            //report failure
-            return HZSTR_RSLT_ALLOC;
-        }
+    //local variables
+    thread_block_type*  block;      //new block
 
-        //update the string's allocated length and string pointer
-        string->alloc = alloc;
-        string->data  = data;
+    //allocate the block (zeroed, so every counter starts at 0)
+    block = diag_calloc( 1, size );
+    if( block == NULL ) {
+        return NULL;
     }
 
-    //report the allocated length of the string
-    return string->alloc;
+    //add the block to the list (blocks are kept after a thread exits, so
+    //  its data remains in the totals)
+    block->next = atomic_load_explicit( blocks, memory_order_relaxed );
+    while( !atomic_compare_exchange_weak_explicit(
+        blocks,
+        &block->next,
+        block,
+        memory_order_release,
+        memory_order_relaxed
+    ) ) {
+    }
+    return block;
 }
 
+#endif
+
 
+#ifdef USE_SSE2
 /*==========================================================================*/
-static hzstr_length_t cstr_len(     //compute length of C-string
-    const char*         cstring     //pointer to C-string
-) {                                 //length of C-string
+static __m128i vec_add(             //add characters in each lane
+    __m128i             a,          //first vector
+    __m128i             b           //second vector
+) {                                 //lane-wise sum
+    if( sizeof( hzstr_char_t ) == 1 ) {
+        return _mm_add_epi8( a, b );
+    }
+    if( sizeof( hzstr_char_t ) == 2 ) {
+        return _mm_add_epi16( a, b );
+    }
+    return _mm_add_epi32( a, b );
+}
 
-    //local variables
-    const char*         start;      //pointer to C-string
 
-    //initialize the pointer to the beginning of the C-string
-    start = cstring;
+/*==========================================================================*/
+static __m128i vec_at_most(         //compare lanes as unsigned characters
+    __m128i             a,          //characters to check
+    __m128i             b           //limit for each lane
+) {                                 //all bits set in lanes where a <= b
 
-    //scan string for the NULL terminator
-    while( *cstring != '\0' ) {
+    //local variables
+    __m128i             bias;       //moves unsigned order into signed order
 
-        //advance the C-string pointer
-        cstring += 1;
+    //a saturating subtraction is zero when a lane is not above its limit
+    if( sizeof( hzstr_char_t ) == 1 ) {
+        return _mm_cmpeq_epi8( _mm_subs_epu8( a, b ), _mm_setzero_si128() );
+    }
+    if( sizeof( hzstr_char_t ) == 2 ) {
+        return _mm_cmpeq_epi16( _mm_subs_epu16( a, b ), _mm_setzero_si128() );
     }
 
-    //return the difference between the pointers
-    return cstring - start;
+    //SSE2 only compares 32-bit lanes as signed values
+    bias = _mm_set1_epi32( ( int ) 0x80000000 );
+    return _mm_cmpeq_epi32(
+        _mm_cmpgt_epi32( _mm_xor_si128( a, bias ), _mm_xor_si128( b, bias ) ),
+        _mm_setzero_si128()
+    );
 }
 
 
 /*==========================================================================*/
-static hzstr_length_t str_alloc(    //allocate/re-allocate string memory
-    hzstr_char_t**      target,     //target string data pointer
-    hzstr_char_t*       source,     //optional source string data pointer
-    hzstr_length_t      length      //length to allocate
-) {                                 //number of bytes actually allocated
-
-    //use a default allocation
-    if( length == 0 ) {
-        length = HZSTR_CHUNK_SIZE;
+static __m128i vec_equal(           //compare lanes for equality
+    __m128i             a,          //first vector
+    __m128i             b           //second vector
+) {                                 //all bits set in lanes where a == b
+    if( sizeof( hzstr_char_t ) == 1 ) {
+        return _mm_cmpeq_epi8( a, b );
     }
-
-    //compute a padded allocation
-    else {
-        length = ( ( length / HZSTR_CHUNK_SIZE ) + 1 ) * HZSTR_CHUNK_SIZE;
+    if( sizeof( hzstr_char_t ) == 2 ) {
+        return _mm_cmpeq_epi16( a, b );
     }
+    return _mm_cmpeq_epi32( a, b );
+}
 
-    //check for new allocation
-    if( source == NULL ) {
 
-        //allocate the requested memory
-        *target = mem_malloc( length * sizeof( hzstr_char_t ) );
+/*==========================================================================*/
+static __m128i vec_fill(            //place a character in every lane
+    hzstr_char_t        c           //character to place
+) {                                 //vector of the character
+    if( sizeof( hzstr_char_t ) == 1 ) {
+        return _mm_set1_epi8( ( char ) c );
     }
+    if( sizeof( hzstr_char_t ) == 2 ) {
+        return _mm_set1_epi16( ( short ) c );
+    }
+    return _mm_set1_epi32( ( int ) c );
+}
 
-    //this is re-allocating an existing string
-    else {
 
-        //re-allocate the string
-        *target = mem_realloc( source, ( length * sizeof( hzstr_char_t ) ) );
+/*==========================================================================*/
+static __m128i vec_sub(             //subtract characters in each lane
+    __m128i             a,          //first vector
+    __m128i             b           //second vector
+) {                                 //lane-wise difference
+    if( sizeof( hzstr_char_t ) == 1 ) {
+        return _mm_sub_epi8( a, b );
     }
-
-    //return length requested for allocation
-    return length;
+    if( sizeof( hzstr_char_t ) == 2 ) {
+        return _mm_sub_epi16( a, b );
+    }
+    return _mm_sub_epi32( a, b );
 }
+#endif
@@ -0,0 +1,805 @@
+/*****************************************************************************
+    hztrace.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Records are collected in a buffer, and written to the trace when
+        the buffer is full (and when recording stops).  The buffer is
+        shared by every thread, and guarded by a spin lock.  Calls made
+        while nothing is being recorded only check a flag.
+
+        Calls that create strings are recorded after the call (so the new
+        string's address is known), and hzstr_trace_destroy() records the
+        call before the string is destroyed, so a later string created at
+        the same address is always recorded after it.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+//the recorder's calls go to the library
+#define HZSTR_TRACE_RECORDER
+
+#include "hzlock.h"
+#include "hztrace.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define TRACE_BUFFER ( 4096 )       //records buffered before writing
+#define PRINT_SIZE ( 256 )          //printed characters kept on the stack
+
+//record a call (only the address of a string is recorded)
+#define trace( _o, _t, _s, _l, _f ) do { \
+    if( atomic_load_explicit( &trace_active, memory_order_relaxed ) != 0 ) { \
+        trace_record( ( _o ), ( _t ), ( _s ), ( _l ), ( _f ) ); \
+    } \
+} while( 0 )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static atomic_int       trace_active;
+                                    //non-zero while recording
+static hzstr_trace_record_type trace_buffer[ TRACE_BUFFER ];
+                                    //records not yet written
+static unsigned long    trace_buffered;
+                                    //number of records in the buffer
+static FILE*            trace_file; //trace being written
+static atomic_int       trace_lock; //spin lock for the buffer and trace
+static unsigned long    trace_total;//number of records written
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static unsigned long trace_cstr_len(
+                                    //measure a C-string up to a limit
+    const char*         source,     //C-string to measure (may be NULL)
+    hzstr_length_t      limit       //longest length measured
+);                                  //length of the C-string (up to the limit)
+
+static void trace_flush(            //write the buffered records
+    void
+);
+
+static void trace_record(           //record a call
+    int                 operation,  //operation called (HZSTR_TRACE_*)
+    const void*         target,     //string operated on (or created)
+    const void*         source,     //source string (NULL if none)
+    unsigned long       length,     //length argument
+    long                offset      //offset argument
+);
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+hzstr_trace_record_type* hzstr_trace_load(
+                                    //read every record of a trace file
+    const char*         path,       //trace file to read
+    unsigned long*      count       //number of records read
+) {                                 //records (NULL if the trace is invalid)
+
+    //local variables
+    FILE*               file;       //trace file
+    hzstr_trace_header_type header; //trace file header
+    long                size;       //size of the trace file
+    hzstr_trace_record_type* records;
+                                    //records read
+
+    //check pointers
+    if( ( path == NULL ) || ( count == NULL ) ) {
+        return NULL;
+    }
+    *count = 0;
+
+    //check the header
+    file = fopen( path, "rb" );
+    if( file == NULL ) {
+        return NULL;
+    }
+    if( ( fread( &header, sizeof( header ), 1, file ) != 1 )
+     || ( memcmp( header.magic, HZSTR_TRACE_MAGIC, 8 ) != 0 )
+     || ( header.version != HZSTR_TRACE_VERSION ) ) {
+        fclose( file );
+        return NULL;
+    }
+
+    //size the records (a partly-written last record is ignored)
+    fseek( file, 0, SEEK_END );
+    size = ftell( file ) - ( long ) sizeof( header );
+    fseek( file, sizeof( header ), SEEK_SET );
+    *count = size / sizeof( hzstr_trace_record_type );
+
+    //read the records (an empty trace still has an allocation to release)
+    records = mem_malloc(
+        ( *count + 1 ) * sizeof( hzstr_trace_record_type )
+    );
+    if( records == NULL ) {
+        *count = 0;
+        fclose( file );
+        return NULL;
+    }
+    if( fread( records, sizeof( hzstr_trace_record_type ), *count, file )
+        != *count ) {
+        mem_free( records );
+        *count = 0;
+        fclose( file );
+        return NULL;
+    }
+    fclose( file );
+    return records;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_start(   //start recording calls into a trace
+    const char*         path        //trace file to write
+) {                                 //result of operation
+
+    //local variables
+    hzstr_trace_header_type header; //trace file header
+    hzstr_result_t      result;     //result of operation
+
+    //check pointer
+    if( path == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    spin_lock( &trace_lock );
+
+    //only one trace is recorded at a time
+    if( trace_file != NULL ) {
+        spin_unlock( &trace_lock );
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //open the trace, and write its header
+    result = HZSTR_RSLT_USAGE;
+    trace_file = fopen( path, "wb" );
+    if( trace_file != NULL ) {
+        memset( &header, 0, sizeof( header ) );
+        memcpy( header.magic, HZSTR_TRACE_MAGIC, 8 );
+        header.version   = HZSTR_TRACE_VERSION;
+        header.char_size = sizeof( hzstr_char_t );
+        fwrite( &header, sizeof( header ), 1, trace_file );
+        trace_buffered = 0;
+        trace_total    = 0;
+        atomic_store_explicit( &trace_active, 1, memory_order_relaxed );
+        result = HZSTR_RSLT_OK;
+    }
+
+    spin_unlock( &trace_lock );
+    return result;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_stop(    //stop recording, and close the trace
+    void
+) {                                 //number of records written (or error)
+
+    //local variables
+    hzstr_result_t      result;     //result of operation
+
+    spin_lock( &trace_lock );
+
+    //nothing is being recorded
+    if( trace_file == NULL ) {
+        spin_unlock( &trace_lock );
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //write the last records, and close the trace
+    atomic_store_explicit( &trace_active, 0, memory_order_relaxed );
+    trace_flush();
+    fclose( trace_file );
+    trace_file = NULL;
+    result     = trace_total;
+
+    spin_unlock( &trace_lock );
+    return result;
+}
+
+
+/*==========================================================================*/
+void hzstr_trace_unload(            //release the records of a loaded trace
+    hzstr_trace_record_type* records//records from hzstr_trace_load()
+) {
+    mem_free( records );
+}
+
+
+/*----------------------------------------------------------------------------
+Recorded Library Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_append(
+    hzstr_type*         string,
+    hzstr_char_t        c
+) {
+    trace( HZSTR_TRACE_APPEND, string, NULL, 1, 0 );
+    return hzstr_append( string, c );
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_COMPAT_CSTR
+
+long hzstr_trace_casecmp(
+    const hzstr_type*   string0,
+    const hzstr_type*   string1
+) {
+    trace( HZSTR_TRACE_CASECMP, string0, string1, 0, 0 );
+    return hzstr_casecmp( string0, string1 );
+}
+
+#endif
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_cat(
+    hzstr_type*         target,
+    const hzstr_type*   source
+) {
+    trace( HZSTR_TRACE_CAT, target, source, 0, 0 );
+    return hzstr_cat( target, source );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_cat_cstr(
+    hzstr_type*         target,
+    const char*         source
+) {
+    trace(
+        HZSTR_TRACE_CAT_CSTR,
+        target,
+        NULL,
+        ( source != NULL ? strlen( source ) : 0 ),
+        0
+    );
+    return hzstr_cat_cstr( target, source );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_cat_cstr_n(
+    hzstr_type*         target,
+    const char*         source,
+    hzstr_length_t      length
+) {
+    trace( HZSTR_TRACE_CAT_CSTR_N, target, NULL, length, 0 );
+    return hzstr_cat_cstr_n( target, source, length );
+}
+
+
+/*==========================================================================*/
+long hzstr_trace_cmp(
+    const hzstr_type*   string0,
+    const hzstr_type*   string1
+) {
+    trace( HZSTR_TRACE_CMP, string0, string1, 0, 0 );
+    return hzstr_cmp( string0, string1 );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_compact_all(
+    hzstr_type**        strings,
+    int                 count
+) {
+
+    //local variables
+    int                 index;      //index of string to record
+
+    //each string is recorded as if it were compacted by itself
+    if( strings != NULL ) {
+        for( index = 0; index < count; ++index ) {
+            if( strings[ index ] != NULL ) {
+                trace( HZSTR_TRACE_COMPACT_ALL, strings[ index ], NULL, 0, 0 );
+            }
+        }
+    }
+    return hzstr_compact_all( strings, count );
+}
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_consume(
+    hzstr_type*         string,
+    hzstr_length_t      length
+) {
+    trace( HZSTR_TRACE_CONSUME, string, NULL, length, 0 );
+    return hzstr_consume( string, length );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_cpy(
+    hzstr_type*         target,
+    const hzstr_type*   source
+) {
+    trace( HZSTR_TRACE_CPY, target, source, 0, 0 );
+    return hzstr_cpy( target, source );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_cpy_cstr(
+    hzstr_type*         target,
+    const char*         source
+) {
+    trace(
+        HZSTR_TRACE_CPY_CSTR,
+        target,
+        NULL,
+        ( source != NULL ? strlen( source ) : 0 ),
+        0
+    );
+    return hzstr_cpy_cstr( target, source );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_cpy_cstr_n(
+    hzstr_type*         target,
+    const char*         source,
+    hzstr_length_t      length
+) {
+    trace( HZSTR_TRACE_CPY_CSTR_N, target, NULL, length, 0 );
+    return hzstr_cpy_cstr_n( target, source, length );
+}
+
+
+/*==========================================================================*/
+hzstr_type* hzstr_trace_create(
+    hzstr_length_t      length
+) {
+
+    //local variables
+    hzstr_type*         string;     //new string
+
+    string = hzstr_create( length );
+    trace( HZSTR_TRACE_CREATE, string, NULL, length, 0 );
+    return string;
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_COMPAT_CSTR
+
+hzstr_type* hzstr_trace_create_ccstr(
+    const char*         cstring
+) {
+
+    //local variables
+    hzstr_type*         string;     //new string
+
+    string = hzstr_create_ccstr( cstring );
+    trace(
+        HZSTR_TRACE_CREATE_CCSTR,
+        string,
+        NULL,
+        ( cstring != NULL ? strlen( cstring ) : 0 ),
+        0
+    );
+    return string;
+}
+
+#endif
+
+/*==========================================================================*/
+hzstr_type* hzstr_trace_create_cstr(
+    const char*         cstring
+) {
+
+    //local variables
+    hzstr_type*         string;     //new string
+
+    string = hzstr_create_cstr( cstring );
+    trace(
+        HZSTR_TRACE_CREATE_CSTR,
+        string,
+        NULL,
+        ( cstring != NULL ? strlen( cstring ) : 0 ),
+        0
+    );
+    return string;
+}
+
+
+/*==========================================================================*/
+hzstr_type* hzstr_trace_create_cstr_n(
+    const char*         cstring,
+    hzstr_length_t      length
+) {
+
+    //local variables
+    hzstr_type*         string;     //new string
+
+    string = hzstr_create_cstr_n( cstring, length );
+    trace( HZSTR_TRACE_CREATE_CSTR_N, string, NULL, length, 0 );
+    return string;
+}
+
+
+/*==========================================================================*/
+hzstr_type* hzstr_trace_create_substr(
+    const hzstr_type*   source,
+    hzstr_index_t       offset,
+    hzstr_length_t      length
+) {
+
+    //local variables
+    hzstr_type*         string;     //new substring
+
+    string = hzstr_create_substr( source, offset, length );
+    trace( HZSTR_TRACE_CREATE_SUBSTR, string, source, length, offset );
+    return string;
+}
+
+
+/*==========================================================================*/
+void hzstr_trace_destroy(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_DESTROY, string, NULL, 0, 0 );
+    hzstr_destroy( string );
+}
+
+
+/*==========================================================================*/
+int hzstr_trace_equal(
+    const hzstr_type*   string0,
+    const hzstr_type*   string1
+) {
+    trace( HZSTR_TRACE_EQUAL, string0, string1, 0, 0 );
+    return hzstr_equal( string0, string1 );
+}
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_erase(
+    hzstr_type*         target,
+    hzstr_index_t       offset,
+    hzstr_length_t      length
+) {
+    trace( HZSTR_TRACE_ERASE, target, NULL, length, offset );
+    return hzstr_erase( target, offset, length );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_export_utf8(
+    const hzstr_type*   string,
+    char*               output,
+    unsigned long       size
+) {
+    trace( HZSTR_TRACE_EXPORT_UTF8, string, NULL, 0, 0 );
+    return hzstr_export_utf8( string, output, size );
+}
+
+/*==========================================================================*/
+#ifdef HZSTR_COMPAT_CSTR
+
+hzstr_result_t hzstr_trace_fold(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_FOLD, string, NULL, 0, 0 );
+    return hzstr_fold( string );
+}
+
+#endif
+
+/*==========================================================================*/
+hzstr_hash_t hzstr_trace_hash(
+    const hzstr_type*   string
+) {
+    trace( HZSTR_TRACE_HASH, string, NULL, 0, 0 );
+    return hzstr_hash( string );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_import(
+    hzstr_type*         string,
+    const char*         source,
+    hzstr_length_t      length
+) {
+    trace(
+        HZSTR_TRACE_IMPORT,
+        string,
+        NULL,
+        trace_cstr_len( source, length ),
+        0
+    );
+    return hzstr_import( string, source, length );
+}
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_import_utf8(
+    hzstr_type*         string,
+    const char*         source,
+    hzstr_length_t      length
+) {
+    trace(
+        HZSTR_TRACE_IMPORT_UTF8,
+        string,
+        NULL,
+        trace_cstr_len( source, length ),
+        0
+    );
+    return hzstr_import_utf8( string, source, length );
+}
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_insert(
+    hzstr_type*         target,
+    hzstr_index_t       offset,
+    const hzstr_type*   source
+) {
+    trace( HZSTR_TRACE_INSERT, target, source, 0, offset );
+    return hzstr_insert( target, offset, source );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_minimize(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_MINIMIZE, string, NULL, 0, 0 );
+    return hzstr_minimize( string );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_replace_all(
+    hzstr_type*         target,
+    const hzstr_type*   needle,
+    const hzstr_type*   replacement
+) {
+    trace(
+        HZSTR_TRACE_REPLACE_ALL,
+        target,
+        needle,
+        ( replacement != NULL ? replacement->length : 0 ),
+        0
+    );
+    return hzstr_replace_all( target, needle, replacement );
+}
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_reserve(
+    hzstr_type*         string,
+    hzstr_length_t      length
+) {
+    trace( HZSTR_TRACE_RESERVE, string, NULL, length, 0 );
+    return hzstr_reserve( string, length );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_splice(
+    hzstr_type*         target,
+    hzstr_index_t       offset,
+    hzstr_length_t      length,
+    const hzstr_type*   source
+) {
+    trace( HZSTR_TRACE_SPLICE, target, source, length, offset );
+    return hzstr_splice( target, offset, length, source );
+}
+
+/*==========================================================================*/
+#ifdef HZSTR_COMPAT_CSTR
+
+hzstr_result_t hzstr_trace_sprintf(
+    hzstr_type*         string,
+    const char*         format,
+    ...
+) {
+
+    //local variables
+    char                buffer[ PRINT_SIZE ];
+                                    //short prints
+    int                 length;     //printed length
+    char*               print;      //printed C-string
+    hzstr_result_t      result;     //result of operation
+    va_list             varargs;    //varargs object
+
+    //the library has no va_list interface, so the arguments are printed
+    //  here, and the library prints the result (as the same C-string)
+    va_start( varargs, format );
+    length = vsnprintf( buffer, PRINT_SIZE, format, varargs );
+    va_end( varargs );
+    if( length < 0 ) {
+        return HZSTR_RSLT_USAGE;
+    }
+    print = buffer;
+    if( length >= PRINT_SIZE ) {
+        print = mem_malloc( length + 1 );
+        if( print == NULL ) {
+            return HZSTR_RSLT_ALLOC;
+        }
+        va_start( varargs, format );
+        vsnprintf( print, ( length + 1 ), format, varargs );
+        va_end( varargs );
+    }
+
+    trace( HZSTR_TRACE_SPRINTF, string, NULL, length, 0 );
+    result = hzstr_sprintf( string, "%s", print );
+
+    if( print != buffer ) {
+        mem_free( print );
+    }
+    return result;
+}
+
+#endif
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_squeeze(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_SQUEEZE, string, NULL, 0, 0 );
+    return hzstr_squeeze( string );
+}
+
+/*==========================================================================*/
+hzstr_index_t hzstr_trace_strchr(
+    const hzstr_type*   string,
+    hzstr_char_t        c
+) {
+    trace( HZSTR_TRACE_STRCHR, string, NULL, 0, 0 );
+    return hzstr_strchr( string, c );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_tolower(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_TOLOWER, string, NULL, 0, 0 );
+    return hzstr_tolower( string );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_toupper(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_TOUPPER, string, NULL, 0, 0 );
+    return hzstr_toupper( string );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_trim(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_TRIM, string, NULL, 0, 0 );
+    return hzstr_trim( string );
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_trim_left(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_TRIM_LEFT, string, NULL, 0, 0 );
+    return hzstr_trim_left( string );
+}
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_trim_right(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_TRIM_RIGHT, string, NULL, 0, 0 );
+    return hzstr_trim_right( string );
+}
+
+/*==========================================================================*/
+hzstr_result_t hzstr_trace_validate(
+    hzstr_type*         string
+) {
+    trace( HZSTR_TRACE_VALIDATE, string, NULL, 0, 0 );
+    return hzstr_validate( string );
+}
+
+/*==========================================================================*/
+static unsigned long trace_cstr_len(
+                                    //measure a C-string up to a limit
+    const char*         source,     //C-string to measure (may be NULL)
+    hzstr_length_t      limit       //longest length measured
+) {                                 //length of the C-string (up to the limit)
+
+    //local variables
+    unsigned long       length;     //length of the C-string
+
+    //scan no further than the library will
+    length = 0;
+    if( source != NULL ) {
+        while( ( length < limit ) && ( source[ length ] != '\0' ) ) {
+            length += 1;
+        }
+    }
+    return length;
+}
+
+/*==========================================================================*/
+static void trace_flush(            //write the buffered records
+    void
+) {
+
+    //the lock is held by the caller
+    if( trace_buffered > 0 ) {
+        fwrite(
+            trace_buffer,
+            sizeof( hzstr_trace_record_type ),
+            trace_buffered,
+            trace_file
+        );
+        trace_buffered = 0;
+    }
+}
+
+
+/*==========================================================================*/
+static void trace_record(           //record a call
+    int                 operation,  //operation called (HZSTR_TRACE_*)
+    const void*         target,     //string operated on (or created)
+    const void*         source,     //source string (NULL if none)
+    unsigned long       length,     //length argument
+    long                offset      //offset argument
+) {
+
+    //local variables
+    hzstr_trace_record_type* record;//record of the call
+
+    spin_lock( &trace_lock );
+
+    //recording may have stopped since the caller checked
+    if( trace_file == NULL ) {
+        spin_unlock( &trace_lock );
+        return;
+    }
+
+    //fill the next record, and write the buffer when it is full
+    record = &trace_buffer[ trace_buffered ];
+    record->target    = ( uintptr_t ) target;
+    record->source    = ( uintptr_t ) source;
+    record->length    = length;
+    record->offset    = offset;
+    record->operation = operation;
+    record->reserved  = 0;
+    trace_buffered += 1;
+    trace_total    += 1;
+    if( trace_buffered == TRACE_BUFFER ) {
+        trace_flush();
+    }
+
+    spin_unlock( &trace_lock );
+}
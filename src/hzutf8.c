@@ -0,0 +1,1467 @@
+/*****************************************************************************
+    hzutf8.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        The vector validator follows the lookup-table method described by
+        Keiser and Lemire ("Validating UTF-8 In Less Than One Instruction Per
+        Byte").  Each byte is classified using the high and low nibbles of
+        the byte before it and the high nibble of the byte itself.  Three
+        table lookups produce a set of error bits that are all zero for valid
+        input, except where a continuation byte is required by the second or
+        third byte before it.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "hzutf8.h"
+#include "hzutf8_fold.h"
+#include "memory.h"
+
+#if defined( __SSE2__ ) && !defined( HZSTR_DSBL_SIMD )
+#include <emmintrin.h>
+#endif
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+    && !defined( HZSTR_DSBL_SIMD )
+#include <tmmintrin.h>
+#endif
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//use vector scans when the target supports them
+#if defined( __SSE2__ ) && !defined( HZSTR_DSBL_SIMD )
+#define USE_SSE2
+#endif
+
+//the lookup-table validator is selected at run time
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+    && !defined( HZSTR_DSBL_SIMD )
+#define USE_SSSE3
+#define SSSE3 __attribute__(( target( "ssse3" ) ))
+#endif
+
+#define VEC_SIZE ( 16 )             //bytes in a vector register
+
+//flags for a string that is all ASCII (which is also valid UTF-8)
+#define TEXT_ASCII ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 )
+
+//decoded value of a byte that is not part of a valid sequence
+#define INVALID( _b ) ( 0x110000 + ( _b ) )
+
+//code point that replaces invalid sequences when transcoding
+#define REPLACEMENT ( 0xFFFD )
+
+//number of bytes needed to encode a code point
+#define seq_size( _c ) \
+    ( ( _c ) < 0x80 ? 1 : ( _c ) < 0x800 ? 2 : ( _c ) < 0x10000 ? 3 : 4 )
+
+//fold an ASCII character
+#define fold_ascii( _c ) \
+    ( ( ( _c ) >= 'A' ) && ( ( _c ) <= 'Z' ) ? ( ( _c ) + 0x20 ) : ( _c ) )
+
+//error classes of two consecutive bytes (several classes share a bit)
+#define TOO_SHORT       ( 1 << 0 )  //lead byte not followed by continuation
+#define TOO_LONG        ( 1 << 1 )  //continuation byte without a lead byte
+#define OVERLONG_3      ( 1 << 2 )  //three-byte sequence could be shorter
+#define TOO_LARGE       ( 1 << 3 )  //code point above U+10FFFF
+#define SURROGATE       ( 1 << 4 )  //code point in U+D800 - U+DFFF
+#define OVERLONG_2      ( 1 << 5 )  //two-byte sequence could be one byte
+#define TOO_LARGE_1000  ( 1 << 6 )  //four-byte lead above 0xF4
+#define OVERLONG_4      ( 1 << 6 )  //four-byte sequence could be shorter
+#define TWO_CONTS       ( 1 << 7 )  //two continuation bytes in a row
+#define CARRY           ( TOO_SHORT | TOO_LONG | TWO_CONTS )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+#ifdef USE_SSSE3
+
+//errors possible given the high nibble of the first byte
+static const unsigned char byte_1_high[ VEC_SIZE ] = {
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+};
+
+//errors possible given the low nibble of the first byte
+static const unsigned char byte_1_low[ VEC_SIZE ] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+};
+
+//errors possible given the high nibble of the second byte
+static const unsigned char byte_2_high[ VEC_SIZE ] = {
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000
+        | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+};
+
+//largest byte values that do not need more bytes after the end of a block
+static const unsigned char block_end[ VEC_SIZE ] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, ( 0xF0 - 1 ), ( 0xE0 - 1 ), ( 0xC0 - 1 )
+};
+
+#endif
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static hzstr_flags_t check_scalar(  //check encoding one sequence at a time
+    const unsigned char* data,      //character data to check
+    unsigned long       length      //number of bytes to check
+);                                  //encoding flags (0 if invalid UTF-8)
+
+#ifdef USE_SSSE3
+static SSSE3 hzstr_flags_t check_ssse3(
+                                    //check encoding with table lookups
+    const unsigned char* data,      //character data to check
+    unsigned long       length      //number of bytes to check
+);                                  //encoding flags (0 if invalid UTF-8)
+
+static SSSE3 __m128i check_block(   //find encoding errors in one block
+    __m128i             block,      //block of bytes to check
+    __m128i             prev        //block of bytes before it
+);                                  //error bits (all zero if valid)
+#endif
+
+static unsigned long decode(        //decode one code point
+    const unsigned char* data,      //text to decode
+    unsigned long       length,     //number of bytes in text (at least 1)
+    unsigned long*      code        //decoded code point
+);                                  //number of bytes used
+
+static unsigned long decode_utf16(  //decode one UTF-16 code point
+    const uint16_t*     data,       //text to decode
+    unsigned long       length,     //number of units in text (at least 1)
+    unsigned long*      code        //decoded code point
+);                                  //number of units used
+
+static unsigned long encode(        //encode one code point
+    unsigned long       code,       //code point to encode
+    unsigned char*      output      //output text (at least 4 bytes)
+);                                  //number of bytes written
+
+#ifdef USE_SSE2
+static __m128i lower_block(         //fold the ASCII letters in a block
+    __m128i             block       //block of bytes
+);                                  //block with A-Z replaced by a-z
+
+static int narrow_utf16(            //narrow a block of ASCII from UTF-16
+    char*               output,     //output bytes
+    const uint16_t*     data        //block of units (VEC_SIZE)
+);                                  //non-zero if the block was narrowed
+
+static int narrow_utf32(            //narrow a block of ASCII from UTF-32
+    char*               output,     //output bytes
+    const uint32_t*     data        //block of units (VEC_SIZE)
+);                                  //non-zero if the block was narrowed
+
+static int widen_utf16(             //widen a block of ASCII to UTF-16
+    uint16_t*           output,     //output units
+    const char*         data        //block of bytes (VEC_SIZE)
+);                                  //non-zero if the block was widened
+
+static int widen_utf32(             //widen a block of ASCII to UTF-32
+    uint32_t*           output,     //output units
+    const char*         data        //block of bytes (VEC_SIZE)
+);                                  //non-zero if the block was widened
+#endif
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+long hzstr_utf8_casecmp(            //compare text ignoring case
+    const char*         data0,      //first text
+    unsigned long       length0,    //number of bytes in first text
+    const char*         data1,      //second text
+    unsigned long       length1     //number of bytes in second text
+) {                                 //comparison value (0 means equal)
+
+    //local variables
+    unsigned long       code0;      //folded code point from first text
+    unsigned long       code1;      //folded code point from second text
+    unsigned long       index0;     //position in first text
+    unsigned long       index1;     //position in second text
+#ifdef USE_SSE2
+    __m128i             block0;     //block of first text
+    __m128i             block1;     //block of second text
+    unsigned int        mask;       //bytes that are equal after folding
+#endif
+
+    index0 = 0;
+    index1 = 0;
+
+    while( ( index0 < length0 ) && ( index1 < length1 ) ) {
+
+#ifdef USE_SSE2
+
+        //compare blocks of ASCII that are aligned in both texts
+        if( ( ( length0 - index0 ) >= VEC_SIZE )
+         && ( ( length1 - index1 ) >= VEC_SIZE ) ) {
+            block0 = _mm_loadu_si128(
+                ( const __m128i* ) ( data0 + index0 )
+            );
+            block1 = _mm_loadu_si128(
+                ( const __m128i* ) ( data1 + index1 )
+            );
+            if( _mm_movemask_epi8( _mm_or_si128( block0, block1 ) ) == 0 ) {
+                mask = _mm_movemask_epi8(
+                    _mm_cmpeq_epi8(
+                        lower_block( block0 ), lower_block( block1 )
+                    )
+                );
+                if( mask == 0xFFFF ) {
+                    index0 += VEC_SIZE;
+                    index1 += VEC_SIZE;
+                    continue;
+                }
+
+                //compare the first characters that differ
+                index0 += __builtin_ctz( ~mask );
+                index1 += __builtin_ctz( ~mask );
+                return ( long ) fold_ascii( data0[ index0 ] )
+                     - ( long ) fold_ascii( data1[ index1 ] );
+            }
+        }
+
+#endif
+
+        //fold and compare one code point from each text
+        index0 += decode(
+            ( const unsigned char* ) ( data0 + index0 ),
+            ( length0 - index0 ),
+            &code0
+        );
+        index1 += decode(
+            ( const unsigned char* ) ( data1 + index1 ),
+            ( length1 - index1 ),
+            &code1
+        );
+        code0 = hzstr_utf8_fold_cp( code0 );
+        code1 = hzstr_utf8_fold_cp( code1 );
+        if( code0 != code1 ) {
+            return ( long ) code0 - ( long ) code1;
+        }
+    }
+
+    //the text that ends first is less than the other
+    if( index0 < length0 ) {
+        return 1;
+    }
+    if( index1 < length1 ) {
+        return -1;
+    }
+    return 0;
+}
+
+
+/*==========================================================================*/
+hzstr_flags_t hzstr_utf8_check(     //check the encoding of character data
+    const char*         data,       //character data to check
+    unsigned long       length      //number of bytes to check
+) {                                 //encoding flags (0 if invalid UTF-8)
+
+#ifdef USE_SSSE3
+
+    //use the lookup-table validator if the processor can run it
+    if( __builtin_cpu_supports( "ssse3" ) ) {
+        return check_ssse3( ( const unsigned char* ) data, length );
+    }
+
+#endif
+
+    //check one sequence at a time
+    return check_scalar( ( const unsigned char* ) data, length );
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_count(     //count the code points in text
+    const char*         data,       //text to count
+    unsigned long       length      //number of bytes in text
+) {                                 //number of code points
+
+    //local variables
+    unsigned long       count;      //number of code points found
+    unsigned long       index;      //current byte
+#ifdef USE_SSE2
+    __m128i             limit;      //largest continuation byte (signed)
+#endif
+
+    count = 0;
+    index = 0;
+
+#ifdef USE_SSE2
+
+    //count the bytes in each block that are not continuation bytes
+    //  (0x80 - 0xBF are the smallest values when compared as signed bytes)
+    limit = _mm_set1_epi8( ( char ) 0xBF );
+    while( ( length - index ) >= VEC_SIZE ) {
+        count += __builtin_popcount( _mm_movemask_epi8(
+            _mm_cmpgt_epi8(
+                _mm_loadu_si128( ( const __m128i* ) ( data + index ) ),
+                limit
+            )
+        ) );
+        index += VEC_SIZE;
+    }
+
+#endif
+
+    //count the remaining bytes
+    for( ; index < length; ++index ) {
+        if( ( data[ index ] & 0xC0 ) != 0x80 ) {
+            count += 1;
+        }
+    }
+
+    //return the number of code points
+    return count;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_fold(      //fold the case of text
+    char*               output,     //folded text (may be data if in-place)
+    const char*         data,       //text to fold
+    unsigned long       length      //number of bytes in text
+) {                                 //number of bytes written to output
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       size;       //bytes in current sequence
+    unsigned long       write;      //write position
+#ifdef USE_SSE2
+    __m128i             block;      //block of text
+#endif
+
+    index = 0;
+    write = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //fold blocks of ASCII
+        if( ( length - index ) >= VEC_SIZE ) {
+            block = _mm_loadu_si128( ( const __m128i* ) ( data + index ) );
+            if( _mm_movemask_epi8( block ) == 0 ) {
+                _mm_storeu_si128(
+                    ( __m128i* ) ( output + write ), lower_block( block )
+                );
+                index += VEC_SIZE;
+                write += VEC_SIZE;
+                continue;
+            }
+        }
+
+#endif
+
+        //fold one code point (invalid bytes are copied as they are)
+        size = decode(
+            ( const unsigned char* ) ( data + index ),
+            ( length - index ),
+            &code
+        );
+        if( code < 0x80 ) {
+            output[ write ] = ( char ) fold_ascii( code );
+            write += 1;
+        }
+        else if( code < INVALID( 0 ) ) {
+            write += encode(
+                hzstr_utf8_fold_cp( code ),
+                ( unsigned char* ) ( output + write )
+            );
+        }
+        else {
+            output[ write ] = data[ index ];
+            write += 1;
+        }
+        index += size;
+    }
+
+    //return the length of the folded text
+    return write;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_fold_cp(   //fold the case of a code point
+    unsigned long       code        //code point to fold
+) {                                 //folded code point
+
+    //most code points are not in the table
+    if( code >= FOLD_LIMIT ) {
+        return code;
+    }
+
+    //look up the difference between the folded code point and this one
+    return code + fold_deltas[
+        ( fold_index[ code >> FOLD_SHIFT ] << FOLD_SHIFT )
+        + ( code & FOLD_MASK )
+    ];
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_fold_size( //measure the case-folded text
+    const char*         data,       //text to fold
+    unsigned long       length,     //number of bytes in text
+    int*                in_place    //set non-zero if folding can be in-place
+) {                                 //number of bytes of folded text
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       folded;     //bytes in folded sequence
+    unsigned long       index;      //read position
+    unsigned long       size;       //bytes in current sequence
+    unsigned long       total;      //bytes of folded text
+
+    //folding can be done in-place unless a sequence gets longer
+    *in_place = 1;
+    index     = 0;
+    total     = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //ASCII stays the same size
+        if( ( ( length - index ) >= VEC_SIZE )
+         && ( _mm_movemask_epi8(
+                _mm_loadu_si128( ( const __m128i* ) ( data + index ) )
+            ) == 0 ) ) {
+            index += VEC_SIZE;
+            total += VEC_SIZE;
+            continue;
+        }
+
+#endif
+
+        //measure one folded code point
+        size = decode(
+            ( const unsigned char* ) ( data + index ),
+            ( length - index ),
+            &code
+        );
+        folded = size;
+        if( ( code >= 0x80 ) && ( code < INVALID( 0 ) ) ) {
+            code = hzstr_utf8_fold_cp( code );
+            folded = seq_size( code );
+        }
+        if( folded > size ) {
+            *in_place = 0;
+        }
+        index += size;
+        total += folded;
+    }
+
+    //return the length of the folded text
+    return total;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_from_utf16(//convert UTF-16 to UTF-8
+    char*               output,     //UTF-8 output
+    const uint16_t*     data,       //UTF-16 text to convert
+    unsigned long       length      //number of units in text
+) {                                 //number of bytes written to output
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       write;      //write position
+
+    index = 0;
+    write = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //narrow blocks of ASCII
+        if( ( ( length - index ) >= VEC_SIZE )
+         && ( narrow_utf16( ( output + write ), ( data + index ) ) != 0 ) ) {
+            index += VEC_SIZE;
+            write += VEC_SIZE;
+            continue;
+        }
+
+#endif
+
+        //convert one code point
+        index += decode_utf16( ( data + index ), ( length - index ), &code );
+        write += encode( code, ( unsigned char* ) ( output + write ) );
+    }
+
+    //return the length of the converted text
+    return write;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_from_utf16_size(
+                                    //measure UTF-16 converted to UTF-8
+    const uint16_t*     data,       //UTF-16 text to convert
+    unsigned long       length      //number of units in text
+) {                                 //number of bytes of UTF-8
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       total;      //bytes of converted text
+#ifdef USE_SSE2
+    __m128i             block;      //block of units
+    __m128i             range;      //high bits of each unit
+    unsigned int        small;      //units that need fewer than 3 bytes
+#endif
+
+    index = 0;
+    total = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //a block without surrogates needs 1 to 3 bytes for each unit
+        //  (the compare masks have two bits for each unit)
+        if( ( length - index ) >= ( VEC_SIZE / 2 ) ) {
+            block = _mm_loadu_si128( ( const __m128i* ) ( data + index ) );
+            range = _mm_and_si128( block, _mm_set1_epi16( ( short ) 0xF800 ) );
+            if( _mm_movemask_epi8( _mm_cmpeq_epi16(
+                range, _mm_set1_epi16( ( short ) 0xD800 )
+            ) ) == 0 ) {
+                small = __builtin_popcount( _mm_movemask_epi8(
+                    _mm_cmpeq_epi16(
+                        _mm_and_si128(
+                            block, _mm_set1_epi16( ( short ) 0xFF80 )
+                        ),
+                        _mm_setzero_si128()
+                    )
+                ) ) + __builtin_popcount( _mm_movemask_epi8(
+                    _mm_cmpeq_epi16( range, _mm_setzero_si128() )
+                ) );
+                total += ( ( VEC_SIZE / 2 ) * 3 ) - ( small / 2 );
+                index += VEC_SIZE / 2;
+                continue;
+            }
+        }
+
+#endif
+
+        //measure one code point
+        index += decode_utf16( ( data + index ), ( length - index ), &code );
+        total += seq_size( code );
+    }
+
+    //return the length of the converted text
+    return total;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_from_utf32(//convert UTF-32 to UTF-8
+    char*               output,     //UTF-8 output
+    const uint32_t*     data,       //UTF-32 text to convert
+    unsigned long       length      //number of units in text
+) {                                 //number of bytes written to output
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       write;      //write position
+
+    index = 0;
+    write = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //narrow blocks of ASCII
+        if( ( ( length - index ) >= VEC_SIZE )
+         && ( narrow_utf32( ( output + write ), ( data + index ) ) != 0 ) ) {
+            index += VEC_SIZE;
+            write += VEC_SIZE;
+            continue;
+        }
+
+#endif
+
+        //convert one code point (surrogates and large values are invalid)
+        code = data[ index ];
+        if( ( code > 0x10FFFF ) || ( ( code & 0xFFFFF800 ) == 0xD800 ) ) {
+            code = REPLACEMENT;
+        }
+        write += encode( code, ( unsigned char* ) ( output + write ) );
+        index += 1;
+    }
+
+    //return the length of the converted text
+    return write;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_from_utf32_size(
+                                    //measure UTF-32 converted to UTF-8
+    const uint32_t*     data,       //UTF-32 text to convert
+    unsigned long       length      //number of units in text
+) {                                 //number of bytes of UTF-8
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       total;      //bytes of converted text
+#ifdef USE_SSE2
+    __m128i             block;      //block of units
+    unsigned int        small;      //units that need fewer than 3 bytes
+#endif
+
+    index = 0;
+    total = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //a block of units below U+D800 needs 1 to 3 bytes for each unit
+        //  (the compare masks have four bits for each unit)
+        if( ( length - index ) >= ( VEC_SIZE / 4 ) ) {
+            block = _mm_loadu_si128( ( const __m128i* ) ( data + index ) );
+            if( _mm_movemask_epi8( _mm_and_si128(
+                _mm_cmpgt_epi32( block, _mm_set1_epi32( -1 ) ),
+                _mm_cmplt_epi32( block, _mm_set1_epi32( 0xD800 ) )
+            ) ) == 0xFFFF ) {
+                small = __builtin_popcount( _mm_movemask_epi8(
+                    _mm_cmplt_epi32( block, _mm_set1_epi32( 0x80 ) )
+                ) ) + __builtin_popcount( _mm_movemask_epi8(
+                    _mm_cmplt_epi32( block, _mm_set1_epi32( 0x800 ) )
+                ) );
+                total += ( ( VEC_SIZE / 4 ) * 3 ) - ( small / 4 );
+                index += VEC_SIZE / 4;
+                continue;
+            }
+        }
+
+#endif
+
+        //measure one code point
+        code = data[ index ];
+        if( ( code > 0x10FFFF ) || ( ( code & 0xFFFFF800 ) == 0xD800 ) ) {
+            code = REPLACEMENT;
+        }
+        total += seq_size( code );
+        index += 1;
+    }
+
+    //return the length of the converted text
+    return total;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_offset(    //find the offset of a code point
+    const char*         data,       //text to search
+    unsigned long       length,     //number of bytes in text
+    unsigned long       index       //index of the code point
+) {                                 //byte offset (length if past the end)
+
+    //local variables
+    unsigned long       pos;        //current byte
+#ifdef USE_SSE2
+    unsigned long       count;      //code points in a block
+    __m128i             limit;      //largest continuation byte (signed)
+    unsigned int        mask;       //bytes that start code points
+#endif
+
+    pos = 0;
+
+#ifdef USE_SSE2
+
+    //skip whole blocks of code points
+    limit = _mm_set1_epi8( ( char ) 0xBF );
+    while( ( length - pos ) >= VEC_SIZE ) {
+        mask = _mm_movemask_epi8(
+            _mm_cmpgt_epi8(
+                _mm_loadu_si128( ( const __m128i* ) ( data + pos ) ),
+                limit
+            )
+        );
+        count = __builtin_popcount( mask );
+
+        //the code point starts in this block (clear the ones before it)
+        if( index < count ) {
+            while( index > 0 ) {
+                mask &= mask - 1;
+                index -= 1;
+            }
+            return pos + __builtin_ctz( mask );
+        }
+
+        index -= count;
+        pos   += VEC_SIZE;
+    }
+
+#endif
+
+    //check the remaining bytes
+    for( ; pos < length; ++pos ) {
+        if( ( data[ pos ] & 0xC0 ) != 0x80 ) {
+            if( index == 0 ) {
+                return pos;
+            }
+            index -= 1;
+        }
+    }
+
+    //the code point is past the end of the text
+    return length;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_to_utf16(  //convert UTF-8 to UTF-16
+    uint16_t*           output,     //UTF-16 output
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+) {                                 //number of units written to output
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       write;      //write position
+
+    index = 0;
+    write = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //widen blocks of ASCII
+        if( ( ( length - index ) >= VEC_SIZE )
+         && ( widen_utf16( ( output + write ), ( data + index ) ) != 0 ) ) {
+            index += VEC_SIZE;
+            write += VEC_SIZE;
+            continue;
+        }
+
+#endif
+
+        //convert one code point
+        index += decode(
+            ( const unsigned char* ) ( data + index ),
+            ( length - index ),
+            &code
+        );
+        if( code >= INVALID( 0 ) ) {
+            code = REPLACEMENT;
+        }
+
+        //code points above the basic plane use a surrogate pair
+        if( code >= 0x10000 ) {
+            code -= 0x10000;
+            output[ write ]     = ( uint16_t ) ( 0xD800 | ( code >> 10 ) );
+            output[ write + 1 ] = ( uint16_t ) ( 0xDC00 | ( code & 0x3FF ) );
+            write += 2;
+        }
+        else {
+            output[ write ] = ( uint16_t ) code;
+            write += 1;
+        }
+    }
+
+    //return the length of the converted text
+    return write;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_to_utf16_size(
+                                    //measure UTF-8 converted to UTF-16
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+) {                                 //number of units of UTF-16
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       total;      //units of converted text
+#ifdef USE_SSE2
+    __m128i             block;      //block of bytes
+#endif
+
+    index = 0;
+    total = 0;
+
+    //valid text needs one unit for each sequence, and one more for each
+    //  four-byte sequence (these are the only ones that start with 0xF_)
+    if( hzstr_utf8_check( data, length ) != 0 ) {
+        total = hzstr_utf8_count( data, length );
+
+#ifdef USE_SSE2
+
+        while( ( length - index ) >= VEC_SIZE ) {
+            block = _mm_loadu_si128( ( const __m128i* ) ( data + index ) );
+            total += __builtin_popcount( _mm_movemask_epi8(
+                _mm_cmpgt_epi8( block, _mm_set1_epi8( ( char ) 0xEF ) )
+            ) & _mm_movemask_epi8( block ) );
+            index += VEC_SIZE;
+        }
+
+#endif
+
+        for( ; index < length; ++index ) {
+            if( ( data[ index ] & 0xF0 ) == 0xF0 ) {
+                total += 1;
+            }
+        }
+        return total;
+    }
+
+    //invalid text is measured one sequence at a time
+    while( index < length ) {
+        index += decode(
+            ( const unsigned char* ) ( data + index ),
+            ( length - index ),
+            &code
+        );
+        total += ( ( code >= 0x10000 ) && ( code < INVALID( 0 ) ) ) ? 2 : 1;
+    }
+
+    //return the length of the converted text
+    return total;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_to_utf32(  //convert UTF-8 to UTF-32
+    uint32_t*           output,     //UTF-32 output
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+) {                                 //number of units written to output
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       write;      //write position
+
+    index = 0;
+    write = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //widen blocks of ASCII
+        if( ( ( length - index ) >= VEC_SIZE )
+         && ( widen_utf32( ( output + write ), ( data + index ) ) != 0 ) ) {
+            index += VEC_SIZE;
+            write += VEC_SIZE;
+            continue;
+        }
+
+#endif
+
+        //convert one code point
+        index += decode(
+            ( const unsigned char* ) ( data + index ),
+            ( length - index ),
+            &code
+        );
+        output[ write ] = code < INVALID( 0 ) ? code : REPLACEMENT;
+        write += 1;
+    }
+
+    //return the length of the converted text
+    return write;
+}
+
+
+/*==========================================================================*/
+unsigned long hzstr_utf8_to_utf32_size(
+                                    //measure UTF-8 converted to UTF-32
+    const char*         data,       //UTF-8 text to convert
+    unsigned long       length      //number of bytes in text
+) {                                 //number of units of UTF-32
+
+    //local variables
+    unsigned long       code;       //current code point
+    unsigned long       index;      //read position
+    unsigned long       total;      //units of converted text
+
+    //valid text needs one unit for each sequence
+    if( hzstr_utf8_check( data, length ) != 0 ) {
+        return hzstr_utf8_count( data, length );
+    }
+
+    //invalid text is measured one sequence at a time
+    index = 0;
+    total = 0;
+    while( index < length ) {
+        index += decode(
+            ( const unsigned char* ) ( data + index ),
+            ( length - index ),
+            &code
+        );
+        total += 1;
+    }
+
+    //return the length of the converted text
+    return total;
+}
+
+
+#ifdef USE_SSSE3
+/*==========================================================================*/
+static SSSE3 __m128i check_block(   //find encoding errors in one block
+    __m128i             block,      //block of bytes to check
+    __m128i             prev        //block of bytes before it
+) {                                 //error bits (all zero if valid)
+
+    //local variables
+    __m128i             nibbles;    //mask of the low nibble of each byte
+    __m128i             prev1;      //the byte before each byte
+    __m128i             required;   //bytes that must be continuations
+    __m128i             special;    //error bits of each pair of bytes
+
+    //line up each byte with the bytes before it
+    prev1   = _mm_alignr_epi8( block, prev, ( VEC_SIZE - 1 ) );
+    nibbles = _mm_set1_epi8( 0x0F );
+
+    //classify each pair of bytes (only errors set in all three remain)
+    special = _mm_and_si128(
+        _mm_and_si128(
+            _mm_shuffle_epi8(
+                _mm_loadu_si128( ( const __m128i* ) byte_1_high ),
+                _mm_and_si128( _mm_srli_epi16( prev1, 4 ), nibbles )
+            ),
+            _mm_shuffle_epi8(
+                _mm_loadu_si128( ( const __m128i* ) byte_1_low ),
+                _mm_and_si128( prev1, nibbles )
+            )
+        ),
+        _mm_shuffle_epi8(
+            _mm_loadu_si128( ( const __m128i* ) byte_2_high ),
+            _mm_and_si128( _mm_srli_epi16( block, 4 ), nibbles )
+        )
+    );
+
+    //bytes two after a three or four-byte lead, or three after a four-byte
+    //  lead, must be continuations (the only place TWO_CONTS is allowed)
+    required = _mm_or_si128(
+        _mm_subs_epu8(
+            _mm_alignr_epi8( block, prev, ( VEC_SIZE - 2 ) ),
+            _mm_set1_epi8( ( char ) ( 0xE0 - 0x80 ) )
+        ),
+        _mm_subs_epu8(
+            _mm_alignr_epi8( block, prev, ( VEC_SIZE - 3 ) ),
+            _mm_set1_epi8( ( char ) ( 0xF0 - 0x80 ) )
+        )
+    );
+    required = _mm_and_si128( required, _mm_set1_epi8( ( char ) 0x80 ) );
+
+    //any remaining bits are errors
+    return _mm_xor_si128( required, special );
+}
+#endif
+
+
+/*==========================================================================*/
+static hzstr_flags_t check_scalar(  //check encoding one sequence at a time
+    const unsigned char* data,      //character data to check
+    unsigned long       length      //number of bytes to check
+) {                                 //encoding flags (0 if invalid UTF-8)
+
+    //local variables
+    hzstr_flags_t       flags;      //encoding flags found so far
+    unsigned char       high;       //largest valid second byte
+    unsigned long       index;      //current byte
+    unsigned char       low;        //smallest valid second byte
+    unsigned long       offset;     //byte within a sequence
+    unsigned long       size;       //number of bytes in a sequence
+
+    //assume the data is ASCII until a larger byte is found
+    flags = TEXT_ASCII;
+    index = 0;
+
+    while( index < length ) {
+
+#ifdef USE_SSE2
+
+        //skip blocks of ASCII
+        while( ( ( index + VEC_SIZE ) <= length )
+            && ( _mm_movemask_epi8(
+                _mm_loadu_si128( ( const __m128i* ) ( data + index ) )
+            ) == 0 ) ) {
+            index += VEC_SIZE;
+        }
+        if( index >= length ) {
+            break;
+        }
+
+#endif
+
+        //ASCII characters are a single byte
+        if( data[ index ] < 0x80 ) {
+            index += 1;
+            continue;
+        }
+        flags = HZSTR_FLG_UTF8;
+
+        //the lead byte determines the size, and the second byte's range
+        //  (this rejects overlong forms, surrogates, and large code points)
+        low  = 0x80;
+        high = 0xBF;
+        if( data[ index ] < 0xC2 ) {
+            return 0;
+        }
+        else if( data[ index ] < 0xE0 ) {
+            size = 2;
+        }
+        else if( data[ index ] < 0xF0 ) {
+            size = 3;
+            if( data[ index ] == 0xE0 ) {
+                low = 0xA0;
+            }
+            else if( data[ index ] == 0xED ) {
+                high = 0x9F;
+            }
+        }
+        else if( data[ index ] < 0xF5 ) {
+            size = 4;
+            if( data[ index ] == 0xF0 ) {
+                low = 0x90;
+            }
+            else if( data[ index ] == 0xF4 ) {
+                high = 0x8F;
+            }
+        }
+        else {
+            return 0;
+        }
+
+        //make sure the entire sequence is present
+        if( size > ( length - index ) ) {
+            return 0;
+        }
+
+        //check the second byte's range, and the remaining continuations
+        if( ( data[ index + 1 ] < low ) || ( data[ index + 1 ] > high ) ) {
+            return 0;
+        }
+        for( offset = 2; offset < size; ++offset ) {
+            if( ( data[ index + offset ] & 0xC0 ) != 0x80 ) {
+                return 0;
+            }
+        }
+
+        //move to the next sequence
+        index += size;
+    }
+
+    //return what was found
+    return flags;
+}
+
+
+#ifdef USE_SSSE3
+/*==========================================================================*/
+static SSSE3 hzstr_flags_t check_ssse3(
+                                    //check encoding with table lookups
+    const unsigned char* data,      //character data to check
+    unsigned long       length      //number of bytes to check
+) {                                 //encoding flags (0 if invalid UTF-8)
+
+    //local variables
+    int                 ascii;      //no multi-byte sequences were found
+    __m128i             block;      //current block of bytes
+    __m128i             errors;     //accumulated error bits
+    __m128i             incomplete; //sequences continuing into next block
+    unsigned long       index;      //current byte
+    __m128i             prev;       //previous block of bytes
+    unsigned char       tail[ VEC_SIZE ];   //zero-padded last block
+
+    //the data is preceded and followed by NULL bytes
+    ascii      = 1;
+    errors     = _mm_setzero_si128();
+    incomplete = _mm_setzero_si128();
+    prev       = _mm_setzero_si128();
+
+    for( index = 0; index < length; index += VEC_SIZE ) {
+
+        //load a block, padding the last one with NULL bytes
+        if( ( length - index ) >= VEC_SIZE ) {
+            block = _mm_loadu_si128( ( const __m128i* ) ( data + index ) );
+        }
+        else {
+            memset( tail, 0, VEC_SIZE );
+            mem_copy( tail, ( data + index ), ( length - index ) );
+            block = _mm_loadu_si128( ( const __m128i* ) tail );
+        }
+
+        //a block of ASCII is only an error if the last block was unfinished
+        if( _mm_movemask_epi8( block ) == 0 ) {
+            errors = _mm_or_si128( errors, incomplete );
+        }
+
+        //check every byte in the block
+        else {
+            ascii      = 0;
+            errors     = _mm_or_si128( errors, check_block( block, prev ) );
+            incomplete = _mm_subs_epu8(
+                block,
+                _mm_loadu_si128( ( const __m128i* ) block_end )
+            );
+        }
+
+        prev = block;
+    }
+
+    //the data can not end in the middle of a sequence
+    errors = _mm_or_si128( errors, incomplete );
+
+    //any error bits mean the data is not UTF-8
+    if( _mm_movemask_epi8(
+        _mm_cmpeq_epi8( errors, _mm_setzero_si128() )
+    ) != 0xFFFF ) {
+        return 0;
+    }
+
+    //return what was found
+    return ascii != 0 ? TEXT_ASCII : HZSTR_FLG_UTF8;
+}
+#endif
+
+
+/*==========================================================================*/
+static unsigned long decode(        //decode one code point
+    const unsigned char* data,      //text to decode
+    unsigned long       length,     //number of bytes in text (at least 1)
+    unsigned long*      code        //decoded code point
+) {                                 //number of bytes used
+
+    //local variables
+    unsigned char       high;       //largest valid second byte
+    unsigned char       low;        //smallest valid second byte
+    unsigned long       offset;     //byte within the sequence
+    unsigned long       size;       //number of bytes in the sequence
+
+    //ASCII characters are a single byte
+    if( data[ 0 ] < 0x80 ) {
+        *code = data[ 0 ];
+        return 1;
+    }
+
+    //the lead byte determines the size, and the second byte's range
+    //  (these are the same rules used by check_scalar())
+    *code = INVALID( data[ 0 ] );
+    low   = 0x80;
+    high  = 0xBF;
+    if( ( data[ 0 ] < 0xC2 ) || ( data[ 0 ] > 0xF4 ) ) {
+        return 1;
+    }
+    else if( data[ 0 ] < 0xE0 ) {
+        size = 2;
+    }
+    else if( data[ 0 ] < 0xF0 ) {
+        size = 3;
+        if( data[ 0 ] == 0xE0 ) {
+            low = 0xA0;
+        }
+        else if( data[ 0 ] == 0xED ) {
+            high = 0x9F;
+        }
+    }
+    else {
+        size = 4;
+        if( data[ 0 ] == 0xF0 ) {
+            low = 0x90;
+        }
+        else if( data[ 0 ] == 0xF4 ) {
+            high = 0x8F;
+        }
+    }
+
+    //an invalid sequence only uses its first byte
+    if( size > length ) {
+        return 1;
+    }
+    if( ( data[ 1 ] < low ) || ( data[ 1 ] > high ) ) {
+        return 1;
+    }
+    for( offset = 2; offset < size; ++offset ) {
+        if( ( data[ offset ] & 0xC0 ) != 0x80 ) {
+            return 1;
+        }
+    }
+
+    //combine the bits of each byte
+    *code = data[ 0 ] & ( 0x7F >> size );
+    for( offset = 1; offset < size; ++offset ) {
+        *code = ( *code << 6 ) | ( data[ offset ] & 0x3F );
+    }
+    return size;
+}
+
+
+/*==========================================================================*/
+static unsigned long decode_utf16(  //decode one UTF-16 code point
+    const uint16_t*     data,       //text to decode
+    unsigned long       length,     //number of units in text (at least 1)
+    unsigned long*      code        //decoded code point
+) {                                 //number of units used
+
+    //units outside the surrogate range are code points
+    if( ( data[ 0 ] & 0xF800 ) != 0xD800 ) {
+        *code = data[ 0 ];
+        return 1;
+    }
+
+    //a high surrogate followed by a low surrogate is a pair
+    if( ( data[ 0 ] < 0xDC00 )
+     && ( length > 1 )
+     && ( ( data[ 1 ] & 0xFC00 ) == 0xDC00 ) ) {
+        *code = 0x10000
+              + ( ( ( unsigned long ) data[ 0 ] & 0x3FF ) << 10 )
+              + ( data[ 1 ] & 0x3FF );
+        return 2;
+    }
+
+    //an unpaired surrogate is invalid
+    *code = REPLACEMENT;
+    return 1;
+}
+
+
+/*==========================================================================*/
+static unsigned long encode(        //encode one code point
+    unsigned long       code,       //code point to encode
+    unsigned char*      output      //output text (at least 4 bytes)
+) {                                 //number of bytes written
+
+    if( code < 0x80 ) {
+        output[ 0 ] = ( unsigned char ) code;
+        return 1;
+    }
+    if( code < 0x800 ) {
+        output[ 0 ] = ( unsigned char ) ( 0xC0 | ( code >> 6 ) );
+        output[ 1 ] = ( unsigned char ) ( 0x80 | ( code & 0x3F ) );
+        return 2;
+    }
+    if( code < 0x10000 ) {
+        output[ 0 ] = ( unsigned char ) ( 0xE0 | ( code >> 12 ) );
+        output[ 1 ] = ( unsigned char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+        output[ 2 ] = ( unsigned char ) ( 0x80 | ( code & 0x3F ) );
+        return 3;
+    }
+    output[ 0 ] = ( unsigned char ) ( 0xF0 | ( code >> 18 ) );
+    output[ 1 ] = ( unsigned char ) ( 0x80 | ( ( code >> 12 ) & 0x3F ) );
+    output[ 2 ] = ( unsigned char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+    output[ 3 ] = ( unsigned char ) ( 0x80 | ( code & 0x3F ) );
+    return 4;
+}
+
+
+#ifdef USE_SSE2
+/*==========================================================================*/
+static __m128i lower_block(         //fold the ASCII letters in a block
+    __m128i             block       //block of bytes
+) {                                 //block with A-Z replaced by a-z
+
+    //local variables
+    __m128i             upper;      //bytes that are upper-case letters
+
+    upper = _mm_and_si128(
+        _mm_cmpgt_epi8( block, _mm_set1_epi8( 'A' - 1 ) ),
+        _mm_cmplt_epi8( block, _mm_set1_epi8( 'Z' + 1 ) )
+    );
+    return _mm_add_epi8(
+        block, _mm_and_si128( upper, _mm_set1_epi8( 0x20 ) )
+    );
+}
+
+
+/*==========================================================================*/
+static int narrow_utf16(            //narrow a block of ASCII from UTF-16
+    char*               output,     //output bytes
+    const uint16_t*     data        //block of units (VEC_SIZE)
+) {                                 //non-zero if the block was narrowed
+
+    //local variables
+    __m128i             high;       //second half of the units
+    __m128i             low;        //first half of the units
+
+    low  = _mm_loadu_si128( ( const __m128i* ) data );
+    high = _mm_loadu_si128( ( const __m128i* ) ( data + ( VEC_SIZE / 2 ) ) );
+
+    //every unit must be ASCII
+    if( _mm_movemask_epi8( _mm_cmpeq_epi16(
+        _mm_and_si128(
+            _mm_or_si128( low, high ), _mm_set1_epi16( ( short ) 0xFF80 )
+        ),
+        _mm_setzero_si128()
+    ) ) != 0xFFFF ) {
+        return 0;
+    }
+
+    //keep the low byte of each unit
+    _mm_storeu_si128( ( __m128i* ) output, _mm_packus_epi16( low, high ) );
+    return 1;
+}
+
+
+/*==========================================================================*/
+static int narrow_utf32(            //narrow a block of ASCII from UTF-32
+    char*               output,     //output bytes
+    const uint32_t*     data        //block of units (VEC_SIZE)
+) {                                 //non-zero if the block was narrowed
+
+    //local variables
+    __m128i             units[ 4 ]; //four quarters of the units
+
+    units[ 0 ] = _mm_loadu_si128( ( const __m128i* ) data );
+    units[ 1 ] = _mm_loadu_si128( ( const __m128i* ) ( data + 4 ) );
+    units[ 2 ] = _mm_loadu_si128( ( const __m128i* ) ( data + 8 ) );
+    units[ 3 ] = _mm_loadu_si128( ( const __m128i* ) ( data + 12 ) );
+
+    //every unit must be ASCII
+    if( _mm_movemask_epi8( _mm_cmpeq_epi32(
+        _mm_and_si128(
+            _mm_or_si128(
+                _mm_or_si128( units[ 0 ], units[ 1 ] ),
+                _mm_or_si128( units[ 2 ], units[ 3 ] )
+            ),
+            _mm_set1_epi32( ( int ) 0xFFFFFF80 )
+        ),
+        _mm_setzero_si128()
+    ) ) != 0xFFFF ) {
+        return 0;
+    }
+
+    //keep the low byte of each unit
+    _mm_storeu_si128(
+        ( __m128i* ) output,
+        _mm_packus_epi16(
+            _mm_packs_epi32( units[ 0 ], units[ 1 ] ),
+            _mm_packs_epi32( units[ 2 ], units[ 3 ] )
+        )
+    );
+    return 1;
+}
+
+
+/*==========================================================================*/
+static int widen_utf16(             //widen a block of ASCII to UTF-16
+    uint16_t*           output,     //output units
+    const char*         data        //block of bytes (VEC_SIZE)
+) {                                 //non-zero if the block was widened
+
+    //local variables
+    __m128i             block;      //block of bytes
+
+    //every byte must be ASCII
+    block = _mm_loadu_si128( ( const __m128i* ) data );
+    if( _mm_movemask_epi8( block ) != 0 ) {
+        return 0;
+    }
+
+    //interleave the bytes with zeros
+    _mm_storeu_si128(
+        ( __m128i* ) output,
+        _mm_unpacklo_epi8( block, _mm_setzero_si128() )
+    );
+    _mm_storeu_si128(
+        ( __m128i* ) ( output + ( VEC_SIZE / 2 ) ),
+        _mm_unpackhi_epi8( block, _mm_setzero_si128() )
+    );
+    return 1;
+}
+
+
+/*==========================================================================*/
+static int widen_utf32(             //widen a block of ASCII to UTF-32
+    uint32_t*           output,     //output units
+    const char*         data        //block of bytes (VEC_SIZE)
+) {                                 //non-zero if the block was widened
+
+    //local variables
+    __m128i             block;      //block of bytes
+    __m128i             high;       //second half of the bytes (as 16 bits)
+    __m128i             low;        //first half of the bytes (as 16 bits)
+
+    //every byte must be ASCII
+    block = _mm_loadu_si128( ( const __m128i* ) data );
+    if( _mm_movemask_epi8( block ) != 0 ) {
+        return 0;
+    }
+
+    //interleave the bytes with zeros twice
+    low  = _mm_unpacklo_epi8( block, _mm_setzero_si128() );
+    high = _mm_unpackhi_epi8( block, _mm_setzero_si128() );
+    _mm_storeu_si128(
+        ( __m128i* ) output, _mm_unpacklo_epi16( low, _mm_setzero_si128() )
+    );
+    _mm_storeu_si128(
+        ( __m128i* ) ( output + 4 ),
+        _mm_unpackhi_epi16( low, _mm_setzero_si128() )
+    );
+    _mm_storeu_si128(
+        ( __m128i* ) ( output + 8 ),
+        _mm_unpacklo_epi16( high, _mm_setzero_si128() )
+    );
+    _mm_storeu_si128(
+        ( __m128i* ) ( output + 12 ),
+        _mm_unpackhi_epi16( high, _mm_setzero_si128() )
+    );
+    return 1;
+}
+#endif
@@ -0,0 +1,489 @@
+/*****************************************************************************
+    hzvec.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        The offset table always has one more entry than there are strings.
+        The last entry is the number of characters used, so the length of
+        any string is the difference of two neighboring entries.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include "hzvec.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//useful values
+#define MAX_LENGTH ( 65535 )        //largest possible single string
+#define MAX_CHARS ( 0xFFFFFFFFul )  //largest possible vector (characters)
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static hzstr_result_t vec_add(      //add characters as a new string
+    hzstr_vec_type*     vec,        //target vector
+    const hzstr_char_t* source,     //characters to add
+    hzstr_length_t      length      //number of characters to add
+);                                  //index of the string (or error result)
+
+static hzstr_result_t vec_reserve(  //make room for one more string
+    hzstr_vec_type*     vec,        //the vector to check
+    unsigned long       chars       //number of characters in the string
+);                                  //result of the check
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_vec_append(    //add a string to the end of a vector
+    hzstr_vec_type*     vec,        //target vector
+    const hzstr_type*   source      //string to add
+) {                                 //index of the string (or error result)
+
+    //check pointers
+    if( ( vec == NULL ) || ( source == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //copy the string's characters to the end of the vector
+    return vec_add( vec, source->data, source->length );
+}
+
+
+/*==========================================================================*/
+#ifdef HZSTR_COMPAT_CSTR
+
+hzstr_result_t hzstr_vec_append_cstr_n(
+                                    //add a known-length C-string to a vector
+    hzstr_vec_type*     vec,        //target vector
+    const char*         source,     //C-string to add
+    hzstr_length_t      length      //number of characters in the C-string
+) {                                 //index of the string (or error result)
+
+    //check pointers
+    if( ( vec == NULL ) || ( ( source == NULL ) && ( length > 0 ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //C-string characters are string characters
+    return vec_add( vec, ( const hzstr_char_t* ) source, length );
+}
+
+#endif
+
+
+/*==========================================================================*/
+void hzstr_vec_clear(               //remove every string from a vector
+    hzstr_vec_type*     vec         //vector to empty
+) {
+
+    //the memory is kept for the next strings
+    if( vec != NULL ) {
+        vec->count        = 0;
+        vec->offsets[ 0 ] = 0;
+    }
+}
+
+
+/*==========================================================================*/
+hzstr_vec_type* hzstr_vec_create(   //create a new, empty vector
+    unsigned long       count,      //initial number of strings (0 for default)
+    unsigned long       chars       //initial characters (0 for default)
+) {                                 //pointer to new vector
+
+    //local variables
+    hzstr_vec_type*     vec;        //pointer to new vector
+
+    //use default sizes (and never more characters than can be indexed)
+    if( count == 0 ) {
+        count = HZSTR_CHUNK_SIZE;
+    }
+    if( chars == 0 ) {
+        chars = HZSTR_CHUNK_SIZE;
+    }
+    if( chars > MAX_CHARS ) {
+        chars = MAX_CHARS;
+    }
+
+    //allocate a vector object
+    vec = mem_calloc( 1, sizeof( hzstr_vec_type ) );
+
+    //check allocation
+    if( vec != NULL ) {
+
+        //allocate the offset table (with its extra entry) and characters
+        vec->offsets = mem_malloc( ( count + 1 ) * sizeof( uint32_t ) );
+        vec->data    = mem_malloc( chars * sizeof( hzstr_char_t ) );
+
+        //check allocations
+        if( ( vec->offsets == NULL ) || ( vec->data == NULL ) ) {
+            hzstr_vec_destroy( vec );
+            return NULL;
+        }
+
+        //the vector is empty
+        vec->slots        = count;
+        vec->alloc        = chars;
+        vec->offsets[ 0 ] = 0;
+    }
+
+    //return the vector pointer
+    return vec;
+}
+
+
+/*==========================================================================*/
+void hzstr_vec_destroy(             //destroy a vector
+    hzstr_vec_type*     vec         //the vector to destroy
+) {
+
+    //check the pointer
+    if( vec != NULL ) {
+
+        //free the offset table and the characters
+        if( vec->offsets != NULL ) {
+            mem_free( vec->offsets );
+        }
+        if( vec->data != NULL ) {
+            mem_free( vec->data );
+        }
+
+        //free the vector object
+        mem_free( vec );
+    }
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_vec_hash(      //hash every string in a vector
+    const hzstr_vec_type* vec,      //source vector
+    hzstr_hash_t*       hashes      //hash of each string (count entries)
+) {                                 //number of strings (or error result)
+
+    //local variables
+    unsigned long       index;      //string index
+    hzstr_type          view;       //view of each string
+
+    //check pointers
+    if( ( vec == NULL ) || ( ( hashes == NULL ) && ( vec->count > 0 ) ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //hash each string where it is stored (the view has no stored hash)
+    for( index = 0; index < vec->count; ++index ) {
+        hzstr_vec_view( vec, index, &view );
+        hashes[ index ] = hzstr_hash( &view );
+    }
+
+    //return the number of strings hashed
+    return vec->count;
+}
+
+
+/*==========================================================================*/
+hzstr_vec_type* hzstr_vec_load(     //read a vector saved by hzstr_vec_save()
+    const char*         path        //file to read
+) {                                 //new vector (NULL if the file is invalid)
+
+    //local variables
+    FILE*               file;       //vector file
+    hzstr_vec_header_type header;   //vector file header
+    unsigned long       index;      //string index
+    long                size;       //size of the vector file
+    hzstr_vec_type*     vec;        //vector read
+
+    //check pointer
+    if( path == NULL ) {
+        return NULL;
+    }
+
+    //check the header
+    file = fopen( path, "rb" );
+    if( file == NULL ) {
+        return NULL;
+    }
+    if( ( fread( &header, sizeof( header ), 1, file ) != 1 )
+     || ( memcmp( header.magic, HZSTR_VEC_MAGIC, sizeof( HZSTR_VEC_MAGIC ) )
+        != 0 )
+     || ( header.version != HZSTR_VEC_VERSION )
+     || ( header.char_size != sizeof( hzstr_char_t ) )
+     || ( header.count > MAX_CHARS )
+     || ( header.chars > MAX_CHARS ) ) {
+        fclose( file );
+        return NULL;
+    }
+
+    //the file must hold exactly the table and characters (so nothing is
+    //  allocated for a damaged file)
+    fseek( file, 0, SEEK_END );
+    size = ftell( file );
+    fseek( file, sizeof( header ), SEEK_SET );
+    if( ( unsigned long ) size != ( sizeof( header )
+        + ( ( header.count + 1 ) * sizeof( uint32_t ) )
+        + ( header.chars * sizeof( hzstr_char_t ) ) ) ) {
+        fclose( file );
+        return NULL;
+    }
+
+    //read the offset table and the characters into a vector of their size
+    vec = hzstr_vec_create( header.count, header.chars );
+    if( vec == NULL ) {
+        fclose( file );
+        return NULL;
+    }
+    if( ( fread( vec->offsets, sizeof( uint32_t ), ( header.count + 1 ), file )
+        != ( header.count + 1 ) )
+     || ( fread( vec->data, sizeof( hzstr_char_t ), header.chars, file )
+        != header.chars ) ) {
+        hzstr_vec_destroy( vec );
+        fclose( file );
+        return NULL;
+    }
+    fclose( file );
+
+    //every string must be within the characters, and a valid length
+    vec->count = header.count;
+    if( ( vec->offsets[ 0 ] != 0 )
+     || ( vec->offsets[ vec->count ] != header.chars ) ) {
+        hzstr_vec_destroy( vec );
+        return NULL;
+    }
+    for( index = 0; index < vec->count; ++index ) {
+        if( ( vec->offsets[ index + 1 ] < vec->offsets[ index ] )
+         || ( ( vec->offsets[ index + 1 ] - vec->offsets[ index ] )
+            >= MAX_LENGTH ) ) {
+            hzstr_vec_destroy( vec );
+            return NULL;
+        }
+    }
+
+    //return the vector
+    return vec;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_vec_save(      //write a vector's memory to a file
+    const hzstr_vec_type* vec,      //vector to save
+    const char*         path        //file to write
+) {                                 //number of strings (or error result)
+
+    //local variables
+    FILE*               file;       //vector file
+    hzstr_vec_header_type header;   //vector file header
+    int                 written;    //non-zero if everything was written
+
+    //check pointers
+    if( ( vec == NULL ) || ( path == NULL ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //describe the vector
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, HZSTR_VEC_MAGIC, sizeof( HZSTR_VEC_MAGIC ) );
+    header.version   = HZSTR_VEC_VERSION;
+    header.char_size = sizeof( hzstr_char_t );
+    header.count     = vec->count;
+    header.chars     = hzstr_vec_chars( vec );
+
+    //write the header, the offset table and the characters
+    file = fopen( path, "wb" );
+    if( file == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+    written = ( fwrite( &header, sizeof( header ), 1, file ) == 1 )
+        && ( fwrite(
+            vec->offsets, sizeof( uint32_t ), ( vec->count + 1 ), file
+        ) == ( vec->count + 1 ) )
+        && ( fwrite(
+            vec->data, sizeof( hzstr_char_t ), header.chars, file
+        ) == header.chars );
+    if( ( fclose( file ) != 0 ) || ( written == 0 ) ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //return the number of strings written
+    return vec->count;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_vec_tolower(   //make every string in a vector lowercase
+    hzstr_vec_type*     vec         //vector to change
+) {                                 //result of operation
+
+    //local variables
+    unsigned long       chars;      //number of characters in the vector
+    unsigned long       start;      //start of the next piece
+    hzstr_type          view;       //view of one piece of the characters
+
+    //check pointer
+    if( vec == NULL ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //the characters are changed in place, so the strings' boundaries do not
+    //  matter (each piece is the longest a string object can describe)
+    memset( &view, 0, sizeof( view ) );
+    view.type = HZSTR_TYPE_SUBSTR;
+    chars     = hzstr_vec_chars( vec );
+    for( start = 0; start < chars; start += view.length ) {
+        view.data   = vec->data + start;
+        view.length = ( ( chars - start ) < MAX_LENGTH )
+            ? ( chars - start ) : ( MAX_LENGTH - 1 );
+        hzstr_tolower( &view );
+    }
+
+    //return success
+    return HZSTR_RSLT_OK;
+}
+
+
+/*==========================================================================*/
+hzstr_result_t hzstr_vec_view(      //describe one string without copying
+    const hzstr_vec_type* vec,      //source vector
+    unsigned long       index,      //index of the string
+    hzstr_type*         view        //receives a substring of the string
+) {                                 //length of the string (or error result)
+
+    //check pointers, and make sure the string exists
+    if( ( vec == NULL ) || ( view == NULL ) || ( index >= vec->count ) ) {
+        return HZSTR_RSLT_USAGE;
+    }
+
+    //the view refers to the vector's characters
+    memset( view, 0, sizeof( hzstr_type ) );
+    view->type   = HZSTR_TYPE_SUBSTR;
+    view->length = hzstr_vec_length( vec, index );
+    view->data   = vec->data + vec->offsets[ index ];
+
+    //return the length of the string
+    return view->length;
+}
+
+
+/*==========================================================================*/
+static hzstr_result_t vec_add(      //add characters as a new string
+    hzstr_vec_type*     vec,        //target vector
+    const hzstr_char_t* source,     //characters to add
+    hzstr_length_t      length      //number of characters to add
+) {                                 //index of the string (or error result)
+
+    //local variables
+    unsigned long       end;        //end of the vector's characters
+    int                 inside;     //non-zero if the source is in the vector
+    hzstr_result_t      result;     //allocation result
+    unsigned long       start;      //position of the source in the vector
+
+    //a vector's strings must be as short as any other string
+    if( length >= MAX_LENGTH ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //a view of this vector is found again after the characters move
+    inside = ( source >= vec->data )
+          && ( source < ( vec->data + vec->alloc ) );
+    start  = inside ? ( unsigned long ) ( source - vec->data ) : 0;
+
+    //make room for the string
+    result = vec_reserve( vec, length );
+    if( result < HZSTR_RSLT_OK ) {
+        return result;
+    }
+    if( inside != 0 ) {
+        source = vec->data + start;
+    }
+
+    //copy the characters after the last string, and end the new string
+    end = vec->offsets[ vec->count ];
+    mem_copy(
+        ( vec->data + end ),
+        source,
+        ( length * sizeof( hzstr_char_t ) )
+    );
+    vec->count += 1;
+    vec->offsets[ vec->count ] = end + length;
+
+    //return the index of the new string
+    return vec->count - 1;
+}
+
+
+/*==========================================================================*/
+static hzstr_result_t vec_reserve(  //make room for one more string
+    hzstr_vec_type*     vec,        //the vector to check
+    unsigned long       chars       //number of characters in the string
+) {                                 //result of the check
+
+    //local variables
+    unsigned long       alloc;      //new allocation of the characters
+    hzstr_char_t*       data;       //pointer to re-allocated characters
+    uint32_t*           offsets;    //pointer to re-allocated offset table
+    unsigned long       slots;      //new size of the offset table
+    unsigned long       used;       //number of characters used
+
+    //the characters must still be indexed by the offset table
+    used = vec->offsets[ vec->count ];
+    if( chars > ( MAX_CHARS - used ) ) {
+        return HZSTR_RSLT_SAFETY;
+    }
+
+    //grow the offset table in proportion to the strings, so repeated
+    //  appends are amortized
+    if( vec->count >= vec->slots ) {
+        slots   = vec->slots + ( vec->slots / 2 ) + HZSTR_CHUNK_SIZE;
+        offsets = mem_realloc(
+            vec->offsets, ( ( slots + 1 ) * sizeof( uint32_t ) )
+        );
+        if( offsets == NULL ) {
+            return HZSTR_RSLT_ALLOC;
+        }
+        vec->offsets = offsets;
+        vec->slots   = slots;
+    }
+
+    //grow the characters the same way (padded the way strings are padded)
+    if( ( used + chars ) > vec->alloc ) {
+        alloc = used + chars;
+        alloc = alloc + ( alloc / 2 );
+        alloc = ( ( alloc / HZSTR_CHUNK_SIZE ) + 1 ) * HZSTR_CHUNK_SIZE;
+        if( alloc > MAX_CHARS ) {
+            alloc = MAX_CHARS;
+        }
+        data = mem_realloc( vec->data, ( alloc * sizeof( hzstr_char_t ) ) );
+        if( data == NULL ) {
+            return HZSTR_RSLT_ALLOC;
+        }
+        vec->data  = data;
+        vec->alloc = alloc;
+    }
+
+    //the vector now has room for the string
+    return HZSTR_RSLT_OK;
+}
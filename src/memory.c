@@ -0,0 +1,475 @@
+/*****************************************************************************
+    memory.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Size-class pool behind the mem_* interface (see memory.h).
+
+        Every block begins with a header that records its size class and
+        the size that was requested.  A free block's first bytes link it
+        into a free list.  Pooled blocks are carved from slabs of
+        POOL_BATCH blocks, and the slabs are linked together so the pool's
+        memory is always reachable.
+
+        Each thread's cache is only used by that thread, so it needs no
+        lock.  The shared lists (one per size class) are guarded by spin
+        locks, which are only taken to move a batch of blocks.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hzlock.h"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+//the pool takes its memory from the system (or from the test stubs)
+#ifdef UNIT_TEST
+#define sys_free        mem_free
+#define sys_malloc      mem_malloc
+#define sys_realloc     mem_realloc
+#else
+#define sys_free        free
+#define sys_malloc      malloc
+#define sys_realloc     realloc
+#endif
+
+//performance tuning
+#define POOL_BATCH ( 32 )           //blocks moved to or from a list at once
+#define POOL_CACHE ( 2 * POOL_BATCH )
+                                    //most blocks a thread caches per class
+
+//size classes
+#define POOL_CLASSES ( MEM_POOL_MAX / MEM_POOL_GRAIN )
+#define POOL_LARGE ( POOL_CLASSES ) //class of blocks from the system
+
+//number of bytes in a size class's blocks, and the size class of a size
+#define pool_bytes( _c ) ( ( ( _c ) + 1 ) * MEM_POOL_GRAIN )
+#define pool_class( _s ) \
+    ( ( _s ) > 0 ? ( ( ( _s ) - 1 ) / MEM_POOL_GRAIN ) : 0 )
+
+//find a block's header, and a header's block
+#define pool_block( _h ) ( ( void* ) ( ( char* ) ( _h ) + MEM_POOL_HEAD ) )
+#define pool_head( _p ) \
+    ( ( pool_head_type* ) ( ( char* ) ( _p ) - MEM_POOL_HEAD ) )
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct pool_head_s {        //block header
+    unsigned long       size_class; //size class (or POOL_LARGE)
+    unsigned long       size;       //bytes requested
+} pool_head_type;
+
+typedef struct pool_free_s {        //link in a list of free blocks
+    struct pool_free_s* next;       //next free block
+} pool_free_type;
+
+typedef struct pool_list_s {        //shared list of free blocks
+    atomic_int          lock;       //spin lock (non-zero when held)
+    pool_free_type*     head;       //first free block
+    unsigned long       count;      //number of free blocks
+} pool_list_type;
+
+typedef struct pool_cache_s {       //a thread's cached free blocks
+    pool_free_type*     head[ POOL_CLASSES ];
+                                    //first free block of each class
+    unsigned int        count[ POOL_CLASSES ];
+                                    //number of free blocks of each class
+    unsigned long       hits;       //hits not yet published
+    unsigned long       misses;     //misses not yet published
+} pool_cache_type;
+
+//blocks must stay aligned after their headers
+_Static_assert(
+    sizeof( pool_head_type ) <= MEM_POOL_HEAD, "block header too large"
+);
+_Static_assert(
+    ( MEM_POOL_GRAIN % MEM_POOL_HEAD ) == 0, "size classes break alignment"
+);
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static pool_list_type   pool_lists[ POOL_CLASSES ];
+                                    //shared lists of free blocks
+static _Thread_local pool_cache_type pool_cache;
+                                    //this thread's cached free blocks
+
+static atomic_int       pool_slab_lock;
+                                    //spin lock for the list of slabs
+static void*            pool_slabs; //most recent slab (slabs are linked)
+
+static atomic_ulong     pool_hits;  //published allocations from free blocks
+static atomic_ulong     pool_misses;//published allocations from the system
+static atomic_ulong     pool_system;//bytes taken from the system for slabs
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static int pool_carve(              //carve a new slab into free blocks
+    unsigned long       size_class  //size class of the blocks
+);                                  //1 on success, -1 on failure
+
+static void pool_publish(           //publish this thread's statistics
+    void
+);
+
+static int pool_refill(             //refill this thread's cache
+    unsigned long       size_class  //size class to refill
+);                                  //0 from a list, 1 from the system, -1
+
+static void pool_return(            //give cached blocks to a shared list
+    unsigned long       size_class, //size class to return
+    unsigned int        count       //number of blocks to return
+);
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_pool_calloc(              //allocate zeroed memory from the pool
+    size_t              num,        //number of elements
+    size_t              size        //size of each element
+) {                                 //new block (NULL on failure)
+
+    //local variables
+    void*               ptr;        //new block
+
+    //the total size must be representable
+    if( ( size > 0 ) && ( num > ( SIZE_MAX / size ) ) ) {
+        return NULL;
+    }
+
+    //re-used blocks hold old data, so every block is cleared
+    ptr = mem_pool_malloc( num * size );
+    if( ptr != NULL ) {
+        memset( ptr, 0, ( num * size ) );
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_pool_flush(                //return this thread's cached blocks
+    void
+) {
+
+    //local variables
+    unsigned long       size_class; //size class index
+
+    //return every cached block
+    for( size_class = 0; size_class < POOL_CLASSES; ++size_class ) {
+        pool_return( size_class, pool_cache.count[ size_class ] );
+    }
+
+    //publish the thread's statistics
+    pool_publish();
+}
+
+
+/*==========================================================================*/
+void mem_pool_free(                 //release memory to the pool
+    void*               ptr         //block to release (may be NULL)
+) {
+
+    //local variables
+    pool_free_type*     block;      //released block
+    pool_head_type*     head;       //header of the block
+
+    //nothing to release
+    if( ptr == NULL ) {
+        return;
+    }
+
+    //large blocks go back to the system
+    head = pool_head( ptr );
+    if( head->size_class == POOL_LARGE ) {
+        sys_free( head );
+        return;
+    }
+
+    //cache the block for this thread
+    block       = ptr;
+    block->next = pool_cache.head[ head->size_class ];
+    pool_cache.head[ head->size_class ]   = block;
+    pool_cache.count[ head->size_class ] += 1;
+
+    //give a batch to the shared list once the cache is full
+    if( pool_cache.count[ head->size_class ] > POOL_CACHE ) {
+        pool_return( head->size_class, POOL_BATCH );
+    }
+}
+
+
+/*==========================================================================*/
+void* mem_pool_malloc(              //allocate memory from the pool
+    size_t              size        //bytes to allocate
+) {                                 //new block (NULL on failure)
+
+    //local variables
+    pool_free_type*     block;      //allocated block
+    pool_head_type*     head;       //header of the block
+    int                 result;     //result of refilling the cache
+    unsigned long       size_class; //size class of the block
+
+    //blocks too large to pool come from the system
+    if( size > MEM_POOL_MAX ) {
+        if( size > ( SIZE_MAX - MEM_POOL_HEAD ) ) {
+            return NULL;
+        }
+        head = sys_malloc( MEM_POOL_HEAD + size );
+        if( head == NULL ) {
+            return NULL;
+        }
+        head->size_class = POOL_LARGE;
+        head->size       = size;
+        pool_cache.misses += 1;
+        return pool_block( head );
+    }
+
+    //refill an empty cache
+    size_class = pool_class( size );
+    result     = 0;
+    if( pool_cache.head[ size_class ] == NULL ) {
+        result = pool_refill( size_class );
+        if( result < 0 ) {
+            return NULL;
+        }
+    }
+
+    //count a request that needed a new slab as a miss
+    if( result > 0 ) {
+        pool_cache.misses += 1;
+    }
+    else {
+        pool_cache.hits += 1;
+    }
+
+    //take the first cached block
+    block = pool_cache.head[ size_class ];
+    pool_cache.head[ size_class ]   = block->next;
+    pool_cache.count[ size_class ] -= 1;
+    head       = pool_head( block );
+    head->size = size;
+    return block;
+}
+
+
+/*==========================================================================*/
+void* mem_pool_realloc(             //re-size memory from the pool
+    void*               ptr,        //block to re-size (may be NULL)
+    size_t              size        //new size of the block
+) {                                 //re-sized block (NULL on failure)
+
+    //local variables
+    pool_head_type*     head;       //header of the block
+    void*               moved;      //new block
+
+    //re-sizing nothing allocates a block
+    if( ptr == NULL ) {
+        return mem_pool_malloc( size );
+    }
+    head = pool_head( ptr );
+
+    //large blocks stay with the system
+    if( ( head->size_class == POOL_LARGE ) && ( size > MEM_POOL_MAX ) ) {
+        if( size > ( SIZE_MAX - MEM_POOL_HEAD ) ) {
+            return NULL;
+        }
+        head = sys_realloc( head, ( MEM_POOL_HEAD + size ) );
+        if( head == NULL ) {
+            return NULL;
+        }
+        head->size = size;
+        return pool_block( head );
+    }
+
+    //a pooled block is kept if the new size is in the same size class
+    if( ( size <= MEM_POOL_MAX )
+     && ( pool_class( size ) == head->size_class ) ) {
+        head->size = size;
+        return ptr;
+    }
+
+    //otherwise, the data moves to a new block (and the original block is
+    //  unchanged if there is no memory)
+    moved = mem_pool_malloc( size );
+    if( moved == NULL ) {
+        return NULL;
+    }
+    memcpy( moved, ptr, ( head->size < size ? head->size : size ) );
+    mem_pool_free( ptr );
+    return moved;
+}
+
+
+/*==========================================================================*/
+void mem_pool_stats(                //report the pool's statistics
+    mem_pool_stats_type* stats      //statistics output
+) {
+
+    //local variables
+    unsigned long       size_class; //size class index
+
+    //published counts, and this thread's counts
+    stats->hits   = atomic_load( &pool_hits ) + pool_cache.hits;
+    stats->misses = atomic_load( &pool_misses ) + pool_cache.misses;
+    stats->system = atomic_load( &pool_system );
+
+    //free blocks in the shared lists and this thread's cache
+    stats->held = 0;
+    for( size_class = 0; size_class < POOL_CLASSES; ++size_class ) {
+        spin_lock( &pool_lists[ size_class ].lock );
+        stats->held += pool_lists[ size_class ].count
+                     * pool_bytes( size_class );
+        spin_unlock( &pool_lists[ size_class ].lock );
+        stats->held += pool_cache.count[ size_class ]
+                     * pool_bytes( size_class );
+    }
+}
+
+
+/*==========================================================================*/
+static int pool_carve(              //carve a new slab into free blocks
+    unsigned long       size_class  //size class of the blocks
+) {                                 //1 on success, -1 on failure
+
+    //local variables
+    unsigned long       bytes;      //bytes per block (with its header)
+    pool_free_type*     block;      //carved block
+    char*               first;      //header of the first block
+    pool_head_type*     head;       //header of the block
+    unsigned long       index;      //block index
+    char*               slab;       //new slab
+
+    //one slab holds a link to the previous slab, and a batch of blocks
+    bytes = MEM_POOL_HEAD + pool_bytes( size_class );
+    slab  = sys_malloc( MEM_POOL_HEAD + ( POOL_BATCH * bytes ) );
+    if( slab == NULL ) {
+        return -1;
+    }
+
+    //cache every block in the slab
+    first = slab + MEM_POOL_HEAD;
+    for( index = 0; index < POOL_BATCH; ++index ) {
+        head = ( pool_head_type* ) ( first + ( index * bytes ) );
+        head->size_class = size_class;
+        head->size       = 0;
+        block       = pool_block( head );
+        block->next = pool_cache.head[ size_class ];
+        pool_cache.head[ size_class ] = block;
+    }
+    pool_cache.count[ size_class ] += POOL_BATCH;
+
+    //keep the slab reachable
+    spin_lock( &pool_slab_lock );
+    *( ( void** ) slab ) = pool_slabs;
+    pool_slabs = slab;
+    spin_unlock( &pool_slab_lock );
+    atomic_fetch_add_explicit(
+        &pool_system,
+        ( MEM_POOL_HEAD + ( POOL_BATCH * bytes ) ),
+        memory_order_relaxed
+    );
+
+    return 1;
+}
+
+
+/*==========================================================================*/
+static void pool_publish(           //publish this thread's statistics
+    void
+) {
+    atomic_fetch_add_explicit(
+        &pool_hits, pool_cache.hits, memory_order_relaxed
+    );
+    atomic_fetch_add_explicit(
+        &pool_misses, pool_cache.misses, memory_order_relaxed
+    );
+    pool_cache.hits   = 0;
+    pool_cache.misses = 0;
+}
+
+
+/*==========================================================================*/
+static int pool_refill(             //refill this thread's cache
+    unsigned long       size_class  //size class to refill
+) {                                 //0 from a list, 1 from the system, -1
+
+    //local variables
+    pool_free_type*     block;      //moved block
+    unsigned int        count;      //number of blocks moved
+    pool_list_type*     list;       //shared list of the size class
+
+    //refills are infrequent, so this is when the statistics are published
+    pool_publish();
+
+    //take a batch from the shared list
+    list  = &pool_lists[ size_class ];
+    count = 0;
+    spin_lock( &list->lock );
+    while( ( list->head != NULL ) && ( count < POOL_BATCH ) ) {
+        block       = list->head;
+        list->head  = block->next;
+        block->next = pool_cache.head[ size_class ];
+        pool_cache.head[ size_class ] = block;
+        count += 1;
+    }
+    list->count -= count;
+    spin_unlock( &list->lock );
+    pool_cache.count[ size_class ] += count;
+
+    //use a new slab if the shared list was empty
+    if( count == 0 ) {
+        return pool_carve( size_class );
+    }
+    return 0;
+}
+
+
+/*==========================================================================*/
+static void pool_return(            //give cached blocks to a shared list
+    unsigned long       size_class, //size class to return
+    unsigned int        count       //number of blocks to return
+) {
+
+    //local variables
+    pool_free_type*     block;      //moved block
+    unsigned int        index;      //block index
+    pool_list_type*     list;       //shared list of the size class
+
+    //move the blocks from the front of the cache
+    list = &pool_lists[ size_class ];
+    spin_lock( &list->lock );
+    for( index = 0; index < count; ++index ) {
+        block = pool_cache.head[ size_class ];
+        pool_cache.head[ size_class ] = block->next;
+        block->next = list->head;
+        list->head  = block;
+    }
+    list->count += count;
+    spin_unlock( &list->lock );
+    pool_cache.count[ size_class ] -= count;
+}
@@ -0,0 +1,538 @@
+/*****************************************************************************
+    hzbasic_test.cpp
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        This tests the header-only policy-based strings (hzbasic.hpp).  The
+        allocation stubs count every call made by the heap allocator, so
+        the tests can verify each growth policy's allocations.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "test.h"
+
+#include "hzbasic.hpp"
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+
+//number of allocation calls made so far
+#define allocs() ( fail_calloc + fail_malloc + fail_realloc )
+
+//define symbols to disable the corresponding test section
+//#define TNO_CREATE
+//#define TNO_APPEND
+//#define TNO_EDIT
+//#define TNO_SEARCH
+//#define TNO_MOVE
+//#define TNO_ARENA
+//#define TNO_POOL
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+//strings that grow geometrically
+typedef hzstr::basic_hzstr< char, hzstr::double_growth > doubling;
+
+//strings that allocate from an arena
+typedef hzstr::basic_hzstr< char, hzstr::chunk_growth< 8 >,
+    hzstr::arena_allocator > scratch;
+
+//strings that allocate from the size-class pool
+typedef hzstr::basic_hzstr< char, hzstr::chunk_growth< 8 >,
+    hzstr::pool_allocator > pooled;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+alignas( 16 ) char      buffer[ 256 ];
+int                     count;
+int                     position;
+int                     thrown;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+extern "C" {
+
+void reset_test(                    //reset the test's variables
+    void
+);
+
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+);                                  //result of test
+
+}
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    memset( buffer, 0, sizeof( buffer ) );
+    count    = 0;
+    position = 0;
+    thrown   = 0;
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_CREATE
+    t_hdg( "String Creation" );
+
+        t_sec( "basic_hzstr(), empty" );
+        {
+            hzstr::hzstr8 string;
+            test_v_long( test, string.length(), 0 );
+            test_v_long( test, string.capacity(), 0 );
+            test_v_str( test, string.data(), "" );
+            test_v_long( test, string.view().size(), 0 );
+            test_v_long( test, allocs(), 0 );
+        }
+
+        t_sec( "basic_hzstr(), string view" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello World" ) );
+            test_v_long( test, string.length(), 11 );
+            test_v_long( test, string.capacity(), ( HZSTR_CHUNK_SIZE - 1 ) );
+            test_v_str( test, string.data(), "Hello World" );
+            test_v_long( test, allocs(), 1 );
+        }
+
+        t_sec( "basic_hzstr(), 16-bit and 32-bit characters" );
+        {
+            hzstr::hzstr16 narrow( std::u16string_view( u"caf\u00E9" ) );
+            hzstr::hzstr32 wide( std::u32string_view( U"\U0001F600!" ) );
+            test_v_long( test, narrow.length(), 4 );
+            test_v_long( test, narrow.data()[ 3 ], 0xE9 );
+            test_v_long( test, narrow.data()[ 4 ], 0 );
+            test_v_long( test, wide.length(), 2 );
+            test_v_long( test, wide.data()[ 0 ], 0x1F600 );
+            test_v_long( test, wide.data()[ 2 ], 0 );
+            test_v_long( test, sizeof( narrow.data()[ 0 ] ), 2 );
+            test_v_long( test, sizeof( wide.data()[ 0 ] ), 4 );
+        }
+
+        t_sec( "basic_hzstr(), string view too long" );
+        try {
+            std::string text( 65535, 'a' );
+            hzstr::hzstr8 string( ( std::string_view( text ) ) );
+        }
+        catch( const std::length_error& ) {
+            thrown = 1;
+        }
+        test_v_long( test, thrown, 1 );
+        test_v_long( test, allocs(), 0 );
+
+        t_sec( "basic_hzstr(), failed allocation" );
+        fail_mallocs[ 0 ] = 1;
+        try {
+            hzstr::hzstr8 string( std::string_view( "Hello" ) );
+        }
+        catch( const std::bad_alloc& ) {
+            thrown = 1;
+        }
+        test_v_long( test, thrown, 1 );
+#endif
+
+#ifndef TNO_APPEND
+    t_hdg( "Appending" );
+
+        t_sec( "append(), chunk growth" );
+        {
+            hzstr::hzstr8 string;
+            for( position = 0; position < 100; ++position ) {
+                string.append( 'a' );
+            }
+            test_v_long( test, string.length(), 100 );
+            test_v_long( test, string.capacity(), 127 );
+            test_v_long( test, fail_malloc, 1 );
+            test_v_long( test, fail_realloc, 3 );
+            test_v_long( test, string.data()[ 100 ], 0 );
+        }
+
+        t_sec( "append(), double growth" );
+        {
+            doubling string;
+            for( position = 0; position < 1000; ++position ) {
+                string.append( 'a' );
+            }
+            test_v_long( test, string.length(), 1000 );
+            test_v_long( test, string.capacity(), 1023 );
+            test_v_long( test, fail_malloc, 1 );
+            test_v_long( test, fail_realloc, 5 );
+        }
+
+        t_sec( "append(), 32-bit characters" );
+        {
+            hzstr::hzstr32 string;
+            test_v_long( test, string.append( 0x10FFFF ), 1 );
+            test_v_long( test, string.append( U'x' ), 2 );
+            test_v_long( test, string.data()[ 0 ], 0x10FFFF );
+            test_v_long( test, string.data()[ 2 ], 0 );
+        }
+
+        t_sec( "append(), failed allocation" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello" ) );
+            string.reserve( 31 );
+            fail_reallocs[ 0 ] = 1;
+            for( position = 0; position < 26; ++position ) {
+                string.append( 'a' );
+            }
+            test_v_long( test, string.append( 'b' ), HZSTR_RSLT_ALLOC );
+            test_v_long( test, string.length(), 31 );
+            test_v_long( test, string.data()[ 31 ], 0 );
+        }
+
+        t_sec( "append(), maximum length" );
+        {
+            std::string text( 65534, 'a' );
+            hzstr::hzstr8 string( ( std::string_view( text ) ) );
+            test_v_long( test, string.append( 'b' ), HZSTR_RSLT_SAFETY );
+            test_v_long( test, string.length(), 65534 );
+        }
+#endif
+
+#ifndef TNO_EDIT
+    t_hdg( "Editing" );
+
+        t_sec( "cat()" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello" ) );
+            test_v_long( test, string.cat( " World" ), 11 );
+            test_v_str( test, string.data(), "Hello World" );
+            test_v_long( test, string.cat( std::string( 40, 'x' ) ), 51 );
+            test_v_long( test, string.capacity(), 63 );
+        }
+
+        t_sec( "cat(), own characters" );
+        {
+            hzstr::hzstr8 string(
+                std::string_view( "abcdefghijklmnopqrstuvwxyz" )
+            );
+            test_v_long( test, string.cat( string.view() ), 52 );
+            test_v_str(
+                test,
+                string.data(),
+                "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+            );
+        }
+
+        t_sec( "assign(), own characters" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello World" ) );
+            test_v_long( test, string.assign( string.view().substr( 6 ) ), 5 );
+            test_v_str( test, string.data(), "World" );
+            test_v_long( test, allocs(), 1 );
+        }
+
+        t_sec( "consume()" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello World" ) );
+            test_v_long( test, string.consume( 6 ), 5 );
+            test_v_str( test, string.data(), "World" );
+            test_v_long( test, string.capacity(), ( HZSTR_CHUNK_SIZE - 7 ) );
+            test_v_long( test, string.consume( 6 ), HZSTR_RSLT_USAGE );
+            test_v_long( test, string.consume( 5 ), 0 );
+            test_v_long( test, string.capacity(), ( HZSTR_CHUNK_SIZE - 1 ) );
+        }
+
+        t_sec( "consume(), reclaimed when growing" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello World" ) );
+            string.consume( 6 );
+            string.cat( std::string( 26, 'x' ) );
+            test_v_long( test, string.length(), 31 );
+            test_v_long( test, fail_realloc, 0 );
+            test_v_long( test, string.capacity(), 31 );
+        }
+
+        t_sec( "trim()" );
+        {
+            hzstr::hzstr8 string( std::string_view( " \t Hello World \n" ) );
+            test_v_long( test, string.trim(), 11 );
+            test_v_str( test, string.data(), "Hello World" );
+            string.assign( "  " );
+            test_v_long( test, string.trim(), 0 );
+            test_v_str( test, string.data(), "" );
+        }
+
+        t_sec( "reserve() and clear()" );
+        {
+            hzstr::hzstr8 string;
+            test_v_long( test, string.reserve( 100 ), 128 );
+            test_v_str( test, string.data(), "" );
+            string.assign( "Hello" );
+            string.clear();
+            test_v_long( test, string.length(), 0 );
+            test_v_str( test, string.data(), "" );
+            test_v_long( test, allocs(), 1 );
+        }
+#endif
+
+#ifndef TNO_SEARCH
+    t_hdg( "Comparing and Searching" );
+
+        t_sec( "compare()" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello" ) );
+            test_v_long( test, string.compare( "Hello" ), 0 );
+            test_v_long( test, ( string.compare( "Hellp" ) < 0 ), 1 );
+            test_v_long( test, ( string.compare( "Hell" ) > 0 ), 1 );
+            test_v_long( test, ( string.compare( "Hello!" ) < 0 ), 1 );
+        }
+
+        t_sec( "compare(), wide characters are unsigned" );
+        {
+            hzstr::hzstr32 string( std::u32string_view( U"\U0010FFFF" ) );
+            test_v_long( test, ( string.compare( U"a" ) > 0 ), 1 );
+        }
+
+        t_sec( "find()" );
+        {
+            hzstr::hzstr16 string( std::u16string_view( u"Hello" ) );
+            test_v_long( test, string.find( u'l' ), 2 );
+            test_v_long( test, string.find( u'x' ), HZSTR_INDEX_NONE );
+        }
+#endif
+
+#ifndef TNO_MOVE
+    t_hdg( "Moving and Copying" );
+
+        t_sec( "basic_hzstr(), move" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello" ) );
+            count = allocs();
+            hzstr::hzstr8 other( std::move( string ) );
+            test_v_long( test, allocs(), count );
+            test_v_str( test, other.data(), "Hello" );
+            test_v_long( test, string.length(), 0 );
+            test_v_str( test, string.data(), "" );
+            string = std::move( other );
+            test_v_str( test, string.data(), "Hello" );
+            test_v_long( test, other.length(), 0 );
+        }
+
+        t_sec( "clone()" );
+        {
+            hzstr::hzstr8 string( std::string_view( "Hello" ) );
+            hzstr::hzstr8 copy = string.clone();
+            test_v_long( test, ( copy.data() != string.data() ), 1 );
+            test_v_str( test, copy.data(), "Hello" );
+            test_v_long( test, fail_malloc, 2 );
+            hzstr::hzstr8 empty = hzstr::hzstr8().clone();
+            test_v_long( test, fail_malloc, 2 );
+        }
+#endif
+
+#ifndef TNO_ARENA
+    t_hdg( "Arena Allocation" );
+
+        t_sec( "arena_allocator, grows in place" );
+        {
+            hzstr::arena arena( buffer, sizeof( buffer ) );
+            scratch string( std::string_view( "Hello" ),
+                hzstr::arena_allocator( arena ) );
+            test_v_long( test, arena.used(), 8 );
+            string.cat( " World" );
+            test_v_long( test, ( string.data() == buffer ), 1 );
+            test_v_long( test, arena.used(), 16 );
+            test_v_str( test, string.data(), "Hello World" );
+            test_v_long( test, allocs(), 0 );
+        }
+
+        t_sec( "arena_allocator, copies an earlier block" );
+        {
+            hzstr::arena arena( buffer, sizeof( buffer ) );
+            scratch first( std::string_view( "abc" ),
+                hzstr::arena_allocator( arena ) );
+            scratch second( std::string_view( "def" ),
+                hzstr::arena_allocator( arena ) );
+            first.cat( "defghij" );
+            test_v_str( test, first.data(), "abcdefghij" );
+            test_v_long( test, ( first.data() > second.data() ), 1 );
+            test_v_str( test, second.data(), "def" );
+        }
+
+        t_sec( "arena_allocator, full arena" );
+        {
+            hzstr::arena arena( buffer, 16 );
+            scratch string( std::string_view( "Hello" ),
+                hzstr::arena_allocator( arena ) );
+            string.cat( " World" );
+            test_v_long( test, string.cat( "!!!!!" ), HZSTR_RSLT_ALLOC );
+            test_v_str( test, string.data(), "Hello World" );
+            arena.reset();
+            test_v_long( test, arena.used(), 0 );
+        }
+
+        t_sec( "arena_allocator, last block given back" );
+        {
+            hzstr::arena arena( buffer, sizeof( buffer ) );
+            {
+                scratch string( std::string_view( "Hello" ),
+                    hzstr::arena_allocator( arena ) );
+            }
+            test_v_long( test, arena.used(), 0 );
+        }
+#endif
+
+#ifndef TNO_POOL
+    t_hdg( "Pool Allocation" );
+
+        t_sec( "pool_allocator, a released block is re-used" );
+        {
+            const char* data;
+            {
+                pooled string( std::string_view( "Hello" ) );
+                data = string.data();
+                test_v_str( test, data, "Hello" );
+            }
+            count = allocs();
+            pooled string( std::string_view( "World" ) );
+            test_v_long( test, ( string.data() == data ), 1 );
+            test_v_long( test, allocs(), count );
+        }
+
+        t_sec( "pool_allocator, grows past the largest pooled block" );
+        {
+            std::string text( MEM_POOL_MAX, 'x' );
+            pooled string( std::string_view( "Hello" ) );
+            string.cat( text );
+            test_v_long( test, string.length(), ( MEM_POOL_MAX + 5 ) );
+            test_v_long( test, string.data()[ MEM_POOL_MAX + 4 ], 'x' );
+            test_v_str( test, &string.data()[ MEM_POOL_MAX + 5 ], "" );
+        }
+
+        t_sec( "pool_allocator, failed allocation" );
+        {
+            std::string text( 300, 'x' );
+            fail_mallocs[ 0 ] = 1;
+            try {
+                pooled string( ( std::string_view( text ) ) );
+            }
+            catch( const std::bad_alloc& ) {
+                thrown = 1;
+            }
+            test_v_long( test, thrown, 1 );
+        }
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
@@ -0,0 +1,338 @@
+/*****************************************************************************
+    hzbatch_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Each batch is checked against the same operation applied to copies
+        of the strings, one at a time.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+#include "test_strings.h"
+
+#include "hzbatch.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define MAX_STRINGS ( 50000 )
+#define BUFFER_SIZE ( 65536 )
+
+//add random strings (letters, spaces and punctuation)
+#define add_random( _t, _l ) test_strings_add( \
+    strings, &count, ( _t ), 0, ( _l ), " aAbBzZ!", 0 \
+)
+
+//define symbols to disable the corresponding test section
+//#define TNO_APPLY
+//#define TNO_HASH
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+char                    buffer[ BUFFER_SIZE ];
+hzstr_type*             copies[ MAX_STRINGS ];
+int                     count;
+hzstr_hash_t            hashes[ MAX_STRINGS ];
+int                     index0;
+int                     mismatches;
+hzstr_result_t          result;
+hzstr_type*             strings[ MAX_STRINGS ];
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static hzstr_result_t bump(         //change the first character of a string
+    hzstr_type*         string      //string to change
+);                                  //result of operation
+
+static int check_apply(             //apply an operation and check it
+    hzstr_batch_op_t    op,         //operation to apply
+    int                 threads     //number of threads
+);                                  //number of strings changed incorrectly
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    count        = 0;
+    index0       = 0;
+    mismatches   = 0;
+    result       = 0;
+    test_strings_seed( 1 );
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_APPLY
+    t_hdg( "Batch Operations" );
+
+        t_sec( "hzstr_batch_apply(), calling thread only" );
+        add_random( 1000, 40 );
+        test_v_long( test, check_apply( hzstr_tolower, 1 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), threads" );
+        add_random( MAX_STRINGS, 40 );
+        test_v_long( test, check_apply( hzstr_tolower, 4 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), thread for each processor" );
+        add_random( MAX_STRINGS, 40 );
+        test_v_long( test, check_apply( hzstr_toupper, 0 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), more threads than allowed" );
+        add_random( MAX_STRINGS, 40 );
+        test_v_long( test, check_apply( hzstr_trim, 1000 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), skewed lengths" );
+        memset( buffer, 'A', 60000 );
+        strings[ count++ ] = hzstr_create_cstr_n( buffer, 60000 );
+        add_random( 20000, 4 );
+        strings[ count++ ] = hzstr_create_cstr_n( buffer, 60000 );
+        test_v_long( test, check_apply( hzstr_tolower, 8 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), each string once, failures counted" );
+        add_random( MAX_STRINGS, 12 );
+        for( index0 = 0; index0 < count; ++index0 ) {
+            mismatches += ( strings[ index0 ]->length == 0 );
+        }
+        test_v_long( test, check_apply( bump, 4 ), 0 );
+        test_v_long( test, result, mismatches );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), validation" );
+        add_random( MAX_STRINGS, 20 );
+        for( index0 = 0; index0 < count; index0 += 7 ) {
+            hzstr_append( strings[ index0 ], '\xff' );
+            mismatches += 1;
+        }
+        test_v_long( test, check_apply( hzstr_validate, 4 ), 0 );
+        test_v_long( test, result, mismatches );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), empty batch" );
+        result = hzstr_batch_apply( NULL, 0, hzstr_tolower, 0 );
+        test_v_long( test, result, 0 );
+
+        t_sec( "hzstr_batch_apply(), failed job allocation" );
+        add_random( MAX_STRINGS, 40 );
+        fail_callocs[ fail_calloc ] = 1;
+        result = hzstr_batch_apply( strings, count, hzstr_tolower, 4 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), failed unit allocation" );
+        add_random( MAX_STRINGS, 40 );
+        fail_mallocs[ fail_malloc ] = 1;
+        result = hzstr_batch_apply( strings, count, hzstr_tolower, 4 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_apply(), invalid usage" );
+        strings[ 0 ] = hzstr_create_cstr( "Hello" );
+        strings[ 1 ] = NULL;
+        result = hzstr_batch_apply( strings, 1, NULL, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_batch_apply( strings, -1, hzstr_tolower, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_batch_apply( strings, 1, hzstr_tolower, -1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_batch_apply( NULL, 1, hzstr_tolower, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_batch_apply( strings, 2, hzstr_tolower, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        test_v_mem( test, strings[ 0 ]->data, "Hello", 5 );
+        hzstr_destroy( strings[ 0 ] );
+#endif
+
+#ifndef TNO_HASH
+    t_hdg( "Batch Hashing" );
+
+        t_sec( "hzstr_batch_hash()" );
+        add_random( MAX_STRINGS, 40 );
+        result = hzstr_batch_hash( strings, count, hashes, 4 );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        for( index0 = 0; index0 < count; ++index0 ) {
+            if( hashes[ index0 ] != hzstr_hash( strings[ index0 ] ) ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_batch_hash(), invalid usage" );
+        strings[ 0 ] = hzstr_create_cstr( "Hello" );
+        result = hzstr_batch_hash( strings, 1, NULL, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_batch_hash( NULL, 1, hashes, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_batch_hash( strings, 1, hashes, -1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_destroy( strings[ 0 ] );
+#endif
+
+    return 0;
+}
+
+
+
+/*==========================================================================*/
+static hzstr_result_t bump(         //change the first character of a string
+    hzstr_type*         string      //string to change
+) {                                 //result of operation
+
+    //empty strings fail
+    if( string->length == 0 ) {
+        return HZSTR_RSLT_USAGE;
+    }
+    string->data[ 0 ] += 1;
+    return HZSTR_RSLT_OK;
+}
+
+
+/*==========================================================================*/
+static int check_apply(             //apply an operation and check it
+    hzstr_batch_op_t    op,         //operation to apply
+    int                 threads     //number of threads
+) {                                 //number of strings changed incorrectly
+
+    //local variables
+    int                 index;      //string index
+    int                 wrong;      //number of strings changed incorrectly
+
+    //apply the operation to copies, one at a time
+    for( index = 0; index < count; ++index ) {
+        copies[ index ] = hzstr_create( 0 );
+        hzstr_cpy( copies[ index ], strings[ index ] );
+        op( copies[ index ] );
+    }
+
+    //apply the operation as a batch, and compare
+    result = hzstr_batch_apply( strings, count, op, threads );
+    wrong  = 0;
+    for( index = 0; index < count; ++index ) {
+        wrong += ( hzstr_cmp( strings[ index ], copies[ index ] ) != 0 );
+        wrong += ( strings[ index ]->flags != copies[ index ]->flags );
+        hzstr_destroy( copies[ index ] );
+    }
+    return wrong;
+}
+
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
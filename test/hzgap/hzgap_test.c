@@ -0,0 +1,419 @@
+/*****************************************************************************
+    hzgap_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzgap.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+
+//define symbols to disable the corresponding test section
+//#define TNO_CREATE
+//#define TNO_EDIT
+//#define TNO_MOVE
+//#define TNO_CONVERT
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+hzstr_type              after;
+hzstr_type              before;
+hzstr_gap_type*         gap;
+hzstr_index_t           position;
+hzstr_result_t          result;
+hzstr_type*             string;
+hzstr_type*             string2;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    memset( &after,  0, sizeof( hzstr_type ) );
+    memset( &before, 0, sizeof( hzstr_type ) );
+    gap      = NULL;
+    position = 0;
+    result   = 0;
+    string   = NULL;
+    string2  = NULL;
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_CREATE
+    t_hdg( "Gap Buffer Creation" );
+
+        t_sec( "hzstr_gap_create(), empty buffer" );
+        gap = hzstr_gap_create( 0 );
+        test_v_ptr( test, gap );
+        test_v_long( test, hzstr_gap_length( gap ), 0 );
+        test_v_long( test, hzstr_gap_cursor( gap ), 0 );
+        test_v_long( test, gap->alloc, HZSTR_CHUNK_SIZE );
+        hzstr_gap_destroy( gap );
+
+        t_sec( "hzstr_gap_create(), failed data allocation" );
+        fail_mallocs[ 0 ] = 1;
+        gap = hzstr_gap_create( 0 );
+        test_v_null( test, gap );
+
+        t_sec( "hzstr_gap_create(), failed object allocation" );
+        fail_callocs[ 0 ] = 1;
+        gap = hzstr_gap_create( 0 );
+        test_v_null( test, gap );
+
+        t_sec( "hzstr_gap_create_str()" );
+        string = hzstr_create_cstr( "Hello World" );
+        gap = hzstr_gap_create_str( string );
+        test_v_ptr( test, gap );
+        test_v_long( test, hzstr_gap_length( gap ), 11 );
+        test_v_long( test, hzstr_gap_cursor( gap ), 11 );
+        hzstr_gap_views( gap, &before, &after );
+        test_v_long( test, hzstr_length( &before ), 11 );
+        test_v_mem( test, before.data, "Hello World", 11 );
+        test_v_long( test, hzstr_length( &after ), 0 );
+        test_v_long( test, before.type, HZSTR_TYPE_SUBSTR );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_create_str(), failed object allocation" );
+        string = hzstr_create_cstr( "Hello World" );
+        fail_callocs[ 1 ] = 1;
+        gap = hzstr_gap_create_str( string );
+        test_v_null( test, gap );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_destroy(), invalid object" );
+        hzstr_gap_destroy( NULL );
+        gap = hzstr_gap_create( 0 );
+        free( gap->data );
+        gap->data = NULL;
+        test_v_null( test, gap->data );
+        hzstr_gap_destroy( gap );
+#endif
+
+#ifndef TNO_EDIT
+    t_hdg( "Gap Buffer Editing" );
+
+        t_sec( "hzstr_gap_append()" );
+        gap = hzstr_gap_create( 0 );
+        hzstr_gap_append( gap, 'H' );
+        result = hzstr_gap_append( gap, 'i' );
+        test_v_long( test, result, 2 );
+        test_v_long( test, hzstr_gap_cursor( gap ), 2 );
+        hzstr_gap_destroy( gap );
+
+        t_sec( "hzstr_gap_append(), invalid usage" );
+        result = hzstr_gap_append( NULL, 'H' );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_gap_append(), widest character" );
+        gap = hzstr_gap_create( 0 );
+        hzstr_gap_append( gap, ( hzstr_char_t ) -1 );
+        test_v_long( test, hzstr_gap_length( gap ), 1 );
+        test_v_boolean( test, ( gap->data[ 0 ] == ( hzstr_char_t ) -1 ), 1 );
+        hzstr_gap_destroy( gap );
+
+        t_sec( "hzstr_gap_append(), growth" );
+        gap = hzstr_gap_create( 0 );
+        for( position = 0; position < 1000; ++position ) {
+            hzstr_gap_append( gap, ( 'a' + ( position % 26 ) ) );
+        }
+        test_v_long( test, hzstr_gap_length( gap ), 1000 );
+        test_v_boolean( test, ( gap->alloc > 1000 ), 1 );
+        test_v_long( test, ( gap->alloc % HZSTR_CHUNK_SIZE ), 0 );
+        test_v_long( test, gap->data[ 999 ], ( 'a' + ( 999 % 26 ) ) );
+        hzstr_gap_destroy( gap );
+
+        t_sec( "hzstr_gap_append(), failed reallocation" );
+        gap = hzstr_gap_create( 0 );
+        for( position = 0; position < 31; ++position ) {
+            hzstr_gap_append( gap, 'x' );
+        }
+        fail_reallocs[ 0 ] = 1;
+        result = hzstr_gap_append( gap, 'x' );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_long( test, hzstr_gap_length( gap ), 31 );
+        hzstr_gap_destroy( gap );
+
+        t_sec( "hzstr_gap_insert()" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "Big " );
+        gap = hzstr_gap_create_str( string );
+        hzstr_gap_move( gap, 6 );
+        result = hzstr_gap_insert( gap, string2 );
+        test_v_long( test, result, 15 );
+        test_v_long( test, hzstr_gap_cursor( gap ), 10 );
+        hzstr_gap_export( gap, string );
+        test_v_str( test, hzstr_cstr( string ), "Hello Big World" );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_insert(), invalid usage" );
+        string = hzstr_create_cstr( "Hello World" );
+        gap = hzstr_gap_create_str( string );
+        result = hzstr_gap_insert( gap, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_gap_insert( NULL, string );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_gap_views( gap, &before, &after );
+        result = hzstr_gap_insert( gap, &before );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_insert(), maximum length" );
+        gap = hzstr_gap_create( 0 );
+        string = hzstr_create( 40000 );
+        memset( string->data, 'x', 40000 );
+        string->length = 40000;
+        result = hzstr_gap_insert( gap, string );
+        test_v_long( test, result, 40000 );
+        result = hzstr_gap_insert( gap, string );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        hzstr_destroy( string );
+        hzstr_gap_destroy( gap );
+
+        t_sec( "hzstr_gap_erase() and hzstr_gap_backspace()" );
+        string = hzstr_create_cstr( "Hello Big World" );
+        gap = hzstr_gap_create_str( string );
+        hzstr_gap_move( gap, 10 );
+        result = hzstr_gap_backspace( gap, 4 );
+        test_v_long( test, result, 11 );
+        test_v_long( test, hzstr_gap_cursor( gap ), 6 );
+        result = hzstr_gap_erase( gap, 5 );
+        test_v_long( test, result, 6 );
+        hzstr_gap_export( gap, string );
+        test_v_str( test, hzstr_cstr( string ), "Hello " );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_erase() and hzstr_gap_backspace(), invalid usage" );
+        string = hzstr_create_cstr( "Hello World" );
+        gap = hzstr_gap_create_str( string );
+        hzstr_gap_move( gap, 6 );
+        result = hzstr_gap_erase( gap, 6 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_gap_backspace( gap, 7 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_gap_erase( NULL, 1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_gap_backspace( NULL, 1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        test_v_long( test, hzstr_gap_length( gap ), 11 );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_MOVE
+    t_hdg( "Gap Buffer Cursor" );
+
+        t_sec( "hzstr_gap_move()" );
+        string = hzstr_create_cstr( "Hello World" );
+        gap = hzstr_gap_create_str( string );
+        result = hzstr_gap_move( gap, 5 );
+        test_v_long( test, result, 5 );
+        hzstr_gap_views( gap, &before, &after );
+        test_v_long( test, hzstr_length( &before ), 5 );
+        test_v_mem( test, before.data, "Hello", 5 );
+        test_v_long( test, hzstr_length( &after ), 6 );
+        test_v_mem( test, after.data, " World", 6 );
+        result = hzstr_gap_move( gap, 0 );
+        test_v_long( test, result, 0 );
+        result = hzstr_gap_move( gap, 11 );
+        test_v_long( test, result, 11 );
+        hzstr_gap_views( gap, &before, &after );
+        test_v_mem( test, before.data, "Hello World", 11 );
+        test_v_long( test, hzstr_length( &after ), 0 );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_move(), invalid usage" );
+        string = hzstr_create_cstr( "Hello World" );
+        gap = hzstr_gap_create_str( string );
+        result = hzstr_gap_move( gap, 12 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_gap_move( gap, -1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_gap_move( NULL, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_CONVERT
+    t_hdg( "Gap Buffer Conversion" );
+
+        t_sec( "hzstr_gap_export()" );
+        string = hzstr_create_cstr( "World" );
+        gap = hzstr_gap_create_str( string );
+        hzstr_gap_move( gap, 0 );
+        hzstr_gap_append( gap, 'A' );
+        string2 = hzstr_create( 0 );
+        result = hzstr_gap_export( gap, string2 );
+        test_v_long( test, result, 6 );
+        test_v_str( test, hzstr_cstr( string2 ), "AWorld" );
+        hzstr_destroy( string2 );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_export(), invalid target string" );
+        string = hzstr_create_cstr( "World" );
+        gap = hzstr_gap_create_str( string );
+        string2 = hzstr_create_ccstr( "Constant" );
+        result = hzstr_gap_export( gap, string2 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        result = hzstr_gap_export( gap, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_destroy( string2 );
+        hzstr_gap_destroy( gap );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_to_str()" );
+        string = hzstr_create_cstr( "Hello World" );
+        gap = hzstr_gap_create_str( string );
+        hzstr_gap_move( gap, 5 );
+        hzstr_gap_append( gap, ',' );
+        string2 = hzstr_gap_to_str( gap );
+        test_v_ptr( test, string2 );
+        test_v_long( test, hzstr_length( string2 ), 12 );
+        test_v_long( test, string2->type, HZSTR_TYPE_DYNAMIC );
+        test_v_str( test, hzstr_cstr( string2 ), "Hello, World" );
+        result = hzstr_append( string2, '!' );
+        test_v_long( test, result, 13 );
+        test_v_str( test, hzstr_cstr( string2 ), "Hello, World!" );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_gap_to_str(), failed object allocation" );
+        gap = hzstr_gap_create( 0 );
+        fail_callocs[ 1 ] = 1;
+        string = hzstr_gap_to_str( gap );
+        test_v_null( test, string );
+        test_v_null( test, hzstr_gap_to_str( NULL ) );
+        hzstr_gap_destroy( gap );
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
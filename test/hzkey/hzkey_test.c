@@ -0,0 +1,325 @@
+/*****************************************************************************
+    hzkey_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzkey.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define NUM_WORDS ( 12 )
+
+//find the sign of a comparison value
+#define sign( _v ) ( ( ( _v ) > 0 ) - ( ( _v ) < 0 ) )
+
+//define symbols to disable the corresponding test section
+//#define TNO_SET
+//#define TNO_COMPARE
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const char*      words[ NUM_WORDS ] = {
+    "",
+    "a",
+    "ab",
+    "abc",
+    "abcd",
+    "abcde",
+    "abcdefghijkl",
+    "abcdefghijklm",
+    "abcdefghijklmn",
+    "abcdefghijkm",
+    "abce",
+    "b"
+};
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+int                     index0;
+int                     index1;
+hzstr_key_type          key0;
+hzstr_key_type          key1;
+hzstr_key_type          keys[ NUM_WORDS ];
+int                     mismatches;
+hzstr_result_t          result;
+hzstr_type*             string0;
+hzstr_type*             string1;
+hzstr_type*             strings[ NUM_WORDS ];
+hzstr_type              view;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    memset( &key0, 0, sizeof( hzstr_key_type ) );
+    memset( &key1, 0, sizeof( hzstr_key_type ) );
+    memset( &view, 0, sizeof( hzstr_type ) );
+    index0     = 0;
+    index1     = 0;
+    mismatches = 0;
+    result     = 0;
+    string0    = NULL;
+    string1    = NULL;
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_SET
+    t_hdg( "Key Conversion" );
+
+        t_sec( "hzstr_key_type, size" );
+        test_v_long( test, sizeof( hzstr_key_type ), 16 );
+
+        t_sec( "hzstr_key_set(), short string" );
+        string0 = hzstr_create_cstr( "Hello" );
+        result = hzstr_key_set( &key0, string0 );
+        test_v_long( test, result, 5 );
+        test_v_long( test, hzstr_key_length( &key0 ), 5 );
+        test_v_boolean( test, hzstr_key_is_inline( &key0 ), 1 );
+        test_v_mem( test, key0.chars, "Hello\0\0\0\0\0\0\0", 12 );
+        hzstr_destroy( string0 );
+
+        t_sec( "hzstr_key_set(), long string" );
+        string0 = hzstr_create_cstr( "Hello, World" );
+        hzstr_cat_cstr( string0, "!" );
+        result = hzstr_key_set( &key0, string0 );
+        test_v_long( test, result, 13 );
+        test_v_boolean( test, hzstr_key_is_inline( &key0 ), 0 );
+        test_v_mem( test, key0.chars, "Hell", 4 );
+        hzstr_destroy( string0 );
+
+        t_sec( "hzstr_key_view()" );
+        string0 = hzstr_create_cstr( "Hello" );
+        hzstr_key_set( &key0, string0 );
+        string1 = hzstr_create_cstr( "Hello, World!" );
+        hzstr_key_set( &key1, string1 );
+        result = hzstr_key_view( &key0, &view );
+        test_v_long( test, result, 5 );
+        test_v_long( test, view.type, HZSTR_TYPE_SUBSTR );
+        test_v_long( test, ( view.data == key0.chars ), 1 );
+        test_v_long( test, hzstr_cmp( &view, string0 ), 0 );
+        result = hzstr_key_view( &key1, &view );
+        test_v_long( test, result, 13 );
+        test_v_long( test, ( view.data == string1->data ), 1 );
+        hzstr_destroy( string1 );
+        hzstr_destroy( string0 );
+
+        t_sec( "hzstr_key_to_str()" );
+        for( index0 = 0; index0 < NUM_WORDS; ++index0 ) {
+            string0 = hzstr_create_cstr( words[ index0 ] );
+            hzstr_key_set( &key0, string0 );
+            string1 = hzstr_key_to_str( &key0 );
+            if( ( string1 == NULL )
+             || ( string1->type != HZSTR_TYPE_DYNAMIC )
+             || ( hzstr_cmp( string0, string1 ) != 0 ) ) {
+                mismatches += 1;
+            }
+            hzstr_destroy( string1 );
+            hzstr_destroy( string0 );
+        }
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_key_to_str(), failed allocation" );
+        string0 = hzstr_create_cstr( "Hello" );
+        hzstr_key_set( &key0, string0 );
+        fail_callocs[ fail_calloc ] = 1;
+        string1 = hzstr_key_to_str( &key0 );
+        test_v_null( test, string1 );
+        hzstr_destroy( string0 );
+
+        t_sec( "hzstr_key_set(), invalid usage" );
+        string0 = hzstr_create_cstr( "Hello" );
+        result = hzstr_key_set( NULL, string0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_key_set( &key0, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_key_view( NULL, &view );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_key_view( &key0, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        string1 = hzstr_key_to_str( NULL );
+        test_v_null( test, string1 );
+        hzstr_destroy( string0 );
+#endif
+
+#ifndef TNO_COMPARE
+    t_hdg( "Key Comparison" );
+
+        for( index0 = 0; index0 < NUM_WORDS; ++index0 ) {
+            strings[ index0 ] = hzstr_create_cstr( words[ index0 ] );
+            hzstr_key_set( &keys[ index0 ], strings[ index0 ] );
+        }
+
+        t_sec( "hzstr_key_cmp(), same order as hzstr_cmp()" );
+        for( index0 = 0; index0 < NUM_WORDS; ++index0 ) {
+            for( index1 = 0; index1 < NUM_WORDS; ++index1 ) {
+                if( sign( hzstr_key_cmp( &keys[ index0 ], &keys[ index1 ] ) )
+                 != sign( hzstr_cmp( strings[ index0 ], strings[ index1 ] ) )
+                ) {
+                    mismatches += 1;
+                }
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_key_equal(), same results as hzstr_equal()" );
+        for( index0 = 0; index0 < NUM_WORDS; ++index0 ) {
+            for( index1 = 0; index1 < NUM_WORDS; ++index1 ) {
+                if( hzstr_key_equal( &keys[ index0 ], &keys[ index1 ] )
+                 != hzstr_equal( strings[ index0 ], strings[ index1 ] ) ) {
+                    mismatches += 1;
+                }
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_key_equal(), copies of the same strings" );
+        for( index0 = 0; index0 < NUM_WORDS; ++index0 ) {
+            string0 = hzstr_create_cstr( words[ index0 ] );
+            hzstr_key_set( &key0, string0 );
+            if( ( hzstr_key_equal( &key0, &keys[ index0 ] ) != 1 )
+             || ( hzstr_key_cmp( &key0, &keys[ index0 ] ) != 0 ) ) {
+                mismatches += 1;
+            }
+            hzstr_destroy( string0 );
+        }
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_key_cmp(), difference after the prefix" );
+        string0 = hzstr_create_cstr( "abcdefghijklmnop" );
+        string1 = hzstr_create_cstr( "abcdefghijklmnoq" );
+        hzstr_key_set( &key0, string0 );
+        hzstr_key_set( &key1, string1 );
+        test_v_long( test, hzstr_key_cmp( &key0, &key1 ), -1 );
+        test_v_long( test, hzstr_key_cmp( &key1, &key0 ), 1 );
+        test_v_long( test, hzstr_key_equal( &key0, &key1 ), 0 );
+        hzstr_destroy( string1 );
+        hzstr_destroy( string0 );
+
+        for( index0 = 0; index0 < NUM_WORDS; ++index0 ) {
+            hzstr_destroy( strings[ index0 ] );
+        }
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
@@ -0,0 +1,352 @@
+/*****************************************************************************
+    hzlatency_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Tests the latency histograms recorded when the string module is
+        built with HZSTR_LATENCY.  Only calls that grow a string are
+        timed, so each check writes GROW_CSTR (longer than an allocation
+        chunk) to make every call grow.  Each check starts from a reset
+        with every growth timed, so the expected sample counts are those
+        of that check alone.  The times themselves depend on the machine,
+        so only their order is checked.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define GROW_CSTR "0123456789012345678901234567890123456789"
+#define MAX_ALLOCS ( 8 )
+#define LINE_SIZE ( 256 )
+
+//define symbols to disable the corresponding test section
+//#define TNO_SAMPLES
+//#define TNO_SUMMARY
+//#define TNO_THREADS
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+int                     found;
+char                    line[ LINE_SIZE ];
+FILE*                   out;
+int                     position;
+hzstr_result_t          result;
+hzstr_type*             string;
+hzstr_type*             string2;
+hzstr_latency_type      summary;
+pthread_t               thread;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static void* append_thread(         //append C-strings in another thread
+    void*               argument    //string to append to
+);                                  //NULL
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    found    = 0;
+    out      = NULL;
+    position = 0;
+    result   = 0;
+    string   = NULL;
+    string2  = NULL;
+    memset( &summary, 0xFF, sizeof( summary ) );
+    hzstr_latency_reset();
+    hzstr_latency_rate( 1 );
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_SAMPLES
+    t_hdg( "Sampled Calls" );
+
+        t_sec( "hzstr_latency_summary(), nothing timed" );
+        result = hzstr_latency_summary( HZSTR_LAT_CAT, &summary );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_long( test, summary.samples, 0 );
+        test_v_long( test, summary.total, 0 );
+        test_v_long( test, summary.maximum, 0 );
+        test_v_long( test, summary.p50, 0 );
+        test_v_long( test, summary.p999, 0 );
+
+        t_sec( "hzstr_latency_rate(), every growth timed" );
+        string  = hzstr_create( 0 );
+        string2 = hzstr_create_cstr( GROW_CSTR );
+        hzstr_latency_reset();
+        for( position = 0; position < 5; ++position ) {
+            hzstr_cat( string, string2 );
+        }
+        hzstr_latency_summary( HZSTR_LAT_CAT, &summary );
+        test_v_long( test, summary.samples, 5 );
+        hzstr_latency_summary( HZSTR_LAT_CPY, &summary );
+        test_v_long( test, summary.samples, 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_latency_rate(), one growth in four timed" );
+        string = hzstr_create( 0 );
+        hzstr_latency_rate( 4 );
+        for( position = 0; position < 8; ++position ) {
+            hzstr_cat_cstr( string, GROW_CSTR );
+        }
+        hzstr_latency_summary( HZSTR_LAT_CAT_CSTR, &summary );
+        test_v_long( test, summary.samples, 2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_latency_rate(), zero times every growth" );
+        string = hzstr_create( 0 );
+        hzstr_latency_rate( 0 );
+        for( position = 0; position < 3; ++position ) {
+            hzstr_cat_cstr( string, GROW_CSTR );
+        }
+        hzstr_latency_summary( HZSTR_LAT_CAT_CSTR, &summary );
+        test_v_long( test, summary.samples, 3 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_latency_summary(), calls that fit not timed" );
+        string = hzstr_create( 20 );
+        for( position = 0; position < 8; ++position ) {
+            hzstr_append( string, 'a' );
+        }
+        hzstr_cpy_cstr( string, "Hello" );
+        hzstr_latency_summary( HZSTR_LAT_APPEND, &summary );
+        test_v_long( test, summary.samples, 0 );
+        hzstr_latency_summary( HZSTR_LAT_CPY_CSTR, &summary );
+        test_v_long( test, summary.samples, 0 );
+        test_v_long( test, hzstr_length( string ), 5 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_latency_summary(), allocations timed" );
+        string = hzstr_create( 0 );
+        hzstr_cpy_cstr( string, GROW_CSTR );
+        hzstr_latency_summary( HZSTR_LAT_ALLOC, &summary );
+        test_v_long( test, summary.samples, 2 );
+        hzstr_latency_summary( HZSTR_LAT_CPY_CSTR, &summary );
+        test_v_long( test, summary.samples, 1 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_latency_reset()" );
+        string = hzstr_create( 0 );
+        hzstr_cat_cstr( string, GROW_CSTR );
+        hzstr_latency_reset();
+        hzstr_latency_summary( HZSTR_LAT_CAT_CSTR, &summary );
+        test_v_long( test, summary.samples, 0 );
+        test_v_long( test, summary.maximum, 0 );
+        hzstr_latency_summary( HZSTR_LAT_ALLOC, &summary );
+        test_v_long( test, summary.samples, 0 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_SUMMARY
+    t_hdg( "Summaries" );
+
+        t_sec( "hzstr_latency_summary(), percentiles in order" );
+        string = hzstr_create( 0 );
+        for( position = 0; position < 100; ++position ) {
+            hzstr_cat_cstr( string, GROW_CSTR );
+        }
+        result = hzstr_latency_summary( HZSTR_LAT_CAT_CSTR, &summary );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_long( test, summary.samples, 100 );
+        test_v_long( test, ( summary.p50 <= summary.p90 ), 1 );
+        test_v_long( test, ( summary.p90 <= summary.p99 ), 1 );
+        test_v_long( test, ( summary.p99 <= summary.p999 ), 1 );
+        test_v_long( test, ( summary.p999 <= summary.maximum ), 1 );
+        test_v_long( test, ( summary.maximum <= summary.total ), 1 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_latency_summary(), invalid arguments" );
+        result = hzstr_latency_summary( -1, &summary );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_latency_summary( HZSTR_NUM_LATS, &summary );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_latency_summary( HZSTR_LAT_CAT, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_latency_dump(), timed operations only" );
+        string = hzstr_create( 0 );
+        hzstr_cat_cstr( string, GROW_CSTR );
+        out = tmpfile();
+        hzstr_latency_dump( out );
+        rewind( out );
+        while( fgets( line, LINE_SIZE, out ) != NULL ) {
+            if( strncmp( line, "hzstr_cat_cstr: 1 samples", 25 ) == 0 ) {
+                found |= 1;
+            }
+            else if( strncmp( line, "hzstr_cpy", 9 ) == 0 ) {
+                found |= 2;
+            }
+            else if( strncmp( line, "  ", 2 ) == 0 ) {
+                found |= 4;
+            }
+        }
+        fclose( out );
+        test_v_long( test, found, ( 1 | 4 ) );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_THREADS
+    t_hdg( "Thread Histograms" );
+
+        t_sec( "hzstr_latency_summary(), times of other threads" );
+        string  = hzstr_create( 0 );
+        string2 = hzstr_create( 0 );
+        hzstr_cat_cstr( string, GROW_CSTR );
+        pthread_create( &thread, NULL, append_thread, string2 );
+        pthread_join( thread, NULL );
+        hzstr_latency_summary( HZSTR_LAT_CAT_CSTR, &summary );
+        test_v_long( test, summary.samples, 101 );
+        test_v_long( test, hzstr_length( string2 ), 4000 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_latency_reset(), times of other threads" );
+        string = hzstr_create( 0 );
+        pthread_create( &thread, NULL, append_thread, string );
+        pthread_join( thread, NULL );
+        hzstr_latency_reset();
+        hzstr_latency_summary( HZSTR_LAT_CAT_CSTR, &summary );
+        test_v_long( test, summary.samples, 0 );
+        hzstr_destroy( string );
+#endif
+
+    return 0;
+}
+
+
+/*==========================================================================*/
+static void* append_thread(         //append C-strings in another thread
+    void*               argument    //string to append to
+) {                                 //NULL
+
+    //local variables
+    int                 count;      //number of C-strings appended
+
+    for( count = 0; count < 100; ++count ) {
+        hzstr_cat_cstr( argument, GROW_CSTR );
+    }
+    return NULL;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
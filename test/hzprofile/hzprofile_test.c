@@ -0,0 +1,368 @@
+/*****************************************************************************
+    hzprofile_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Tests the live string profile kept when the string module is built
+        with HZSTR_PROFILE.  Each check destroys the strings it creates, so
+        the expected sites are those of that check alone.  The line of each
+        create call is kept in site_line, so the expected line follows the
+        call when the test is edited.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define MAX_SITES ( 4 )
+#define LINE_SIZE ( 256 )
+
+//bytes held by a string object with a number of allocated characters
+#define held( _a ) ( sizeof( hzstr_type ) + chars( _a ) )
+
+//bytes of a number of characters
+#define chars( _n ) ( ( _n ) * sizeof( hzstr_char_t ) )
+
+//define symbols to disable the corresponding test section
+//#define TNO_SITES
+//#define TNO_REPORTS
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+unsigned long           ages;
+int                     bucket;
+int                     found;
+char                    line[ LINE_SIZE ];
+FILE*                   out;
+hzstr_result_t          result;
+int                     site_line;
+int                     site_line2;
+hzstr_profile_site_type sites[ MAX_SITES ];
+unsigned long           sizes;
+hzstr_type*             string;
+hzstr_type*             string2;
+hzstr_type*             string3;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    ages       = 0;
+    bucket     = 0;
+    found      = 0;
+    out        = NULL;
+    result     = 0;
+    site_line  = 0;
+    site_line2 = 0;
+    sizes      = 0;
+    string     = NULL;
+    string2    = NULL;
+    string3    = NULL;
+    memset( sites, 0xFF, sizeof( sites ) );
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_SITES
+    t_hdg( "Call Sites" );
+
+        t_sec( "hzstr_profile_sites(), no live strings" );
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 0 );
+
+        t_sec( "hzstr_profile_sites(), hzstr_create()" );
+        string = hzstr_create( 0 ); site_line = __LINE__;
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 1 );
+        test_v_ptr( test, strstr( sites[ 0 ].file, "hzprofile_test.c" ) );
+        test_v_long( test, sites[ 0 ].line, site_line );
+        test_v_long( test, sites[ 0 ].strings, 1 );
+        test_v_long( test, sites[ 0 ].bytes, held( 32 ) );
+        test_v_long( test, sites[ 0 ].slack, chars( 31 ) );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), the caller is the call site" );
+        string = hzstr_create_cstr( "Hello World" ); site_line = __LINE__;
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 1 );
+        test_v_ptr( test, strstr( sites[ 0 ].file, "hzprofile_test.c" ) );
+        test_v_long( test, sites[ 0 ].line, site_line );
+        test_v_long( test, sites[ 0 ].slack, chars( 20 ) );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), strings from the same site" );
+        for( bucket = 0; bucket < 3; ++bucket ) {
+            string = hzstr_create( 0 ); site_line = __LINE__;
+            string2 = ( bucket == 0 ) ? string : string2;
+            string3 = ( bucket == 1 ) ? string : string3;
+        }
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 1 );
+        test_v_long( test, sites[ 0 ].line, site_line );
+        test_v_long( test, sites[ 0 ].strings, 3 );
+        test_v_long( test, sites[ 0 ].bytes, ( 3 * held( 32 ) ) );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), most slack first" );
+        string  = hzstr_create_cstr( "Hello World" ); site_line2 = __LINE__;
+        string2 = hzstr_create( 200 ); site_line = __LINE__;
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 2 );
+        test_v_long( test, sites[ 0 ].line, site_line );
+        test_v_long( test, sites[ 0 ].bytes, held( 224 ) );
+        test_v_long( test, sites[ 0 ].slack, chars( 223 ) );
+        test_v_long( test, sites[ 1 ].line, site_line2 );
+        hzstr_cpy_cstr( string2, "Hello" );
+        hzstr_minimize( string2 );
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 2 );
+        test_v_long( test, sites[ 0 ].line, site_line2 );
+        test_v_long( test, sites[ 1 ].line, site_line );
+        test_v_long( test, sites[ 1 ].slack, 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), consumed characters are slack" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_consume( string, 6 );
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 1 );
+        test_v_long( test, sites[ 0 ].slack, chars( 26 ) );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), substrings hold no slack" );
+        string  = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_substr( string, 6, 5 ); site_line = __LINE__;
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 2 );
+        test_v_long( test, sites[ 1 ].line, site_line );
+        test_v_long( test, sites[ 1 ].bytes, held( 0 ) );
+        test_v_long( test, sites[ 1 ].slack, 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), strings without a call site" );
+        string = ( hzstr_create )( 0 );
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 1 );
+        test_v_long( test, ( sites[ 0 ].file == NULL ), 1 );
+        test_v_long( test, sites[ 0 ].line, 0 );
+        test_v_long( test, sites[ 0 ].strings, 1 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), destroyed strings" );
+        string = hzstr_create( 0 );
+        hzstr_destroy( string );
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 0 );
+
+        t_sec( "hzstr_profile_sites(), failed creation" );
+        fail_callocs[ 0 ] = 1;
+        string = hzstr_create( 0 );
+        test_v_null( test, string );
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 0 );
+#endif
+
+#ifndef TNO_REPORTS
+    t_hdg( "Reports" );
+
+        t_sec( "hzstr_profile_sites(), size and age distributions" );
+        string  = hzstr_create( 0 );
+        string2 = hzstr_create( 0 );
+        string3 = hzstr_create( 1000 );
+        hzstr_cpy( string2, string3 );
+        result = hzstr_profile_sites( sites, MAX_SITES );
+        test_v_long( test, result, 3 );
+        for( found = 0; found < result; ++found ) {
+            sizes = 0;
+            ages  = 0;
+            for( bucket = 0; bucket < HZSTR_PROFILE_BUCKETS; ++bucket ) {
+                sizes += sites[ found ].sizes[ bucket ];
+                ages  += sites[ found ].ages[ bucket ];
+            }
+            test_v_long( test, sizes, sites[ found ].strings );
+            test_v_long( test, ages, sites[ found ].strings );
+        }
+        test_v_long( test, sites[ 0 ].sizes[ 0 ], 0 );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), counting the sites" );
+        string  = hzstr_create( 0 );
+        string2 = hzstr_create( 0 );
+        result = hzstr_profile_sites( NULL, 0 );
+        test_v_long( test, result, 2 );
+        result = hzstr_profile_sites( sites, 1 );
+        test_v_long( test, result, 2 );
+        test_v_long( test, sites[ 1 ].strings, ~0ul );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_sites(), invalid arguments" );
+        result = hzstr_profile_sites( NULL, 1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_profile_sites( sites, -1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_profile_tag(), no string" );
+        test_v_null( test, hzstr_profile_tag( NULL, __FILE__, __LINE__ ) );
+
+        t_sec( "hzstr_profile_dump(), every site" );
+        string  = hzstr_create( 100 );
+        string2 = ( hzstr_create )( 0 );
+        out = tmpfile();
+        result = hzstr_profile_dump( out );
+        test_v_long( test, result, 2 );
+        rewind( out );
+        while( fgets( line, LINE_SIZE, out ) != NULL ) {
+            if( strncmp( line, "live strings: 2,", 16 ) == 0 ) {
+                found |= 1;
+            }
+            else if( strstr( line, "hzprofile_test.c:" ) != NULL ) {
+                found |= 2;
+            }
+            else if( strncmp( line, "(unknown):0:", 12 ) == 0 ) {
+                found |= 4;
+            }
+            else if( strncmp( line, "  sizes (bytes):", 16 ) == 0 ) {
+                found |= 8;
+            }
+        }
+        fclose( out );
+        test_v_long( test, found, ( 1 | 2 | 4 | 8 ) );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_profile_dump(), invalid arguments" );
+        result = hzstr_profile_dump( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
@@ -0,0 +1,393 @@
+/*****************************************************************************
+    hzsort_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Each sort is checked against qsort() of the same strings, using a
+        comparison that breaks ties by the strings' original order.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+#include "test_strings.h"
+
+#include "hzsort.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define MAX_STRINGS ( 100000 )
+#define BUFFER_SIZE ( 65536 )
+
+//add random strings (mostly letters, with a few bytes of any value)
+#define add_random( _t, _p, _l ) test_strings_add( \
+    strings, &count, ( _t ), ( _p ), ( _l ), "aAbBcC", 16 \
+)
+
+//define symbols to disable the corresponding test section
+//#define TNO_SORT
+//#define TNO_VARIANTS
+//#define TNO_PARALLEL
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+typedef struct expect_s {           //string in the expected order
+    hzstr_type*         string;     //the string
+    int                 index;      //original position of the string
+} expect_type;
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const char*      words[] = {
+    "banana", "", "apple", "Apple", "apples", "b", "\xc3\xa9t\xc3\xa9",
+    "APPLE", "ban", "banana", "a", "z", "Zebra", "\x7f", "\x80", "apple"
+};
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+char                    buffer[ BUFFER_SIZE ];
+int                     count;
+expect_type             expected[ MAX_STRINGS ];
+int                     expect_flags;
+int                     index0;
+int                     mismatches;
+hzstr_type*             originals[ MAX_STRINGS ];
+hzstr_result_t          result;
+hzstr_type*             strings[ MAX_STRINGS ];
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static int check_sort(              //sort the test set and check it
+    int                 flags       //sort behavior flags
+);                                  //number of strings out of order
+
+static int compare_expect(          //order two strings for qsort()
+    const void*         expect0,    //first string
+    const void*         expect1     //second string
+);                                  //comparison value (0 means equal)
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    count        = 0;
+    expect_flags = 0;
+    index0       = 0;
+    mismatches   = 0;
+    result       = 0;
+    test_strings_seed( 1 );
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_SORT
+    t_hdg( "Sorting" );
+
+        t_sec( "hzstr_sort(), short words" );
+        for( index0 = 0; index0 < 16; ++index0 ) {
+            strings[ count++ ] = hzstr_create_cstr( words[ index0 ] );
+        }
+        test_v_long( test, check_sort( 0 ), 0 );
+        test_v_long( test, strings[ 0 ]->length, 0 );
+        test_v_long( test, strings[ 15 ]->length, 1 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), random strings" );
+        add_random( 20000, 0, 12 );
+        test_v_long( test, check_sort( 0 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), long shared prefixes" );
+        add_random( 5000, 40, 30 );
+        test_v_long( test, check_sort( 0 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), equal long strings" );
+        memset( buffer, 'x', 60000 );
+        for( index0 = 0; index0 < 200; ++index0 ) {
+            strings[ count++ ] = hzstr_create_cstr_n(
+                buffer, ( 59990 + ( index0 % 10 ) )
+            );
+        }
+        test_v_long( test, check_sort( 0 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), embedded null characters" );
+        strings[ count++ ] = hzstr_create_cstr_n( "ab\0", 3 );
+        strings[ count++ ] = hzstr_create_cstr_n( "ab", 2 );
+        strings[ count++ ] = hzstr_create_cstr_n( "a\0b", 3 );
+        strings[ count++ ] = hzstr_create_cstr_n( "a", 1 );
+        test_v_long( test, check_sort( 0 ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), nothing to sort" );
+        result = hzstr_sort( NULL, 0, 0 );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        strings[ 0 ] = NULL;
+        result = hzstr_sort( strings, 1, 0 );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+
+        t_sec( "hzstr_sort(), failed allocation" );
+        add_random( 100, 0, 12 );
+        memcpy( originals, strings, ( count * sizeof( hzstr_type* ) ) );
+        fail_mallocs[ fail_malloc ] = 1;
+        result = hzstr_sort( strings, count, 0 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_mem(
+            test, strings, originals, ( count * sizeof( hzstr_type* ) )
+        );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), invalid usage" );
+        result = hzstr_sort( NULL, 2, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_sort( strings, -1, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        strings[ 0 ] = hzstr_create_cstr( "b" );
+        strings[ 1 ] = NULL;
+        strings[ 2 ] = hzstr_create_cstr( "a" );
+        result = hzstr_sort( strings, 3, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        test_v_long( test, strings[ 0 ]->data[ 0 ], 'b' );
+        hzstr_destroy( strings[ 0 ] );
+        hzstr_destroy( strings[ 2 ] );
+#endif
+
+#ifndef TNO_VARIANTS
+    t_hdg( "Sort Variants" );
+
+        t_sec( "hzstr_sort(), stable" );
+        add_random( 20000, 0, 3 );
+        add_random( 100, 20, 3 );
+        test_v_long( test, check_sort( HZSTR_SORT_STABLE ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), case-insensitive" );
+        for( index0 = 0; index0 < 16; ++index0 ) {
+            strings[ count++ ] = hzstr_create_cstr( words[ index0 ] );
+        }
+        test_v_long( test, check_sort( HZSTR_SORT_NOCASE ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), stable and case-insensitive" );
+        add_random( 20000, 0, 4 );
+        test_v_long(
+            test, check_sort( HZSTR_SORT_STABLE | HZSTR_SORT_NOCASE ), 0
+        );
+        test_strings_destroy( strings, &count );
+#endif
+
+#ifndef TNO_PARALLEL
+    t_hdg( "Parallel Sorting" );
+
+        t_sec( "hzstr_sort(), parallel" );
+        add_random( MAX_STRINGS, 0, 10 );
+        test_v_long( test, check_sort( HZSTR_SORT_PARALLEL ), 0 );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), parallel and stable" );
+        add_random( MAX_STRINGS, 0, 4 );
+        test_v_long(
+            test, check_sort( HZSTR_SORT_PARALLEL | HZSTR_SORT_STABLE ), 0
+        );
+        test_strings_destroy( strings, &count );
+
+        t_sec( "hzstr_sort(), parallel without a job" );
+        add_random( MAX_STRINGS, 0, 6 );
+        fail_callocs[ fail_calloc ] = 1;
+        test_v_long( test, check_sort( HZSTR_SORT_PARALLEL ), 0 );
+        test_strings_destroy( strings, &count );
+#endif
+
+    return 0;
+}
+
+
+
+/*==========================================================================*/
+static int check_sort(              //sort the test set and check it
+    int                 flags       //sort behavior flags
+) {                                 //number of strings out of order
+
+    //local variables
+    expect_type         actual;     //string in the sorted order
+    int                 index;      //string index
+    int                 wrong;      //number of strings out of order
+
+    //find the expected order
+    for( index = 0; index < count; ++index ) {
+        expected[ index ].string = strings[ index ];
+        expected[ index ].index  = index;
+    }
+    expect_flags = flags;
+    qsort( expected, count, sizeof( expect_type ), compare_expect );
+
+    //stable sorts give the same order, and other sorts give equal strings
+    actual.index = 0;
+    result = hzstr_sort( strings, count, flags );
+    if( result != HZSTR_RSLT_OK ) {
+        return count;
+    }
+    wrong = 0;
+    for( index = 0; index < count; ++index ) {
+        if( ( flags & HZSTR_SORT_STABLE ) != 0 ) {
+            wrong += ( strings[ index ] != expected[ index ].string );
+        }
+        else {
+            actual.string = strings[ index ];
+            wrong += ( compare_expect( &actual, &expected[ index ] ) != 0 );
+        }
+    }
+    return wrong;
+}
+
+
+/*==========================================================================*/
+static int compare_expect(          //order two strings for qsort()
+    const void*         expect0,    //first string
+    const void*         expect1     //second string
+) {                                 //comparison value (0 means equal)
+
+    //local variables
+    hzstr_char_t        char0;      //character of the first string
+    hzstr_char_t        char1;      //character of the second string
+    const expect_type*  first;      //first string
+    long                order;      //comparison of the characters
+    hzstr_index_t       pos;        //position index
+    const expect_type*  second;     //second string
+
+    //compare the strings the way hzstr_cmp() does
+    first  = expect0;
+    second = expect1;
+    order  = ( long ) first->string->length - ( long ) second->string->length;
+    for( pos = 0;
+         ( pos < first->string->length ) && ( pos < second->string->length );
+         ++pos ) {
+        char0 = first->string->data[ pos ];
+        char1 = second->string->data[ pos ];
+        if( ( expect_flags & HZSTR_SORT_NOCASE ) != 0 ) {
+            char0 += ( ( char0 >= 'A' ) && ( char0 <= 'Z' ) ) * 32;
+            char1 += ( ( char1 >= 'A' ) && ( char1 <= 'Z' ) ) * 32;
+        }
+        if( char0 != char1 ) {
+            order = ( long ) char0 - ( long ) char1;
+            break;
+        }
+    }
+    if( ( order == 0 ) && ( ( expect_flags & HZSTR_SORT_STABLE ) != 0 ) ) {
+        return first->index - second->index;
+    }
+    return ( order > 0 ) - ( order < 0 );
+}
+
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
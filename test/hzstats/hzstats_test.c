@@ -0,0 +1,313 @@
+/*****************************************************************************
+    hzstats_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Tests the statistics counted when the string module is built with
+        HZSTR_STATS.  Each check starts from a reset, so the expected
+        values are the counts of that check alone.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+
+//define symbols to disable the corresponding test section
+//#define TNO_CALLS
+//#define TNO_MEMORY
+//#define TNO_THREADS
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+int                     position;
+hzstr_result_t          result;
+hzstr_stats_type        stats;
+hzstr_type*             string;
+hzstr_type*             string2;
+pthread_t               thread;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static void* append_thread(         //append characters in another thread
+    void*               argument    //string to append to
+);                                  //NULL
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    position = 0;
+    result   = 0;
+    string   = NULL;
+    string2  = NULL;
+    memset( &stats, 0xFF, sizeof( stats ) );
+    hzstr_stats_reset();
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_CALLS
+    t_hdg( "Call Statistics" );
+
+        t_sec( "hzstr_stats_snapshot(), nothing counted" );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CREATE ], 0 );
+        test_v_long( test, stats.moved[ HZSTR_STAT_CPY ], 0 );
+        test_v_long( test, stats.grows, 0 );
+        test_v_long( test, stats.requested, 0 );
+        test_v_long( test, stats.allocated, 0 );
+        test_v_long( test, stats.minimized, 0 );
+
+        t_sec( "hzstr_stats_snapshot(), calls and bytes moved" );
+        string  = hzstr_create( 0 );
+        string2 = hzstr_create( 0 );
+        hzstr_cpy_cstr( string2, "Hello World" );
+        hzstr_cpy( string, string2 );
+        hzstr_cat( string, string2 );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CREATE ], 2 );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CPY ], 1 );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CAT ], 1 );
+        test_v_long( test, stats.moved[ HZSTR_STAT_CPY ], 11 );
+        test_v_long( test, stats.moved[ HZSTR_STAT_CAT ], 11 );
+        test_v_long( test, stats.calls[ HZSTR_STAT_DESTROY ], 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_stats_snapshot(), calls between library functions" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CREATE_CSTR ], 1 );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CREATE_CSTR_N ], 1 );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CREATE ], 1 );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CPY_CSTR_N ], 1 );
+        test_v_long( test, stats.moved[ HZSTR_STAT_CPY_CSTR_N ], 11 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_stats_snapshot(), every append is counted" );
+        string = hzstr_create( 0 );
+        for( position = 0; position < 10; ++position ) {
+            hzstr_append( string, 'a' );
+        }
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_APPEND ], 10 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_stats_reset()" );
+        string = hzstr_create( 0 );
+        hzstr_stats_reset();
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_CREATE ], 0 );
+        test_v_long( test, stats.requested, 0 );
+        hzstr_destroy( string );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_DESTROY ], 1 );
+#endif
+
+#ifndef TNO_MEMORY
+    t_hdg( "Memory Statistics" );
+
+        t_sec( "hzstr_stats_snapshot(), bytes requested and allocated" );
+        string = hzstr_create( 40 );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.requested, 41 );
+        test_v_long( test, stats.allocated, 64 );
+        test_v_long( test, stats.grows, 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_stats_snapshot(), growing a string" );
+        string = hzstr_create( 0 );
+        hzstr_cpy_cstr( string, "0123456789012345678901234567890123456789" );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.grows, 1 );
+        test_v_long( test, stats.requested, ( 1 + 41 ) );
+        test_v_long( test, stats.allocated, ( 32 + 64 ) );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_stats_snapshot(), failed allocations" );
+        string = hzstr_create( 0 );
+        fail_reallocs[ 0 ] = 1;
+        result = hzstr_cpy_cstr(
+            string, "0123456789012345678901234567890123456789"
+        );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.grows, 0 );
+        test_v_long( test, stats.allocated, 32 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_stats_snapshot(), bytes released by hzstr_minimize()" );
+        string = hzstr_create( 100 );
+        hzstr_cpy_cstr( string, "Hello" );
+        result = hzstr_minimize( string );
+        test_v_long( test, result, 6 );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.minimized, ( 128 - 6 ) );
+        test_v_long( test, stats.calls[ HZSTR_STAT_MINIMIZE ], 1 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_THREADS
+    t_hdg( "Thread Statistics" );
+
+        t_sec( "hzstr_stats_snapshot(), counts of other threads" );
+        string = hzstr_create( 0 );
+        string2 = hzstr_create( 0 );
+        hzstr_append( string, 'a' );
+        pthread_create( &thread, NULL, append_thread, string2 );
+        pthread_join( thread, NULL );
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_APPEND ], 101 );
+        test_v_long( test, stats.grows, 3 );
+        test_v_long( test, hzstr_length( string2 ), 100 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_stats_reset(), counts of other threads" );
+        string = hzstr_create( 0 );
+        pthread_create( &thread, NULL, append_thread, string );
+        pthread_join( thread, NULL );
+        hzstr_stats_reset();
+        hzstr_stats_snapshot( &stats );
+        test_v_long( test, stats.calls[ HZSTR_STAT_APPEND ], 0 );
+        hzstr_destroy( string );
+#endif
+
+    return 0;
+}
+
+
+/*==========================================================================*/
+static void* append_thread(         //append characters in another thread
+    void*               argument    //string to append to
+) {                                 //NULL
+
+    //local variables
+    int                 count;      //number of characters appended
+
+    for( count = 0; count < 100; ++count ) {
+        hzstr_append( argument, 'b' );
+    }
+    return NULL;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
@@ -23,6 +23,11 @@ Macros
 ----------------------------------------------------------------------------*/
 
 #define MAX_ALLOCS ( 8 )
+#define BUFFER_SIZE ( 70000 )       //larger than the longest possible string
+
+//encoding flags of a string
+#define encoding( _s ) ( ( _s )->flags & ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 ) )
+#define ASCII ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 )
 
 //define symbols to disable the corresponding test section
 //#define TNO_APPEND
@@ -31,10 +36,17 @@ Macros
 //#define TNO_CAT
 //#define TNO_CPY
 //#define TNO_CMP
+//#define TNO_CONSUME
 //#define TNO_DESTROY
+//#define TNO_EDIT
+//#define TNO_ENCODING
+//#define TNO_HASH
 //#define TNO_IMPORT
 //#define TNO_MINIMIZE
+//#define TNO_RESERVE
+//#define TNO_SHRINK
 //#define TNO_SPRINTF
+//#define TNO_SQUEEZE
 //#define TNO_STRCHR
 //#define TNO_TOCASE
 //#define TNO_TRIM
@@ -47,6 +59,10 @@ Types and Structures
 Memory Constants
 ----------------------------------------------------------------------------*/
 
+static const hzstr_type constant = HZSTR_LITERAL( "Hello World" );
+static const hzstr_type lower = HZSTR_LITERAL( "already lowercase text here" );
+static const hzstr_type upper = HZSTR_LITERAL( "ALREADY UPPERCASE TEXT HERE" );
+
 /*----------------------------------------------------------------------------
 Module Variables
 ----------------------------------------------------------------------------*/
@@ -58,12 +74,18 @@ unsigned char           fail_mallocs[ MAX_ALLOCS ];
 unsigned char           fail_realloc;
 unsigned char           fail_reallocs[ MAX_ALLOCS ];
 
+int                     align;
+char                    buffer[ BUFFER_SIZE ];
 long                    comp;
+int                     mismatches;
 hzstr_index_t           strindex;
 hzstr_result_t          result;
 hzstr_type*             string;
 hzstr_type*             string2;
+hzstr_type*             string3;
+hzstr_type*             strings[ 4 ];
 hzstr_type*             substring;
+hzstr_type              writable = HZSTR_LITERAL( "caf\xC3\xA9" );
 
 /*----------------------------------------------------------------------------
 Module Prototypes
@@ -85,12 +107,17 @@ void reset_test(
     memset( fail_mallocs,  0, MAX_ALLOCS );
     memset( fail_reallocs, 0, MAX_ALLOCS );
 
-    comp      = 0;
-    strindex  = 0;
-    result    = 0;
-    string    = NULL;
-    string2   = NULL;
-    substring = NULL;
+    align      = 0;
+    comp       = 0;
+    mismatches = 0;
+    strindex   = 0;
+    result     = 0;
+    string     = NULL;
+    string2    = NULL;
+    string3    = NULL;
+    substring  = NULL;
+    memset( strings, 0, sizeof( strings ) );
+    hzstr_shrink_policy( HZSTR_SHRINK_FACTOR, HZSTR_SHRINK_MINIMUM );
 }
 
 
@@ -124,6 +151,36 @@ int run_test(                       //run the unit test
         result = hzstr_append( string, 'W' );
         test_v_long( test, result, HZSTR_RSLT_ALLOC );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_append(), inline and library paths agree" );
+        string  = hzstr_create( 0 );
+        string2 = hzstr_create( 0 );
+        for( strindex = 0; strindex < 100; ++strindex ) {
+            if( hzstr_append( string, ( 'a' + ( strindex % 26 ) ) )
+             != ( hzstr_append )( string2, ( 'a' + ( strindex % 26 ) ) ) ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        test_v_long( test, hzstr_cmp( string, string2 ), 0 );
+        test_v_long( test, string->alloc, string2->alloc );
+        test_v_long( test, fail_realloc, 6 );
+        test_v_long( test, hzstr_available( string ), 27 );
+        hzstr_append( string, '\xC3' );
+        test_v_long( test, encoding( string ), 0 );
+        test_v_long( test, hzstr_data( string )[ 101 ], 0 );
+        hzstr_destroy( string );
+        hzstr_destroy( string2 );
+
+        t_sec( "hzstr_available()" );
+        string = hzstr_create_cstr( "Hello" );
+        test_v_long( test, hzstr_available( string ), 26 );
+        hzstr_consume( string, 2 );
+        test_v_long( test, hzstr_available( string ), 26 );
+        hzstr_destroy( string );
+        string = hzstr_create_ccstr( "Hello" );
+        test_v_long( test, hzstr_available( string ), 0 );
+        hzstr_destroy( string );
 #endif
 
 #ifndef TNO_CREATE
@@ -174,6 +231,42 @@ int run_test(                       //run the unit test
         string = hzstr_create_cstr( "Hello World" );
         test_v_null( test, string );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_create_cstr(), every alignment and short length" );
+        for( align = 0; align < 16; ++align ) {
+            for( strindex = 0; strindex < 48; ++strindex ) {
+                memset( buffer, 'x', 80 );
+                buffer[ align + strindex ] = '\0';
+                string = hzstr_create_cstr( ( buffer + align ) );
+                if( hzstr_length( string ) != strindex ) {
+                    mismatches += 1;
+                }
+                hzstr_destroy( string );
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_create_cstr(), C string too long" );
+        memset( buffer, 'x', ( BUFFER_SIZE - 1 ) );
+        buffer[ BUFFER_SIZE - 1 ] = '\0';
+        string = hzstr_create_cstr( buffer );
+        test_v_null( test, string );
+        string = hzstr_create_ccstr( buffer );
+        test_v_null( test, string );
+
+        t_sec( "hzstr_create_cstr_n(), known length" );
+        string = hzstr_create_cstr_n( "Hello World", 5 );
+        test_v_ptr( test, string );
+        test_v_long( test, hzstr_length( string ), 5 );
+        test_v_long( test, string->alloc, HZSTR_CHUNK_SIZE );
+        test_v_str( test, hzstr_cstr( string ), "Hello" );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_create_cstr_n(), failed object allocation" );
+        fail_callocs[ 0 ] = 1;
+        string = hzstr_create_cstr_n( "Hello World", 5 );
+        test_v_null( test, string );
 #endif
 
 #ifndef TNO_CREATE_SUBSTR
@@ -233,6 +326,19 @@ int run_test(                       //run the unit test
         hzstr_destroy( string2 );
         hzstr_destroy( string );
 
+        t_sec( "hzstr_cat(), in place and growing" );
+        string = hzstr_create_cstr( "Hello " );
+        result = hzstr_cat( string, string );
+        test_v_long( test, result, 12 );
+        test_v_long( test, fail_realloc, 0 );
+        result = hzstr_cat( string, string );
+        test_v_long( test, result, 24 );
+        result = hzstr_cat( string, string );
+        test_v_long( test, result, 48 );
+        test_v_long( test, fail_realloc, 1 );
+        test_v_str( test, ( hzstr_cstr( string ) + 36 ), "Hello Hello " );
+        hzstr_destroy( string );
+
         t_sec( "hzstr_cat(), invalid target string" );
         string = hzstr_create_ccstr( "Hello " );
         string2 = hzstr_create_cstr( "World" );
@@ -277,6 +383,32 @@ int run_test(                       //run the unit test
         result = hzstr_cat_cstr( string, "World World World World World World" );
         test_v_long( test, result, HZSTR_RSLT_ALLOC );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_cat_cstr(), C string too long" );
+        string = hzstr_create_cstr( "Hello " );
+        memset( buffer, 'x', 65529 );
+        buffer[ 65529 ] = '\0';
+        result = hzstr_cat_cstr( string, buffer );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        test_v_str( test, hzstr_cstr( string ), "Hello " );
+        buffer[ 65528 ] = '\0';
+        result = hzstr_cat_cstr( string, buffer );
+        test_v_long( test, result, 65534 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cat_cstr_n()" );
+        string = hzstr_create_cstr( "Hello " );
+        result = hzstr_cat_cstr_n( string, "World Wide Web", 5 );
+        test_v_long( test, result, 11 );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cat_cstr_n(), invalid target string" );
+        string = hzstr_create_ccstr( "Hello " );
+        result = hzstr_cat_cstr_n( string, "World", 5 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
 #endif
 
 #ifndef TNO_CPY
@@ -332,6 +464,29 @@ int run_test(                       //run the unit test
         );
         test_v_long( test, result, HZSTR_RSLT_ALLOC );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr(), C string too long" );
+        string = hzstr_create_cstr( "Hello" );
+        memset( buffer, 'x', ( BUFFER_SIZE - 1 ) );
+        buffer[ BUFFER_SIZE - 1 ] = '\0';
+        result = hzstr_cpy_cstr( string, buffer );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        test_v_str( test, hzstr_cstr( string ), "Hello" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr_n()" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_cpy_cstr_n( string, "Good\0bye", 8 );
+        test_v_long( test, result, 8 );
+        test_v_mem( test, hzstr_cstr( string ), "Good\0bye", 9 );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr_n(), invalid target string" );
+        string = hzstr_create_ccstr( "Constant" );
+        result = hzstr_cpy_cstr_n( string, "Hello World", 11 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
 #endif
 
 #ifndef TNO_CMP
@@ -352,6 +507,184 @@ int run_test(                       //run the unit test
         test_v_long( test, comp, ( 'W' - 'E' ) );
         hzstr_destroy( string2 );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_cmp(), long strings" );
+        string = hzstr_create_cstr( "The quick brown fox jumps over the dog" );
+        string2 = hzstr_create_cstr( "The quick brown fox jumps over the cat" );
+        comp = hzstr_cmp( string, string2 );
+        test_v_long( test, comp, ( 'd' - 'c' ) );
+        comp = hzstr_cmp( string, string );
+        test_v_long( test, comp, 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cmp(), prefix" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_substr( string, 0, 5 );
+        comp = hzstr_cmp( string2, string );
+        test_v_long( test, comp, -6 );
+        comp = hzstr_cmp( string, string2 );
+        test_v_long( test, comp, 6 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_casecmp(), same strings" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "hELLO wORLD" );
+        comp = hzstr_casecmp( string, string2 );
+        test_v_long( test, comp, 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_casecmp(), different strings" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "HELLO EARTH" );
+        comp = hzstr_casecmp( string, string2 );
+        test_v_long( test, comp, ( 'w' - 'e' ) );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_casecmp(), UTF-8 strings" );
+        string = hzstr_create_cstr(
+            "\xCE\xA3\xCE\xB9\xCF\x83\xCF\x85\xCF\x86\xCE\xBF\xCF\x82"
+        );
+        string2 = hzstr_create_cstr(
+            "\xCE\xA3\xCE\x99\xCE\xA3\xCE\xA5\xCE\xA6\xCE\x9F\xCE\xA3"
+        );
+        comp = hzstr_casecmp( string, string2 );
+        test_v_long( test, comp, 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_CONSUME
+    t_hdg( "String Consume" );
+
+        t_sec( "hzstr_consume()" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_consume( string, 6 );
+        test_v_long( test, result, 5 );
+        test_v_str( test, hzstr_cstr( string ), "World" );
+        test_v_long( test, string->offset, 6 );
+        test_v_long( test, string->alloc, 32 );
+        result = hzstr_consume( string, 0 );
+        test_v_long( test, result, 5 );
+        test_v_long( test, string->offset, 6 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), entire string" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_consume( string, 11 );
+        test_v_long( test, result, 0 );
+        test_v_long( test, string->offset, 0 );
+        test_v_str( test, hzstr_cstr( string ), "" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), growth keeps a small prefix" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_consume( string, 3 );
+        result = hzstr_cat_cstr( string, "!!" );
+        test_v_long( test, result, 10 );
+        test_v_long( test, string->offset, 3 );
+        test_v_long( test, string->alloc, 32 );
+        result = hzstr_cat_cstr( string, "0123456789012345678901234567890" );
+        test_v_long( test, result, 41 );
+        test_v_long( test, string->offset, 3 );
+        test_v_long( test, string->alloc, 64 );
+        test_v_str(
+            test,
+            hzstr_cstr( string ),
+            "lo World!!0123456789012345678901234567890"
+        );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), growth reclaims a large prefix" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_consume( string, 8 );
+        result = hzstr_cat_cstr( string, "0123456789012345678901234" );
+        test_v_long( test, result, 28 );
+        test_v_long( test, string->offset, 0 );
+        test_v_long( test, string->alloc, 32 );
+        test_v_str( test, hzstr_cstr( string ), "rld0123456789012345678901234" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), copy and minimize reclaim the prefix" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "Hello" );
+        hzstr_consume( string, 6 );
+        result = hzstr_cpy( string, string2 );
+        test_v_long( test, result, 5 );
+        test_v_long( test, string->offset, 0 );
+        test_v_str( test, hzstr_cstr( string ), "Hello" );
+        hzstr_consume( string, 2 );
+        result = hzstr_minimize( string );
+        test_v_long( test, result, 4 );
+        test_v_long( test, string->offset, 0 );
+        test_v_str( test, hzstr_cstr( string ), "llo" );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), copy of itself" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_consume( string, 6 );
+        result = hzstr_cpy( string, string );
+        test_v_long( test, result, 5 );
+        test_v_long( test, string->offset, 0 );
+        test_v_str( test, hzstr_cstr( string ), "World" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), copy of a view of itself" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_consume( string, 6 );
+        string2 = hzstr_create_substr( string, 1, 3 );
+        result = hzstr_cpy( string, string2 );
+        test_v_long( test, result, 3 );
+        test_v_str( test, hzstr_cstr( string ), "orl" );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), copy of its own C-string" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_consume( string, 6 );
+        result = hzstr_cpy_cstr( string, ( hzstr_cstr( string ) + 1 ) );
+        test_v_long( test, result, 4 );
+        test_v_str( test, hzstr_cstr( string ), "orld" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), failed copy keeps the string" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "0123456789012345678901234567890123" );
+        hzstr_consume( string, 3 );
+        fail_reallocs[ fail_realloc ] = 1;
+        result = hzstr_cpy( string, string2 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_long( test, string->offset, 3 );
+        test_v_str( test, hzstr_cstr( string ), "lo World" );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), invalid usage" );
+        result = hzstr_consume( NULL, 1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        string = hzstr_create_cstr( "Hello" );
+        result = hzstr_consume( string, 6 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        test_v_str( test, hzstr_cstr( string ), "Hello" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), invalid target string" );
+        string = hzstr_create_ccstr( "Hello" );
+        result = hzstr_consume( string, 1 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_erase(), from the front" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_erase( string, 0, 6 );
+        test_v_long( test, result, 5 );
+        test_v_long( test, string->offset, 6 );
+        test_v_str( test, hzstr_cstr( string ), "World" );
+        hzstr_destroy( string );
 #endif
 
 #ifndef TNO_DESTROY
@@ -365,6 +698,465 @@ int run_test(                       //run the unit test
         hzstr_destroy( string );
 #endif
 
+#ifndef TNO_EDIT
+    t_hdg( "String Editing" );
+
+        t_sec( "hzstr_insert()" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "Big " );
+        result = hzstr_insert( string, 6, string2 );
+        test_v_long( test, result, 15 );
+        test_v_str( test, hzstr_cstr( string ), "Hello Big World" );
+        result = hzstr_insert( string, 0, string2 );
+        test_v_str( test, hzstr_cstr( string ), "Big Hello Big World" );
+        result = hzstr_insert( string, hzstr_length( string ), string2 );
+        test_v_str( test, hzstr_cstr( string ), "Big Hello Big WorldBig " );
+        test_v_long( test, hzstr_length( string ), 23 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_insert(), invalid usage" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_insert( string, 0, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_insert( NULL, 0, string );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        substring = hzstr_create_substr( string, 0, 5 );
+        result = hzstr_insert( string, 0, substring );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_destroy( substring );
+        string2 = hzstr_create_cstr( "Big " );
+        result = hzstr_insert( string, 12, string2 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_insert( string, -1, string2 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_insert(), invalid target string" );
+        string = hzstr_create_ccstr( "Hello World" );
+        string2 = hzstr_create_cstr( "Big " );
+        result = hzstr_insert( string, 6, string2 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_insert(), failed reallocation" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "World World World World World" );
+        fail_reallocs[ 0 ] = 1;
+        result = hzstr_insert( string, 6, string2 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_erase()" );
+        string = hzstr_create_cstr( "Hello Big World" );
+        result = hzstr_erase( string, 6, 4 );
+        test_v_long( test, result, 11 );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        result = hzstr_erase( string, 0, 6 );
+        test_v_str( test, hzstr_cstr( string ), "World" );
+        result = hzstr_erase( string, 3, 2 );
+        test_v_str( test, hzstr_cstr( string ), "Wor" );
+        result = hzstr_erase( string, 0, 3 );
+        test_v_long( test, result, 0 );
+        test_v_str( test, hzstr_cstr( string ), "" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_erase(), invalid usage" );
+        result = hzstr_erase( NULL, 0, 1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_erase( string, 6, 6 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_erase(), invalid target string" );
+        string = hzstr_create_ccstr( "Hello World" );
+        result = hzstr_erase( string, 0, 6 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_splice()" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "Earth" );
+        result = hzstr_splice( string, 6, 5, string2 );
+        test_v_long( test, result, 11 );
+        test_v_str( test, hzstr_cstr( string ), "Hello Earth" );
+        string3 = hzstr_create_cstr( "Goodbye" );
+        result = hzstr_splice( string, 0, 5, string3 );
+        test_v_long( test, result, 13 );
+        test_v_str( test, hzstr_cstr( string ), "Goodbye Earth" );
+        result = hzstr_splice( string, 0, 8, string2 );
+        test_v_str( test, hzstr_cstr( string ), "EarthEarth" );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_splice(), invalid usage" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_splice( string, 0, 5, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_splice( NULL, 0, 5, string );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        substring = hzstr_create_substr( string, 6, 5 );
+        result = hzstr_splice( string, 0, 5, substring );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_destroy( substring );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_splice(), maximum length" );
+        string = hzstr_create( 0 );
+        string2 = hzstr_create( 40000 );
+        memset( string2->data, 'x', 40000 );
+        string2->length = 40000;
+        string2->data[ 40000 ] = 0;
+        result = hzstr_splice( string, 0, 0, string2 );
+        test_v_long( test, result, 40000 );
+        result = hzstr_splice( string, 0, 0, string2 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        test_v_long( test, hzstr_length( string ), 40000 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), growing" );
+        string = hzstr_create_cstr( "a-b-c-d" );
+        string2 = hzstr_create_cstr( "-" );
+        string3 = hzstr_create_cstr( " -- " );
+        result = hzstr_replace_all( string, string2, string3 );
+        test_v_long( test, result, 16 );
+        test_v_str( test, hzstr_cstr( string ), "a -- b -- c -- d" );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), shrinking" );
+        string = hzstr_create_cstr( "one, two, three, " );
+        string2 = hzstr_create_cstr( ", " );
+        string3 = hzstr_create_cstr( ";" );
+        result = hzstr_replace_all( string, string2, string3 );
+        test_v_long( test, result, 14 );
+        test_v_str( test, hzstr_cstr( string ), "one;two;three;" );
+        hzstr_destroy( string3 );
+        string3 = hzstr_create_cstr( "" );
+        string2->data[ 0 ] = ';';
+        string2->data[ 1 ] = 0;
+        string2->length = 1;
+        result = hzstr_replace_all( string, string2, string3 );
+        test_v_long( test, result, 11 );
+        test_v_str( test, hzstr_cstr( string ), "onetwothree" );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), no instances" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "Earth" );
+        result = hzstr_replace_all( string, string2, string2 );
+        test_v_long( test, result, 11 );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), invalid usage" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "" );
+        string3 = hzstr_create_cstr( "x" );
+        result = hzstr_replace_all( string, string2, string3 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_replace_all( string, NULL, string3 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        substring = hzstr_create_substr( string, 0, 1 );
+        result = hzstr_replace_all( string, string3, substring );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_destroy( substring );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), invalid target string" );
+        string = hzstr_create_ccstr( "Hello World" );
+        string2 = hzstr_create_cstr( "o" );
+        result = hzstr_replace_all( string, string2, string2 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), failed allocation" );
+        string = hzstr_create_cstr( "Hello World" );
+        string2 = hzstr_create_cstr( "o" );
+        string3 = hzstr_create_cstr( "ooooooooooooooooooooooooo" );
+        fail_mallocs[ 3 ] = 1;
+        result = hzstr_replace_all( string, string2, string3 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), maximum length" );
+        string = hzstr_create( 40000 );
+        memset( string->data, 'x', 40000 );
+        string->length = 40000;
+        string->data[ 40000 ] = 0;
+        string2 = hzstr_create_cstr( "x" );
+        string3 = hzstr_create_cstr( "xx" );
+        result = hzstr_replace_all( string, string2, string3 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_ENCODING
+    t_hdg( "String Encoding" );
+
+        t_sec( "hzstr_create(), empty strings are ASCII" );
+        string = hzstr_create( 0 );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_create_cstr(), encoding of new characters" );
+        string = hzstr_create_cstr( "Hello" );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_destroy( string );
+        string = hzstr_create_cstr( "caf\xC3\xA9" );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_destroy( string );
+        string = hzstr_create_cstr( "caf\xE9" );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_create_ccstr(), encoding is unknown" );
+        string = hzstr_create_ccstr( "Hello" );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_append(), encoding" );
+        string = hzstr_create( 0 );
+        hzstr_append( string, 'x' );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_append( string, '\xC3' );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cat(), encoding known about both strings" );
+        string  = hzstr_create_cstr( "Hello " );
+        string2 = hzstr_create_cstr( "\xE2\x82\xAC" );
+        hzstr_cat( string, string2 );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_destroy( string2 );
+        string2 = hzstr_create_ccstr( "World" );
+        hzstr_cat( string, string2 );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cat_cstr(), encoding of new characters" );
+        string = hzstr_create_cstr( "Hello " );
+        hzstr_cat_cstr( string, "\xE2\x82\xAC" );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_cat_cstr( string, "\xAC" );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy(), encoding of source" );
+        string  = hzstr_create_cstr( "Hello" );
+        string2 = hzstr_create_ccstr( "World" );
+        hzstr_cpy( string, string2 );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string2 );
+        string2 = hzstr_create_cstr( "World" );
+        hzstr_cpy( string, string2 );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_create_substr(), splitting a sequence" );
+        string = hzstr_create_cstr( "caf\xC3\xA9!" );
+        substring = hzstr_create_substr( string, 0, 5 );
+        test_v_long( test, encoding( substring ), HZSTR_FLG_UTF8 );
+        hzstr_destroy( substring );
+        substring = hzstr_create_substr( string, 0, 4 );
+        test_v_long( test, encoding( substring ), 0 );
+        hzstr_destroy( substring );
+        substring = hzstr_create_substr( string, 4, 2 );
+        test_v_long( test, encoding( substring ), 0 );
+        hzstr_destroy( substring );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_insert(), on and between sequences" );
+        string  = hzstr_create_cstr( "caf\xC3\xA9" );
+        string2 = hzstr_create_cstr( "e" );
+        hzstr_insert( string, 3, string2 );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_insert( string, 5, string2 );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_erase(), on and between sequences" );
+        string = hzstr_create_cstr( "caf\xC3\xA9s" );
+        hzstr_erase( string, 3, 2 );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_cpy_cstr( string, "caf\xC3\xA9s" );
+        hzstr_erase( string, 4, 1 );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_consume(), on and between sequences" );
+        string = hzstr_create_cstr( "\xC3\xA9t\xC3\xA9" );
+        hzstr_consume( string, 2 );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_consume( string, 2 );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_replace_all(), encoding" );
+        string  = hzstr_create_cstr( "a\xC3\xA9" "a" );
+        string2 = hzstr_create_cstr( "a" );
+        string3 = hzstr_create_cstr( "\xE2\x82\xAC" );
+        hzstr_replace_all( string, string2, string3 );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_destroy( string2 );
+        string2 = hzstr_create_ccstr( "b" );
+        hzstr_replace_all( string, string3, string2 );
+        test_v_long( test, encoding( string ), 0 );
+        test_v_str( test, hzstr_cstr( string ), "b\xC3\xA9" "b" );
+        hzstr_destroy( string3 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_sprintf(), encoding of printed characters" );
+        string = hzstr_create( 0 );
+        hzstr_sprintf( string, "%s %d", "caf\xC3\xA9", 42 );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_sprintf( string, "%d", 42 );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_validate()" );
+        string = hzstr_create_ccstr( "caf\xC3\xA9" );
+        result = hzstr_validate( string );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_destroy( string );
+        string = hzstr_create_ccstr( "Hello" );
+        result = hzstr_validate( string );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_validate(), invalid UTF-8" );
+        string = hzstr_create_ccstr( "caf\xC3" );
+        result = hzstr_validate( string );
+        test_v_long( test, result, HZSTR_RSLT_ENCODING );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_validate(), invalid usage" );
+        result = hzstr_validate( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_cp_count()" );
+        string = hzstr_create_cstr( "Hello" );
+        result = hzstr_cp_count( string );
+        test_v_long( test, result, 5 );
+        hzstr_destroy( string );
+        string = hzstr_create_ccstr( "caf\xC3\xA9 \xE2\x82\xAC" );
+        result = hzstr_cp_count( string );
+        test_v_long( test, result, 6 );
+        hzstr_destroy( string );
+        result = hzstr_cp_count( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_cp_offset()" );
+        string = hzstr_create_ccstr( "caf\xC3\xA9 \xE2\x82\xAC" );
+        strindex = hzstr_cp_offset( string, 3 );
+        test_v_long( test, strindex, 3 );
+        strindex = hzstr_cp_offset( string, 4 );
+        test_v_long( test, strindex, 5 );
+        strindex = hzstr_cp_offset( string, 5 );
+        test_v_long( test, strindex, 6 );
+        strindex = hzstr_cp_offset( string, 6 );
+        test_v_long( test, strindex, 9 );
+        strindex = hzstr_cp_offset( string, 7 );
+        test_v_long( test, strindex, HZSTR_INDEX_NONE );
+        strindex = hzstr_cp_offset( string, -1 );
+        test_v_long( test, strindex, HZSTR_INDEX_NONE );
+        hzstr_destroy( string );
+        string = hzstr_create_cstr( "Hello" );
+        strindex = hzstr_cp_offset( string, 5 );
+        test_v_long( test, strindex, 5 );
+        strindex = hzstr_cp_offset( string, 6 );
+        test_v_long( test, strindex, HZSTR_INDEX_NONE );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_HASH
+    t_hdg( "String Hashes and Constants" );
+
+        t_sec( "HZSTR_LITERAL()" );
+        test_v_long( test, constant.type, HZSTR_TYPE_CONST );
+        test_v_long( test, hzstr_length( &constant ), 11 );
+        test_v_long( test, constant.alloc, 0 );
+        test_v_str( test, hzstr_cstr( &constant ), "Hello World" );
+        hzstr_destroy( ( hzstr_type* ) &constant );
+        test_v_long( test, fail_calloc, 0 );
+        test_v_long( test, fail_malloc, 0 );
+
+        t_sec( "hzstr_hash()" );
+        string = hzstr_create( 0 );
+        test_v_long( test, hzstr_hash( string ), 0x811C9DC5 );
+        hzstr_cpy_cstr( string, "a" );
+        test_v_long( test, hzstr_hash( string ), 0xE40C292C );
+        hzstr_cpy_cstr( string, "foobar" );
+        test_v_long( test, hzstr_hash( string ), 0xBF9CF968 );
+        hzstr_cpy_cstr( string, "\xFF" );
+        test_v_long( test, hzstr_hash( string ), 0x7A0B824E );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_hash(), stored hash" );
+        string = hzstr_create_ccstr( "foobar" );
+        string->hash   = 1234;
+        string->flags |= HZSTR_FLG_HASHED;
+        test_v_long( test, hzstr_hash( string ), 1234 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_equal()" );
+        string  = hzstr_create_cstr( " Hello World" );
+        string2 = hzstr_create_cstr( "Hello Worle" );
+        test_v_long( test, hzstr_equal( string, &constant ), 0 );
+        hzstr_consume( string, 1 );
+        test_v_long( test, hzstr_equal( string, &constant ), 1 );
+        test_v_long( test, hzstr_equal( &constant, &constant ), 1 );
+        test_v_long( test, hzstr_equal( string, string2 ), 0 );
+        hzstr_destroy( string );
+        hzstr_destroy( string2 );
+
+        t_sec( "hzstr_equal(), stored hashes" );
+        string  = hzstr_create_ccstr( "Hello World" );
+        string2 = hzstr_create_ccstr( "Hello World" );
+        string->hash    = 1;
+        string->flags  |= HZSTR_FLG_HASHED;
+        string2->hash   = 2;
+        string2->flags |= HZSTR_FLG_HASHED;
+        test_v_long( test, hzstr_equal( string, string2 ), 0 );
+        string2->hash   = 1;
+        test_v_long( test, hzstr_equal( string, string2 ), 1 );
+        hzstr_destroy( string );
+        hzstr_destroy( string2 );
+
+        t_sec( "hzstr_validate(), constant object" );
+        result = hzstr_validate( &writable );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_long( test, writable.flags, HZSTR_FLG_STATIC );
+#endif
+
 #ifndef TNO_IMPORT
     t_hdg( "String Import" );
 
@@ -379,6 +1171,39 @@ int run_test(                       //run the unit test
         test_v_str( test, hzstr_cstr( string ), "Hello Beautiful" );
         hzstr_destroy( string );
 
+        t_sec( "hzstr_import(), oversized input" );
+        string = hzstr_create( 0 );
+        memset( buffer, 'x', ( BUFFER_SIZE - 1 ) );
+        buffer[ BUFFER_SIZE - 1 ] = '\0';
+        result = hzstr_import( string, buffer, 64 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        buffer[ 64 ] = '\0';
+        result = hzstr_import( string, ( buffer + 1 ), 64 );
+        test_v_long( test, result, 63 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_import(), records encoding" );
+        string = hzstr_create( 0 );
+        result = hzstr_import( string, "caf\xC3\xA9", 16 );
+        test_v_long( test, result, 5 );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        result = hzstr_import( string, "caf\xC0\xA9", 16 );
+        test_v_long( test, result, 5 );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_import_utf8()" );
+        string = hzstr_create( 0 );
+        result = hzstr_import_utf8( string, "caf\xC3\xA9", 16 );
+        test_v_long( test, result, 5 );
+        test_v_str( test, hzstr_cstr( string ), "caf\xC3\xA9" );
+        result = hzstr_import_utf8( string, "caf\xC0\xA9", 16 );
+        test_v_long( test, result, HZSTR_RSLT_ENCODING );
+        test_v_str( test, hzstr_cstr( string ), "caf\xC3\xA9" );
+        result = hzstr_import_utf8( string, "caf\xC3\xA9", 4 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        hzstr_destroy( string );
+
         t_sec( "hzstr_import(), invalid target string" );
         string = hzstr_create_ccstr( "Constant" );
         result = hzstr_import( string, "Hello World", 11 );
@@ -411,6 +1236,180 @@ int run_test(                       //run the unit test
         hzstr_destroy( string );
 #endif
 
+#ifndef TNO_RESERVE
+    t_hdg( "String Memory Reserve" );
+
+        t_sec( "hzstr_reserve()" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_reserve( string, 100 );
+        test_v_long( test, result, string->alloc );
+        test_v_long( test, ( string->alloc > 100 ), 1 );
+        test_v_long( test, fail_realloc, 1 );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        memset( buffer, 'x', 89 );
+        buffer[ 89 ] = '\0';
+        result = hzstr_cat_cstr( string, buffer );
+        test_v_long( test, result, 100 );
+        test_v_long( test, fail_realloc, 1 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_reserve(), room already available" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_reserve( string, 20 );
+        test_v_long( test, result, 32 );
+        test_v_long( test, fail_realloc, 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_reserve(), maximum length" );
+        string = hzstr_create_cstr( "Hello World" );
+        result = hzstr_reserve( string, 65535 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_reserve(), failed reallocation" );
+        string = hzstr_create_cstr( "Hello World" );
+        fail_reallocs[ 0 ] = 1;
+        result = hzstr_reserve( string, 100 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_reserve(), invalid usage" );
+        result = hzstr_reserve( NULL, 100 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        string = hzstr_create_ccstr( "Hello World" );
+        result = hzstr_reserve( string, 100 );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_SHRINK
+    t_hdg( "String Memory Shrink" );
+
+        t_sec( "hzstr_shrink_policy(), no policy" );
+        hzstr_shrink_policy( 0, 0 );
+        string = hzstr_create( 2000 );
+        hzstr_cpy_cstr( string, "Hello World" );
+        test_v_long( test, string->alloc, 2016 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr(), shrinking a much shorter string" );
+        result = hzstr_shrink_policy( 4, 1024 );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        string = hzstr_create( 2000 );
+        result = hzstr_cpy_cstr( string, "Hello World" );
+        test_v_long( test, result, 11 );
+        test_v_long( test, string->alloc, 32 );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy(), hysteresis" );
+        hzstr_shrink_policy( 4, 0 );
+        string  = hzstr_create( 400 );
+        string2 = hzstr_create( 200 );
+        memset( buffer, 'x', 200 );
+        buffer[ 200 ] = '\0';
+        hzstr_cpy_cstr( string2, buffer );
+        hzstr_cpy( string, string2 );
+        test_v_long( test, string->alloc, 416 );
+        hzstr_erase( string2, 100, 100 );
+        hzstr_cpy( string, string2 );
+        test_v_long( test, string->alloc, 224 );
+        hzstr_erase( string2, 60, 40 );
+        hzstr_cpy( string, string2 );
+        test_v_long( test, string->alloc, 224 );
+        hzstr_erase( string2, 40, 20 );
+        hzstr_cpy( string, string2 );
+        test_v_long( test, string->alloc, 96 );
+        test_v_long( test, hzstr_length( string ), 40 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr(), allocation within the minimum" );
+        hzstr_shrink_policy( 4, 4096 );
+        string = hzstr_create( 2000 );
+        hzstr_cpy_cstr( string, "Hello World" );
+        test_v_long( test, string->alloc, 2016 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), shrinking a much shorter string" );
+        hzstr_shrink_policy( 4, 0 );
+        memset( buffer, ' ', 300 );
+        strcpy( &buffer[ 150 ], "x" );
+        buffer[ 151 ] = ' ';
+        buffer[ 300 ] = '\0';
+        string = hzstr_create_cstr( buffer );
+        test_v_long( test, string->alloc, 320 );
+        result = hzstr_trim( string );
+        test_v_long( test, result, 1 );
+        test_v_long( test, string->alloc, 32 );
+        test_v_long( test, string->offset, 0 );
+        test_v_str( test, hzstr_cstr( string ), "x" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_erase(), shrinking a much shorter string" );
+        hzstr_shrink_policy( 4, 0 );
+        memset( buffer, 'a', 300 );
+        buffer[ 300 ] = '\0';
+        string = hzstr_create_cstr( buffer );
+        result = hzstr_erase( string, 10, 290 );
+        test_v_long( test, result, 10 );
+        test_v_long( test, string->alloc, 32 );
+        test_v_str( test, hzstr_cstr( string ), "aaaaaaaaaa" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr(), failed reallocation" );
+        hzstr_shrink_policy( 4, 0 );
+        string = hzstr_create( 400 );
+        fail_reallocs[ 0 ] = 1;
+        result = hzstr_cpy_cstr( string, "Hello World" );
+        test_v_long( test, result, 11 );
+        test_v_long( test, string->alloc, 416 );
+        test_v_str( test, hzstr_cstr( string ), "Hello World" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_shrink_policy(), invalid factor" );
+        result = hzstr_shrink_policy( 2, 0 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_compact_all()" );
+        strings[ 0 ] = hzstr_create( 100 );
+        hzstr_cpy_cstr( strings[ 0 ], "abc" );
+        strings[ 1 ] = hzstr_create_cstr( "Hello World" );
+        hzstr_consume( strings[ 1 ], 6 );
+        strings[ 2 ] = hzstr_create_ccstr( "Hello World" );
+        result = hzstr_compact_all( strings, 4 );
+        test_v_long( test, result, ( ( 124 + 26 ) * sizeof( hzstr_char_t ) ) );
+        test_v_long( test, strings[ 0 ]->alloc, 4 );
+        test_v_str( test, hzstr_cstr( strings[ 0 ] ), "abc" );
+        test_v_long( test, strings[ 1 ]->alloc, 6 );
+        test_v_long( test, strings[ 1 ]->offset, 0 );
+        test_v_str( test, hzstr_cstr( strings[ 1 ] ), "World" );
+        test_v_long( test, strings[ 2 ]->alloc, 0 );
+        result = hzstr_cat_cstr( strings[ 1 ], "!" );
+        test_v_long( test, result, 6 );
+        result = hzstr_compact_all( strings, 4 );
+        test_v_long( test, result, ( 31 - 6 ) * sizeof( hzstr_char_t ) );
+        hzstr_destroy( strings[ 2 ] );
+        hzstr_destroy( strings[ 1 ] );
+        hzstr_destroy( strings[ 0 ] );
+
+        t_sec( "hzstr_compact_all(), failed allocation" );
+        strings[ 0 ] = hzstr_create_cstr( "Hello World" );
+        fail_mallocs[ fail_malloc ] = 1;
+        result = hzstr_compact_all( strings, 1 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_long( test, strings[ 0 ]->alloc, 32 );
+        test_v_str( test, hzstr_cstr( strings[ 0 ] ), "Hello World" );
+        hzstr_destroy( strings[ 0 ] );
+
+        t_sec( "hzstr_compact_all(), invalid usage" );
+        result = hzstr_compact_all( NULL, 1 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_compact_all( NULL, 0 );
+        test_v_long( test, result, 0 );
+#endif
+
 #ifdef HZSTR_COMPAT_CSTR
 #ifndef TNO_SPRINTF
     t_hdg( "String Formatted Printing" );
@@ -442,6 +1441,50 @@ int run_test(                       //run the unit test
 #endif
 #endif
 
+#ifndef TNO_SQUEEZE
+    t_hdg( "Whitespace Collapse" );
+
+        t_sec( "hzstr_squeeze()" );
+        string = hzstr_create_cstr( "  Hello \t\r\n World  !" );
+        result = hzstr_squeeze( string );
+        test_v_long( test, result, 14 );
+        test_v_str( test, hzstr_cstr( string ), " Hello World !" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_squeeze(), long runs" );
+        string = hzstr_create_cstr(
+            "The quick brown fox                                  jumps"
+            "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+            "over the lazy dog, the quick brown fox jumps over the lazy"
+        );
+        result = hzstr_squeeze( string );
+        test_v_str(
+            test,
+            hzstr_cstr( string ),
+            "The quick brown fox jumps over the lazy dog, the quick brown"
+            " fox jumps over the lazy"
+        );
+        test_v_long( test, result, 84 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_squeeze(), no whitespace" );
+        string = hzstr_create_cstr( "Hello" );
+        result = hzstr_squeeze( string );
+        test_v_long( test, result, 5 );
+        test_v_str( test, hzstr_cstr( string ), "Hello" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_squeeze(), invalid usage" );
+        result = hzstr_squeeze( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_squeeze(), invalid target string" );
+        string = hzstr_create_ccstr( "Hello  World" );
+        result = hzstr_squeeze( string );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
+#endif
+
 #ifndef TNO_STRCHR
     t_hdg( "Character Search" );
 
@@ -452,6 +1495,16 @@ int run_test(                       //run the unit test
         strindex = hzstr_strchr( string, 'z' );
         test_v_long( test, strindex, HZSTR_INDEX_NONE );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_strchr(), long string" );
+        string = hzstr_create_cstr( "The quick brown fox jumps over the dog" );
+        strindex = hzstr_strchr( string, 'j' );
+        test_v_long( test, strindex, 20 );
+        strindex = hzstr_strchr( string, 'g' );
+        test_v_long( test, strindex, 37 );
+        strindex = hzstr_strchr( string, 'z' );
+        test_v_long( test, strindex, HZSTR_INDEX_NONE );
+        hzstr_destroy( string );
 #endif
 
 #ifndef TNO_TOCASE
@@ -470,6 +1523,87 @@ int run_test(                       //run the unit test
         test_v_long( test, result, HZSTR_RSLT_OK );
         test_v_str( test, hzstr_cstr( string ), "HELLO WORLD~" );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_tolower(), hzstr_toupper(), long string" );
+        string = hzstr_create_cstr(
+            "@AZ[`az{ The Quick Brown Fox \xC3\x89 Jumps Over The Dog"
+        );
+        hzstr_tolower( string );
+        test_v_str(
+            test,
+            hzstr_cstr( string ),
+            "@az[`az{ the quick brown fox \xC3\x89 jumps over the dog"
+        );
+        hzstr_toupper( string );
+        test_v_str(
+            test,
+            hzstr_cstr( string ),
+            "@AZ[`AZ{ THE QUICK BROWN FOX \xC3\x89 JUMPS OVER THE DOG"
+        );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_tolower(), hzstr_toupper(), nothing to change" );
+        string = hzstr_create_ccstr( "already lowercase text here" );
+        result = hzstr_tolower( string );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_str(
+            test, hzstr_cstr( string ), "already lowercase text here"
+        );
+        hzstr_destroy( string );
+        string = hzstr_create_ccstr( "ALREADY UPPERCASE TEXT HERE" );
+        result = hzstr_toupper( string );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_str(
+            test, hzstr_cstr( string ), "ALREADY UPPERCASE TEXT HERE"
+        );
+        hzstr_destroy( string );
+        result = hzstr_tolower( ( hzstr_type* ) &lower );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        result = hzstr_toupper( ( hzstr_type* ) &upper );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_str(
+            test, hzstr_cstr( &upper ), "ALREADY UPPERCASE TEXT HERE"
+        );
+
+        t_sec( "hzstr_fold(), ASCII" );
+        string = hzstr_create_cstr( "Hello World~" );
+        result = hzstr_fold( string );
+        test_v_long( test, result, 12 );
+        test_v_str( test, hzstr_cstr( string ), "hello world~" );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_fold(), in place" );
+        string = hzstr_create_cstr( "\xE2\x84\xAA" "ELVIN \xC3\x89T\xC3\x89" );
+        result = hzstr_fold( string );
+        test_v_long( test, result, 12 );
+        test_v_str( test, hzstr_cstr( string ), "kelvin \xC3\xA9t\xC3\xA9" );
+        test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_fold(), growing string" );
+        string = hzstr_create_cstr( "\xC8\xBA\xC8\xBE" );
+        result = hzstr_fold( string );
+        test_v_long( test, result, 6 );
+        test_v_str( test, hzstr_cstr( string ), "\xE2\xB1\xA5\xE2\xB1\xA6" );
+        test_v_long( test, string->offset, 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_fold(), failed allocation" );
+        string = hzstr_create_cstr( "\xC8\xBA" );
+        fail_mallocs[ 1 ] = 1;
+        result = hzstr_fold( string );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_str( test, hzstr_cstr( string ), "\xC8\xBA" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_fold(), invalid usage" );
+        result = hzstr_fold( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        string = hzstr_create_ccstr( "Hello" );
+        result = hzstr_fold( string );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
 #endif
 
 #ifndef TNO_TRIM
@@ -490,6 +1624,86 @@ int run_test(                       //run the unit test
         test_v_long( test, result, 0 );
         test_v_str( test, hzstr_cstr( string ), "" );
         hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), whitespace only" );
+        string = hzstr_create_cstr( " \t\r\n " );
+        result = hzstr_trim( string );
+        test_v_long( test, result, 0 );
+        test_v_str( test, hzstr_cstr( string ), "" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), leading whitespace is skipped" );
+        string = hzstr_create_cstr( "   Hello" );
+        result = hzstr_trim( string );
+        test_v_long( test, result, 5 );
+        test_v_long( test, string->offset, 3 );
+        test_v_str( test, hzstr_cstr( string ), "Hello" );
+        result = hzstr_append( string, '!' );
+        test_v_long( test, result, 6 );
+        test_v_str( test, hzstr_cstr( string ), "Hello!" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), substring" );
+        string = hzstr_create_cstr( "a  Hello  b" );
+        substring = hzstr_create_substr( string, 1, 9 );
+        result = hzstr_trim( substring );
+        test_v_long( test, result, 5 );
+        test_v_mem( test, substring->data, "Hello", 5 );
+        test_v_str( test, hzstr_cstr( string ), "a  Hello  b" );
+        hzstr_destroy( substring );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), invalid target string" );
+        string = hzstr_create_ccstr( " Constant " );
+        result = hzstr_trim( string );
+        test_v_long( test, result, HZSTR_RSLT_TYPE );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), invalid usage" );
+        result = hzstr_trim( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_trim(), long whitespace runs" );
+        string = hzstr_create_cstr(
+            "                                        \t\t\t\t\t"
+            "Hello, this is a string longer than a vector register."
+            "\r\n                                                  "
+        );
+        result = hzstr_trim( string );
+        test_v_long( test, result, 54 );
+        test_v_str(
+            test,
+            hzstr_cstr( string ),
+            "Hello, this is a string longer than a vector register."
+        );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), characters above 0x7F are not whitespace" );
+        string = hzstr_create_cstr( " \xC3\xA9t\xC3\xA9 " );
+        result = hzstr_trim( string );
+        test_v_long( test, result, 5 );
+        test_v_str( test, hzstr_cstr( string ), "\xC3\xA9t\xC3\xA9" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim_left()" );
+        string = hzstr_create_cstr( "\t Hello World     \r\n" );
+        result = hzstr_trim_left( string );
+        test_v_long( test, result, 18 );
+        test_v_str( test, hzstr_cstr( string ), "Hello World     \r\n" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim_right()" );
+        string = hzstr_create_cstr( "\t Hello World     \r\n" );
+        result = hzstr_trim_right( string );
+        test_v_long( test, result, 13 );
+        test_v_str( test, hzstr_cstr( string ), "\t Hello World" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim_left() and hzstr_trim_right(), invalid usage" );
+        result = hzstr_trim_left( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_trim_right( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
 #endif
 
     return 0;
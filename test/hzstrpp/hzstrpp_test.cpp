@@ -0,0 +1,622 @@
+/*****************************************************************************
+    hzstrpp_test.cpp
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        This tests the C++ interface (hzstr.hpp) to the string module.  The
+        allocation stubs count every call, so the tests can verify that
+        moves never allocate.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "test.h"
+
+#include "hzstr.hpp"
+#include "memory.h"
+
+using namespace hzstr::literals;
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+
+//number of allocation calls made so far
+#define allocs() ( fail_calloc + fail_malloc + fail_realloc )
+
+//encoding flags of a string
+#define encoding( _s ) \
+    ( ( _s ).get()->flags & ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 ) )
+#define ASCII ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 )
+
+//define symbols to disable the corresponding test section
+//#define TNO_CREATE
+//#define TNO_MOVE
+//#define TNO_CLONE
+//#define TNO_VIEW
+//#define TNO_CONCAT
+//#define TNO_LITERAL
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+//characters that are not followed by a NULL byte
+static const char unterminated[] = { 'H', 'e', 'l', 'l', 'o' };
+
+//constant string objects made by the compiler
+static constexpr hzstr_type hello   = "Hello World"_hz;
+static constexpr hzstr_type unicode = "caf\xC3\xA9"_hz;
+static constexpr hzstr_type invalid = "caf\xC0\xA9"_hz;
+
+static_assert( hello.length == 11, "literal length" );
+static_assert( hello.hash == hzstr::hash( "Hello World" ), "literal hash" );
+static_assert( hzstr::hash( "foobar" ) == 0xBF9CF968, "FNV-1a hash" );
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+int                     count;
+hzstr_type*             object;
+int                     thrown;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+extern "C" {
+
+void reset_test(                    //reset the test's variables
+    void
+);
+
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+);                                  //result of test
+
+}
+
+static std::string_view pass_view(  //accept a view of characters
+    std::string_view    view        //view of characters
+);                                  //the same view
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    count  = 0;
+    object = NULL;
+    thrown = 0;
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_CREATE
+    t_hdg( "String Creation" );
+
+        t_sec( "hzstr::string(), empty" );
+        {
+            hzstr::string string;
+            test_v_null( test, string.get() );
+            test_v_long( test, string.length(), 0 );
+            test_v_long( test, string.empty(), 1 );
+            test_v_long( test, string.view().size(), 0 );
+            test_v_long( test, allocs(), 0 );
+        }
+
+        t_sec( "hzstr::string(), string view" );
+        {
+            hzstr::string string( std::string_view( "Hello World" ) );
+            test_v_ptr( test, string.get() );
+            test_v_long( test, string.length(), 11 );
+            test_v_str( test, hzstr_cstr( string.get() ), "Hello World" );
+            test_v_long( test, allocs(), 2 );
+        }
+
+        t_sec( "hzstr::string(), unterminated string view" );
+        {
+            hzstr::string string(
+                std::string_view( unterminated, sizeof( unterminated ) )
+            );
+            test_v_long( test, string.length(), 5 );
+            test_v_str( test, hzstr_cstr( string.get() ), "Hello" );
+        }
+
+        t_sec( "hzstr::string(), empty string view" );
+        {
+            hzstr::string string( ( std::string_view() ) );
+            test_v_ptr( test, string.get() );
+            test_v_long( test, string.length(), 0 );
+        }
+
+        t_sec( "hzstr::string(), string view too long" );
+        try {
+            std::string text( 65536, 'a' );
+            hzstr::string string( ( std::string_view( text ) ) );
+        }
+        catch( const std::length_error& ) {
+            thrown = 1;
+        }
+        test_v_long( test, thrown, 1 );
+        test_v_long( test, allocs(), 0 );
+
+        t_sec( "hzstr::string(), failed allocation" );
+        fail_callocs[ 0 ] = 1;
+        try {
+            hzstr::string string( std::string_view( "Hello" ) );
+        }
+        catch( const std::bad_alloc& ) {
+            thrown = 1;
+        }
+        test_v_long( test, thrown, 1 );
+
+        t_sec( "hzstr::string(), string object" );
+        object = hzstr_create_cstr( "Hello" );
+        {
+            hzstr::string string( object );
+            test_v_long( test, ( string.get() == object ), 1 );
+        }
+        test_v_long( test, fail_calloc, 1 );
+#endif
+
+#ifndef TNO_MOVE
+    t_hdg( "Moving Strings" );
+
+        t_sec( "hzstr::string(), move construction" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            object = string.get();
+            count  = allocs();
+            hzstr::string moved( std::move( string ) );
+            test_v_long( test, allocs(), count );
+            test_v_long( test, ( moved.get() == object ), 1 );
+            test_v_null( test, string.get() );
+            test_v_long( test, string.length(), 0 );
+            test_v_str( test, hzstr_cstr( moved.get() ), "Hello" );
+        }
+
+        t_sec( "operator=(), move assignment" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            hzstr::string other( std::string_view( "World" ) );
+            object = string.get();
+            count  = allocs();
+            other  = std::move( string );
+            test_v_long( test, allocs(), count );
+            test_v_long( test, ( other.get() == object ), 1 );
+            test_v_null( test, string.get() );
+            test_v_str( test, hzstr_cstr( other.get() ), "Hello" );
+        }
+
+        t_sec( "operator=(), move assignment to itself" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            hzstr::string& same = string;
+            object = string.get();
+            string = std::move( same );
+            test_v_long( test, ( string.get() == object ), 1 );
+        }
+
+        t_sec( "release(), reset()" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            object = string.release();
+            test_v_null( test, string.get() );
+            string.reset( object );
+            test_v_long( test, ( string.get() == object ), 1 );
+            string.reset( object );
+            test_v_long( test, ( string.get() == object ), 1 );
+            string.reset();
+            test_v_null( test, string.get() );
+        }
+#endif
+
+#ifndef TNO_CLONE
+    t_hdg( "Copying Strings" );
+
+        t_sec( "clone()" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            hzstr::string copy = string.clone();
+            test_v_long( test, ( copy.get() != string.get() ), 1 );
+            test_v_long( test, ( copy.data() != string.data() ), 1 );
+            test_v_str( test, hzstr_cstr( copy.get() ), "Hello" );
+        }
+
+        t_sec( "clone(), substring" );
+        {
+            hzstr::string string( std::string_view( "Hello World" ) );
+            hzstr::string view = string.substr( 6, 5 );
+            hzstr::string copy = view.clone();
+            test_v_long( test, copy.get()->type, HZSTR_TYPE_DYNAMIC );
+            test_v_str( test, hzstr_cstr( copy.get() ), "World" );
+        }
+
+        t_sec( "clone(), empty" );
+        {
+            hzstr::string string;
+            hzstr::string copy = string.clone();
+            test_v_null( test, copy.get() );
+            test_v_long( test, allocs(), 0 );
+        }
+
+        t_sec( "clone(), failed allocation" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            fail_callocs[ 1 ] = 1;
+            try {
+                hzstr::string copy = string.clone();
+            }
+            catch( const std::bad_alloc& ) {
+                thrown = 1;
+            }
+            test_v_long( test, thrown, 1 );
+        }
+#endif
+
+#ifndef TNO_VIEW
+    t_hdg( "Viewing Strings" );
+
+        t_sec( "operator view_type()" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            test_v_long( test, ( pass_view( string ) == "Hello" ), 1 );
+            test_v_long(
+                test, ( pass_view( string ).data() == string.data() ), 1
+            );
+        }
+
+        t_sec( "substr(), view is not NULL-terminated" );
+        {
+            hzstr::string string( std::string_view( "Hello World!" ) );
+            hzstr::string view = string.substr( 6, 5 );
+            test_v_long( test, view.get()->type, HZSTR_TYPE_SUBSTR );
+            test_v_long( test, view.view().size(), 5 );
+            test_v_long( test, ( view.view() == "World" ), 1 );
+            test_v_long( test, ( view.data() == ( string.data() + 6 ) ), 1 );
+        }
+
+        t_sec( "substr(), empty" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            count = allocs();
+            hzstr::string view = string.substr( 5, 0 );
+            test_v_null( test, view.get() );
+            test_v_long( test, allocs(), count );
+        }
+
+        t_sec( "substr(), out of range" );
+        {
+            hzstr::string string( std::string_view( "Hello" ) );
+            try {
+                hzstr::string view = string.substr( 3, 3 );
+            }
+            catch( const std::out_of_range& ) {
+                thrown += 1;
+            }
+            try {
+                hzstr::string view = string.substr( -1, 1 );
+            }
+            catch( const std::out_of_range& ) {
+                thrown += 1;
+            }
+            test_v_long( test, thrown, 2 );
+        }
+#endif
+
+#ifndef TNO_CONCAT
+    t_hdg( "Concatenation" );
+
+        t_sec( "operator+(), new string" );
+        {
+            hzstr::string path( std::string_view( "usr" ) );
+            hzstr::string name( std::string_view( "bin" ) );
+            std::string query( "id" );
+            count = allocs();
+            hzstr::string string = path + "/" + name + '?' + query + "=" + 42;
+            test_v_long( test, allocs(), ( count + 2 ) );
+            test_v_str( test, hzstr_cstr( string.get() ), "usr/bin?id=42" );
+            test_v_long( test, string.length(), 13 );
+            test_v_long( test, encoding( string ), 0 );
+        }
+
+        t_sec( "operator+(), integers" );
+        {
+            hzstr::string empty;
+            hzstr::string string = empty + 0 + ' ' + -7 + ' ' + 1234567890U
+                + ' ' + ( -9223372036854775807LL - 1 )
+                + ' ' + 18446744073709551615ULL;
+            test_v_str(
+                test,
+                hzstr_cstr( string.get() ),
+                "0 -7 1234567890 -9223372036854775808 18446744073709551615"
+            );
+            test_v_long( test, encoding( string ), ASCII );
+        }
+
+        t_sec( "operator=(), allocation is checked once" );
+        {
+            hzstr::string string( std::string_view( "previous contents" ) );
+            hzstr::string name( std::string_view( "bin" ) );
+            hzstr_validate( name.get() );
+            count = allocs();
+            string = name + '/' + name;
+            test_v_long( test, allocs(), count );
+            test_v_str( test, hzstr_cstr( string.get() ), "bin/bin" );
+            test_v_long( test, encoding( string ), ASCII );
+            std::string text( 100, 'x' );
+            string = name + std::string_view( text );
+            test_v_long( test, allocs(), ( count + 1 ) );
+            test_v_long( test, string.length(), 103 );
+            test_v_long( test, string.get()->data[ 103 ], 0 );
+        }
+
+        t_sec( "operator=(), expression reads the target" );
+        {
+            hzstr::string string( std::string_view( "ab" ) );
+            hzstr::string view = string.substr( 1, 1 );
+            string = string + "-" + view + "-" + string;
+            test_v_str( test, hzstr_cstr( string.get() ), "ab-b-ab" );
+        }
+
+        t_sec( "operator=(), substring target" );
+        {
+            hzstr::string string( std::string_view( "Hello World" ) );
+            hzstr::string view = string.substr( 0, 5 );
+            object = view.get();
+            view = view + "!";
+            test_v_long( test, ( view.get() != object ), 1 );
+            test_v_long( test, view.get()->type, HZSTR_TYPE_DYNAMIC );
+            test_v_str( test, hzstr_cstr( view.get() ), "Hello!" );
+            test_v_str( test, hzstr_cstr( string.get() ), "Hello World" );
+        }
+
+        t_sec( "operator+=()" );
+        {
+            hzstr::string string( std::string_view( "a" ) );
+            hzstr::string other( std::string_view( "b" ) );
+            string += "c";
+            string += other;
+            string += other + 1;
+            string += string;
+            test_v_str( test, hzstr_cstr( string.get() ), "acbb1acbb1" );
+            test_v_long( test, encoding( string ), 0 );
+        }
+
+        t_sec( "operator+=(), empty string" );
+        {
+            hzstr::string string;
+            string += 5;
+            test_v_str( test, hzstr_cstr( string.get() ), "5" );
+        }
+
+        t_sec( "operator+(), character arrays" );
+        {
+            hzstr::string name( std::string_view( "bin" ) );
+            char buffer[ 256 ];
+            char full[ 3 ] = { 'a', 'b', 'c' };
+            hzstr_validate( name.get() );
+            memset( buffer, 'x', sizeof( buffer ) );
+            memcpy( buffer, "usr", 4 );
+            hzstr::string string = name + buffer;
+            test_v_str( test, hzstr_cstr( string.get() ), "binusr" );
+            test_v_long( test, string.length(), 6 );
+            test_v_long( test, encoding( string ), ASCII );
+            string = name + full;
+            test_v_str( test, hzstr_cstr( string.get() ), "binab" );
+            string = name + "/caf\xC3\xA9";
+            test_v_long( test, encoding( string ), HZSTR_FLG_UTF8 );
+            string = name + "/caf\xC0\xA9";
+            test_v_long( test, encoding( string ), 0 );
+        }
+
+        t_sec( "operator+(), too long" );
+        {
+            hzstr::string string( std::string_view( "x" ) );
+            std::string text( 65534, 'a' );
+            try {
+                string = string + std::string_view( text );
+            }
+            catch( const std::length_error& ) {
+                thrown = 1;
+            }
+            test_v_long( test, thrown, 1 );
+            test_v_str( test, hzstr_cstr( string.get() ), "x" );
+        }
+
+        t_sec( "operator+(), failed allocation" );
+        {
+            hzstr::string string( std::string_view( "x" ) );
+            hzstr::string other( std::string_view( "y" ) );
+            std::string text( 100, 'a' );
+            fail_reallocs[ 0 ] = 1;
+            try {
+                string = other + std::string_view( text );
+            }
+            catch( const std::bad_alloc& ) {
+                thrown += 1;
+            }
+            test_v_str( test, hzstr_cstr( string.get() ), "x" );
+            fail_callocs[ fail_calloc ] = 1;
+            try {
+                hzstr::string copy = string + "y";
+            }
+            catch( const std::bad_alloc& ) {
+                thrown += 1;
+            }
+            test_v_long( test, thrown, 2 );
+        }
+#endif
+
+#ifndef TNO_LITERAL
+    t_hdg( "Constant Strings" );
+
+        t_sec( "operator\"\"_hz()" );
+        test_v_long( test, hello.type, HZSTR_TYPE_CONST );
+        test_v_long( test, hello.alloc, 0 );
+        test_v_str( test, hzstr_cstr( &hello ), "Hello World" );
+        test_v_long( test, ( hello.flags & ~ASCII ),
+            ( HZSTR_FLG_STATIC | HZSTR_FLG_HASHED ) );
+        test_v_long( test, ( hello.flags & ASCII ), ASCII );
+        test_v_long( test, ( unicode.flags & ASCII ), HZSTR_FLG_UTF8 );
+        test_v_long( test, ( invalid.flags & ASCII ), 0 );
+        test_v_long( test, ( "\xF0\x9F\x98\x80"_hz.flags & ASCII ),
+            HZSTR_FLG_UTF8 );
+        test_v_long( test, ( "\xED\xA0\x80"_hz.flags & ASCII ), 0 );
+        test_v_long( test, ( "\xE2\x82"_hz.flags & ASCII ), 0 );
+        test_v_long( test, ( "\xC1\xBF"_hz.flags & ASCII ), 0 );
+
+        t_sec( "operator\"\"_hz(), hash matches hzstr_hash()" );
+        {
+            hzstr::string string( std::string_view( "Hello World" ) );
+            test_v_long( test, hzstr_hash( string.get() ), hello.hash );
+            test_v_long( test, string.hash(), hello.hash );
+            test_v_long( test, hzstr::string().hash(), hzstr::hash( "" ) );
+            test_v_long( test, hzstr_equal( &hello, string.get() ), 1 );
+            test_v_long( test, hzstr_equal( &hello, &unicode ), 0 );
+        }
+
+        t_sec( "operator\"\"_hz(), no allocation" );
+        {
+            count = allocs();
+            const hzstr_type local = "Hello"_hz;
+            test_v_long( test, hzstr_length( &local ), 5 );
+            hzstr_destroy( const_cast< hzstr_type* >( &local ) );
+            test_v_long( test, allocs(), count );
+        }
+
+        t_sec( "hzstr::hash(), case labels" );
+        switch( hzstr_hash( &hello ) ) {
+            case hzstr::hash( "Hello" ):
+                count = 1;
+                break;
+            case hzstr::hash( "Hello World" ):
+                count = 2;
+                break;
+            default:
+                count = 3;
+                break;
+        }
+        test_v_long( test, count, 2 );
+#endif
+
+    return 0;
+}
+
+
+/*==========================================================================*/
+static std::string_view pass_view(  //accept a view of characters
+    std::string_view    view        //view of characters
+) {                                 //the same view
+    return view;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
@@ -0,0 +1,393 @@
+/*****************************************************************************
+    hztrace_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        This test is built with HZSTR_TRACE, so its calls to the library
+        are routed through the recorder.  Each trace is written to the
+        build directory, and read back with hzstr_trace_load().
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzstr.h"
+#include "hztrace.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define TRACE_PATH "build/test.hzt"
+#define BAD_PATH "build/bad.hzt"
+
+//check that a record names a string
+#define addr( _s ) ( ( uint64_t ) ( uintptr_t ) ( _s ) )
+
+//define symbols to disable the corresponding test section
+//#define TNO_RECORDING
+//#define TNO_RECORDS
+//#define TNO_LOADING
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+unsigned long           count;
+FILE*                   file;
+char                    long_text[ 301 ];
+hzstr_trace_record_type* records;
+hzstr_result_t          result;
+hzstr_type*             string;
+hzstr_type*             string2;
+hzstr_type*             strings[ 3 ];
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    count   = 0;
+    file    = NULL;
+    records = NULL;
+    result  = 0;
+    string  = NULL;
+    string2 = NULL;
+    memset( strings, 0, sizeof( strings ) );
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_RECORDING
+    t_hdg( "Recording" );
+
+        t_sec( "hzstr_trace_start(), invalid path" );
+        result = hzstr_trace_start( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_trace_start( "build/missing/test.hzt" );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_trace_stop(), nothing recorded" );
+        result = hzstr_trace_stop();
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_trace_start(), one trace at a time" );
+        result = hzstr_trace_start( TRACE_PATH );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        result = hzstr_trace_start( TRACE_PATH );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_trace_stop();
+        test_v_long( test, result, 0 );
+
+        t_sec( "hzstr_trace_stop(), calls recorded while started" );
+        string = hzstr_create( 0 );
+        hzstr_trace_start( TRACE_PATH );
+        hzstr_append( string, 'a' );
+        hzstr_append( string, 'b' );
+        result = hzstr_trace_stop();
+        test_v_long( test, result, 2 );
+        hzstr_append( string, 'c' );
+        test_v_long( test, hzstr_length( string ), 3 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trace_stop(), buffered records written" );
+        string = hzstr_create( 0 );
+        hzstr_trace_start( TRACE_PATH );
+        for( count = 0; count < 5000; ++count ) {
+            hzstr_hash( string );
+        }
+        result = hzstr_trace_stop();
+        test_v_long( test, result, 5000 );
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_ptr( test, records );
+        test_v_long( test, count, 5000 );
+        test_v_long( test, records[ 4999 ].operation, HZSTR_TRACE_HASH );
+        hzstr_trace_unload( records );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_RECORDS
+    t_hdg( "Records" );
+
+        t_sec( "hzstr_trace_load(), strings and lengths" );
+        hzstr_trace_start( TRACE_PATH );
+        string  = hzstr_create( 40 );
+        string2 = hzstr_create_cstr( "Hello" );
+        hzstr_cat_cstr( string, "World!" );
+        hzstr_cat( string, string2 );
+        hzstr_insert( string, 3, string2 );
+        hzstr_erase( string, 2, 4 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+        hzstr_trace_stop();
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_long( test, count, 8 );
+        test_v_long( test, records[ 0 ].operation, HZSTR_TRACE_CREATE );
+        test_v_long( test, ( records[ 0 ].target == addr( string ) ), 1 );
+        test_v_long( test, records[ 0 ].length, 40 );
+        test_v_long( test, records[ 1 ].operation, HZSTR_TRACE_CREATE_CSTR );
+        test_v_long( test, ( records[ 1 ].target == addr( string2 ) ), 1 );
+        test_v_long( test, records[ 1 ].length, 5 );
+        test_v_long( test, records[ 2 ].operation, HZSTR_TRACE_CAT_CSTR );
+        test_v_long( test, records[ 2 ].length, 6 );
+        test_v_long( test, records[ 2 ].source, 0 );
+        test_v_long( test, records[ 3 ].operation, HZSTR_TRACE_CAT );
+        test_v_long( test, ( records[ 3 ].source == addr( string2 ) ), 1 );
+        test_v_long( test, records[ 4 ].operation, HZSTR_TRACE_INSERT );
+        test_v_long( test, records[ 4 ].offset, 3 );
+        test_v_long( test, records[ 5 ].operation, HZSTR_TRACE_ERASE );
+        test_v_long( test, records[ 5 ].offset, 2 );
+        test_v_long( test, records[ 5 ].length, 4 );
+        test_v_long( test, records[ 6 ].operation, HZSTR_TRACE_DESTROY );
+        test_v_long( test, ( records[ 6 ].target == addr( string2 ) ), 1 );
+        test_v_long( test, records[ 7 ].operation, HZSTR_TRACE_DESTROY );
+        test_v_long( test, records[ 7 ].reserved, 0 );
+        hzstr_trace_unload( records );
+
+        t_sec( "hzstr_trace_load(), substrings" );
+        string = hzstr_create_cstr( "Hello World" );
+        hzstr_trace_start( TRACE_PATH );
+        string2 = hzstr_create_substr( string, 6, 5 );
+        hzstr_trace_stop();
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_long( test, count, 1 );
+        test_v_long( test, records[ 0 ].operation, HZSTR_TRACE_CREATE_SUBSTR );
+        test_v_long( test, ( records[ 0 ].target == addr( string2 ) ), 1 );
+        test_v_long( test, ( records[ 0 ].source == addr( string ) ), 1 );
+        test_v_long( test, records[ 0 ].offset, 6 );
+        test_v_long( test, records[ 0 ].length, 5 );
+        hzstr_trace_unload( records );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trace_load(), splices and replacements" );
+        string  = hzstr_create_cstr( "one two one" );
+        string2 = hzstr_create_cstr( "one" );
+        strings[ 0 ] = hzstr_create_cstr( "three" );
+        hzstr_trace_start( TRACE_PATH );
+        hzstr_splice( string, 4, 3, string2 );
+        hzstr_replace_all( string, string2, strings[ 0 ] );
+        hzstr_squeeze( string );
+        hzstr_trim_right( string );
+        result = hzstr_equal( string, string2 );
+        test_v_long( test, result, 0 );
+        hzstr_trace_stop();
+        test_v_str( test, hzstr_cstr( string ), "three three three" );
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_long( test, count, 5 );
+        test_v_long( test, records[ 0 ].operation, HZSTR_TRACE_SPLICE );
+        test_v_long( test, ( records[ 0 ].source == addr( string2 ) ), 1 );
+        test_v_long( test, records[ 0 ].offset, 4 );
+        test_v_long( test, records[ 0 ].length, 3 );
+        test_v_long( test, records[ 1 ].operation, HZSTR_TRACE_REPLACE_ALL );
+        test_v_long( test, ( records[ 1 ].source == addr( string2 ) ), 1 );
+        test_v_long( test, records[ 1 ].length, 5 );
+        test_v_long( test, records[ 2 ].operation, HZSTR_TRACE_SQUEEZE );
+        test_v_long( test, records[ 3 ].operation, HZSTR_TRACE_TRIM_RIGHT );
+        test_v_long( test, records[ 4 ].operation, HZSTR_TRACE_EQUAL );
+        test_v_long( test, ( records[ 4 ].source == addr( string2 ) ), 1 );
+        hzstr_trace_unload( records );
+        hzstr_destroy( strings[ 0 ] );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trace_load(), imports and compaction" );
+        string = hzstr_create( 0 );
+        hzstr_trace_start( TRACE_PATH );
+        hzstr_import( string, "Hello", 64 );
+        result = hzstr_import_utf8( string, "Hello World", 5 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        strings[ 1 ] = string;
+        hzstr_compact_all( strings, 3 );
+        hzstr_trace_stop();
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_long( test, count, 3 );
+        test_v_long( test, records[ 0 ].operation, HZSTR_TRACE_IMPORT );
+        test_v_long( test, records[ 0 ].length, 5 );
+        test_v_long( test, records[ 1 ].operation, HZSTR_TRACE_IMPORT_UTF8 );
+        test_v_long( test, records[ 1 ].length, 5 );
+        test_v_long( test, records[ 2 ].operation, HZSTR_TRACE_COMPACT_ALL );
+        test_v_long( test, ( records[ 2 ].target == addr( string ) ), 1 );
+        hzstr_trace_unload( records );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trace_sprintf(), printed length recorded" );
+        string = hzstr_create( 0 );
+        memset( long_text, 'x', 300 );
+        long_text[ 300 ] = '\0';
+        hzstr_trace_start( TRACE_PATH );
+        result = hzstr_sprintf( string, "%d:%s", 42, "abc" );
+        test_v_long( test, result, 6 );
+        test_v_str( test, hzstr_cstr( string ), "42:abc" );
+        result = hzstr_sprintf( string, "<%s>", long_text );
+        test_v_long( test, result, 302 );
+        test_v_long( test, hzstr_length( string ), 302 );
+        hzstr_trace_stop();
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_long( test, count, 2 );
+        test_v_long( test, records[ 0 ].operation, HZSTR_TRACE_SPRINTF );
+        test_v_long( test, records[ 0 ].length, 6 );
+        test_v_long( test, records[ 1 ].length, 302 );
+        hzstr_trace_unload( records );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trace_sprintf(), failed allocation" );
+        string = hzstr_create( 0 );
+        fail_mallocs[ fail_malloc ] = 1;
+        result = hzstr_sprintf( string, "<%s>", long_text );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_long( test, hzstr_length( string ), 0 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_LOADING
+    t_hdg( "Loading" );
+
+        t_sec( "hzstr_trace_load(), empty trace" );
+        hzstr_trace_start( TRACE_PATH );
+        hzstr_trace_stop();
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_ptr( test, records );
+        test_v_long( test, count, 0 );
+        hzstr_trace_unload( records );
+
+        t_sec( "hzstr_trace_load(), invalid traces" );
+        records = hzstr_trace_load( "build/missing.hzt", &count );
+        test_v_null( test, records );
+        test_v_long( test, count, 0 );
+        file = fopen( BAD_PATH, "wb" );
+        fputs( "not a trace, but long enough for a header", file );
+        fclose( file );
+        records = hzstr_trace_load( BAD_PATH, &count );
+        test_v_null( test, records );
+        records = hzstr_trace_load( NULL, &count );
+        test_v_null( test, records );
+
+        t_sec( "hzstr_trace_load(), failed allocation" );
+        hzstr_trace_start( TRACE_PATH );
+        string = hzstr_create( 0 );
+        hzstr_trace_stop();
+        fail_mallocs[ fail_malloc ] = 1;
+        records = hzstr_trace_load( TRACE_PATH, &count );
+        test_v_null( test, records );
+        test_v_long( test, count, 0 );
+        hzstr_destroy( string );
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
@@ -0,0 +1,657 @@
+/*****************************************************************************
+    hzutf8_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        Each sequence is checked at every position in a field of ASCII so
+        that sequences crossing the vector blocks are exercised.  The
+        expected results of the exhaustive checks come directly from the
+        well-formed byte sequence table in the Unicode standard (Table 3-7).
+
+        The folding checks encode every code point into one buffer, so the
+        vector and one-at-a-time paths must agree with hzstr_utf8_fold_cp()
+        on every code point.  The transcoders are checked the same way, by
+        converting every code point and back again.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzutf8.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define FIELD_SIZE ( 64 )           //size of the ASCII field for sweeps
+#define MAX_CODE ( 0x110000 )       //one past the last code point
+
+//flags of ASCII data
+#define ASCII ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 )
+
+//sweep a literal sequence through the field
+#define sweep_lit( _s, _e ) sweep( ( _s ), ( sizeof( _s ) - 1 ), ( _e ) )
+
+//define symbols to disable the corresponding test section
+//#define TNO_ASCII
+//#define TNO_VALID
+//#define TNO_INVALID
+//#define TNO_EXHAUSTIVE
+//#define TNO_FOLD
+//#define TNO_COUNT
+//#define TNO_CASECMP
+//#define TNO_TRANSCODE
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+char*                   buffer;
+unsigned long           code;
+hzstr_flags_t           flags;
+char*                   folded;
+int                     in_place;
+unsigned long           length;
+int                     mismatches;
+char                    output[ FIELD_SIZE ];
+long                    result;
+unsigned long           size;
+uint16_t                units16[ FIELD_SIZE ];
+uint32_t                units32[ FIELD_SIZE ];
+uint16_t*               wide16;
+uint32_t*               wide32;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static int encode(                  //encode a code point as UTF-8
+    unsigned long       code,       //code point to encode
+    char*               output      //output buffer (at least 4 bytes)
+);                                  //number of bytes written
+
+static hzstr_flags_t expected(      //expected result for a three-byte string
+    unsigned char       lead,       //first byte
+    unsigned char       second,     //second byte
+    unsigned char       third       //third byte
+);                                  //expected flags
+
+static int sweep(                   //check a sequence at every position
+    const char*         sequence,   //sequence to check
+    unsigned long       size,       //number of bytes in sequence
+    hzstr_flags_t       flags       //expected flags
+);                                  //number of mismatched results
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    buffer     = NULL;
+    code       = 0;
+    flags      = 0;
+    folded     = NULL;
+    in_place   = 0;
+    length     = 0;
+    mismatches = 0;
+    result     = 0;
+    size       = 0;
+    wide16     = NULL;
+    wide32     = NULL;
+    memset( units16, 0, sizeof( units16 ) );
+    memset( units32, 0, sizeof( units32 ) );
+    memset( output, 0, FIELD_SIZE );
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_ASCII
+    t_hdg( "ASCII Data" );
+
+        t_sec( "hzstr_utf8_check(), empty data" );
+        flags = hzstr_utf8_check( "", 0 );
+        test_v_long( test, flags, ASCII );
+
+        t_sec( "hzstr_utf8_check(), short ASCII" );
+        flags = hzstr_utf8_check( "Hello World", 11 );
+        test_v_long( test, flags, ASCII );
+
+        t_sec( "hzstr_utf8_check(), every ASCII character" );
+        buffer = malloc( 128 );
+        for( code = 0; code < 128; ++code ) {
+            buffer[ code ] = ( char ) code;
+        }
+        flags = hzstr_utf8_check( buffer, 128 );
+        test_v_long( test, flags, ASCII );
+        free( buffer );
+
+        t_sec( "hzstr_utf8_check(), every length" );
+        mismatches = sweep( "", 0, ASCII );
+        test_v_long( test, mismatches, 0 );
+#endif
+
+#ifndef TNO_VALID
+    t_hdg( "Valid UTF-8" );
+
+        t_sec( "hzstr_utf8_check(), two-byte sequence" );
+        mismatches = sweep_lit( "\xC3\xA9", HZSTR_FLG_UTF8 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), three-byte sequence" );
+        mismatches = sweep_lit( "\xE2\x82\xAC", HZSTR_FLG_UTF8 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), four-byte sequence" );
+        mismatches = sweep_lit( "\xF0\x9F\x98\x80", HZSTR_FLG_UTF8 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), range limits" );
+        mismatches  = sweep_lit( "\xC2\x80", HZSTR_FLG_UTF8 );
+        mismatches += sweep_lit( "\xDF\xBF", HZSTR_FLG_UTF8 );
+        mismatches += sweep_lit( "\xE0\xA0\x80", HZSTR_FLG_UTF8 );
+        mismatches += sweep_lit( "\xED\x9F\xBF", HZSTR_FLG_UTF8 );
+        mismatches += sweep_lit( "\xEE\x80\x80", HZSTR_FLG_UTF8 );
+        mismatches += sweep_lit( "\xEF\xBF\xBF", HZSTR_FLG_UTF8 );
+        mismatches += sweep_lit( "\xF0\x90\x80\x80", HZSTR_FLG_UTF8 );
+        mismatches += sweep_lit( "\xF4\x8F\xBF\xBF", HZSTR_FLG_UTF8 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), every code point" );
+        buffer = malloc( MAX_CODE * 4 );
+        length = 0;
+        for( code = 0; code < MAX_CODE; ++code ) {
+            if( ( code < 0xD800 ) || ( code > 0xDFFF ) ) {
+                length += encode( code, ( buffer + length ) );
+            }
+        }
+        flags = hzstr_utf8_check( buffer, length );
+        test_v_long( test, flags, HZSTR_FLG_UTF8 );
+        free( buffer );
+#endif
+
+#ifndef TNO_INVALID
+    t_hdg( "Invalid UTF-8" );
+
+        t_sec( "hzstr_utf8_check(), stray continuation bytes" );
+        mismatches  = sweep_lit( "\x80", 0 );
+        mismatches += sweep_lit( "\xBF", 0 );
+        mismatches += sweep_lit( "\xC3\xA9\xA9", 0 );
+        mismatches += sweep_lit( "\xE2\x82\xAC\x80", 0 );
+        mismatches += sweep_lit( "\xF0\x9F\x98\x80\x80", 0 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), truncated sequences" );
+        mismatches  = sweep_lit( "\xC3", 0 );
+        mismatches += sweep_lit( "\xE2\x82", 0 );
+        mismatches += sweep_lit( "\xF0\x9F\x98", 0 );
+        mismatches += sweep_lit( "\xC3\xC3\xA9", 0 );
+        mismatches += sweep_lit( "\xE2\xC3\xA9", 0 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), overlong forms" );
+        mismatches  = sweep_lit( "\xC0\x80", 0 );
+        mismatches += sweep_lit( "\xC1\xBF", 0 );
+        mismatches += sweep_lit( "\xE0\x80\x80", 0 );
+        mismatches += sweep_lit( "\xE0\x9F\xBF", 0 );
+        mismatches += sweep_lit( "\xF0\x80\x80\x80", 0 );
+        mismatches += sweep_lit( "\xF0\x8F\xBF\xBF", 0 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), surrogates" );
+        mismatches  = sweep_lit( "\xED\xA0\x80", 0 );
+        mismatches += sweep_lit( "\xED\xBF\xBF", 0 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), code points too large" );
+        mismatches  = sweep_lit( "\xF4\x90\x80\x80", 0 );
+        mismatches += sweep_lit( "\xF5\x80\x80\x80", 0 );
+        mismatches += sweep_lit( "\xF8\x88\x80\x80\x80", 0 );
+        mismatches += sweep_lit( "\xFE", 0 );
+        mismatches += sweep_lit( "\xFF", 0 );
+        test_v_long( test, mismatches, 0 );
+
+        t_sec( "hzstr_utf8_check(), error after valid sequences" );
+        buffer = malloc( 4096 );
+        length = 0;
+        while( length < 4000 ) {
+            length += encode( ( 0x100 + length ), ( buffer + length ) );
+        }
+        buffer[ length - 1 ] = 'x';
+        flags = hzstr_utf8_check( buffer, length );
+        test_v_long( test, flags, 0 );
+        free( buffer );
+#endif
+
+#ifndef TNO_EXHAUSTIVE
+    t_hdg( "Exhaustive Checks" );
+
+        t_sec( "hzstr_utf8_check(), every three-byte string" );
+        buffer = malloc( FIELD_SIZE );
+        memset( buffer, 'a', FIELD_SIZE );
+        for( code = 0; code < 0x1000000; ++code ) {
+            buffer[ 14 ] = ( char ) ( code >> 16 );
+            buffer[ 15 ] = ( char ) ( code >> 8 );
+            buffer[ 16 ] = ( char ) code;
+            flags = hzstr_utf8_check( buffer, FIELD_SIZE );
+            if( flags != expected( ( code >> 16 ), ( code >> 8 ), code ) ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        free( buffer );
+#endif
+
+#ifndef TNO_FOLD
+    t_hdg( "Case Folding" );
+
+        t_sec( "hzstr_utf8_fold_cp(), ASCII" );
+        test_v_long( test, hzstr_utf8_fold_cp( 'A' ), 'a' );
+        test_v_long( test, hzstr_utf8_fold_cp( 'Z' ), 'z' );
+        test_v_long( test, hzstr_utf8_fold_cp( 'a' ), 'a' );
+        test_v_long( test, hzstr_utf8_fold_cp( '@' ), '@' );
+        test_v_long( test, hzstr_utf8_fold_cp( '[' ), '[' );
+
+        t_sec( "hzstr_utf8_fold_cp(), simple folding" );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x03A3 ), 0x03C3 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x03C2 ), 0x03C3 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x212A ), 'k' );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x017F ), 's' );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x1E9E ), 0x00DF );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x0130 ), 0x0130 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x13F8 ), 0x13F0 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0xAB70 ), 0x13A0 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x10400 ), 0x10428 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x1E900 ), 0x1E922 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x1E922 ), 0x1E922 );
+        test_v_long( test, hzstr_utf8_fold_cp( 0x10FFFF ), 0x10FFFF );
+
+        t_sec( "hzstr_utf8_fold(), ASCII" );
+        length = hzstr_utf8_fold( output, "Hello WORLD [@]", 15 );
+        test_v_long( test, length, 15 );
+        test_v_mem( test, output, "hello world [@]", 15 );
+
+        t_sec( "hzstr_utf8_fold(), mixed text in place" );
+        strcpy( output, "THE QUICK BROWN FOX \xCE\xA3\xC5\xBF\xE2\x84\xAA" );
+        length = hzstr_utf8_fold_size( output, 27, &in_place );
+        test_v_long( test, length, 24 );
+        test_v_long( test, in_place, 1 );
+        length = hzstr_utf8_fold( output, output, 27 );
+        test_v_long( test, length, 24 );
+        test_v_mem( test, output, "the quick brown fox \xCF\x83sk", 24 );
+
+        t_sec( "hzstr_utf8_fold(), folding that grows" );
+        length = hzstr_utf8_fold_size( "x\xC8\xBAy", 4, &in_place );
+        test_v_long( test, length, 5 );
+        test_v_long( test, in_place, 0 );
+        length = hzstr_utf8_fold( output, "x\xC8\xBAy", 4 );
+        test_v_long( test, length, 5 );
+        test_v_mem( test, output, "x\xE2\xB1\xA5y", 5 );
+
+        t_sec( "hzstr_utf8_fold(), invalid bytes are copied" );
+        length = hzstr_utf8_fold( output, "A\xFF" "B\xC3\xC3\x89" "C\xC3", 8 );
+        test_v_long( test, length, 8 );
+        test_v_mem( test, output, "a\xFF" "b\xC3\xC3\xA9" "c\xC3", 8 );
+
+        t_sec( "hzstr_utf8_fold(), every code point" );
+        buffer = malloc( MAX_CODE * 4 );
+        folded = malloc( MAX_CODE * 4 );
+        length = 0;
+        for( code = 0; code < MAX_CODE; ++code ) {
+            if( ( code < 0xD800 ) || ( code > 0xDFFF ) ) {
+                length += encode( code, ( buffer + length ) );
+            }
+        }
+        result = hzstr_utf8_fold_size( buffer, length, &in_place );
+        test_v_long( test, in_place, 0 );
+        test_v_long( test, hzstr_utf8_fold( folded, buffer, length ), result );
+        length = 0;
+        for( code = 0; code < MAX_CODE; ++code ) {
+            if( ( code < 0xD800 ) || ( code > 0xDFFF ) ) {
+                size = encode( hzstr_utf8_fold_cp( code ), output );
+                if( memcmp( output, ( folded + length ), size ) != 0 ) {
+                    mismatches += 1;
+                }
+                length += size;
+            }
+        }
+        test_v_long( test, length, result );
+        test_v_long( test, mismatches, 0 );
+        free( folded );
+        free( buffer );
+#endif
+
+#ifndef TNO_COUNT
+    t_hdg( "Code Points" );
+
+        t_sec( "hzstr_utf8_count()" );
+        test_v_long( test, hzstr_utf8_count( "", 0 ), 0 );
+        test_v_long( test, hzstr_utf8_count( "a\xC3\xA9\xE2\x82\xAC", 6 ), 3 );
+        test_v_long( test, hzstr_utf8_count( "\x80\x80", 2 ), 0 );
+
+        t_sec( "hzstr_utf8_offset()" );
+        strcpy( output, "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" );
+        test_v_long( test, hzstr_utf8_offset( output, 10, 0 ), 0 );
+        test_v_long( test, hzstr_utf8_offset( output, 10, 1 ), 1 );
+        test_v_long( test, hzstr_utf8_offset( output, 10, 2 ), 3 );
+        test_v_long( test, hzstr_utf8_offset( output, 10, 3 ), 6 );
+        test_v_long( test, hzstr_utf8_offset( output, 10, 4 ), 10 );
+        test_v_long( test, hzstr_utf8_offset( output, 10, 5 ), 10 );
+
+        t_sec( "hzstr_utf8_count(), hzstr_utf8_offset(), long text" );
+        buffer = malloc( 4096 );
+        length = 0;
+        for( code = 0; code < 1000; ++code ) {
+            length += encode(
+                ( ( code % 3 ) == 0 ? 'a' : 0xE9 ), ( buffer + length )
+            );
+        }
+        test_v_long( test, hzstr_utf8_count( buffer, length ), 1000 );
+        for( code = 0; code < 1000; ++code ) {
+            //each group of three code points is 5 bytes ("a" and two "é")
+            size = ( ( code / 3 ) * 5 ) + ( ( code % 3 ) * 2 )
+                 - ( ( code % 3 ) != 0 );
+            if( hzstr_utf8_offset( buffer, length, code ) != size ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        test_v_long( test, hzstr_utf8_offset( buffer, length, 1000 ), length );
+        free( buffer );
+#endif
+
+#ifndef TNO_CASECMP
+    t_hdg( "Case-Insensitive Comparison" );
+
+        t_sec( "hzstr_utf8_casecmp(), ASCII" );
+        result = hzstr_utf8_casecmp( "Hello", 5, "hELLO", 5 );
+        test_v_long( test, result, 0 );
+        result = hzstr_utf8_casecmp( "abc", 3, "ABD", 3 );
+        test_v_long( test, ( result < 0 ), 1 );
+        result = hzstr_utf8_casecmp( "abd", 3, "ABC", 3 );
+        test_v_long( test, ( result > 0 ), 1 );
+        result = hzstr_utf8_casecmp( "ab", 2, "ABC", 3 );
+        test_v_long( test, ( result < 0 ), 1 );
+        result = hzstr_utf8_casecmp( "abc", 3, "AB", 2 );
+        test_v_long( test, ( result > 0 ), 1 );
+        result = hzstr_utf8_casecmp( "", 0, "", 0 );
+        test_v_long( test, result, 0 );
+
+        t_sec( "hzstr_utf8_casecmp(), long ASCII" );
+        strcpy( output, "The Quick Brown Fox Jumps Over The Lazy Dog" );
+        result = hzstr_utf8_casecmp(
+            output, 43, "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG", 43
+        );
+        test_v_long( test, result, 0 );
+        result = hzstr_utf8_casecmp(
+            output, 43, "THE QUICK BROWN FOX JUMPS OVER THE LAZY COG", 43
+        );
+        test_v_long( test, ( result > 0 ), 1 );
+
+        t_sec( "hzstr_utf8_casecmp(), folded code points" );
+        result = hzstr_utf8_casecmp( "\xCE\xA3", 2, "\xCF\x82", 2 );
+        test_v_long( test, result, 0 );
+        result = hzstr_utf8_casecmp( "\xE2\x84\xAA" "elvin", 8, "KELVIN", 6 );
+        test_v_long( test, result, 0 );
+        result = hzstr_utf8_casecmp(
+            "Stra\xE1\xBA\x9E" "e -- 16 bytes in", 23,
+            "STRA\xC3\x9F" "E -- 16 BYTES IN", 22
+        );
+        test_v_long( test, result, 0 );
+        result = hzstr_utf8_casecmp( "stra\xC3\x9F" "e", 7, "STRASSE", 7 );
+        test_v_long( test, ( result != 0 ), 1 );
+
+        t_sec( "hzstr_utf8_casecmp(), invalid bytes" );
+        result = hzstr_utf8_casecmp( "a\xFF", 2, "A\xFF", 2 );
+        test_v_long( test, result, 0 );
+        result = hzstr_utf8_casecmp( "\xFF", 1, "\xF4\x8F\xBF\xBF", 4 );
+        test_v_long( test, ( result > 0 ), 1 );
+#endif
+
+#ifndef TNO_TRANSCODE
+    t_hdg( "Transcoding" );
+
+        t_sec( "UTF-8 to UTF-16 and back, every code point" );
+        buffer = malloc( MAX_CODE * 4 );
+        folded = malloc( MAX_CODE * 4 );
+        wide16 = malloc( MAX_CODE * 2 * sizeof( uint16_t ) );
+        length = 0;
+        for( code = 0; code < MAX_CODE; ++code ) {
+            if( ( code < 0xD800 ) || ( code > 0xDFFF ) ) {
+                length += encode( code, ( buffer + length ) );
+            }
+        }
+        size = hzstr_utf8_to_utf16_size( buffer, length );
+        test_v_long( test, size, ( 0x10000 - 0x800 + ( 0x100000 * 2 ) ) );
+        result = hzstr_utf8_to_utf16( wide16, buffer, length );
+        test_v_long( test, result, size );
+        test_v_long( test, wide16[ 0xD7FF ], 0xD7FF );
+        test_v_long( test, wide16[ 0xF800 ], 0xD800 );
+        test_v_long( test, wide16[ 0xF801 ], 0xDC00 );
+        result = hzstr_utf8_from_utf16_size( wide16, size );
+        test_v_long( test, result, length );
+        result = hzstr_utf8_from_utf16( folded, wide16, size );
+        test_v_long( test, result, length );
+        test_v_long( test, memcmp( folded, buffer, length ), 0 );
+        free( wide16 );
+        free( folded );
+        free( buffer );
+
+        t_sec( "UTF-8 to UTF-32 and back, every code point" );
+        buffer = malloc( MAX_CODE * 4 );
+        folded = malloc( MAX_CODE * 4 );
+        wide32 = malloc( MAX_CODE * sizeof( uint32_t ) );
+        length = 0;
+        for( code = 0; code < MAX_CODE; ++code ) {
+            if( ( code < 0xD800 ) || ( code > 0xDFFF ) ) {
+                length += encode( code, ( buffer + length ) );
+            }
+        }
+        size = hzstr_utf8_to_utf32_size( buffer, length );
+        test_v_long( test, size, ( MAX_CODE - 0x800 ) );
+        result = hzstr_utf8_to_utf32( wide32, buffer, length );
+        test_v_long( test, result, size );
+        for( code = 0; code < size; ++code ) {
+            if( wide32[ code ] != ( code + ( code < 0xD800 ? 0 : 0x800 ) ) ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        result = hzstr_utf8_from_utf32_size( wide32, size );
+        test_v_long( test, result, length );
+        result = hzstr_utf8_from_utf32( folded, wide32, size );
+        test_v_long( test, result, length );
+        test_v_long( test, memcmp( folded, buffer, length ), 0 );
+        free( wide32 );
+        free( folded );
+        free( buffer );
+
+        t_sec( "hzstr_utf8_to_utf16(), invalid sequences" );
+        strcpy( output, "a\xFF" "b\xE2\x82\xF0\x9F\x98\x80" );
+        size = hzstr_utf8_to_utf16_size( output, 9 );
+        test_v_long( test, size, 7 );
+        size = hzstr_utf8_to_utf16( units16, output, 9 );
+        test_v_long( test, size, 7 );
+        test_v_long( test, units16[ 1 ], 0xFFFD );
+        test_v_long( test, units16[ 3 ], 0xFFFD );
+        test_v_long( test, units16[ 4 ], 0xFFFD );
+        test_v_long( test, units16[ 5 ], 0xD83D );
+        test_v_long( test, units16[ 6 ], 0xDE00 );
+
+        t_sec( "hzstr_utf8_to_utf32(), invalid sequences" );
+        size = hzstr_utf8_to_utf32_size( "\x80\xC3", 2 );
+        test_v_long( test, size, 2 );
+        size = hzstr_utf8_to_utf32( units32, "\x80\xC3", 2 );
+        test_v_long( test, size, 2 );
+        test_v_long( test, units32[ 0 ], 0xFFFD );
+        test_v_long( test, units32[ 1 ], 0xFFFD );
+
+        t_sec( "hzstr_utf8_from_utf16(), unpaired surrogates" );
+        units16[ 0 ] = 0xDC00;
+        units16[ 1 ] = 'a';
+        units16[ 2 ] = 0xD800;
+        test_v_long( test, hzstr_utf8_from_utf16_size( units16, 3 ), 7 );
+        test_v_long( test, hzstr_utf8_from_utf16( output, units16, 3 ), 7 );
+        test_v_str( test, output, "\xEF\xBF\xBD" "a\xEF\xBF\xBD" );
+
+        t_sec( "hzstr_utf8_from_utf32(), invalid code points" );
+        units32[ 0 ] = 0x110000;
+        units32[ 1 ] = 0xDFFF;
+        units32[ 2 ] = 0xFFFFFFFF;
+        units32[ 3 ] = 'a';
+        test_v_long( test, hzstr_utf8_from_utf32_size( units32, 4 ), 10 );
+        test_v_long( test, hzstr_utf8_from_utf32( output, units32, 4 ), 10 );
+        test_v_str( test, output, "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD" "a" );
+
+        t_sec( "UTF-8 to UTF-16 and back, every position" );
+        for( code = 0; code < ( FIELD_SIZE - 4 ); ++code ) {
+            memset( output, 'a', FIELD_SIZE );
+            memcpy( ( output + code ), "\xF0\x9F\x98\x80", 4 );
+            size = hzstr_utf8_to_utf16( units16, output, FIELD_SIZE );
+            length = hzstr_utf8_from_utf16(
+                ( char* ) units32, units16, size
+            );
+            if( ( size != hzstr_utf8_to_utf16_size( output, FIELD_SIZE ) )
+             || ( length != hzstr_utf8_from_utf16_size( units16, size ) )
+             || ( memcmp( units32, output, FIELD_SIZE ) != 0 ) ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+#endif
+
+    return 0;
+}
+
+
+/*==========================================================================*/
+static int encode(                  //encode a code point as UTF-8
+    unsigned long       code,       //code point to encode
+    char*               output      //output buffer (at least 4 bytes)
+) {                                 //number of bytes written
+    if( code < 0x80 ) {
+        output[ 0 ] = ( char ) code;
+        return 1;
+    }
+    if( code < 0x800 ) {
+        output[ 0 ] = ( char ) ( 0xC0 | ( code >> 6 ) );
+        output[ 1 ] = ( char ) ( 0x80 | ( code & 0x3F ) );
+        return 2;
+    }
+    if( code < 0x10000 ) {
+        output[ 0 ] = ( char ) ( 0xE0 | ( code >> 12 ) );
+        output[ 1 ] = ( char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+        output[ 2 ] = ( char ) ( 0x80 | ( code & 0x3F ) );
+        return 3;
+    }
+    output[ 0 ] = ( char ) ( 0xF0 | ( code >> 18 ) );
+    output[ 1 ] = ( char ) ( 0x80 | ( ( code >> 12 ) & 0x3F ) );
+    output[ 2 ] = ( char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+    output[ 3 ] = ( char ) ( 0x80 | ( code & 0x3F ) );
+    return 4;
+}
+
+
+/*==========================================================================*/
+static hzstr_flags_t expected(      //expected result for a three-byte string
+    unsigned char       lead,       //first byte
+    unsigned char       second,     //second byte
+    unsigned char       third       //third byte
+) {                                 //expected flags
+    unsigned char       bytes[ 3 ];
+    unsigned char       high;
+    int                 index;
+    unsigned char       low;
+    int                 size;
+
+    //the string is surrounded by ASCII, so each sequence must be complete
+    bytes[ 0 ] = lead;
+    bytes[ 1 ] = second;
+    bytes[ 2 ] = third;
+    if( ( lead < 0x80 ) && ( second < 0x80 ) && ( third < 0x80 ) ) {
+        return ASCII;
+    }
+    for( index = 0; index < 3; index += size ) {
+        low  = 0x80;
+        high = 0xBF;
+        if( bytes[ index ] < 0x80 ) {
+            size = 1;
+            continue;
+        }
+        else if( ( bytes[ index ] >= 0xC2 ) && ( bytes[ index ] <= 0xDF ) ) {
+            size = 2;
+        }
+        else if( ( bytes[ index ] >= 0xE0 ) && ( bytes[ index ] <= 0xEF ) ) {
+            size = 3;
+            low  = bytes[ index ] == 0xE0 ? 0xA0 : 0x80;
+            high = bytes[ index ] == 0xED ? 0x9F : 0xBF;
+        }
+        else {
+            return 0;
+        }
+        if( ( index + size ) > 3 ) {
+            return 0;
+        }
+        if( ( bytes[ index + 1 ] < low ) || ( bytes[ index + 1 ] > high ) ) {
+            return 0;
+        }
+        if( ( size == 3 ) && ( ( bytes[ index + 2 ] & 0xC0 ) != 0x80 ) ) {
+            return 0;
+        }
+    }
+    return HZSTR_FLG_UTF8;
+}
+
+
+/*==========================================================================*/
+static int sweep(                   //check a sequence at every position
+    const char*         sequence,   //sequence to check
+    unsigned long       size,       //number of bytes in sequence
+    hzstr_flags_t       flags       //expected flags
+) {                                 //number of mismatched results
+    char                field[ FIELD_SIZE ];
+    int                 mismatches;
+    unsigned long       offset;
+
+    mismatches = 0;
+    for( offset = 0; ( offset + size ) <= FIELD_SIZE; ++offset ) {
+        memset( field, 'a', FIELD_SIZE );
+        memcpy( ( field + offset ), sequence, size );
+
+        //followed by ASCII
+        if( hzstr_utf8_check( field, FIELD_SIZE ) != flags ) {
+            mismatches += 1;
+        }
+
+        //at the very end of the data
+        if( hzstr_utf8_check( field, ( offset + size ) ) != flags ) {
+            mismatches += 1;
+        }
+    }
+    return mismatches;
+}
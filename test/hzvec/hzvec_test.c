@@ -0,0 +1,450 @@
+/*****************************************************************************
+    hzvec_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzvec.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define BUFFER_SIZE ( 65536 )
+#define VEC_PATH "build/test.hzv"
+
+//define symbols to disable the corresponding test section
+//#define TNO_CREATE
+//#define TNO_APPEND
+//#define TNO_BULK
+//#define TNO_SAVE
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+char                    buffer[ BUFFER_SIZE ];
+FILE*                   file;
+hzstr_hash_t            hashes[ 4 ];
+int                     mismatches;
+unsigned long           position;
+hzstr_result_t          result;
+hzstr_type*             string;
+hzstr_vec_type*         vec;
+hzstr_vec_type*         vec2;
+hzstr_type              view;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    memset( hashes, 0, sizeof( hashes ) );
+    memset( &view,  0, sizeof( hzstr_type ) );
+    file       = NULL;
+    mismatches = 0;
+    position   = 0;
+    result     = 0;
+    string     = NULL;
+    vec        = NULL;
+    vec2       = NULL;
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_CREATE
+    t_hdg( "Vector Creation" );
+
+        t_sec( "hzstr_vec_create(), empty vector" );
+        vec = hzstr_vec_create( 0, 0 );
+        test_v_ptr( test, vec );
+        test_v_long( test, hzstr_vec_count( vec ), 0 );
+        test_v_long( test, hzstr_vec_chars( vec ), 0 );
+        test_v_long( test, vec->slots, HZSTR_CHUNK_SIZE );
+        test_v_long( test, vec->alloc, HZSTR_CHUNK_SIZE );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_create(), initial sizes" );
+        vec = hzstr_vec_create( 1000, 8000 );
+        test_v_long( test, vec->slots, 1000 );
+        test_v_long( test, vec->alloc, 8000 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_create(), failed object allocation" );
+        fail_callocs[ 0 ] = 1;
+        vec = hzstr_vec_create( 0, 0 );
+        test_v_null( test, vec );
+
+        t_sec( "hzstr_vec_create(), failed data allocation" );
+        fail_mallocs[ 1 ] = 1;
+        vec = hzstr_vec_create( 0, 0 );
+        test_v_null( test, vec );
+
+        t_sec( "hzstr_vec_destroy(), invalid object" );
+        hzstr_vec_destroy( NULL );
+#endif
+
+#ifndef TNO_APPEND
+    t_hdg( "Vector Append and Views" );
+
+        t_sec( "hzstr_vec_append()" );
+        vec = hzstr_vec_create( 0, 0 );
+        string = hzstr_create_cstr( "Hello" );
+        result = hzstr_vec_append( vec, string );
+        test_v_long( test, result, 0 );
+        hzstr_cpy_cstr( string, "World" );
+        result = hzstr_vec_append( vec, string );
+        test_v_long( test, result, 1 );
+        hzstr_cpy_cstr( string, "" );
+        result = hzstr_vec_append( vec, string );
+        test_v_long( test, result, 2 );
+        test_v_long( test, hzstr_vec_count( vec ), 3 );
+        test_v_long( test, hzstr_vec_chars( vec ), 10 );
+        test_v_long( test, hzstr_vec_length( vec, 1 ), 5 );
+        test_v_long( test, hzstr_vec_length( vec, 2 ), 0 );
+        hzstr_destroy( string );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_view()" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        hzstr_vec_append_cstr_n( vec, "World", 5 );
+        result = hzstr_vec_view( vec, 1, &view );
+        test_v_long( test, result, 5 );
+        test_v_long( test, view.type, HZSTR_TYPE_SUBSTR );
+        test_v_mem( test, view.data, "World", 5 );
+        string = hzstr_create_cstr( "World" );
+        test_v_long( test, hzstr_cmp( &view, string ), 0 );
+        hzstr_destroy( string );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_view(), invalid usage" );
+        vec = hzstr_vec_create( 0, 0 );
+        result = hzstr_vec_view( vec, 0, &view );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_vec_view( NULL, 0, &view );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        result = hzstr_vec_view( vec, 0, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_append(), growth" );
+        vec = hzstr_vec_create( 0, 0 );
+        for( position = 0; position < 1000; ++position ) {
+            sprintf( buffer, "string %lu", position );
+            hzstr_vec_append_cstr_n( vec, buffer, strlen( buffer ) );
+        }
+        test_v_long( test, hzstr_vec_count( vec ), 1000 );
+        test_v_boolean( test, ( vec->slots >= 1000 ), 1 );
+        for( position = 0; position < 1000; ++position ) {
+            sprintf( buffer, "string %lu", position );
+            hzstr_vec_view( vec, position, &view );
+            if( ( view.length != strlen( buffer ) )
+             || ( memcmp( view.data, buffer, view.length ) != 0 ) ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_append(), a view of the same vector" );
+        vec = hzstr_vec_create( 1, 32 );
+        memset( buffer, 'x', 30 );
+        hzstr_vec_append_cstr_n( vec, buffer, 30 );
+        hzstr_vec_view( vec, 0, &view );
+        result = hzstr_vec_append( vec, &view );
+        test_v_long( test, result, 1 );
+        test_v_long( test, fail_realloc, 2 );
+        hzstr_vec_view( vec, 1, &view );
+        test_v_long( test, view.length, 30 );
+        test_v_mem( test, view.data, buffer, 30 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_append(), failed reallocation" );
+        vec = hzstr_vec_create( 1, 32 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        fail_reallocs[ 0 ] = 1;
+        result = hzstr_vec_append_cstr_n( vec, "World", 5 );
+        test_v_long( test, result, HZSTR_RSLT_ALLOC );
+        test_v_long( test, hzstr_vec_count( vec ), 1 );
+        test_v_long( test, hzstr_vec_chars( vec ), 5 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_append(), string too long" );
+        vec = hzstr_vec_create( 0, 0 );
+        memset( buffer, 'x', 65535 );
+        result = hzstr_vec_append_cstr_n( vec, buffer, 65535 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        result = hzstr_vec_append_cstr_n( vec, buffer, 65534 );
+        test_v_long( test, result, 0 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_append(), invalid usage" );
+        vec = hzstr_vec_create( 0, 0 );
+        result = hzstr_vec_append( vec, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_vec_append_cstr_n( NULL, "Hello", 5 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_vec_append_cstr_n( vec, NULL, 5 );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_clear()" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        hzstr_vec_clear( vec );
+        test_v_long( test, hzstr_vec_count( vec ), 0 );
+        test_v_long( test, hzstr_vec_chars( vec ), 0 );
+        result = hzstr_vec_append_cstr_n( vec, "World", 5 );
+        test_v_long( test, result, 0 );
+        hzstr_vec_destroy( vec );
+#endif
+
+#ifndef TNO_BULK
+    t_hdg( "Vector Bulk Operations" );
+
+        t_sec( "hzstr_vec_tolower()" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        hzstr_vec_append_cstr_n( vec, "WORLD 42", 8 );
+        result = hzstr_vec_tolower( vec );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        hzstr_vec_view( vec, 0, &view );
+        test_v_mem( test, view.data, "hello", 5 );
+        hzstr_vec_view( vec, 1, &view );
+        test_v_mem( test, view.data, "world 42", 8 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_tolower(), more characters than a string" );
+        vec = hzstr_vec_create( 0, 0 );
+        memset( buffer, 'A', 40000 );
+        hzstr_vec_append_cstr_n( vec, buffer, 40000 );
+        hzstr_vec_append_cstr_n( vec, buffer, 40000 );
+        hzstr_vec_tolower( vec );
+        for( position = 0; position < hzstr_vec_chars( vec ); ++position ) {
+            if( vec->data[ position ] != 'a' ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_tolower(), invalid usage" );
+        result = hzstr_vec_tolower( NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+
+        t_sec( "hzstr_vec_hash()" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        hzstr_vec_append_cstr_n( vec, "", 0 );
+        hzstr_vec_append_cstr_n( vec, "World", 5 );
+        result = hzstr_vec_hash( vec, hashes );
+        test_v_long( test, result, 3 );
+        string = hzstr_create_cstr( "Hello" );
+        test_v_long( test, hashes[ 0 ], hzstr_hash( string ) );
+        hzstr_cpy_cstr( string, "" );
+        test_v_long( test, hashes[ 1 ], hzstr_hash( string ) );
+        hzstr_cpy_cstr( string, "World" );
+        test_v_long( test, hashes[ 2 ], hzstr_hash( string ) );
+        hzstr_destroy( string );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_hash(), invalid usage" );
+        vec = hzstr_vec_create( 0, 0 );
+        result = hzstr_vec_hash( vec, NULL );
+        test_v_long( test, result, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        result = hzstr_vec_hash( vec, NULL );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        result = hzstr_vec_hash( NULL, hashes );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        hzstr_vec_destroy( vec );
+#endif
+
+#ifndef TNO_SAVE
+    t_hdg( "Vector Save and Load" );
+
+        t_sec( "hzstr_vec_save(), hzstr_vec_load()" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        hzstr_vec_append_cstr_n( vec, "", 0 );
+        hzstr_vec_append_cstr_n( vec, "World", 5 );
+        result = hzstr_vec_save( vec, VEC_PATH );
+        test_v_long( test, result, 3 );
+        vec2 = hzstr_vec_load( VEC_PATH );
+        test_v_ptr( test, vec2 );
+        test_v_long( test, hzstr_vec_count( vec2 ), 3 );
+        test_v_long( test, hzstr_vec_chars( vec2 ), 10 );
+        test_v_mem(
+            test, vec2->offsets, vec->offsets, ( 4 * sizeof( uint32_t ) )
+        );
+        test_v_mem( test, vec2->data, "HelloWorld", 10 );
+        hzstr_vec_destroy( vec2 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_load(), empty vector" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_save( vec, VEC_PATH );
+        vec2 = hzstr_vec_load( VEC_PATH );
+        test_v_ptr( test, vec2 );
+        test_v_long( test, hzstr_vec_count( vec2 ), 0 );
+        result = hzstr_vec_append_cstr_n( vec2, "Hello", 5 );
+        test_v_long( test, result, 0 );
+        hzstr_vec_destroy( vec2 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_load(), truncated file" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        hzstr_vec_save( vec, VEC_PATH );
+        file = fopen( VEC_PATH, "rb" );
+        position = fread( buffer, 1, BUFFER_SIZE, file );
+        fclose( file );
+        file = fopen( VEC_PATH, "wb" );
+        fwrite( buffer, 1, ( position - 1 ), file );
+        fclose( file );
+        vec2 = hzstr_vec_load( VEC_PATH );
+        test_v_null( test, vec2 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_load(), invalid offsets" );
+        vec = hzstr_vec_create( 0, 0 );
+        hzstr_vec_append_cstr_n( vec, "Hello", 5 );
+        hzstr_vec_append_cstr_n( vec, "World", 5 );
+        vec->offsets[ 1 ] = 7;
+        vec->offsets[ 2 ] = 6;
+        hzstr_vec_save( vec, VEC_PATH );
+        vec2 = hzstr_vec_load( VEC_PATH );
+        test_v_null( test, vec2 );
+        hzstr_vec_destroy( vec );
+
+        t_sec( "hzstr_vec_load(), invalid usage" );
+        vec2 = hzstr_vec_load( "build/missing.hzv" );
+        test_v_null( test, vec2 );
+        vec2 = hzstr_vec_load( NULL );
+        test_v_null( test, vec2 );
+        result = hzstr_vec_save( NULL, VEC_PATH );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+        remove( VEC_PATH );
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
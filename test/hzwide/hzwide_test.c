@@ -0,0 +1,405 @@
+/*****************************************************************************
+    hzwide_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        This tests the string module built with 16-bit characters and without
+        C-string compatibility (see the Makefile).  C-strings are decoded
+        from UTF-8 into UTF-16, and encoded back into UTF-8 on export.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define BUFFER_SIZE ( 256 )         //size of C-string buffers
+
+//encoding flags of a string
+#define encoding( _s ) ( ( _s )->flags & ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 ) )
+#define ASCII ( HZSTR_FLG_ASCII | HZSTR_FLG_UTF8 )
+
+//verify the characters of a string against an array of characters
+#define test_v_chars( _t, _s, _a ) \
+    test_v_long( ( _t ), hzstr_length( _s ), \
+        ( sizeof( _a ) / sizeof( hzstr_char_t ) ) ); \
+    test_v_mem( ( _t ), ( _s )->data, ( _a ), sizeof( _a ) )
+
+//define symbols to disable the corresponding test section
+//#define TNO_CREATE
+//#define TNO_DECODE
+//#define TNO_CAT
+//#define TNO_SCAN
+//#define TNO_EXPORT
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+static const hzstr_char_t accented[] = { 'c', 'a', 'f', 0x00E9 };
+static const hzstr_char_t cjk[] = { 0x65E5, 0x672C, 0x8A9E };
+static const hzstr_char_t emoji[] = { 'x', 0xD83D, 0xDE00, 'y' };
+static const hzstr_char_t invalid[] = { 'a', 0xFFFD, 'b', 0xFFFD, 0xFFFD };
+static const hzstr_char_t joined[] = { 'a', 'b', 0x20AC, 'c', 'd', 0x20AC };
+static const hzstr_char_t lowered[] = {
+    'a', 0x0141, 'z', 0x015A, 0x0161, 'b', 0x0120, 0x3000, 'c', 0x2041,
+    'd', 'e', 'f', 0x0100, 'g', 'h', 'i', 0x0149, 'j', 'k'
+};
+static const hzstr_char_t world[] = {
+    'H', 'e', 'l', 'l', 'o', ' ', 'w', 0x00F6, 'r', 'l', 'd'
+};
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+char                    buffer[ BUFFER_SIZE ];
+int                     mismatches;
+hzstr_index_t           position;
+hzstr_result_t          result;
+hzstr_type*             string;
+hzstr_type*             string2;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    memset( buffer, 0, BUFFER_SIZE );
+    mismatches = 0;
+    position   = 0;
+    result     = 0;
+    string     = NULL;
+    string2    = NULL;
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_CREATE
+    t_hdg( "String Creation" );
+
+        t_sec( "hzstr_create_cstr(), ASCII" );
+        string = hzstr_create_cstr( "Hello" );
+        test_v_ptr( test, string );
+        test_v_long( test, hzstr_length( string ), 5 );
+        test_v_long( test, string->data[ 0 ], 'H' );
+        test_v_long( test, string->data[ 4 ], 'o' );
+        test_v_long( test, string->data[ 5 ], 0 );
+        test_v_long( test, encoding( string ), ASCII );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_create_cstr(), long ASCII" );
+        memset( buffer, 'z', 200 );
+        string = hzstr_create_cstr( buffer );
+        test_v_long( test, hzstr_length( string ), 200 );
+        for( position = 0; position < 200; ++position ) {
+            if( string->data[ position ] != 'z' ) {
+                mismatches += 1;
+            }
+        }
+        test_v_long( test, mismatches, 0 );
+        test_v_long( test, string->data[ 200 ], 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_hash(), same as the UTF-8 hash for ASCII" );
+        string = hzstr_create_cstr( "foobar" );
+        test_v_long( test, hzstr_hash( string ), 0xBF9CF968 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_DECODE
+    t_hdg( "UTF-8 Decoding" );
+
+        t_sec( "hzstr_cpy_cstr(), two-byte sequence" );
+        string = hzstr_create( 0 );
+        result = hzstr_cpy_cstr( string, "caf\xC3\xA9" );
+        test_v_long( test, result, 4 );
+        test_v_chars( test, string, accented );
+        test_v_long( test, encoding( string ), 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr(), surrogate pair" );
+        string = hzstr_create( 0 );
+        result = hzstr_cpy_cstr( string, "x\xF0\x9F\x98\x80y" );
+        test_v_long( test, result, 4 );
+        test_v_chars( test, string, emoji );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr(), invalid sequences" );
+        string = hzstr_create( 0 );
+        result = hzstr_cpy_cstr( string, "a\xFF" "b\xE2\x82" );
+        test_v_long( test, result, 5 );
+        test_v_chars( test, string, invalid );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cpy_cstr_n(), allocation sized in characters" );
+        string = hzstr_create( 0 );
+        for( position = 0; position < 10; ++position ) {
+            memcpy(
+                ( buffer + ( position * 9 ) ),
+                "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E",
+                9
+            );
+        }
+        result = hzstr_cpy_cstr_n( string, buffer, 90 );
+        test_v_long( test, result, 30 );
+        test_v_long( test, fail_realloc, 0 );
+        test_v_long( test, string->alloc, HZSTR_CHUNK_SIZE );
+        test_v_mem( test, ( string->data + 27 ), cjk, sizeof( cjk ) );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_CAT
+    t_hdg( "String Concatenation" );
+
+        t_sec( "hzstr_cat_cstr()" );
+        string = hzstr_create_cstr( "Hello " );
+        result = hzstr_cat_cstr( string, "w\xC3\xB6rld" );
+        test_v_long( test, result, 11 );
+        test_v_chars( test, string, world );
+        test_v_long( test, string->data[ 11 ], 0 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cat()" );
+        string = hzstr_create_cstr( "ab\xE2\x82\xAC" );
+        string2 = hzstr_create_cstr( "cd\xE2\x82\xAC" );
+        result = hzstr_cat( string, string2 );
+        test_v_long( test, result, 6 );
+        test_v_chars( test, string, joined );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_strchr(), wide character" );
+        string = hzstr_create_cstr( "ab\xE2\x82\xAC" "cd" );
+        position = hzstr_strchr( string, 0x20AC );
+        test_v_long( test, position, 2 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_SCAN
+    t_hdg( "Character Scans" );
+
+        //characters that share their low byte with an ASCII letter or space
+        //  must be compared as whole characters
+
+        t_sec( "hzstr_strchr(), long string" );
+        string = hzstr_create( 0 );
+        for( position = 0; position < 40; ++position ) {
+            hzstr_append( string, ( 0x0100 + 'x' ) );
+        }
+        string->data[ 33 ] = 'x';
+        position = hzstr_strchr( string, 'x' );
+        test_v_long( test, position, 33 );
+        position = hzstr_strchr( string, ( 0x0100 + 'x' ) );
+        test_v_long( test, position, 0 );
+        position = hzstr_strchr( string, 0x20AC );
+        test_v_long( test, position, HZSTR_INDEX_NONE );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_cmp(), long strings" );
+        string = hzstr_create_cstr( "The quick brown fox jumps" );
+        string2 = hzstr_create_cstr( "The quick brown fox jumps" );
+        test_v_long( test, hzstr_cmp( string, string2 ), 0 );
+        string2->data[ 20 ] = 0x0100 + 'j';
+        test_v_long( test, hzstr_cmp( string, string2 ), -0x0100 );
+        hzstr_destroy( string2 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_tolower(), long string" );
+        string = hzstr_create( 0 );
+        for( position = 0; position < 20; ++position ) {
+            hzstr_append( string, lowered[ position ] );
+        }
+        string->data[ 0 ] = 'A';
+        string->data[ 2 ] = 'Z';
+        string->data[ 10 ] = 'D';
+        string->data[ 19 ] = 'K';
+        result = hzstr_tolower( string );
+        test_v_long( test, result, HZSTR_RSLT_OK );
+        test_v_chars( test, string, lowered );
+        result = hzstr_toupper( string );
+        test_v_long( test, string->data[ 0 ], 'A' );
+        test_v_long( test, string->data[ 1 ], 0x0141 );
+        test_v_long( test, string->data[ 4 ], 0x0161 );
+        test_v_long( test, string->data[ 17 ], 0x0149 );
+        test_v_long( test, string->data[ 19 ], 'K' );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_trim(), long string" );
+        string = hzstr_create( 0 );
+        for( position = 0; position < 40; ++position ) {
+            hzstr_append( string, ' ' );
+        }
+        string->data[ 12 ] = 0x0120;
+        string->data[ 27 ] = 0x3000;
+        result = hzstr_trim( string );
+        test_v_long( test, result, 16 );
+        test_v_long( test, string->data[ 0 ], 0x0120 );
+        test_v_long( test, string->data[ 15 ], 0x3000 );
+        hzstr_destroy( string );
+#endif
+
+#ifndef TNO_EXPORT
+    t_hdg( "UTF-8 Export" );
+
+        t_sec( "hzstr_export_utf8()" );
+        string = hzstr_create_cstr( "x\xF0\x9F\x98\x80y caf\xC3\xA9" );
+        result = hzstr_export_utf8( string, NULL, 0 );
+        test_v_long( test, result, 12 );
+        result = hzstr_export_utf8( string, buffer, BUFFER_SIZE );
+        test_v_long( test, result, 12 );
+        test_v_str( test, buffer, "x\xF0\x9F\x98\x80y caf\xC3\xA9" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_export_utf8(), replaced sequences" );
+        string = hzstr_create_cstr( "a\xFF" "b" );
+        result = hzstr_export_utf8( string, buffer, BUFFER_SIZE );
+        test_v_long( test, result, 5 );
+        test_v_str( test, buffer, "a\xEF\xBF\xBD" "b" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_export_utf8(), unpaired surrogate" );
+        string = hzstr_create_cstr( "ab" );
+        string->data[ 0 ] = 0xD800;
+        result = hzstr_export_utf8( string, buffer, BUFFER_SIZE );
+        test_v_long( test, result, 4 );
+        test_v_str( test, buffer, "\xEF\xBF\xBD" "b" );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_export_utf8(), long string" );
+        memset( buffer, 'q', 200 );
+        string = hzstr_create_cstr( buffer );
+        memset( buffer, 0, BUFFER_SIZE );
+        result = hzstr_export_utf8( string, buffer, BUFFER_SIZE );
+        test_v_long( test, result, 200 );
+        test_v_long( test, strspn( buffer, "q" ), 200 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_export_utf8(), output too small" );
+        string = hzstr_create_cstr( "caf\xC3\xA9" );
+        result = hzstr_export_utf8( string, buffer, 5 );
+        test_v_long( test, result, HZSTR_RSLT_SAFETY );
+        result = hzstr_export_utf8( string, buffer, 6 );
+        test_v_long( test, result, 5 );
+        hzstr_destroy( string );
+
+        t_sec( "hzstr_export_utf8(), invalid usage" );
+        result = hzstr_export_utf8( NULL, buffer, BUFFER_SIZE );
+        test_v_long( test, result, HZSTR_RSLT_USAGE );
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
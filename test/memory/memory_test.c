@@ -0,0 +1,402 @@
+/*****************************************************************************
+    memory_test.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        The pool keeps its blocks from one check to the next, so each check
+        uses a size class that no earlier check has used, and verifies the
+        change in the pool's statistics.  The test stubs take the place of
+        the system allocator, so they count the pool's calls to the system.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "memory.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define MAX_ALLOCS ( 8 )
+#define NUM_BLOCKS ( 100 )          //blocks for the batch checks
+
+//bytes taken from the system for one slab of a size class
+#define slab_bytes( _s ) ( MEM_POOL_HEAD + ( 32 * ( MEM_POOL_HEAD + _s ) ) )
+
+//define symbols to disable the corresponding test section
+//#define TNO_MALLOC
+//#define TNO_FREE
+//#define TNO_REALLOC
+//#define TNO_CALLOC
+//#define TNO_FLUSH
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+unsigned char           fail_calloc;
+unsigned char           fail_callocs[ MAX_ALLOCS ];
+unsigned char           fail_malloc;
+unsigned char           fail_mallocs[ MAX_ALLOCS ];
+unsigned char           fail_realloc;
+unsigned char           fail_reallocs[ MAX_ALLOCS ];
+
+mem_pool_stats_type     after;
+mem_pool_stats_type     before;
+char*                   block;
+char*                   blocks[ NUM_BLOCKS ];
+int                     position;
+char*                   other;
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void reset_test(
+    void
+) {
+    fail_calloc  = 0;
+    fail_malloc  = 0;
+    fail_realloc = 0;
+    memset( fail_callocs,  0, MAX_ALLOCS );
+    memset( fail_mallocs,  0, MAX_ALLOCS );
+    memset( fail_reallocs, 0, MAX_ALLOCS );
+
+    block    = NULL;
+    other    = NULL;
+    position = 0;
+    memset( blocks, 0, sizeof( blocks ) );
+    mem_pool_stats( &before );
+    after = before;
+}
+
+
+/*==========================================================================*/
+int run_test(                       //run the unit test
+    test_control_type*  test        //test control object
+) {                                 //result of test
+
+#ifndef TNO_MALLOC
+    t_hdg( "Pool Allocation" );
+
+        t_sec( "mem_pool_malloc(), first block of a size class" );
+        block = mem_pool_malloc( 24 );
+        test_v_ptr( test, block );
+        test_v_long( test, fail_malloc, 1 );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.misses - before.misses ), 1 );
+        test_v_long( test, ( after.hits - before.hits ), 0 );
+        test_v_long(
+            test, ( after.system - before.system ), slab_bytes( 32 )
+        );
+        test_v_long( test, ( after.held - before.held ), ( 31 * 32 ) );
+        test_v_long( test, ( ( uintptr_t ) block % MEM_POOL_GRAIN ), 0 );
+        mem_pool_free( block );
+
+        t_sec( "mem_pool_malloc(), the rest of the slab is re-used" );
+        block = mem_pool_malloc( 17 );
+        other = mem_pool_malloc( 32 );
+        test_v_ptr( test, block );
+        test_v_ptr( test, other );
+        test_v_long( test, fail_malloc, 0 );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.hits - before.hits ), 2 );
+        test_v_long( test, ( after.misses - before.misses ), 0 );
+        mem_pool_free( block );
+        mem_pool_free( other );
+
+        t_sec( "mem_pool_malloc(), zero bytes" );
+        block = mem_pool_malloc( 0 );
+        test_v_ptr( test, block );
+        mem_pool_free( block );
+
+        t_sec( "mem_pool_malloc(), large blocks come from the system" );
+        block = mem_pool_malloc( MEM_POOL_MAX + 1 );
+        test_v_ptr( test, block );
+        test_v_long( test, fail_malloc, 1 );
+        memset( block, 'a', ( MEM_POOL_MAX + 1 ) );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.misses - before.misses ), 1 );
+        test_v_long( test, ( after.system - before.system ), 0 );
+        mem_pool_free( block );
+
+        t_sec( "mem_pool_malloc(), no memory for a slab" );
+        fail_mallocs[ 0 ] = 1;
+        block = mem_pool_malloc( 400 );
+        test_v_null( test, block );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.system - before.system ), 0 );
+
+        t_sec( "mem_pool_malloc(), no memory for a large block" );
+        fail_mallocs[ 0 ] = 1;
+        block = mem_pool_malloc( 5000 );
+        test_v_null( test, block );
+
+        t_sec( "mem_pool_malloc(), size too large" );
+        block = mem_pool_malloc( SIZE_MAX );
+        test_v_null( test, block );
+        test_v_long( test, fail_malloc, 0 );
+#endif
+
+#ifndef TNO_FREE
+    t_hdg( "Pool Release" );
+
+        t_sec( "mem_pool_free(), a released block is re-used" );
+        block = mem_pool_malloc( 40 );
+        mem_pool_free( block );
+        other = mem_pool_malloc( 48 );
+        test_v_long( test, ( other == block ), 1 );
+        test_v_long( test, fail_malloc, 1 );
+        mem_pool_free( other );
+
+        t_sec( "mem_pool_free(), NULL" );
+        mem_pool_free( NULL );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.held - before.held ), 0 );
+
+        t_sec( "mem_pool_free(), held bytes" );
+        for( position = 0; position < NUM_BLOCKS; ++position ) {
+            blocks[ position ] = mem_pool_malloc( 496 );
+        }
+        test_v_long( test, fail_malloc, 4 );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.held - before.held ), ( 28 * 496 ) );
+        for( position = 0; position < NUM_BLOCKS; ++position ) {
+            mem_pool_free( blocks[ position ] );
+        }
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.held - before.held ), ( 128 * 496 ) );
+
+        t_sec( "mem_pool_free(), blocks given back in batches are re-used" );
+        for( position = 0; position < NUM_BLOCKS; ++position ) {
+            blocks[ position ] = mem_pool_malloc( 490 );
+        }
+        test_v_long( test, fail_malloc, 0 );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.hits - before.hits ), NUM_BLOCKS );
+        for( position = 0; position < NUM_BLOCKS; ++position ) {
+            mem_pool_free( blocks[ position ] );
+        }
+
+        t_sec( "mem_pool_free(), large blocks go back to the system" );
+        block = mem_pool_malloc( 1000 );
+        mem_pool_free( block );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.held - before.held ), 0 );
+#endif
+
+#ifndef TNO_REALLOC
+    t_hdg( "Pool Re-Size" );
+
+        t_sec( "mem_pool_realloc(), NULL allocates" );
+        block = mem_pool_realloc( NULL, 56 );
+        test_v_ptr( test, block );
+        test_v_long( test, fail_malloc, 1 );
+        test_v_long( test, fail_realloc, 0 );
+        mem_pool_free( block );
+
+        t_sec( "mem_pool_realloc(), within the size class" );
+        block = mem_pool_malloc( 50 );
+        strcpy( block, "Hello World" );
+        other = mem_pool_realloc( block, 64 );
+        test_v_long( test, ( other == block ), 1 );
+        test_v_str( test, other, "Hello World" );
+        other = mem_pool_realloc( other, 49 );
+        test_v_long( test, ( other == block ), 1 );
+        mem_pool_free( other );
+
+        t_sec( "mem_pool_realloc(), to a larger size class" );
+        block = mem_pool_malloc( 72 );
+        strcpy( block, "Hello World" );
+        other = mem_pool_realloc( block, 200 );
+        test_v_ptr( test, other );
+        test_v_long( test, ( other == block ), 0 );
+        test_v_str( test, other, "Hello World" );
+        test_v_long( test, fail_realloc, 0 );
+        mem_pool_free( other );
+
+        t_sec( "mem_pool_realloc(), to a smaller size class" );
+        block = mem_pool_malloc( 300 );
+        memset( block, 'a', 300 );
+        other = mem_pool_realloc( block, 80 );
+        test_v_ptr( test, other );
+        test_v_long( test, ( other == block ), 0 );
+        test_v_long( test, other[ 79 ], 'a' );
+        mem_pool_free( other );
+
+        t_sec( "mem_pool_realloc(), large blocks" );
+        block = mem_pool_malloc( 100 );
+        strcpy( block, "Hello World" );
+        block = mem_pool_realloc( block, 1000 );
+        test_v_str( test, block, "Hello World" );
+        block = mem_pool_realloc( block, 2000 );
+        test_v_str( test, block, "Hello World" );
+        test_v_long( test, fail_realloc, 1 );
+        block = mem_pool_realloc( block, 100 );
+        test_v_str( test, block, "Hello World" );
+        test_v_long( test, fail_realloc, 1 );
+        mem_pool_free( block );
+
+        t_sec( "mem_pool_realloc(), no memory for a new block" );
+        block = mem_pool_malloc( 140 );
+        strcpy( block, "Hello World" );
+        fail_mallocs[ 1 ] = 1;
+        other = mem_pool_realloc( block, 380 );
+        test_v_null( test, other );
+        test_v_str( test, block, "Hello World" );
+        mem_pool_free( block );
+
+        t_sec( "mem_pool_realloc(), no memory for a large block" );
+        block = mem_pool_malloc( 3000 );
+        fail_reallocs[ 0 ] = 1;
+        other = mem_pool_realloc( block, 4000 );
+        test_v_null( test, other );
+        other = mem_pool_realloc( block, SIZE_MAX );
+        test_v_null( test, other );
+        mem_pool_free( block );
+#endif
+
+#ifndef TNO_CALLOC
+    t_hdg( "Pool Zeroed Allocation" );
+
+        t_sec( "mem_pool_calloc(), re-used blocks are cleared" );
+        block = mem_pool_malloc( 120 );
+        memset( block, 0xFF, 120 );
+        mem_pool_free( block );
+        other = mem_pool_calloc( 4, 30 );
+        test_v_long( test, ( other == block ), 1 );
+        for( position = 0; position < 120; ++position ) {
+            if( other[ position ] != 0 ) {
+                break;
+            }
+        }
+        test_v_long( test, position, 120 );
+        mem_pool_free( other );
+
+        t_sec( "mem_pool_calloc(), size too large" );
+        block = mem_pool_calloc( SIZE_MAX, 2 );
+        test_v_null( test, block );
+        test_v_long( test, fail_malloc, 0 );
+
+        t_sec( "mem_pool_calloc(), no memory" );
+        fail_mallocs[ 0 ] = 1;
+        block = mem_pool_calloc( 1, 430 );
+        test_v_null( test, block );
+#endif
+
+#ifndef TNO_FLUSH
+    t_hdg( "Pool Flush" );
+
+        t_sec( "mem_pool_flush(), cached blocks are kept for re-use" );
+        block = mem_pool_malloc( 150 );
+        mem_pool_free( block );
+        mem_pool_stats( &before );
+        mem_pool_flush();
+        mem_pool_stats( &after );
+        test_v_long( test, after.held, before.held );
+
+        t_sec( "mem_pool_flush(), flushed blocks are re-used" );
+        block = mem_pool_malloc( 150 );
+        test_v_ptr( test, block );
+        test_v_long( test, fail_malloc, 0 );
+        mem_pool_stats( &after );
+        test_v_long( test, ( after.hits - before.hits ), 1 );
+        mem_pool_free( block );
+#endif
+
+    return 0;
+}
+
+
+/*----------------------------------------------------------------------------
+Test Stubs
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void* mem_calloc(
+    size_t              num,
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_callocs[ fail_calloc ] == 0 ) {
+        ptr = calloc( num, size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_calloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_calloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void mem_free(
+    void*               ptr
+) {
+    free( ptr );
+}
+
+
+/*==========================================================================*/
+void* mem_malloc(
+    size_t              size
+) {
+    void*               ptr;
+    if( fail_mallocs[ fail_malloc ] == 0 ) {
+        ptr = malloc( size );
+    }
+    else {
+        ptr = NULL;
+    }
+    if( fail_malloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_malloc += 1;
+    }
+    return ptr;
+}
+
+
+/*==========================================================================*/
+void* mem_realloc(
+    void*               ptr,
+    size_t              size
+) {
+    void*               reptr;
+    if( fail_reallocs[ fail_realloc ] == 0 ) {
+        reptr = realloc( ptr, size );
+    }
+    else {
+        reptr = NULL;
+    }
+    if( fail_realloc < ( MAX_ALLOCS - 1 ) ) {
+        fail_realloc += 1;
+    }
+    return reptr;
+}
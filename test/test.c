@@ -122,7 +122,7 @@ void test_fmt(                      //write formatted text to a test
 /*==========================================================================*/
 void test_hdg(                      //write a heading to a test
     test_control_type*  test,       //the test instance
-    char*               hdg,        //heading to write
+    const char*         hdg,        //heading to write
     unsigned char       level       //heading level (0 -> 3)
 ) {
 
@@ -49,6 +49,10 @@ Memory Constants
 Interface Prototypes
 ----------------------------------------------------------------------------*/
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 void test_fmt(                      //write formatted text to a test
     test_control_type*  test,       //the test instance
     const char*         format,     //the format string
@@ -57,7 +61,7 @@ void test_fmt(                      //write formatted text to a test
 
 void test_hdg(                      //write a heading to a test
     test_control_type*  test,       //the test instance
-    char*               hdg,        //heading to write
+    const char*         hdg,        //heading to write
     unsigned char       level       //heading level (0 -> 3)
 );
 
@@ -120,4 +124,8 @@ int test_v_str(                     //verify strings are the same
     const char*         str1        //string 1
 );                                  //0 if verified
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _TEST_H */
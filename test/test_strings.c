@@ -0,0 +1,124 @@
+/*****************************************************************************
+    test_strings.c
+    Zac Hester
+    2026-10-19
+
+    Notes
+
+        The strings come from a linear congruential generator, so a test
+        set is the same on every run (and every platform) after the same
+        seed.
+
+*****************************************************************************/
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "test_strings.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+#define BUFFER_SIZE ( 65536 )       //longest string added
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Module Variables
+----------------------------------------------------------------------------*/
+
+static char             buffer[ BUFFER_SIZE ];
+                                    //characters of the next string
+static unsigned long    random_state = 1;
+                                    //pseudo-random state
+
+/*----------------------------------------------------------------------------
+Module Prototypes
+----------------------------------------------------------------------------*/
+
+static unsigned long next_random(   //advance the pseudo-random state
+    void
+);                                  //new state
+
+/*----------------------------------------------------------------------------
+Functions
+----------------------------------------------------------------------------*/
+
+
+/*==========================================================================*/
+void test_strings_add(              //add random strings to a test set
+    hzstr_type**        strings,    //the test set
+    int*                count,      //number of strings in the test set
+    int                 total,      //number of strings to add
+    int                 prefix,     //length of a shared prefix
+    int                 longest,    //longest string after the prefix
+    const char*         alphabet,   //characters the strings are made of
+    int                 bytes       //one in this many is any byte (0 = none)
+) {
+
+    //local variables
+    int                 index;      //string index
+    int                 length;     //length of the string
+    int                 letters;    //number of characters in the alphabet
+    int                 pos;        //character position
+    unsigned long       random;     //next pseudo-random value
+
+    //the characters come from the alphabet, with a few bytes of any value
+    letters = strlen( alphabet );
+    memset( buffer, 'q', prefix );
+    for( index = 0; index < total; ++index ) {
+        random = next_random();
+        length = prefix + ( int ) ( ( random >> 16 ) % ( longest + 1 ) );
+        for( pos = prefix; pos < length; ++pos ) {
+            random = next_random();
+            buffer[ pos ] = alphabet[ ( random >> 16 ) % letters ];
+            if( ( bytes != 0 ) && ( ( ( random >> 24 ) % bytes ) == 0 ) ) {
+                buffer[ pos ] = ( char ) ( random >> 8 );
+            }
+        }
+        strings[ ( *count )++ ] = hzstr_create_cstr_n( buffer, length );
+    }
+}
+
+
+/*==========================================================================*/
+void test_strings_destroy(          //destroy every string in a test set
+    hzstr_type**        strings,    //the test set
+    int*                count       //number of strings in the test set
+) {
+
+    //local variables
+    int                 index;      //string index
+
+    for( index = 0; index < *count; ++index ) {
+        hzstr_destroy( strings[ index ] );
+    }
+    *count = 0;
+}
+
+
+/*==========================================================================*/
+void test_strings_seed(             //restart the random strings
+    unsigned long       seed        //pseudo-random state
+) {
+    random_state = seed;
+}
+
+
+/*==========================================================================*/
+static unsigned long next_random(   //advance the pseudo-random state
+    void
+) {                                 //new state
+    random_state = ( random_state * 1103515245ul ) + 12345ul;
+    return random_state;
+}
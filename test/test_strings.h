@@ -0,0 +1,73 @@
+/*****************************************************************************
+    test_strings.h
+    Zac Hester
+    2026-10-19
+
+    Description
+
+        Shared fixture for tests of modules that work on arrays of Hz
+        strings.  A test keeps its own array and count; the fixture fills
+        the array with reproducible pseudo-random strings and destroys
+        them again.
+
+    Example Usage
+
+        test_strings_seed( 1 );
+        test_strings_add( strings, &count, 1000, 0, 40, "aAbB", 0 );
+        test_strings_destroy( strings, &count );
+
+*****************************************************************************/
+
+#ifndef _TEST_STRINGS_H
+#define _TEST_STRINGS_H
+
+/*----------------------------------------------------------------------------
+Includes
+----------------------------------------------------------------------------*/
+
+#include "hzstr.h"
+
+/*----------------------------------------------------------------------------
+Macros
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Types and Structures
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Memory Constants
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+Interface Prototypes
+----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void test_strings_add(              //add random strings to a test set
+    hzstr_type**        strings,    //the test set
+    int*                count,      //number of strings in the test set
+    int                 total,      //number of strings to add
+    int                 prefix,     //length of a shared prefix
+    int                 longest,    //longest string after the prefix
+    const char*         alphabet,   //characters the strings are made of
+    int                 bytes       //one in this many is any byte (0 = none)
+);
+
+void test_strings_destroy(          //destroy every string in a test set
+    hzstr_type**        strings,    //the test set
+    int*                count       //number of strings in the test set
+);
+
+void test_strings_seed(             //restart the random strings
+    unsigned long       seed        //pseudo-random state
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TEST_STRINGS_H */